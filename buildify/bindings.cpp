@@ -12,6 +12,79 @@
 namespace py = pybind11;
 using namespace buildify;
 
+namespace {
+
+// Python objects held by tasks that finish on worker threads; released
+// with the GIL.
+std::shared_ptr<py::object> hold_for_workers(py::object object) {
+    return std::shared_ptr<py::object>(new py::object(std::move(object)), [](py::object* held) {
+        py::gil_scoped_acquire acquire;
+        delete held;
+    });
+}
+
+// Runs `task` and returns an asyncio future of the running loop for its
+// result, converted by `convert` under the GIL; an exception thrown by the
+// task is raised from the future as RuntimeError. Progress is reported on
+// the loop thread; cancelling the future cancels the task.
+template<typename T, typename Convert>
+py::object as_future(utils::Task<T> task, utils::CancellationSource cancel, Convert convert) {
+    auto loop = py::module_::import("asyncio").attr("get_running_loop")();
+    auto future = loop.attr("create_future")();
+    future.attr("add_done_callback")(py::cpp_function([cancel](py::object done) mutable {
+        if (done.attr("cancelled")().cast<bool>()) {
+            cancel.cancel();
+        }
+    }));
+
+    auto held_loop = hold_for_workers(loop);
+    auto held_future = hold_for_workers(future);
+    utils::start(std::move(task), [held_loop, held_future, convert](std::exception_ptr error, std::optional<T> value) {
+        py::gil_scoped_acquire acquire;
+        auto settle = py::cpp_function([](py::object future, py::object result, bool failed) {
+            if (!future.attr("done")().cast<bool>()) {
+                future.attr(failed ? "set_exception" : "set_result")(result);
+            }
+        });
+        try {
+            py::object result;
+            if (error) {
+                std::string message = "unknown error";
+                try {
+                    std::rethrow_exception(error);
+                } catch (const std::exception& exception) {
+                    message = exception.what();
+                } catch (...) {
+                }
+                result = py::module_::import("builtins").attr("RuntimeError")(message);
+            } else {
+                result = convert(std::move(*value));
+            }
+            held_loop->attr("call_soon_threadsafe")(settle, *held_future, result, static_cast<bool>(error));
+        } catch (py::error_already_set&) {
+            // The loop closed before the task finished; nobody is waiting.
+        }
+    });
+    return future;
+}
+
+utils::ProgressCallback progress_on_loop(const py::object& progress) {
+    if (progress.is_none()) {
+        return {};
+    }
+    auto held_loop = hold_for_workers(py::module_::import("asyncio").attr("get_running_loop")());
+    auto held_progress = hold_for_workers(progress);
+    return [held_loop, held_progress](float done) {
+        py::gil_scoped_acquire acquire;
+        try {
+            held_loop->attr("call_soon_threadsafe")(*held_progress, done);
+        } catch (py::error_already_set&) {
+        }
+    };
+}
+
+}
+
 PYBIND11_MODULE(pybuildify, m) {
     m.doc() = "Buildify 3D Gaussian Splatting Python bindings";
 
@@ -51,7 +124,22 @@ PYBIND11_MODULE(pybuildify, m) {
         .def_readwrite("z", &utils::Quaternion<float>::z)
         .def_readwrite("w", &utils::Quaternion<float>::w)
         .def_static("from_axis_angle", &utils::Quaternion<float>::from_axis_angle)
-        .def("to_matrix", &utils::Quaternion<float>::to_matrix);
+        .def_static("from_matrix", &utils::Quaternion<float>::from_matrix)
+        .def_static("slerp", &utils::Quaternion<float>::slerp,
+                    py::arg("a"), py::arg("b"), py::arg("t"), py::arg("shortest_path") = true)
+        .def("__mul__", &utils::Quaternion<float>::operator*)
+        .def("dot", &utils::Quaternion<float>::dot)
+        .def("length", &utils::Quaternion<float>::length)
+        .def("normalized", &utils::Quaternion<float>::normalized)
+        .def("conjugate", &utils::Quaternion<float>::conjugate)
+        .def("inverse", &utils::Quaternion<float>::inverse)
+        .def("rotate", &utils::Quaternion<float>::rotate)
+        .def("log", &utils::Quaternion<float>::log)
+        .def("exp", &utils::Quaternion<float>::exp)
+        .def("to_matrix", &utils::Quaternion<float>::to_matrix)
+        .def("__repr__", [](const utils::Quaternion<float>& q) {
+            return std::format("Quaternion({}, {}, {}, {})", q.x, q.y, q.z, q.w);
+        });
 
     py::class_<utils::Matrix4<float>>(utils, "Matrix4")
         .def(py::init<>())
@@ -76,17 +164,138 @@ PYBIND11_MODULE(pybuildify, m) {
         utils::Logger::instance().set_level(level);
     });
 
+    py::enum_<utils::MemoryPlacement>(utils, "MemoryPlacement")
+        .value("Default", utils::MemoryPlacement::Default)
+        .value("Interleave", utils::MemoryPlacement::Interleave)
+        .value("Partitioned", utils::MemoryPlacement::Partitioned);
+
+    utils.def("numa_node_cpus", []() {
+        std::vector<std::vector<std::uint32_t>> cpus;
+        for (const auto& node : utils::NumaTopology::system().nodes()) {
+            cpus.push_back(node.cpus);
+        }
+        return cpus;
+    }, "CPUs of each NUMA node this process may run on");
+
+    py::enum_<utils::HugePageMode>(utils, "HugePageMode")
+        .value("Off", utils::HugePageMode::Off)
+        .value("Transparent", utils::HugePageMode::Transparent)
+        .value("Explicit", utils::HugePageMode::Explicit);
+
+    utils.def("set_huge_page_mode", &utils::set_huge_page_mode);
+    utils.def("get_huge_page_mode", &utils::get_huge_page_mode);
+
+    py::class_<utils::HugePageStats>(utils, "HugePageStats")
+        .def_readonly("mapped_bytes", &utils::HugePageStats::mapped_bytes)
+        .def_readonly("explicit_allocations", &utils::HugePageStats::explicit_allocations)
+        .def_readonly("explicit_fallbacks", &utils::HugePageStats::explicit_fallbacks);
+
+    utils.def("get_huge_page_stats", &utils::get_huge_page_stats);
+
+    py::class_<utils::TlbMissCounter>(utils, "TlbMissCounter")
+        .def(py::init<>())
+        .def("start", &utils::TlbMissCounter::start)
+        .def("stop", &utils::TlbMissCounter::stop);
+
+    py::class_<utils::FileWatcher>(utils, "FileWatcher")
+        .def(py::init<>())
+        .def("watch", &utils::FileWatcher::watch)
+        .def("unwatch", &utils::FileWatcher::unwatch)
+        .def("is_watching", &utils::FileWatcher::is_watching)
+        .def("poll", &utils::FileWatcher::poll)
+        .def_static("normalize", &utils::FileWatcher::normalize);
+
     py::module_ core = m.def_submodule("core", "Core engine classes");
 
+    py::class_<core::EngineConfig>(core, "EngineConfig")
+        .def(py::init<>())
+        .def_readwrite("worker_threads", &core::EngineConfig::worker_threads)
+        .def_readwrite("pin_threads", &core::EngineConfig::pin_threads)
+        .def_readwrite("memory_placement", &core::EngineConfig::memory_placement)
+        .def_readwrite("huge_pages", &core::EngineConfig::huge_pages)
+        .def_readwrite("scene_memory_budget", &core::EngineConfig::scene_memory_budget)
+        .def_readwrite("spill_directory", &core::EngineConfig::spill_directory)
+        .def_readwrite("hot_reload_scenes", &core::EngineConfig::hot_reload_scenes)
+        .def_readwrite("log_level", &core::EngineConfig::log_level)
+        .def_readwrite("sort_mode", &core::EngineConfig::sort_mode)
+        .def_property("frame_budget_ms",
+            [](const core::EngineConfig& config) { return config.frame_budget.count() / 1000.0; },
+            [](core::EngineConfig& config, double milliseconds) {
+                config.frame_budget = std::chrono::microseconds(static_cast<std::int64_t>(milliseconds * 1000.0));
+            })
+        .def_readwrite("temporal_cache", &core::EngineConfig::temporal_cache)
+        .def_static("from_json", [](const std::string& text) {
+            utils::Config config;
+            if (!config.parse(text)) {
+                throw std::invalid_argument("Invalid configuration JSON");
+            }
+            return core::EngineConfig::from_config(config);
+        }, py::arg("text"))
+        .def("to_json", [](const core::EngineConfig& config) { return config.to_config().dump(); });
+
+    py::class_<core::RunSettings>(core, "RunSettings")
+        .def(py::init<>())
+        .def_property("fixed_timestep_ms",
+            [](const core::RunSettings& settings) { return settings.fixed_timestep.count() / 1000.0; },
+            [](core::RunSettings& settings, double milliseconds) {
+                settings.fixed_timestep = std::chrono::microseconds(static_cast<std::int64_t>(milliseconds * 1000.0));
+            })
+        .def_readwrite("target_frame_rate", &core::RunSettings::target_frame_rate)
+        .def_readwrite("max_catch_up_steps", &core::RunSettings::max_catch_up_steps)
+        .def_property("spin_threshold_ms",
+            [](const core::RunSettings& settings) { return settings.spin_threshold.count() / 1000.0; },
+            [](core::RunSettings& settings, double milliseconds) {
+                settings.spin_threshold = std::chrono::microseconds(static_cast<std::int64_t>(milliseconds * 1000.0));
+            })
+        .def_readwrite("max_frames", &core::RunSettings::max_frames);
+
+    py::class_<core::FrameTimingStats>(core, "FrameTimingStats")
+        .def_readonly("frames", &core::FrameTimingStats::frames)
+        .def_readonly("updates", &core::FrameTimingStats::updates)
+        .def_readonly("dropped_updates", &core::FrameTimingStats::dropped_updates)
+        .def_readonly("last_frame_ms", &core::FrameTimingStats::last_frame_ms)
+        .def_readonly("average_frame_ms", &core::FrameTimingStats::average_frame_ms)
+        .def_readonly("p99_frame_ms", &core::FrameTimingStats::p99_frame_ms)
+        .def_readonly("max_frame_ms", &core::FrameTimingStats::max_frame_ms)
+        .def_readonly("update_ms", &core::FrameTimingStats::update_ms)
+        .def_readonly("render_ms", &core::FrameTimingStats::render_ms)
+        .def_readonly("pacing_error_ms", &core::FrameTimingStats::pacing_error_ms)
+        .def_readonly("frames_per_second", &core::FrameTimingStats::frames_per_second);
+
+    py::class_<core::SceneResidencyStats>(core, "SceneResidencyStats")
+        .def_readonly("resident_bytes", &core::SceneResidencyStats::resident_bytes)
+        .def_readonly("resident_scenes", &core::SceneResidencyStats::resident_scenes)
+        .def_readonly("evicted_scenes", &core::SceneResidencyStats::evicted_scenes)
+        .def_readonly("evictions", &core::SceneResidencyStats::evictions)
+        .def_readonly("reloads", &core::SceneResidencyStats::reloads)
+        .def_readonly("stalls", &core::SceneResidencyStats::stalls);
+
     py::class_<core::Engine>(core, "Engine")
         .def(py::init<>())
-        .def("initialize", &core::Engine::initialize, py::arg("config_path") = "")
+        .def("initialize", py::overload_cast<const std::string&>(&core::Engine::initialize),
+             py::arg("config_path") = "")
+        .def("initialize", py::overload_cast<const core::EngineConfig&>(&core::Engine::initialize),
+             py::arg("config"))
+        .def("apply_config", &core::Engine::apply_config)
+        .def("get_config", &core::Engine::get_config)
+        .def("dump_config", &core::Engine::dump_config)
         .def("shutdown", &core::Engine::shutdown)
         .def("update", &core::Engine::update)
         .def("render", &core::Engine::render)
+        .def("set_frame_budget", [](core::Engine& engine, double milliseconds) {
+            engine.set_frame_budget(std::chrono::microseconds(static_cast<std::int64_t>(milliseconds * 1000.0)));
+        }, py::arg("milliseconds"))
+        .def("is_frame_converged", &core::Engine::is_frame_converged)
+        // Callbacks take the GIL back for themselves.
+        .def("run", &core::Engine::run, py::arg("settings") = core::RunSettings{},
+             py::call_guard<py::gil_scoped_release>())
+        .def("get_timing_stats", &core::Engine::get_timing_stats)
+        .def("get_interpolation_alpha", &core::Engine::get_interpolation_alpha)
         .def("create_scene", &core::Engine::create_scene)
-        .def("get_scene", &core::Engine::get_scene)
+        .def("get_scene", &core::Engine::get_scene, py::call_guard<py::gil_scoped_release>())
         .def("set_active_scene", &core::Engine::set_active_scene)
+        .def("prefetch_scene", &core::Engine::prefetch_scene)
+        .def("get_residency_stats", &core::Engine::get_residency_stats)
         .def("is_running", &core::Engine::is_running)
         .def("stop", &core::Engine::stop)
         .def("add_update_callback", [](core::Engine& engine, py::function callback) {
@@ -104,14 +313,434 @@ PYBIND11_MODULE(pybuildify, m) {
         .def("set_transform", &core::Entity::set_transform)
         .def("update", &core::Entity::update);
 
+    py::class_<core::CameraParams>(core, "CameraParams")
+        .def_readonly("view", &core::CameraParams::view)
+        .def_readonly("projection", &core::CameraParams::projection)
+        .def_readonly("view_projection", &core::CameraParams::view_projection)
+        .def_property_readonly("frustum", [](const core::CameraParams& params) {
+            py::array_t<float> planes({6, 4});
+            auto out = planes.mutable_unchecked<2>();
+            for (py::ssize_t i = 0; i < 6; ++i) {
+                const auto& plane = params.frustum[i];
+                out(i, 0) = plane.x;
+                out(i, 1) = plane.y;
+                out(i, 2) = plane.z;
+                out(i, 3) = plane.w;
+            }
+            return planes;
+        })
+        .def_readonly("position", &core::CameraParams::position)
+        .def_readonly("near", &core::CameraParams::near)
+        .def_readonly("far", &core::CameraParams::far)
+        .def_readonly("orthographic", &core::CameraParams::orthographic)
+        .def("sphere_in_frustum", &core::CameraParams::sphere_in_frustum, py::arg("center"), py::arg("radius"));
+
     py::class_<core::Camera, core::Entity, std::shared_ptr<core::Camera>>(core, "Camera")
         .def(py::init<const std::string&>(), py::arg("name") = "Camera")
+        .def("set_transform", &core::Camera::set_transform)
         .def("set_perspective", &core::Camera::set_perspective)
         .def("set_orthographic", &core::Camera::set_orthographic)
+        .def("get_params", &core::Camera::get_params)
         .def("get_view_matrix", &core::Camera::get_view_matrix)
         .def("get_projection_matrix", &core::Camera::get_projection_matrix)
+        .def("get_view_projection_matrix", &core::Camera::get_view_projection_matrix)
         .def("look_at", &core::Camera::look_at, py::arg("target"), py::arg("up") = utils::Vector3<float>{0, 1, 0});
 
+    py::class_<core::GaussianCloud>(core, "GaussianCloud")
+        .def(py::init<std::uint32_t>(), py::arg("sh_degree") = 0)
+        .def("size", &core::GaussianCloud::size)
+        .def("__len__", &core::GaussianCloud::size)
+        .def("get_sh_degree", &core::GaussianCloud::get_sh_degree)
+        .def("reserve", &core::GaussianCloud::reserve)
+        .def("resize", &core::GaussianCloud::resize)
+        .def("clear", &core::GaussianCloud::clear)
+        .def("add", &core::GaussianCloud::add,
+             py::arg("position"), py::arg("scale"), py::arg("rotation"), py::arg("opacity"), py::arg("color"))
+        .def("get_position", &core::GaussianCloud::get_position)
+        .def("get_color", &core::GaussianCloud::get_color)
+        .def("has_filter_3d", &core::GaussianCloud::has_filter_3d)
+        .def("compute_filter_3d", [](core::GaussianCloud& cloud, const std::vector<std::shared_ptr<core::Camera>>& cameras,
+                                     std::uint32_t width, std::uint32_t height) {
+            std::vector<core::Camera> views;
+            views.reserve(cameras.size());
+            for (const auto& camera : cameras) {
+                views.push_back(*camera);
+            }
+            cloud.compute_filter_3d(views, width, height);
+        }, py::arg("cameras"), py::arg("width"), py::arg("height"))
+        .def("clear_filter_3d", &core::GaussianCloud::clear_filter_3d)
+        .def_property("memory_placement", &core::GaussianCloud::get_memory_placement,
+                      &core::GaussianCloud::set_memory_placement)
+        .def("memory_footprint", &core::GaussianCloud::memory_footprint);
+
+    py::enum_<core::GaussianAttribute>(core, "GaussianAttribute")
+        .value("PositionX", core::GaussianAttribute::PositionX)
+        .value("PositionY", core::GaussianAttribute::PositionY)
+        .value("PositionZ", core::GaussianAttribute::PositionZ)
+        .value("ScaleX", core::GaussianAttribute::ScaleX)
+        .value("ScaleY", core::GaussianAttribute::ScaleY)
+        .value("ScaleZ", core::GaussianAttribute::ScaleZ)
+        .value("RotationX", core::GaussianAttribute::RotationX)
+        .value("RotationY", core::GaussianAttribute::RotationY)
+        .value("RotationZ", core::GaussianAttribute::RotationZ)
+        .value("RotationW", core::GaussianAttribute::RotationW)
+        .value("Opacity", core::GaussianAttribute::Opacity)
+        .value("ColorR", core::GaussianAttribute::ColorR)
+        .value("ColorG", core::GaussianAttribute::ColorG)
+        .value("ColorB", core::GaussianAttribute::ColorB);
+
+    // Column views alias the mapping and keep the segment alive; check
+    // end_read() before trusting what was read through them.
+    auto shared_view = [](const core::SharedGaussianSegment& segment, std::span<const float> values,
+                          py::ssize_t width) {
+        py::array_t<float> view({static_cast<py::ssize_t>(values.size()) / std::max<py::ssize_t>(width, 1), width},
+                                {width * static_cast<py::ssize_t>(sizeof(float)), static_cast<py::ssize_t>(sizeof(float))},
+                                values.data(), py::cast(segment, py::return_value_policy::reference));
+        view.attr("flags").attr("writeable") = false;
+        return view;
+    };
+
+    py::class_<core::SharedGaussianSegment>(core, "SharedGaussianSegment")
+        .def(py::init<>())
+        .def("create", &core::SharedGaussianSegment::create,
+             py::arg("name"), py::arg("capacity"), py::arg("sh_degree") = 0)
+        .def("open", &core::SharedGaussianSegment::open)
+        .def("close", &core::SharedGaussianSegment::close)
+        .def("is_open", &core::SharedGaussianSegment::is_open)
+        .def("is_writable", &core::SharedGaussianSegment::is_writable)
+        .def_property_readonly("name", &core::SharedGaussianSegment::get_name)
+        .def_property_readonly("capacity", &core::SharedGaussianSegment::get_capacity)
+        .def_property_readonly("sh_degree", &core::SharedGaussianSegment::get_sh_degree)
+        .def_property_readonly("generation", &core::SharedGaussianSegment::get_generation)
+        .def("publish", &core::SharedGaussianSegment::publish, py::call_guard<py::gil_scoped_release>())
+        // None when the writer never finished its publish.
+        .def("begin_read", [](const core::SharedGaussianSegment& segment, double milliseconds) {
+            return segment.begin_read(std::chrono::milliseconds(static_cast<std::int64_t>(milliseconds)));
+        }, py::arg("timeout_ms") = static_cast<double>(core::SharedGaussianSegment::default_read_timeout.count()),
+           py::call_guard<py::gil_scoped_release>())
+        .def("end_read", &core::SharedGaussianSegment::end_read)
+        .def("size", &core::SharedGaussianSegment::size)
+        .def("__len__", &core::SharedGaussianSegment::size)
+        .def("column", [shared_view](const core::SharedGaussianSegment& segment, core::GaussianAttribute attribute) {
+            return shared_view(segment, segment.column(attribute), 1).attr("reshape")(-1);
+        })
+        .def("sh_rest", [shared_view](const core::SharedGaussianSegment& segment) {
+            return shared_view(segment, segment.sh_rest(),
+                               static_cast<py::ssize_t>(core::GaussianCloud::sh_rest_coefficients(segment.get_sh_degree()) * 3));
+        })
+        .def("read", [](const core::SharedGaussianSegment& segment, core::GaussianCloud& cloud, double milliseconds) {
+            return segment.read(cloud, std::chrono::milliseconds(static_cast<std::int64_t>(milliseconds)));
+        }, py::arg("cloud"),
+           py::arg("timeout_ms") = static_cast<double>(core::SharedGaussianSegment::default_read_timeout.count()),
+           py::call_guard<py::gil_scoped_release>());
+
+    py::class_<core::Ray>(core, "Ray")
+        .def(py::init<>())
+        .def(py::init([](const utils::Vector3f& origin, const utils::Vector3f& direction) {
+            core::Ray ray;
+            ray.origin = origin;
+            ray.direction = direction;
+            return ray;
+        }), py::arg("origin"), py::arg("direction"))
+        .def_readwrite("origin", &core::Ray::origin)
+        .def_readwrite("direction", &core::Ray::direction)
+        .def_readwrite("t_min", &core::Ray::t_min)
+        .def_readwrite("t_max", &core::Ray::t_max);
+
+    py::class_<core::RayHit>(core, "RayHit")
+        .def_readonly("index", &core::RayHit::index)
+        .def_readonly("t", &core::RayHit::t)
+        .def_readonly("alpha", &core::RayHit::alpha)
+        .def_readonly("transmittance", &core::RayHit::transmittance);
+
+    py::class_<core::GaussianBVH>(core, "GaussianBVH")
+        .def(py::init<>())
+        .def("build", &core::GaussianBVH::build)
+        .def("refit", &core::GaussianBVH::refit)
+        .def("clear", &core::GaussianBVH::clear)
+        .def("empty", &core::GaussianBVH::empty)
+        .def("size", &core::GaussianBVH::size)
+        .def("node_count", &core::GaussianBVH::node_count)
+        .def("occluded", &core::GaussianBVH::occluded, py::arg("ray"), py::arg("max_transmittance") = 0.5f)
+        .def("pick", [](const core::GaussianBVH& bvh, const core::Ray& ray) -> std::optional<core::RayHit> {
+            auto result = bvh.cast_rays(std::span(&ray, 1), 1);
+            if (result.hit_counts[0] == 0) {
+                return std::nullopt;
+            }
+            return result.hits[0];
+        }, py::arg("ray"))
+        .def("cast_rays", [](const core::GaussianBVH& bvh,
+                             py::array_t<float, py::array::c_style | py::array::forcecast> origins,
+                             py::array_t<float, py::array::c_style | py::array::forcecast> directions,
+                             std::uint32_t max_hits) {
+            if (origins.ndim() != 2 || origins.shape(1) != 3 || directions.ndim() != 2 ||
+                directions.shape(1) != 3 || origins.shape(0) != directions.shape(0)) {
+                throw std::invalid_argument("origins and directions must both have shape (N, 3)");
+            }
+
+            const auto count = static_cast<std::size_t>(origins.shape(0));
+            std::vector<core::Ray> rays(count);
+            auto o = origins.unchecked<2>();
+            auto d = directions.unchecked<2>();
+            for (std::size_t i = 0; i < count; ++i) {
+                rays[i].origin = {o(i, 0), o(i, 1), o(i, 2)};
+                rays[i].direction = {d(i, 0), d(i, 1), d(i, 2)};
+            }
+
+            core::RayQueryResult result;
+            {
+                py::gil_scoped_release release;
+                bvh.cast_rays(rays, max_hits, result);
+            }
+
+            const auto k = static_cast<py::ssize_t>(result.max_hits);
+            const auto n = static_cast<py::ssize_t>(count);
+            py::array_t<std::int64_t> index({n, k});
+            py::array_t<float> t({n, k});
+            py::array_t<float> alpha({n, k});
+            py::array_t<float> transmittance({n, k});
+            auto index_out = index.mutable_unchecked<2>();
+            auto t_out = t.mutable_unchecked<2>();
+            auto alpha_out = alpha.mutable_unchecked<2>();
+            auto transmittance_out = transmittance.mutable_unchecked<2>();
+            for (py::ssize_t r = 0; r < n; ++r) {
+                auto hits = result.hits_for(static_cast<std::size_t>(r));
+                for (py::ssize_t h = 0; h < k; ++h) {
+                    bool valid = h < static_cast<py::ssize_t>(hits.size());
+                    index_out(r, h) = valid ? hits[h].index : -1;
+                    t_out(r, h) = valid ? hits[h].t : std::numeric_limits<float>::infinity();
+                    alpha_out(r, h) = valid ? hits[h].alpha : 0.0f;
+                    transmittance_out(r, h) = valid ? hits[h].transmittance : result.transmittance[r];
+                }
+            }
+
+            py::dict output;
+            output["index"] = index;
+            output["t"] = t;
+            output["alpha"] = alpha;
+            output["transmittance"] = transmittance;
+            output["hit_count"] = py::array_t<std::uint32_t>(n, result.hit_counts.data());
+            output["remaining_transmittance"] = py::array_t<float>(n, result.transmittance.data());
+            return output;
+        }, py::arg("origins"), py::arg("directions"), py::arg("max_hits") = 1);
+
+    py::enum_<core::TrajectoryInterpolation>(core, "TrajectoryInterpolation")
+        .value("Linear", core::TrajectoryInterpolation::Linear)
+        .value("CatmullRom", core::TrajectoryInterpolation::CatmullRom)
+        .value("CubicSpline", core::TrajectoryInterpolation::CubicSpline);
+
+    py::class_<core::CameraKeyframe>(core, "CameraKeyframe")
+        .def(py::init<>())
+        .def_readwrite("time", &core::CameraKeyframe::time)
+        .def_readwrite("position", &core::CameraKeyframe::position)
+        .def_readwrite("rotation", &core::CameraKeyframe::rotation);
+
+    py::class_<core::CameraTrajectory>(core, "CameraTrajectory")
+        .def(py::init<core::TrajectoryInterpolation>(),
+             py::arg("interpolation") = core::TrajectoryInterpolation::CatmullRom)
+        .def("add_keyframe", py::overload_cast<double, const utils::Vector3f&, const utils::Quaternionf&>(
+                 &core::CameraTrajectory::add_keyframe),
+             py::arg("time"), py::arg("position"), py::arg("rotation"))
+        .def("add_keyframe", py::overload_cast<double, const core::Camera&>(&core::CameraTrajectory::add_keyframe),
+             py::arg("time"), py::arg("camera"))
+        .def("set_keyframes", [](core::CameraTrajectory& trajectory,
+                                 py::array_t<double, py::array::c_style | py::array::forcecast> times,
+                                 py::array_t<float, py::array::c_style | py::array::forcecast> positions,
+                                 py::array_t<float, py::array::c_style | py::array::forcecast> rotations) {
+            if (times.ndim() != 1 || positions.ndim() != 2 || positions.shape(1) != 3 || rotations.ndim() != 2 ||
+                rotations.shape(1) != 4 || positions.shape(0) != times.shape(0) ||
+                rotations.shape(0) != times.shape(0)) {
+                throw std::invalid_argument("expected times (N,), positions (N, 3) and rotations (N, 4) as xyzw");
+            }
+            auto t = times.unchecked<1>();
+            auto p = positions.unchecked<2>();
+            auto q = rotations.unchecked<2>();
+            std::vector<core::CameraKeyframe> keyframes(static_cast<std::size_t>(times.shape(0)));
+            for (py::ssize_t i = 0; i < times.shape(0); ++i) {
+                keyframes[i] = {t(i), {p(i, 0), p(i, 1), p(i, 2)}, {q(i, 0), q(i, 1), q(i, 2), q(i, 3)}};
+            }
+            trajectory.set_keyframes(std::move(keyframes));
+        }, py::arg("times"), py::arg("positions"), py::arg("rotations"))
+        .def("get_keyframes", [](const core::CameraTrajectory& trajectory) {
+            auto keyframes = trajectory.get_keyframes();
+            return std::vector<core::CameraKeyframe>(keyframes.begin(), keyframes.end());
+        })
+        .def("clear", &core::CameraTrajectory::clear)
+        .def("size", &core::CameraTrajectory::size)
+        .def("__len__", &core::CameraTrajectory::size)
+        .def("get_start_time", &core::CameraTrajectory::get_start_time)
+        .def("get_end_time", &core::CameraTrajectory::get_end_time)
+        .def("get_duration", &core::CameraTrajectory::get_duration)
+        .def("set_interpolation", &core::CameraTrajectory::set_interpolation)
+        .def("get_interpolation", &core::CameraTrajectory::get_interpolation)
+        .def("set_looping", &core::CameraTrajectory::set_looping)
+        .def("is_looping", &core::CameraTrajectory::is_looping)
+        .def("evaluate", py::overload_cast<double>(&core::CameraTrajectory::evaluate, py::const_), py::arg("time"))
+        .def("evaluate_batch", [](const core::CameraTrajectory& trajectory,
+                                  py::array_t<double, py::array::c_style | py::array::forcecast> times) {
+            const auto count = static_cast<std::size_t>(times.size());
+            std::vector<utils::Vector3f> positions(count);
+            std::vector<utils::Quaternionf> rotations(count);
+            {
+                py::gil_scoped_release release;
+                trajectory.evaluate({times.data(), count}, positions, rotations);
+            }
+            const auto n = static_cast<py::ssize_t>(count);
+            py::array_t<float> position({n, py::ssize_t{3}});
+            py::array_t<float> rotation({n, py::ssize_t{4}});
+            auto position_out = position.mutable_unchecked<2>();
+            auto rotation_out = rotation.mutable_unchecked<2>();
+            for (py::ssize_t i = 0; i < n; ++i) {
+                position_out(i, 0) = positions[i].x;
+                position_out(i, 1) = positions[i].y;
+                position_out(i, 2) = positions[i].z;
+                rotation_out(i, 0) = rotations[i].x;
+                rotation_out(i, 1) = rotations[i].y;
+                rotation_out(i, 2) = rotations[i].z;
+                rotation_out(i, 3) = rotations[i].w;
+            }
+            return py::make_tuple(position, rotation);
+        }, py::arg("times"))
+        .def("sample_cameras", [](const core::CameraTrajectory& trajectory, const core::Camera& prototype,
+                                  const std::vector<double>& times) {
+            std::vector<std::shared_ptr<core::Camera>> cameras;
+            cameras.reserve(times.size());
+            for (auto& camera : trajectory.sample_cameras(prototype, times)) {
+                cameras.push_back(std::make_shared<core::Camera>(std::move(camera)));
+            }
+            return cameras;
+        }, py::arg("prototype"), py::arg("times"));
+
+    py::enum_<core::DeformationChannel>(core, "DeformationChannel", py::arithmetic())
+        .value("None", core::DeformationChannel::None)
+        .value("Position", core::DeformationChannel::Position)
+        .value("Rotation", core::DeformationChannel::Rotation)
+        .value("Scale", core::DeformationChannel::Scale);
+
+    py::class_<core::DeformationStreamWriter>(core, "DeformationStreamWriter")
+        .def(py::init<>())
+        .def("open", [](core::DeformationStreamWriter& writer, const std::string& path, std::size_t splat_count,
+                        float frame_rate, std::uint32_t channels, std::uint32_t block_frames) {
+            return writer.open(path, splat_count, frame_rate, static_cast<core::DeformationChannel>(channels),
+                               block_frames);
+        }, py::arg("path"), py::arg("splat_count"), py::arg("frame_rate"), py::arg("channels"),
+           py::arg("block_frames") = 8)
+        // Deltas are (N, 3) position offsets, (N, 4) xyzw rotations and
+        // (N, 3) scale factors; channels the stream lacks may be omitted.
+        .def("append_frame", [](core::DeformationStreamWriter& writer,
+                                std::optional<py::array_t<float, py::array::c_style | py::array::forcecast>> position,
+                                std::optional<py::array_t<float, py::array::c_style | py::array::forcecast>> rotation,
+                                std::optional<py::array_t<float, py::array::c_style | py::array::forcecast>> scale) {
+            std::vector<float> columns;
+            auto split = [&](const auto& array, std::size_t width) {
+                if (!array) {
+                    return std::size_t{0};
+                }
+                if (array->ndim() != 2 || array->shape(1) != static_cast<py::ssize_t>(width)) {
+                    throw std::invalid_argument("deformation arrays must have shape (N, 3) or (N, 4) for rotations");
+                }
+                auto view = array->template unchecked<2>();
+                auto count = static_cast<std::size_t>(view.shape(0));
+                for (std::size_t c = 0; c < width; ++c) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        columns.push_back(view(i, c));
+                    }
+                }
+                return count;
+            };
+            std::size_t counts[3] = {split(position, 3), split(rotation, 4), split(scale, 3)};
+
+            core::DeformationFrame frame;
+            const float* data = columns.data();
+            for (auto& column : frame.position) {
+                column = {data, counts[0]};
+                data += counts[0];
+            }
+            for (auto& column : frame.rotation) {
+                column = {data, counts[1]};
+                data += counts[1];
+            }
+            for (auto& column : frame.scale) {
+                column = {data, counts[2]};
+                data += counts[2];
+            }
+            return writer.append_frame(frame);
+        }, py::arg("position") = py::none(), py::arg("rotation") = py::none(), py::arg("scale") = py::none())
+        .def("close", &core::DeformationStreamWriter::close)
+        .def("get_frame_count", &core::DeformationStreamWriter::get_frame_count);
+
+    py::class_<core::GaussianAnimationStats>(core, "GaussianAnimationStats")
+        .def_readonly("blocks_loaded", &core::GaussianAnimationStats::blocks_loaded)
+        .def_readonly("stalls", &core::GaussianAnimationStats::stalls)
+        .def_readonly("resident_bytes", &core::GaussianAnimationStats::resident_bytes);
+
+    py::class_<core::GaussianAnimation, std::shared_ptr<core::GaussianAnimation>>(core, "GaussianAnimation")
+        .def(py::init<>())
+        .def("open", &core::GaussianAnimation::open)
+        .def("close", &core::GaussianAnimation::close)
+        .def("is_open", &core::GaussianAnimation::is_open)
+        .def("get_splat_count", &core::GaussianAnimation::get_splat_count)
+        .def("get_frame_count", &core::GaussianAnimation::get_frame_count)
+        .def("get_frame_rate", &core::GaussianAnimation::get_frame_rate)
+        .def("get_duration", &core::GaussianAnimation::get_duration)
+        .def("get_channels", [](const core::GaussianAnimation& animation) {
+            return static_cast<std::uint32_t>(animation.get_channels());
+        })
+        .def("bind", &core::GaussianAnimation::bind)
+        .def("is_bound", &core::GaussianAnimation::is_bound)
+        .def("set_time", &core::GaussianAnimation::set_time)
+        .def("get_time", &core::GaussianAnimation::get_time)
+        .def("set_playback_rate", &core::GaussianAnimation::set_playback_rate)
+        .def("get_playback_rate", &core::GaussianAnimation::get_playback_rate)
+        .def("set_looping", &core::GaussianAnimation::set_looping)
+        .def("is_looping", &core::GaussianAnimation::is_looping)
+        .def("set_playing", &core::GaussianAnimation::set_playing)
+        .def("is_playing", &core::GaussianAnimation::is_playing)
+        .def("advance", &core::GaussianAnimation::advance)
+        .def("evaluate", &core::GaussianAnimation::evaluate, py::call_guard<py::gil_scoped_release>())
+        .def("set_max_resident_blocks", &core::GaussianAnimation::set_max_resident_blocks)
+        .def("get_max_resident_blocks", &core::GaussianAnimation::get_max_resident_blocks)
+        .def("get_stats", &core::GaussianAnimation::get_stats);
+
+    py::class_<core::GaussianCluster>(core, "GaussianCluster")
+        .def_readonly("first", &core::GaussianCluster::first)
+        .def_readonly("count", &core::GaussianCluster::count)
+        .def_readonly("center", &core::GaussianCluster::center)
+        .def_readonly("radius", &core::GaussianCluster::radius);
+
+    // Held mutable on the Python side; the C++ API only ever reads assets.
+    py::class_<core::GaussianAsset, std::shared_ptr<core::GaussianAsset>>(core, "GaussianAsset")
+        .def(py::init([](const core::GaussianCloud& cloud, std::size_t cluster_size) {
+            return std::make_shared<core::GaussianAsset>(cloud, cluster_size);
+        }), py::arg("cloud"), py::arg("cluster_size") = core::GaussianAsset::default_cluster_size)
+        .def("get_gaussians", &core::GaussianAsset::get_gaussians, py::return_value_policy::reference_internal)
+        .def("get_clusters", [](const core::GaussianAsset& asset) {
+            return std::vector<core::GaussianCluster>(asset.get_clusters().begin(), asset.get_clusters().end());
+        })
+        .def("get_center", &core::GaussianAsset::get_center)
+        .def("get_radius", &core::GaussianAsset::get_radius);
+
+    py::class_<core::GaussianInstance, core::Entity, std::shared_ptr<core::GaussianInstance>>(core, "GaussianInstance")
+        .def(py::init([](const std::string& name, std::shared_ptr<core::GaussianAsset> asset) {
+            return std::make_shared<core::GaussianInstance>(name, std::move(asset));
+        }), py::arg("name") = "", py::arg("asset") = nullptr)
+        .def("get_asset", [](const core::GaussianInstance& instance) {
+            return std::const_pointer_cast<core::GaussianAsset>(instance.get_asset());
+        })
+        .def("set_asset", [](core::GaussianInstance& instance, std::shared_ptr<core::GaussianAsset> asset) {
+            instance.set_asset(std::move(asset));
+        })
+        .def("is_visible", &core::GaussianInstance::is_visible)
+        .def("set_visible", &core::GaussianInstance::set_visible);
+
+    py::class_<core::GaussianReloadStats>(core, "GaussianReloadStats")
+        .def_readonly("chunks", &core::GaussianReloadStats::chunks)
+        .def_readonly("changed_chunks", &core::GaussianReloadStats::changed_chunks)
+        .def_readonly("full_load", &core::GaussianReloadStats::full_load)
+        .def_readonly("positions_changed", &core::GaussianReloadStats::positions_changed)
+        .def_readonly("shapes_changed", &core::GaussianReloadStats::shapes_changed)
+        .def_readonly("appearance_changed", &core::GaussianReloadStats::appearance_changed);
+
     py::class_<core::Scene, std::shared_ptr<core::Scene>>(core, "Scene")
         .def(py::init<const std::string&>())
         .def("get_name", &core::Scene::get_name)
@@ -121,20 +750,58 @@ PYBIND11_MODULE(pybuildify, m) {
         .def("find_entity", &core::Scene::find_entity)
         .def("set_active_camera", &core::Scene::set_active_camera)
         .def("get_active_camera", &core::Scene::get_active_camera)
+        .def("get_gaussians", static_cast<core::GaussianCloud&(core::Scene::*)()>(&core::Scene::get_gaussians), py::return_value_policy::reference_internal)
+        .def("get_gaussian_bvh", &core::Scene::get_gaussian_bvh, py::return_value_policy::reference_internal)
+        .def("refit_gaussian_bvh", &core::Scene::refit_gaussian_bvh, py::return_value_policy::reference_internal)
+        .def("set_gaussian_animation", &core::Scene::set_gaussian_animation)
+        .def("get_gaussian_animation", &core::Scene::get_gaussian_animation)
         .def("update", &core::Scene::update)
         .def("load_from_file", &core::Scene::load_from_file)
         .def("save_to_file", &core::Scene::save_to_file)
+        .def("get_source_path", &core::Scene::get_source_path)
+        // None when the reload fails.
+        .def("reload_from_file", [](core::Scene& scene) -> std::optional<core::GaussianReloadStats> {
+            core::GaussianReloadStats stats;
+            py::gil_scoped_release release;
+            if (!scene.reload_from_file(stats)) {
+                return std::nullopt;
+            }
+            return stats;
+        })
 #ifdef WITH_BLENDER
         .def("import_from_blender", &core::Scene::import_from_blender)
         .def("export_to_blender", &core::Scene::export_to_blender)
 #endif
         ;
 
+    py::enum_<core::ShadingRate>(core, "ShadingRate")
+        .value("Full", core::ShadingRate::Full)
+        .value("Half", core::ShadingRate::Half)
+        .value("Quarter", core::ShadingRate::Quarter);
+
+    py::enum_<core::AuxChannel>(core, "AuxChannel", py::arithmetic())
+        .value("None", core::AuxChannel::None)
+        .value("Alpha", core::AuxChannel::Alpha)
+        .value("MedianDepth", core::AuxChannel::MedianDepth)
+        .value("Normal", core::AuxChannel::Normal);
+
+    py::class_<core::VariableRateShading>(core, "VariableRateShading")
+        .def(py::init<>())
+        .def_readwrite("enabled", &core::VariableRateShading::enabled)
+        .def_readwrite("tile_rates", &core::VariableRateShading::tile_rates)
+        .def_readwrite("fovea_x", &core::VariableRateShading::fovea_x)
+        .def_readwrite("fovea_y", &core::VariableRateShading::fovea_y)
+        .def_readwrite("inner_radius", &core::VariableRateShading::inner_radius)
+        .def_readwrite("outer_radius", &core::VariableRateShading::outer_radius)
+        .def_readwrite("reduced_sh_degree", &core::VariableRateShading::reduced_sh_degree)
+        .def_readwrite("reduced_min_alpha", &core::VariableRateShading::reduced_min_alpha);
+
     py::class_<core::RenderTarget>(core, "RenderTarget")
         .def(py::init<>())
         .def_readwrite("width", &core::RenderTarget::width)
         .def_readwrite("height", &core::RenderTarget::height)
-        .def_readwrite("samples", &core::RenderTarget::samples);
+        .def_readwrite("samples", &core::RenderTarget::samples)
+        .def_readwrite("variable_rate", &core::RenderTarget::variable_rate);
 
     py::class_<core::Renderer>(core, "Renderer");
 
@@ -148,9 +815,467 @@ PYBIND11_MODULE(pybuildify, m) {
         .def("set_viewport", &core::OpenGLRenderer::set_viewport)
         .def("clear", &core::OpenGLRenderer::clear, py::arg("color") = std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f});
 
+    py::enum_<core::TileSortMode>(core, "TileSortMode")
+        .value("Auto", core::TileSortMode::Auto)
+        .value("Comparison", core::TileSortMode::Comparison)
+        .value("Radix", core::TileSortMode::Radix);
+
+    py::class_<core::TemporalCacheSettings>(core, "TemporalCacheSettings")
+        .def(py::init<>())
+        .def_readwrite("enabled", &core::TemporalCacheSettings::enabled)
+        .def_readwrite("max_pixel_motion", &core::TemporalCacheSettings::max_pixel_motion)
+        .def_readwrite("max_splat_change", &core::TemporalCacheSettings::max_splat_change)
+        .def_readwrite("max_reuse_frames", &core::TemporalCacheSettings::max_reuse_frames);
+
+    py::class_<core::AntiAliasingSettings>(core, "AntiAliasingSettings")
+        .def(py::init<>())
+        .def_readwrite("filter_3d", &core::AntiAliasingSettings::filter_3d)
+        .def_readwrite("mip_filter_2d", &core::AntiAliasingSettings::mip_filter_2d)
+        .def_readwrite("filter_2d_variance", &core::AntiAliasingSettings::filter_2d_variance);
+
+    py::class_<core::TileFrameStats>(core, "TileFrameStats")
+        .def_readonly("visible_splats", &core::TileFrameStats::visible_splats)
+        .def_readonly("instances_visible", &core::TileFrameStats::instances_visible)
+        .def_readonly("instances_culled", &core::TileFrameStats::instances_culled)
+        .def_readonly("tile_count", &core::TileFrameStats::tile_count)
+        .def_readonly("tiles_rendered", &core::TileFrameStats::tiles_rendered)
+        .def_readonly("tiles_reused", &core::TileFrameStats::tiles_reused)
+        .def_readonly("tiles_reduced_rate", &core::TileFrameStats::tiles_reduced_rate)
+        .def_readonly("pixels_shaded", &core::TileFrameStats::pixels_shaded)
+        .def_readonly("frame_ms", &core::TileFrameStats::frame_ms);
+
+    py::class_<core::TileRenderer, core::Renderer>(core, "TileRenderer")
+        .def(py::init<>())
+        .def("initialize", &core::TileRenderer::initialize)
+        .def("shutdown", &core::TileRenderer::shutdown)
+        .def("render_scene", &core::TileRenderer::render_scene)
+        .def("render_scene_progressive", [](core::TileRenderer& renderer, const core::Scene& scene, double milliseconds) {
+            return renderer.render_scene_progressive(scene, std::chrono::microseconds(static_cast<std::int64_t>(milliseconds * 1000.0)));
+        }, py::arg("scene"), py::arg("budget_ms"))
+        .def("set_viewport", &core::TileRenderer::set_viewport)
+        .def("clear", &core::TileRenderer::clear, py::arg("color") = std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f})
+        .def("set_temporal_cache", &core::TileRenderer::set_temporal_cache)
+        .def("get_temporal_cache", &core::TileRenderer::get_temporal_cache)
+        .def("invalidate_temporal_cache", &core::TileRenderer::invalidate_temporal_cache)
+        .def("set_variable_rate", &core::TileRenderer::set_variable_rate)
+        .def("get_frame_stats", &core::TileRenderer::get_frame_stats)
+        .def("set_anti_aliasing", &core::TileRenderer::set_anti_aliasing)
+        .def("get_anti_aliasing", &core::TileRenderer::get_anti_aliasing)
+        .def("set_sort_mode", &core::TileRenderer::set_sort_mode)
+        .def("get_sort_mode", &core::TileRenderer::get_sort_mode)
+        .def("set_memory_placement", &core::TileRenderer::set_memory_placement)
+        .def("get_memory_placement", &core::TileRenderer::get_memory_placement)
+        .def("set_aux_channels", [](core::TileRenderer& renderer, std::uint32_t channels) {
+            renderer.set_aux_channels(static_cast<core::AuxChannel>(channels));
+        }, py::arg("channels"))
+        .def("get_aux_channels", [](const core::TileRenderer& renderer) {
+            return static_cast<std::uint32_t>(renderer.get_aux_channels());
+        })
+        .def("get_color_buffer", [](const core::TileRenderer& renderer) {
+            const auto& target = renderer.get_target();
+            return py::array_t<float>({static_cast<py::ssize_t>(target.height), static_cast<py::ssize_t>(target.width), py::ssize_t{4}},
+                                      renderer.get_color_buffer().data());
+        })
+        .def("get_depth_buffer", [](const core::TileRenderer& renderer) {
+            const auto& target = renderer.get_target();
+            return py::array_t<float>({static_cast<py::ssize_t>(target.height), static_cast<py::ssize_t>(target.width)},
+                                      renderer.get_depth_buffer().data());
+        })
+        .def("get_alpha_buffer", [](const core::TileRenderer& renderer) {
+            const auto& target = renderer.get_target();
+            auto alpha = renderer.get_alpha_buffer();
+            if (alpha.empty()) {
+                return py::array_t<float>();
+            }
+            return py::array_t<float>({static_cast<py::ssize_t>(target.height), static_cast<py::ssize_t>(target.width)},
+                                      alpha.data());
+        })
+        .def("get_median_depth_buffer", [](const core::TileRenderer& renderer) {
+            const auto& target = renderer.get_target();
+            auto median = renderer.get_median_depth_buffer();
+            if (median.empty()) {
+                return py::array_t<float>();
+            }
+            return py::array_t<float>({static_cast<py::ssize_t>(target.height), static_cast<py::ssize_t>(target.width)},
+                                      median.data());
+        })
+        .def("get_normal_buffer", [](const core::TileRenderer& renderer) {
+            const auto& target = renderer.get_target();
+            auto normal = renderer.get_normal_buffer();
+            if (normal.empty()) {
+                return py::array_t<float>();
+            }
+            return py::array_t<float>({static_cast<py::ssize_t>(target.height), static_cast<py::ssize_t>(target.width), py::ssize_t{3}},
+                                      normal.data());
+        })
+        .def("render_views", [](core::TileRenderer& renderer, const core::Scene& scene,
+                                const std::vector<std::shared_ptr<core::Camera>>& cameras) {
+            std::vector<core::Camera> views;
+            views.reserve(cameras.size());
+            for (const auto& camera : cameras) {
+                views.push_back(*camera);
+            }
+            const auto& target = renderer.get_target();
+            py::array_t<float> color({static_cast<py::ssize_t>(views.size()), static_cast<py::ssize_t>(target.height),
+                                      static_cast<py::ssize_t>(target.width), py::ssize_t{4}});
+            {
+                py::gil_scoped_release release;
+                renderer.render_views(scene, views, {color.mutable_data(), static_cast<std::size_t>(color.size())});
+            }
+            return color;
+        }, py::arg("scene"), py::arg("cameras"))
+        .def("render_views_into", [](core::TileRenderer& renderer, const core::Scene& scene,
+                                     const std::vector<std::shared_ptr<core::Camera>>& cameras,
+                                     py::array_t<float, py::array::c_style> color) {
+            std::vector<core::Camera> views;
+            views.reserve(cameras.size());
+            for (const auto& camera : cameras) {
+                views.push_back(*camera);
+            }
+            py::gil_scoped_release release;
+            renderer.render_views(scene, views, {color.mutable_data(), static_cast<std::size_t>(color.size())});
+        }, py::arg("scene"), py::arg("cameras"), py::arg("color"))
+        .def("render_trajectory", [](core::TileRenderer& renderer, const core::Scene& scene,
+                                     const core::CameraTrajectory& trajectory, const core::Camera& prototype,
+                                     const std::vector<double>& times) {
+            const auto& target = renderer.get_target();
+            py::array_t<float> color({static_cast<py::ssize_t>(times.size()), static_cast<py::ssize_t>(target.height),
+                                      static_cast<py::ssize_t>(target.width), py::ssize_t{4}});
+            {
+                py::gil_scoped_release release;
+                auto views = trajectory.sample_cameras(prototype, times);
+                renderer.render_views(scene, views, {color.mutable_data(), static_cast<std::size_t>(color.size())});
+            }
+            return color;
+        }, py::arg("scene"), py::arg("trajectory"), py::arg("prototype"), py::arg("times"));
+
+    py::class_<core::RenderServerSettings>(core, "RenderServerSettings")
+        .def(py::init<>())
+        .def_readwrite("socket_path", &core::RenderServerSettings::socket_path)
+        .def_readwrite("max_batch_views", &core::RenderServerSettings::max_batch_views)
+        .def_property("batch_window_ms",
+            [](const core::RenderServerSettings& settings) { return settings.batch_window.count() / 1000.0; },
+            [](core::RenderServerSettings& settings, double milliseconds) {
+                settings.batch_window = std::chrono::microseconds(static_cast<std::int64_t>(milliseconds * 1000.0));
+            })
+        .def_readwrite("max_frame_pixels", &core::RenderServerSettings::max_frame_pixels)
+        .def_readwrite("max_slots", &core::RenderServerSettings::max_slots)
+        .def_readwrite("max_cached_renderers", &core::RenderServerSettings::max_cached_renderers);
+
+    py::class_<core::RenderServerStats>(core, "RenderServerStats")
+        .def_readonly("connections", &core::RenderServerStats::connections)
+        .def_readonly("requests", &core::RenderServerStats::requests)
+        .def_readonly("batches", &core::RenderServerStats::batches)
+        .def_readonly("largest_batch", &core::RenderServerStats::largest_batch)
+        .def_readonly("rejected", &core::RenderServerStats::rejected)
+        .def_readonly("cached_renderers", &core::RenderServerStats::cached_renderers);
+
+    py::class_<core::RenderServer>(core, "RenderServer")
+        .def(py::init<>())
+        .def("add_scene", [](core::RenderServer& server, const std::string& name, std::shared_ptr<core::Scene> scene) {
+            server.add_scene(name, std::move(scene));
+        })
+        .def("remove_scene", &core::RenderServer::remove_scene)
+        .def("start", &core::RenderServer::start, py::arg("settings") = core::RenderServerSettings{})
+        .def("stop", &core::RenderServer::stop, py::call_guard<py::gil_scoped_release>())
+        .def("is_running", &core::RenderServer::is_running)
+        .def("get_stats", &core::RenderServer::get_stats);
+
+    py::class_<core::RenderClient>(core, "RenderClient")
+        .def(py::init<>())
+        .def("connect", &core::RenderClient::connect,
+             py::arg("socket_path"), py::arg("max_width"), py::arg("max_height"), py::arg("slots") = 2)
+        .def("close", &core::RenderClient::close)
+        .def("is_connected", &core::RenderClient::is_connected)
+        // Copies the frame out of the shared slot, which the server reuses.
+        .def("render", [](core::RenderClient& client, const std::string& scene, const core::Camera& camera,
+                          std::uint32_t width, std::uint32_t height) -> py::object {
+            std::span<const float> frame;
+            {
+                py::gil_scoped_release release;
+                frame = client.render(scene, camera, width, height);
+            }
+            if (frame.empty()) {
+                return py::none();
+            }
+            py::array_t<float> image({static_cast<py::ssize_t>(height), static_cast<py::ssize_t>(width), py::ssize_t{4}});
+            std::copy(frame.begin(), frame.end(), image.mutable_data());
+            return image;
+        })
+        .def("get_last_batch_size", &core::RenderClient::get_last_batch_size);
+
+    auto vectors_to_array = [](const std::vector<utils::Vector3f>& values) {
+        py::array_t<float> array({static_cast<py::ssize_t>(values.size()), py::ssize_t{3}});
+        auto out = array.mutable_unchecked<2>();
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            out(i, 0) = values[i].x;
+            out(i, 1) = values[i].y;
+            out(i, 2) = values[i].z;
+        }
+        return array;
+    };
+
+    py::class_<core::TriangleMesh>(core, "TriangleMesh")
+        .def(py::init<>())
+        .def_property_readonly("vertices", [vectors_to_array](const core::TriangleMesh& mesh) {
+            return vectors_to_array(mesh.vertices);
+        })
+        .def_property_readonly("normals", [vectors_to_array](const core::TriangleMesh& mesh) {
+            return vectors_to_array(mesh.normals);
+        })
+        .def_property_readonly("colors", [vectors_to_array](const core::TriangleMesh& mesh) {
+            return vectors_to_array(mesh.colors);
+        })
+        .def_property_readonly("triangles", [](const core::TriangleMesh& mesh) {
+            return py::array_t<std::uint32_t>({static_cast<py::ssize_t>(mesh.triangle_count()), py::ssize_t{3}},
+                                              mesh.indices.data());
+        })
+        .def("vertex_count", &core::TriangleMesh::vertex_count)
+        .def("triangle_count", &core::TriangleMesh::triangle_count)
+        .def("empty", &core::TriangleMesh::empty)
+        .def("save_ply", &core::TriangleMesh::save_ply)
+        .def("save_obj", &core::TriangleMesh::save_obj)
+        .def("save", &core::TriangleMesh::save);
+
+    py::class_<core::TsdfSettings>(core, "TsdfSettings")
+        .def(py::init<>())
+        .def_readwrite("voxel_size", &core::TsdfSettings::voxel_size)
+        .def_readwrite("truncation", &core::TsdfSettings::truncation)
+        .def_readwrite("max_depth", &core::TsdfSettings::max_depth)
+        .def_readwrite("min_alpha", &core::TsdfSettings::min_alpha)
+        .def_readwrite("min_weight", &core::TsdfSettings::min_weight);
+
+    py::class_<core::TsdfVolume>(core, "TsdfVolume")
+        .def(py::init<const core::TsdfSettings&>(), py::arg("settings") = core::TsdfSettings{})
+        .def("integrate", [](core::TsdfVolume& volume, const core::Camera& camera,
+                             py::array_t<float, py::array::c_style | py::array::forcecast> depth,
+                             std::optional<py::array_t<float, py::array::c_style | py::array::forcecast>> color,
+                             std::optional<py::array_t<float, py::array::c_style | py::array::forcecast>> alpha) {
+            if (depth.ndim() != 2) {
+                throw std::invalid_argument("depth must have shape (height, width)");
+            }
+            const auto height = static_cast<std::uint32_t>(depth.shape(0));
+            const auto width = static_cast<std::uint32_t>(depth.shape(1));
+            auto as_span = [](const auto& array) {
+                return array ? std::span<const float>(array->data(), static_cast<std::size_t>(array->size()))
+                             : std::span<const float>();
+            };
+            py::gil_scoped_release release;
+            volume.integrate(camera, width, height, {depth.data(), static_cast<std::size_t>(depth.size())},
+                             as_span(color), as_span(alpha));
+        }, py::arg("camera"), py::arg("depth"), py::arg("color") = py::none(), py::arg("alpha") = py::none())
+        .def("extract_mesh", &core::TsdfVolume::extract_mesh, py::call_guard<py::gil_scoped_release>())
+        .def("block_count", &core::TsdfVolume::block_count)
+        .def("memory_footprint", &core::TsdfVolume::memory_footprint)
+        .def("clear", &core::TsdfVolume::clear);
+
+    core.def("extract_gaussian_mesh", [](const core::Scene& scene,
+                                         const std::vector<std::shared_ptr<core::Camera>>& cameras,
+                                         std::uint32_t width, std::uint32_t height,
+                                         const core::TsdfSettings& settings) {
+        std::vector<core::Camera> views;
+        views.reserve(cameras.size());
+        for (const auto& camera : cameras) {
+            views.push_back(*camera);
+        }
+        py::gil_scoped_release release;
+        return core::extract_gaussian_mesh(scene, views, width, height, settings);
+    }, py::arg("scene"), py::arg("cameras"), py::arg("width"), py::arg("height"),
+       py::arg("settings") = core::TsdfSettings{});
+
+    // Awaitable loaders and savers; the blocking work stays off the event
+    // loop and the GIL.
+    core.def("load_gaussians_async", [](const std::string& path, py::object progress) {
+        utils::CancellationSource cancel;
+        return as_future(core::load_gaussians_async(path, cancel.token(), progress_on_loop(progress)), cancel,
+                         [](std::shared_ptr<core::GaussianCloud> cloud) -> py::object {
+            return cloud ? py::cast(std::move(*cloud)) : py::none();
+        });
+    }, py::arg("path"), py::arg("progress") = py::none());
+    core.def("save_gaussians_async", [](const std::string& path, const core::GaussianCloud& cloud,
+                                        py::object progress) {
+        utils::CancellationSource cancel;
+        auto snapshot = std::make_shared<const core::GaussianCloud>(cloud);
+        return as_future(core::save_gaussians_async(path, std::move(snapshot), cancel.token(),
+                                                    progress_on_loop(progress)),
+                         cancel, [](bool saved) -> py::object { return py::bool_(saved); });
+    }, py::arg("path"), py::arg("cloud"), py::arg("progress") = py::none());
+    core.def("load_scene_async", [](const std::string& name, const std::string& path, py::object progress) {
+        utils::CancellationSource cancel;
+        return as_future(core::load_scene_async(name, path, cancel.token(), progress_on_loop(progress)), cancel,
+                         [](std::shared_ptr<core::Scene> scene) -> py::object { return py::cast(std::move(scene)); });
+    }, py::arg("name"), py::arg("path"), py::arg("progress") = py::none());
+    core.def("save_scene_async", [](const std::string& path, std::shared_ptr<core::Scene> scene,
+                                    py::object progress) {
+        utils::CancellationSource cancel;
+        return as_future(core::save_scene_async(path, std::move(scene), cancel.token(), progress_on_loop(progress)),
+                         cancel, [](bool saved) -> py::object { return py::bool_(saved); });
+    }, py::arg("path"), py::arg("scene"), py::arg("progress") = py::none());
+    core.def("save_mesh_async", [](const std::string& path, const core::TriangleMesh& mesh) {
+        utils::CancellationSource cancel;
+        auto snapshot = std::make_shared<const core::TriangleMesh>(mesh);
+        return as_future(core::save_mesh_async(path, std::move(snapshot), cancel.token()), cancel,
+                         [](bool saved) -> py::object { return py::bool_(saved); });
+    }, py::arg("path"), py::arg("mesh"));
+
+    auto array_to_vectors = [](const py::array_t<float, py::array::c_style | py::array::forcecast>& array,
+                               const char* name) {
+        if (array.ndim() != 2 || array.shape(1) != 3) {
+            throw std::invalid_argument(std::format("{} must have shape (N, 3)", name));
+        }
+        std::vector<utils::Vector3f> values(static_cast<std::size_t>(array.shape(0)));
+        auto in = array.unchecked<2>();
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            values[i] = {in(i, 0), in(i, 1), in(i, 2)};
+        }
+        return values;
+    };
+
+    py::class_<core::KdTree>(core, "KdTree")
+        .def(py::init<>())
+        .def("build", [array_to_vectors](core::KdTree& tree,
+                                         py::array_t<float, py::array::c_style | py::array::forcecast> points) {
+            auto values = array_to_vectors(points, "points");
+            py::gil_scoped_release release;
+            tree.build(values);
+        }, py::arg("points"))
+        .def("size", &core::KdTree::size)
+        .def("empty", &core::KdTree::empty)
+        .def("query", [array_to_vectors](const core::KdTree& tree,
+                                         py::array_t<float, py::array::c_style | py::array::forcecast> queries,
+                                         std::uint32_t k, float max_distance) {
+            auto values = array_to_vectors(queries, "queries");
+            const auto n = static_cast<py::ssize_t>(values.size());
+            py::array_t<std::int64_t> index({n, static_cast<py::ssize_t>(k)});
+            py::array_t<float> distance({n, static_cast<py::ssize_t>(k)});
+            auto index_out = index.mutable_unchecked<2>();
+            auto distance_out = distance.mutable_unchecked<2>();
+            {
+                py::gil_scoped_release release;
+                utils::ThreadPool::instance().parallel_for(0, values.size(), [&](std::size_t begin, std::size_t end) {
+                    std::vector<std::uint32_t> indices(k);
+                    std::vector<float> distances2(k);
+                    for (std::size_t q = begin; q < end; ++q) {
+                        std::uint32_t found = tree.knn(values[q], k, indices.data(), distances2.data(), max_distance);
+                        for (std::uint32_t j = 0; j < k; ++j) {
+                            index_out(q, j) = j < found ? indices[j] : -1;
+                            distance_out(q, j) = j < found ? std::sqrt(distances2[j])
+                                                           : std::numeric_limits<float>::infinity();
+                        }
+                    }
+                }, 1024);
+            }
+            return py::make_tuple(distance, index);
+        }, py::arg("queries"), py::arg("k") = 1, py::arg("max_distance") = std::numeric_limits<float>::infinity());
+
+    core.def("voxel_downsample", [](core::GaussianCloud& cloud, float voxel_size) {
+        py::gil_scoped_release release;
+        return core::voxel_downsample(cloud, voxel_size);
+    }, py::arg("cloud"), py::arg("voxel_size"));
+    core.def("voxel_downsample", [array_to_vectors, vectors_to_array](
+                 py::array_t<float, py::array::c_style | py::array::forcecast> points, float voxel_size,
+                 std::optional<py::array_t<float, py::array::c_style | py::array::forcecast>> colors) -> py::object {
+        auto point_values = array_to_vectors(points, "points");
+        std::vector<utils::Vector3f> color_values;
+        if (colors) {
+            color_values = array_to_vectors(*colors, "colors");
+        }
+        std::vector<utils::Vector3f> out_points;
+        std::vector<utils::Vector3f> out_colors;
+        {
+            py::gil_scoped_release release;
+            core::voxel_downsample(point_values, color_values, voxel_size, out_points, out_colors);
+        }
+        if (!colors) {
+            return vectors_to_array(out_points);
+        }
+        return py::make_tuple(vectors_to_array(out_points), vectors_to_array(out_colors));
+    }, py::arg("points"), py::arg("voxel_size"), py::arg("colors") = py::none());
+    core.def("statistical_inlier_mask", [array_to_vectors](
+                 py::array_t<float, py::array::c_style | py::array::forcecast> points, std::uint32_t neighbors,
+                 float std_ratio) {
+        auto values = array_to_vectors(points, "points");
+        std::vector<std::uint8_t> mask;
+        {
+            py::gil_scoped_release release;
+            mask = core::statistical_inlier_mask(values, neighbors, std_ratio);
+        }
+        py::array_t<bool> result(static_cast<py::ssize_t>(mask.size()));
+        std::copy(mask.begin(), mask.end(), result.mutable_data());
+        return result;
+    }, py::arg("points"), py::arg("neighbors") = 20, py::arg("std_ratio") = 2.0f);
+    core.def("remove_statistical_outliers", &core::remove_statistical_outliers, py::arg("cloud"),
+             py::arg("neighbors") = 20, py::arg("std_ratio") = 2.0f, py::call_guard<py::gil_scoped_release>());
+
+    py::enum_<core::RobustKernel>(core, "RobustKernel")
+        .value("None", core::RobustKernel::None)
+        .value("Huber", core::RobustKernel::Huber)
+        .value("Tukey", core::RobustKernel::Tukey)
+        .value("Cauchy", core::RobustKernel::Cauchy);
+
+    py::class_<core::IcpSettings>(core, "IcpSettings")
+        .def(py::init<>())
+        .def_readwrite("voxel_sizes", &core::IcpSettings::voxel_sizes)
+        .def_readwrite("max_iterations", &core::IcpSettings::max_iterations)
+        .def_readwrite("max_correspondence_distance", &core::IcpSettings::max_correspondence_distance)
+        .def_readwrite("kernel", &core::IcpSettings::kernel)
+        .def_readwrite("kernel_scale", &core::IcpSettings::kernel_scale)
+        .def_readwrite("normal_neighbors", &core::IcpSettings::normal_neighbors)
+        .def_readwrite("rotation_tolerance", &core::IcpSettings::rotation_tolerance)
+        .def_readwrite("translation_tolerance", &core::IcpSettings::translation_tolerance);
+
+    py::class_<core::IcpResult>(core, "IcpResult")
+        .def_property_readonly("transform", [](const core::IcpResult& result) {
+            py::array_t<float> matrix({py::ssize_t{4}, py::ssize_t{4}});
+            auto out = matrix.mutable_unchecked<2>();
+            for (py::ssize_t r = 0; r < 4; ++r) {
+                for (py::ssize_t c = 0; c < 4; ++c) {
+                    out(r, c) = result.transform.m[r][c];
+                }
+            }
+            return matrix;
+        })
+        .def_readonly("rmse", &core::IcpResult::rmse)
+        .def_readonly("fitness", &core::IcpResult::fitness)
+        .def_readonly("iterations", &core::IcpResult::iterations)
+        .def_readonly("converged", &core::IcpResult::converged);
+
+    core.def("align_point_to_plane", [array_to_vectors](
+                 py::array_t<float, py::array::c_style | py::array::forcecast> source,
+                 py::array_t<float, py::array::c_style | py::array::forcecast> target,
+                 const core::IcpSettings& settings,
+                 std::optional<py::array_t<float, py::array::c_style | py::array::forcecast>> initial) {
+        auto source_points = array_to_vectors(source, "source");
+        auto target_points = array_to_vectors(target, "target");
+        utils::Matrix4f start;
+        if (initial) {
+            if (initial->ndim() != 2 || initial->shape(0) != 4 || initial->shape(1) != 4) {
+                throw std::invalid_argument("initial must have shape (4, 4)");
+            }
+            auto in = initial->unchecked<2>();
+            for (py::ssize_t r = 0; r < 4; ++r) {
+                for (py::ssize_t c = 0; c < 4; ++c) {
+                    start.m[r][c] = in(r, c);
+                }
+            }
+        }
+        py::gil_scoped_release release;
+        return core::align_point_to_plane(source_points, target_points, settings, start);
+    }, py::arg("source"), py::arg("target"), py::arg("settings") = core::IcpSettings{},
+       py::arg("initial") = py::none());
+
 #ifdef WITH_PYTORCH
     m.def("render_to_tensor", [](core::Renderer* renderer, const core::Scene& scene) {
         return renderer->render_to_tensor(scene);
     }, "Render scene to PyTorch tensor");
+    m.def("render_to_tensor_batch", [](core::Renderer* renderer, const core::Scene& scene,
+                                       const std::vector<std::shared_ptr<core::Camera>>& cameras) {
+        std::vector<core::Camera> views;
+        views.reserve(cameras.size());
+        for (const auto& camera : cameras) {
+            views.push_back(*camera);
+        }
+        return renderer->render_to_tensor_batch(scene, views);
+    }, "Render one view per camera into a pooled [views, height, width, 4] tensor");
 #endif
 }
\ No newline at end of file
@@ -165,6 +165,128 @@ def benchmark_camera_operations(iterations=10000):
     print(f"  행렬 계산: {matrix_time:.3f}초 ({iterations/matrix_time:.0f} 행렬/초)")
     print()
 
+def create_splat_scene(engine, num_splats):
+    """무작위 Gaussian 스플랫과 카메라로 구성된 벤치마크 씬 생성"""
+    import random
+
+    random.seed(42)
+    scene = engine.create_scene("SplatBenchmarkScene")
+
+    camera = buildify.core.Camera("SplatCamera")
+    camera.set_perspective(60.0, 16.0/9.0, 0.1, 100.0)
+    scene.add_entity(camera)
+    scene.set_active_camera(camera)
+
+    gaussians = scene.get_gaussians()
+    gaussians.reserve(num_splats)
+    identity = buildify.utils.Quaternion()
+    for _ in range(num_splats):
+        position = buildify.utils.Vector3(random.uniform(-3, 3), random.uniform(-2, 2), random.uniform(-12, -6))
+        size = random.uniform(0.02, 0.08)
+        scale = buildify.utils.Vector3(size, size * 0.7, size)
+        color = buildify.utils.Vector3(random.random(), random.random(), random.random())
+        gaussians.add(position, scale, identity, random.uniform(0.3, 1.0), color)
+
+    return scene
+
+def benchmark_tile_renderer(num_splats=100000, frames=10, width=1280, height=720):
+    """타일 렌더러 성능 테스트 (전체 해상도 vs 가변 셰이딩 레이트)"""
+    print(f"🖼️  타일 렌더러 벤치마크 ({num_splats:,}개 스플랫, {width}x{height}, {frames}프레임)")
+
+    engine = buildify.core.Engine()
+    engine.initialize()
+    scene = create_splat_scene(engine, num_splats)
+
+    def run(target):
+        renderer = buildify.core.TileRenderer()
+        renderer.initialize(target)
+        renderer.render_scene(scene)  # 워밍업
+
+        frame_times = []
+        shaded = 0
+        for _ in range(frames):
+            renderer.render_scene(scene)
+            stats = renderer.get_frame_stats()
+            frame_times.append(stats.frame_ms)
+            shaded = stats.pixels_shaded
+        renderer.shutdown()
+        return statistics.mean(frame_times), shaded
+
+    full_target = buildify.core.RenderTarget()
+    full_target.width = width
+    full_target.height = height
+    full_ms, full_shaded = run(full_target)
+
+    foveated_target = buildify.core.RenderTarget()
+    foveated_target.width = width
+    foveated_target.height = height
+    rate = buildify.core.VariableRateShading()
+    rate.enabled = True
+    rate.inner_radius = 0.2
+    rate.outer_radius = 0.4
+    foveated_target.variable_rate = rate
+    foveated_ms, foveated_shaded = run(foveated_target)
+
+    engine.shutdown()
+
+    print(f"  전체 해상도: {full_ms:.2f}ms/프레임 ({full_shaded:,} 샘플)")
+    print(f"  가변 레이트: {foveated_ms:.2f}ms/프레임 ({foveated_shaded:,} 샘플)")
+    print(f"  절감률: 시간 {100 * (1 - foveated_ms / full_ms):.1f}%, 샘플 {100 * (1 - foveated_shaded / full_shaded):.1f}%")
+    print()
+
+def read_anon_huge_pages_kb():
+    """현재 프로세스가 투명 huge page로 매핑한 메모리 (kB)"""
+    try:
+        with open("/proc/self/smaps_rollup") as smaps:
+            for line in smaps:
+                if line.startswith("AnonHugePages:"):
+                    return int(line.split()[1])
+    except OSError:
+        pass
+    return None
+
+def benchmark_huge_pages(num_splats=300000, frames=10, width=1920, height=1080):
+    """Huge page 할당 유무에 따른 렌더링 시간과 TLB 미스 비교"""
+    print(f"📄 Huge page 벤치마크 ({num_splats:,}개 스플랫, {width}x{height}, {frames}프레임)")
+
+    modes = [("4KB 페이지", buildify.utils.HugePageMode.Off),
+             ("투명 huge page", buildify.utils.HugePageMode.Transparent)]
+    results = []
+    for label, mode in modes:
+        # 모드는 이후의 할당에만 적용되므로 씬과 렌더러를 새로 만든다
+        buildify.utils.set_huge_page_mode(mode)
+        engine = buildify.core.Engine()
+        engine.initialize()
+        scene = create_splat_scene(engine, num_splats)
+
+        target = buildify.core.RenderTarget()
+        target.width = width
+        target.height = height
+        renderer = buildify.core.TileRenderer()
+        renderer.initialize(target)
+        renderer.render_scene(scene)  # 워밍업
+
+        counter = buildify.utils.TlbMissCounter()
+        counting = counter.start()
+        frame_times = []
+        for _ in range(frames):
+            renderer.render_scene(scene)
+            frame_times.append(renderer.get_frame_stats().frame_ms)
+        misses = counter.stop() if counting else None
+        huge_kb = read_anon_huge_pages_kb()
+
+        renderer.shutdown()
+        engine.shutdown()
+        results.append((label, statistics.mean(frame_times), misses, huge_kb))
+
+    buildify.utils.set_huge_page_mode(buildify.utils.HugePageMode.Transparent)
+    for label, frame_ms, misses, huge_kb in results:
+        tlb = f"{misses / frames:,.0f} dTLB 미스/프레임" if misses is not None else "dTLB 카운터 없음 (perf 권한 필요)"
+        huge = f", AnonHugePages {huge_kb / 1024:.0f} MB" if huge_kb is not None else ""
+        print(f"  {label}: {frame_ms:.2f}ms/프레임, {tlb}{huge}")
+    print(f"  개선율: {100 * (1 - results[1][1] / results[0][1]):.1f}%")
+    print()
+
 def benchmark_memory_usage():
     """메모리 사용량 측정"""
     print("💾 메모리 사용량 체크")
@@ -215,6 +337,8 @@ def main():
     benchmark_transform_matrix(50000)
     benchmark_scene_management(1000)
     benchmark_camera_operations(10000)
+    benchmark_tile_renderer(100000)
+    benchmark_huge_pages(300000)
     benchmark_memory_usage()
     
     total_time = time.time() - start_time
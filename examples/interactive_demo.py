@@ -91,11 +91,13 @@ def demo_scene_management():
     
     engine.add_update_callback(update_callback)
     
-    # 시뮬레이션 실행
+    # 시뮬레이션 실행: 고정 타임스텝 업데이트, 60 FPS 페이싱
     print("🏃 시뮬레이션 시작...")
-    for i in range(5):
-        engine.update(0.016667)  # 60 FPS
-        time.sleep(0.1)
+    settings = buildify.core.RunSettings()
+    settings.max_frames = 30
+    engine.run(settings)
+    stats = engine.get_timing_stats()
+    print(f"⏱️ 프레임 {stats.frames}, 평균 {stats.average_frame_ms:.2f}ms, p99 {stats.p99_frame_ms:.2f}ms")
     
     engine.shutdown()
     print("✅ 엔진 종료됨")
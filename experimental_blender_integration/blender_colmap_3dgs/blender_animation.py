@@ -56,6 +56,30 @@ def create_camera_with_animation(poses: List[Tuple[str, np.ndarray, np.ndarray]]
     return camera
 
 
+def create_native_trajectory(poses: List[Tuple[str, np.ndarray, np.ndarray]],
+                             frame_start: int = 1,
+                             interpolation: str = "CatmullRom"):
+    """Build a buildify CameraTrajectory through the poses, keyed on frame
+    numbers, so render jobs can sample any frame range in one native call
+    (CameraTrajectory.sample_cameras / TileRenderer.render_trajectory)"""
+    import buildify
+    if buildify.core is None:
+        raise RuntimeError("buildify extension is not available")
+    if not poses:
+        raise ValueError("No camera poses provided")
+
+    times = np.arange(frame_start, frame_start + len(poses), dtype=np.float64)
+    positions = np.array([translation for _, _, translation in poses], dtype=np.float32)
+    rotations = np.empty((len(poses), 4), dtype=np.float32)
+    for i, (_, rotation_matrix, _) in enumerate(poses):
+        q = Matrix(rotation_matrix.tolist()).to_quaternion()
+        rotations[i] = (q.x, q.y, q.z, q.w)
+
+    trajectory = buildify.core.CameraTrajectory(getattr(buildify.core.TrajectoryInterpolation, interpolation))
+    trajectory.set_keyframes(times, positions, rotations)
+    return trajectory
+
+
 def create_point_cloud_mesh(points: np.ndarray,
                            colors: np.ndarray,
                            name: str = "COLMAP_PointCloud",
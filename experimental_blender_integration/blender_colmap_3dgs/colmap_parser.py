@@ -278,3 +278,24 @@ class COLMAPLoader:
             colors.append(point3d.rgb / 255.0)  # Normalize to [0, 1]
 
         return np.array(points), np.array(colors)
+
+    def get_filtered_point_cloud(self, voxel_size: float = 0.0, neighbors: int = 20,
+                                 std_ratio: float = 2.0) -> Tuple[np.ndarray, np.ndarray]:
+        """Get the point cloud with floaters removed and, if voxel_size > 0,
+        thinned to one averaged point per voxel (needs the buildify extension)"""
+        points, colors = self.get_point_cloud()
+        try:
+            import buildify
+            core = buildify.core
+        except ImportError:
+            core = None
+        if core is None or len(points) == 0:
+            return points, colors
+
+        points = np.asarray(points, dtype=np.float32)
+        colors = np.asarray(colors, dtype=np.float32)
+        mask = core.statistical_inlier_mask(points, neighbors, std_ratio)
+        points, colors = points[mask], colors[mask]
+        if voxel_size > 0.0:
+            points, colors = core.voxel_downsample(points, voxel_size, colors)
+        return points, colors
@@ -542,52 +542,38 @@ def simple_icp_alignment(source_points: np.ndarray,
                         max_iterations: int = 10,
                         tolerance: float = 0.001) -> Tuple[np.ndarray, np.ndarray]:
     """
-    Simple ICP alignment between two point clouds
+    ICP alignment of source_points onto target_points
+    
+    Uses buildify's native point-to-plane ICP over the full clouds (coarse to
+    fine, Huber-weighted). max_iterations applies per resolution level and
+    tolerance is the translation step at which a level stops.
     
     Returns:
         rotation_matrix: 3x3 rotation matrix
         translation: 3x1 translation vector
     """
-    # Subsample points for faster computation
-    max_points = 1000
-    if len(source_points) > max_points:
-        indices = np.random.choice(len(source_points), max_points, replace=False)
-        source_subset = source_points[indices]
-    else:
-        source_subset = source_points.copy()
-    
-    if len(target_points) > max_points:
-        indices = np.random.choice(len(target_points), max_points, replace=False)
-        target_subset = target_points[indices]
-    else:
-        target_subset = target_points.copy()
-    
-    # Initialize transformation
-    R = np.eye(3)
-    t = np.zeros(3)
-    
-    prev_error = float('inf')
-    
-    for iteration in range(max_iterations):
-        # Transform source points
-        transformed_source = (R @ source_subset.T).T + t
-        
-        # Find closest points (simplified - just use centroid matching)
-        source_centroid = np.mean(transformed_source, axis=0)
-        target_centroid = np.mean(target_subset, axis=0)
-        
-        # Update translation
-        t = target_centroid - source_centroid
-        
-        # Calculate current error
-        current_error = np.linalg.norm(t)
-        
-        if abs(prev_error - current_error) < tolerance:
-            break
-            
-        prev_error = current_error
-    
-    return R, t
+    try:
+        import buildify
+        core = buildify.core
+    except ImportError:
+        core = None
+
+    if core is None or not hasattr(core, "align_point_to_plane"):
+        # Without the extension, only the centroid offset is estimated.
+        print("⚠️ buildify extension not available, aligning centroids only")
+        t = np.mean(target_points, axis=0) - np.mean(source_points, axis=0)
+        return np.eye(3), t
+
+    settings = core.IcpSettings()
+    settings.max_iterations = max_iterations
+    settings.translation_tolerance = tolerance
+    result = core.align_point_to_plane(np.asarray(source_points, dtype=np.float32),
+                                       np.asarray(target_points, dtype=np.float32),
+                                       settings)
+
+    print(f"✅ ICP: {result.iterations} iterations, fitness {result.fitness:.3f}, rmse {result.rmse:.5f}")
+    transform = np.asarray(result.transform, dtype=np.float64)
+    return transform[:3, :3], transform[:3, 3]
 
 
 class GaussianSplattingIntegration:
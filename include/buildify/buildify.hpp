@@ -14,10 +14,33 @@ constexpr std::uint32_t VERSION_PATCH = 0;
 
 }
 
+#include "buildify/core/async_io.hpp"
+#include "buildify/core/camera_trajectory.hpp"
 #include "buildify/core/engine.hpp"
+#include "buildify/core/gaussian_animation.hpp"
+#include "buildify/core/gaussian_bvh.hpp"
+#include "buildify/core/gaussian_instance.hpp"
+#include "buildify/core/gaussian_io.hpp"
+#include "buildify/core/gaussians.hpp"
+#include "buildify/core/kd_tree.hpp"
+#include "buildify/core/point_filters.hpp"
+#include "buildify/core/registration.hpp"
+#include "buildify/core/render_server.hpp"
 #include "buildify/core/renderer.hpp"
 #include "buildify/core/scene.hpp"
+#include "buildify/core/scene_residency.hpp"
+#include "buildify/core/shared_gaussians.hpp"
+#include "buildify/core/tensor_pool.hpp"
+#include "buildify/core/tile_renderer.hpp"
+#include "buildify/core/triangle_mesh.hpp"
+#include "buildify/core/tsdf_volume.hpp"
+#include "buildify/utils/config.hpp"
+#include "buildify/utils/file_watcher.hpp"
+#include "buildify/utils/huge_pages.hpp"
 #include "buildify/utils/math.hpp"
 #include "buildify/utils/logger.hpp"
+#include "buildify/utils/numa.hpp"
+#include "buildify/utils/task.hpp"
+#include "buildify/utils/thread_pool.hpp"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef BUILDIFY_CORE_ASYNC_IO_HPP
+#define BUILDIFY_CORE_ASYNC_IO_HPP
+
+#include <memory>
+#include <string>
+
+#include "buildify/utils/task.hpp"
+
+namespace buildify::core {
+
+class GaussianCloud;
+class Scene;
+struct TriangleMesh;
+
+// Coroutine versions of the blocking loaders and savers. File access runs
+// on ThreadPool::io_instance() and CPU-bound preparation on the worker
+// pool, so several operations started together (e.g. with when_all) overlap.
+// A cancelled or failed operation returns null or false and logs nothing
+// for cancellation.
+
+utils::Task<std::shared_ptr<GaussianCloud>> load_gaussians_async(std::string path,
+                                                                 utils::CancellationToken cancel = {},
+                                                                 utils::ProgressCallback progress = {});
+// The cloud must not change until the task completes.
+utils::Task<bool> save_gaussians_async(std::string path, std::shared_ptr<const GaussianCloud> cloud,
+                                       utils::CancellationToken cancel = {},
+                                       utils::ProgressCallback progress = {});
+
+// Reads a scene saved with Scene::save_to_file and builds its ray-query
+// BVH on the workers, so the scene is ready to pick against on arrival.
+utils::Task<std::shared_ptr<Scene>> load_scene_async(std::string name, std::string path,
+                                                     utils::CancellationToken cancel = {},
+                                                     utils::ProgressCallback progress = {});
+utils::Task<bool> save_scene_async(std::string path, std::shared_ptr<const Scene> scene,
+                                   utils::CancellationToken cancel = {},
+                                   utils::ProgressCallback progress = {});
+
+utils::Task<bool> save_mesh_async(std::string path, std::shared_ptr<const TriangleMesh> mesh,
+                                  utils::CancellationToken cancel = {});
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef BUILDIFY_CORE_CAMERA_TRAJECTORY_HPP
+#define BUILDIFY_CORE_CAMERA_TRAJECTORY_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "buildify/utils/math.hpp"
+
+namespace buildify::core {
+
+class Camera;
+
+// Linear interpolates positions and slerps rotations. CatmullRom and
+// CubicSpline (natural, C2) shape positions with cubic curves and
+// rotations with SQUAD, so the path turns without kinks at keyframes.
+enum class TrajectoryInterpolation {
+    Linear,
+    CatmullRom,
+    CubicSpline
+};
+
+struct CameraKeyframe {
+    double time = 0.0;
+    utils::Vector3f position;
+    utils::Quaternionf rotation;
+};
+
+// Camera path through timed poses. Keyframes are kept sorted by time and
+// per-segment curve coefficients are rebuilt on every edit, so evaluation
+// only locates the segment and evaluates a cubic.
+class CameraTrajectory {
+public:
+    explicit CameraTrajectory(TrajectoryInterpolation interpolation = TrajectoryInterpolation::CatmullRom);
+
+    // A keyframe at an existing time replaces it.
+    void add_keyframe(double time, const utils::Vector3f& position, const utils::Quaternionf& rotation);
+    void add_keyframe(double time, const Camera& camera);
+    void set_keyframes(std::vector<CameraKeyframe> keyframes);
+    void clear();
+
+    std::span<const CameraKeyframe> get_keyframes() const { return keyframes_; }
+    std::size_t size() const { return keyframes_.size(); }
+    bool empty() const { return keyframes_.empty(); }
+    double get_start_time() const;
+    double get_end_time() const;
+    double get_duration() const { return get_end_time() - get_start_time(); }
+
+    void set_interpolation(TrajectoryInterpolation interpolation);
+    TrajectoryInterpolation get_interpolation() const { return interpolation_; }
+    // Times outside the keyframes wrap around when looping and clamp
+    // otherwise.
+    void set_looping(bool looping) { looping_ = looping; }
+    bool is_looping() const { return looping_; }
+
+    utils::Transform evaluate(double time) const;
+    // Evaluates every time in parallel; sorted times are located by a
+    // forward scan instead of a search.
+    void evaluate(std::span<const double> times, std::span<utils::Vector3f> positions,
+                  std::span<utils::Quaternionf> rotations) const;
+
+    // Copies of `prototype` (name and projection) moved to the pose at each
+    // time, ready for TileRenderer::render_views.
+    std::vector<Camera> sample_cameras(const Camera& prototype, std::span<const double> times) const;
+
+private:
+    // Position on [t0, t0 + duration] is a + u (b + u (c + u d)) with
+    // u = (t - t0) / duration; rotation is slerp(q0, q1, u), or SQUAD with
+    // inner controls s0 and s1.
+    struct Segment {
+        double start;
+        double inverse_duration;
+        utils::Vector3f a, b, c, d;
+        utils::Quaternionf q0, q1, s0, s1;
+    };
+
+    void rebuild();
+    double wrap(double time) const;
+    std::size_t find_segment(double time, std::size_t hint) const;
+    void evaluate_segment(const Segment& segment, double time, utils::Vector3f& position,
+                          utils::Quaternionf& rotation) const;
+
+    TrajectoryInterpolation interpolation_;
+    bool looping_ = false;
+    std::vector<CameraKeyframe> keyframes_;
+    std::vector<Segment> segments_;
+};
+
+}
+
+#endif
\ No newline at end of file
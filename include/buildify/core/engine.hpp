@@ -1,17 +1,100 @@
 #ifndef BUILDIFY_CORE_ENGINE_HPP
 #define BUILDIFY_CORE_ENGINE_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <chrono>
 #include <vector>
 #include <functional>
 #include <concepts>
 
+#include "buildify/core/scene_residency.hpp"
+#include "buildify/core/tile_renderer.hpp"
+#include "buildify/utils/config.hpp"
+#include "buildify/utils/huge_pages.hpp"
+#include "buildify/utils/logger.hpp"
+#include "buildify/utils/numa.hpp"
+
 namespace buildify::core {
 
 class Scene;
 class Renderer;
 
+// Deployment tuning read by Engine::initialize() from a JSON file and then
+// from BUILDIFY_* environment variables (see utils::Config). Keys:
+//   threads.count, threads.pin     worker threads (0 = every CPU), pinning;
+//                                  only applied before the pool runs any work
+//   memory.placement               default, interleave, partitioned (NUMA
+//                                  placement of scene Gaussian columns and
+//                                  TileRenderer frame buffers)
+//   memory.huge_pages              off, transparent, explicit (see HugePageMode)
+//   memory.scene_budget_mb         Gaussian memory of all resident scenes, 0 = unlimited
+//   memory.spill_directory         where evicted scenes are written (see SceneResidency)
+//   scene.hot_reload               reapply scene files rewritten on disk once
+//                                  per frame (see Scene::reload_from_file);
+//                                  off by default, as it modifies scenes in
+//                                  place: only enable it when no other
+//                                  thread renders them, e.g. a RenderServer
+//   log.level                      trace, debug, info, warning, error, critical
+//   render.sort_mode               auto, comparison, radix
+//   render.frame_budget_us         progressive frame budget, 0 renders whole frames
+//   render.temporal_cache.*        enabled, max_pixel_motion, max_splat_change,
+//                                  max_reuse_frames
+struct EngineConfig {
+    std::size_t worker_threads = 0;
+    bool pin_threads = false;
+    utils::MemoryPlacement memory_placement = utils::MemoryPlacement::Default;
+    utils::HugePageMode huge_pages = utils::HugePageMode::Transparent;
+    std::size_t scene_memory_budget = 0;
+    std::string spill_directory;
+    bool hot_reload_scenes = false;
+    utils::LogLevel log_level = utils::LogLevel::Info;
+    TileSortMode sort_mode = TileSortMode::Auto;
+    std::chrono::microseconds frame_budget{0};
+    TemporalCacheSettings temporal_cache;
+
+    // Known keys override the defaults; unknown keys and malformed values
+    // are logged and skipped.
+    static EngineConfig from_config(const utils::Config& config);
+    utils::Config to_config() const;
+};
+
+// Engine::run() advances the simulation in fixed steps and renders once
+// per loop iteration. Rendering is paced to target_frame_rate (0 renders
+// as fast as possible): the loop sleeps until spin_threshold before the
+// deadline and spins the rest, since sleeps overshoot by the scheduler
+// tick. After a stall at most max_catch_up_steps updates run in one frame
+// and the remaining backlog is dropped, so the loop does not spiral.
+struct RunSettings {
+    std::chrono::microseconds fixed_timestep{16'667};
+    double target_frame_rate = 60.0;
+    std::uint32_t max_catch_up_steps = 5;
+    std::chrono::microseconds spin_threshold{1'000};
+    // Stops after this many frames; 0 runs until stop().
+    std::uint64_t max_frames = 0;
+};
+
+// Frame times cover the whole loop iteration including pacing; the
+// average and percentile are over the last frame_window frames.
+struct FrameTimingStats {
+    static constexpr std::size_t frame_window = 240;
+
+    std::uint64_t frames = 0;
+    std::uint64_t updates = 0;
+    std::uint64_t dropped_updates = 0;
+    double last_frame_ms = 0.0;
+    double average_frame_ms = 0.0;
+    double p99_frame_ms = 0.0;
+    double max_frame_ms = 0.0;
+    double update_ms = 0.0;
+    double render_ms = 0.0;
+    // Mean distance between the pacing deadline and the actual wake-up.
+    double pacing_error_ms = 0.0;
+    double frames_per_second = 0.0;
+};
+
 class Engine {
 public:
     Engine();
@@ -22,15 +105,51 @@ public:
     Engine(Engine&&) noexcept;
     Engine& operator=(Engine&&) noexcept;
 
+    // Loads config_path (when given), applies environment overrides and
+    // the resulting settings, and logs the effective configuration. Fails
+    // only when the file cannot be read or parsed.
     bool initialize(const std::string& config_path = "");
+    bool initialize(const EngineConfig& config);
     void shutdown();
 
+    // Applies settings immediately; renderer settings also reach renderers
+    // set later. threads.* cannot change once ThreadPool::instance() has
+    // run work, as other subsystems may be submitting to it; the current
+    // pool is then kept with a warning.
+    void apply_config(const EngineConfig& config);
+    const EngineConfig& get_config() const;
+    // Effective configuration as JSON, in the format initialize() reads.
+    std::string dump_config() const;
+
     void update(double delta_time);
     void render();
 
+    // Blocks in the fixed-timestep loop until stop() (from a callback or
+    // another thread) or max_frames. Returns false if not initialized.
+    bool run(const RunSettings& settings = {});
+    // Safe to call from any thread, also while run() is going; the
+    // figures are updated every frame.
+    FrameTimingStats get_timing_stats() const;
+    // Fraction of a fixed step left in the accumulator when the current
+    // frame was rendered, for interpolating between simulation states.
+    double get_interpolation_alpha() const;
+
+    // A non-zero budget switches render() to progressive refinement: each
+    // call stays within the budget and improves the image while the camera
+    // is still.
+    void set_frame_budget(std::chrono::microseconds budget);
+    std::chrono::microseconds get_frame_budget() const;
+    bool is_frame_converged() const;
+
     std::shared_ptr<Scene> create_scene(const std::string& name);
+    // Reloads the scene first if it was evicted to stay within
+    // memory.scene_budget_mb.
     std::shared_ptr<Scene> get_scene(const std::string& name) const;
     void set_active_scene(std::shared_ptr<Scene> scene);
+    // Starts reloading an evicted scene in the background, ahead of a
+    // get_scene() or switch to it.
+    void prefetch_scene(const std::string& name);
+    SceneResidencyStats get_residency_stats() const;
 
     void set_renderer(std::unique_ptr<Renderer> renderer);
     Renderer* get_renderer() const;
@@ -41,14 +160,15 @@ public:
         update_callbacks_.emplace_back(std::forward<T>(callback));
     }
 
-    bool is_running() const { return running_; }
-    void stop() { running_ = false; }
+    bool is_running() const;
+    // Safe to call from any thread; a blocking run() returns after the
+    // current frame.
+    void stop();
 
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
-    
-    bool running_ = false;
+
     std::vector<std::function<void(double)>> update_callbacks_;
 };
 
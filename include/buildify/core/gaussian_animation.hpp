@@ -0,0 +1,132 @@
+#ifndef BUILDIFY_CORE_GAUSSIAN_ANIMATION_HPP
+#define BUILDIFY_CORE_GAUSSIAN_ANIMATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace buildify::core {
+
+class GaussianCloud;
+
+enum class DeformationChannel : std::uint32_t {
+    None = 0,
+    Position = 1,
+    Rotation = 2,
+    Scale = 4
+};
+
+constexpr DeformationChannel operator|(DeformationChannel a, DeformationChannel b) {
+    return static_cast<DeformationChannel>(static_cast<std::uint32_t>(a) | static_cast<std::uint32_t>(b));
+}
+
+constexpr bool operator&(DeformationChannel a, DeformationChannel b) {
+    return (static_cast<std::uint32_t>(a) & static_cast<std::uint32_t>(b)) != 0;
+}
+
+// Per-frame deltas for one keyframe of a deformation stream, stored as
+// structure-of-arrays columns over the splats. Positions are offsets added
+// to the rest pose, rotations are quaternions applied on top of the rest
+// rotation, and scales are factors on the rest scale.
+struct DeformationFrame {
+    std::span<const float> position[3];
+    std::span<const float> rotation[4];
+    std::span<const float> scale[3];
+};
+
+// Writes a deformation stream (.b4dg). Every frame stores each channel
+// component as 16-bit values quantized over that frame's range, so frames
+// have a fixed size and any run of frames can be read with a single seek.
+class DeformationStreamWriter {
+public:
+    DeformationStreamWriter() = default;
+    ~DeformationStreamWriter();
+
+    DeformationStreamWriter(const DeformationStreamWriter&) = delete;
+    DeformationStreamWriter& operator=(const DeformationStreamWriter&) = delete;
+
+    bool open(const std::string& path, std::size_t splat_count, float frame_rate,
+              DeformationChannel channels, std::uint32_t block_frames = 8);
+    // Channels the stream was opened without are ignored.
+    bool append_frame(const DeformationFrame& frame);
+    // Patches the frame count into the header; called by the destructor.
+    bool close();
+
+    std::uint32_t get_frame_count() const { return frame_count_; }
+
+private:
+    std::ofstream file_;
+    std::size_t splat_count_ = 0;
+    DeformationChannel channels_ = DeformationChannel::None;
+    std::uint32_t frame_count_ = 0;
+};
+
+struct GaussianAnimationStats {
+    std::uint64_t blocks_loaded = 0;
+    // Blocks the background loader had not finished when a frame needed
+    // them, so evaluate() read them itself.
+    std::uint64_t stalls = 0;
+    std::size_t resident_bytes = 0;
+};
+
+// Plays a deformation stream back onto a Gaussian cloud. bind() captures
+// the cloud's current positions, rotations and scales as the rest pose;
+// evaluate() interpolates the two keyframes around the playback time and
+// writes the deformed splats back into the cloud.
+//
+// Keyframes are read in blocks of block_frames frames. Only a few blocks
+// stay resident: a background thread loads the block after the one being
+// played so playback at frame rate does not wait on the disk.
+class GaussianAnimation {
+public:
+    GaussianAnimation();
+    ~GaussianAnimation();
+
+    GaussianAnimation(const GaussianAnimation&) = delete;
+    GaussianAnimation& operator=(const GaussianAnimation&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const;
+
+    std::size_t get_splat_count() const;
+    std::uint32_t get_frame_count() const;
+    float get_frame_rate() const;
+    double get_duration() const;
+    DeformationChannel get_channels() const;
+
+    // Fails when the cloud's size does not match the stream.
+    bool bind(const GaussianCloud& cloud);
+    bool is_bound() const;
+
+    void set_time(double seconds);
+    double get_time() const;
+    void set_playback_rate(double rate);
+    double get_playback_rate() const;
+    void set_looping(bool looping);
+    bool is_looping() const;
+    void set_playing(bool playing);
+    bool is_playing() const;
+
+    // Advances the playback time when playing.
+    void advance(double delta_time);
+    // Writes the pose at the current time into the cloud.
+    bool evaluate(GaussianCloud& cloud);
+
+    // At least two, so both keyframes of an interpolation can be resident.
+    void set_max_resident_blocks(std::size_t count);
+    std::size_t get_max_resident_blocks() const;
+
+    GaussianAnimationStats get_stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+#ifndef BUILDIFY_CORE_GAUSSIAN_BVH_HPP
+#define BUILDIFY_CORE_GAUSSIAN_BVH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "buildify/utils/math.hpp"
+
+namespace buildify::core {
+
+class GaussianCloud;
+
+struct Ray {
+    utils::Vector3f origin;
+    utils::Vector3f direction;
+    float t_min = 0.0f;
+    float t_max = std::numeric_limits<float>::infinity();
+};
+
+// A splat crossed by a ray. t is the ray parameter of the splat's density
+// peak along the ray, alpha its opacity there, and transmittance the light
+// left in front of it after the nearer hits of the same query.
+struct RayHit {
+    std::uint32_t index = 0;
+    float t = 0.0f;
+    float alpha = 0.0f;
+    float transmittance = 1.0f;
+};
+
+// Results for a batch of rays. Ray i owns hits[i * max_hits, i * max_hits +
+// hit_counts[i]), sorted front to back; transmittance[i] is what remains
+// behind those hits.
+struct RayQueryResult {
+    std::uint32_t max_hits = 0;
+    std::vector<RayHit> hits;
+    std::vector<std::uint32_t> hit_counts;
+    std::vector<float> transmittance;
+
+    std::span<const RayHit> hits_for(std::size_t ray) const {
+        return {hits.data() + ray * max_hits, hit_counts[ray]};
+    }
+};
+
+// Bounding volume hierarchy over the 3-sigma ellipsoids of a Gaussian cloud.
+// Each splat is stored as its centre and the matrix mapping world space into
+// its unit-sphere frame, so queries do not touch the cloud itself.
+//
+// The tree is built top-down with binned SAH, subtrees in parallel, and then
+// collapsed into 4-wide nodes whose child boxes are laid out so one node
+// visit tests all four children together.
+class GaussianBVH {
+public:
+    static constexpr std::uint32_t packet_size = 8;
+    static constexpr std::uint32_t max_leaf_size = 4;
+    static constexpr std::uint32_t branching = 4;
+
+    void build(const GaussianCloud& cloud);
+    // Updates bounds for splats that moved while their count, scales,
+    // rotations and opacities stayed the same, keeping the topology. Falls
+    // back to a full build when the splat count changed. Tree quality
+    // degrades with large motions, so rebuild now and then.
+    void refit(const GaussianCloud& cloud);
+    // Keeps the tree for a cloud whose splats changed in color only.
+    void retarget(const GaussianCloud& cloud);
+    void clear();
+
+    bool empty() const { return nodes_.empty(); }
+    std::size_t size() const { return primitives_.size(); }
+    std::size_t node_count() const { return nodes_.size(); }
+    std::uint64_t get_source_version() const { return source_version_; }
+
+    // Returns up to max_hits splats per ray. Rays are traced in packets of
+    // packet_size, so batches of neighbouring rays (e.g. a pixel block)
+    // share node visits; packets run in parallel on the thread pool.
+    RayQueryResult cast_rays(std::span<const Ray> rays, std::uint32_t max_hits) const;
+    void cast_rays(std::span<const Ray> rays, std::uint32_t max_hits, RayQueryResult& result) const;
+
+    // True when the splats along the ray let through less than
+    // max_transmittance of the light.
+    bool occluded(const Ray& ray, float max_transmittance = 0.5f) const;
+
+private:
+    // Child boxes are stored per axis so a node's four slab tests are one
+    // vector operation. Nodes are stored breadth first; level_offsets_
+    // marks where each tree level starts.
+    struct Node {
+        float min_x[branching];
+        float min_y[branching];
+        float min_z[branching];
+        float max_x[branching];
+        float max_y[branching];
+        float max_z[branching];
+        // Interior children: node index. Leaves: first primitive, with
+        // count[i] > 0 primitives. Unused slots hold an empty box.
+        std::uint32_t child[branching];
+        std::uint8_t count[branching];
+    };
+
+    // Shape of a splat: the world-to-unit-sphere matrix and opacity.
+    // Centres, box extents and cloud indices are kept in separate arrays
+    // (all in tree order) so a refit streams only the data it touches.
+    struct Primitive {
+        float to_local[3][3];
+        float opacity;
+    };
+
+    void trace_packet(const Ray* rays, std::uint32_t count, std::uint32_t max_hits,
+                      RayHit* hits, std::uint32_t* hit_counts) const;
+
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> level_offsets_;
+    std::vector<Primitive> primitives_;
+    std::vector<utils::Vector3f> centers_;
+    std::vector<utils::Vector3f> extents_;
+    std::vector<std::uint32_t> indices_;
+    std::size_t source_count_ = 0;
+    std::uint64_t source_version_ = 0;
+};
+
+}
+
+#endif
\ No newline at end of file
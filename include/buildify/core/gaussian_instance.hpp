@@ -0,0 +1,69 @@
+#ifndef BUILDIFY_CORE_GAUSSIAN_INSTANCE_HPP
+#define BUILDIFY_CORE_GAUSSIAN_INSTANCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "buildify/core/gaussians.hpp"
+#include "buildify/core/scene.hpp"
+#include "buildify/utils/math.hpp"
+
+namespace buildify::core {
+
+// A run of spatially close splats of an asset, bounded by a sphere that
+// contains their 3-sigma ellipsoids.
+struct GaussianCluster {
+    std::uint32_t first = 0;
+    std::uint32_t count = 0;
+    utils::Vector3f center;
+    float radius = 0.0f;
+};
+
+// Gaussian data placed many times in a scene through GaussianInstance.
+// The splats are reordered along a Morton curve on construction and split
+// into clusters of cluster_size, so the renderer can cull an instance
+// piecewise. The cloud is immutable afterwards.
+class GaussianAsset {
+public:
+    static constexpr std::size_t default_cluster_size = 1024;
+
+    explicit GaussianAsset(GaussianCloud cloud, std::size_t cluster_size = default_cluster_size);
+
+    const GaussianCloud& get_gaussians() const { return cloud_; }
+    std::span<const GaussianCluster> get_clusters() const { return clusters_; }
+    // Bounds of the whole asset in its local frame.
+    const utils::Vector3f& get_center() const { return center_; }
+    float get_radius() const { return radius_; }
+
+private:
+    GaussianCloud cloud_;
+    std::vector<GaussianCluster> clusters_;
+    utils::Vector3f center_;
+    float radius_ = 0.0f;
+};
+
+// Places a shared asset in the scene under the entity's transform. The
+// renderer transforms the asset's splats per instance while projecting,
+// so any number of instances cost one copy of the data.
+class GaussianInstance : public Entity {
+public:
+    explicit GaussianInstance(const std::string& name = "", std::shared_ptr<const GaussianAsset> asset = nullptr);
+
+    const std::shared_ptr<const GaussianAsset>& get_asset() const { return asset_; }
+    void set_asset(std::shared_ptr<const GaussianAsset> asset) { asset_ = std::move(asset); }
+
+    bool is_visible() const { return visible_; }
+    void set_visible(bool visible) { visible_ = visible; }
+
+private:
+    std::shared_ptr<const GaussianAsset> asset_;
+    bool visible_ = true;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef BUILDIFY_CORE_GAUSSIAN_IO_HPP
+#define BUILDIFY_CORE_GAUSSIAN_IO_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "buildify/utils/task.hpp"
+
+namespace buildify::core {
+
+class GaussianCloud;
+
+// Binary snapshot of a GaussianCloud: a small header and then each column
+// back to back, live splats only, so a file is about memory_footprint()
+// without the spare capacity. Used for checkpoints, Scene::save_to_file
+// and evicted scenes.
+//
+// Both functions work in chunks, reporting progress and polling `cancel`
+// between them. A cancelled save removes the partial file; a failed or
+// cancelled load leaves `cloud` untouched.
+bool save_gaussians(const std::string& path, const GaussianCloud& cloud,
+                    const utils::ProgressCallback& progress = {},
+                    const utils::CancellationToken& cancel = {});
+bool load_gaussians(const std::string& path, GaussianCloud& cloud,
+                    const utils::ProgressCallback& progress = {},
+                    const utils::CancellationToken& cancel = {});
+
+// What reload_gaussians() changed, in chunks of a few thousand values of
+// one column.
+struct GaussianReloadStats {
+    std::size_t chunks = 0;
+    std::size_t changed_chunks = 0;
+    // The splat count, SH degree or 3D filter presence differs, so the
+    // file was loaded in full and every flag below is set.
+    bool full_load = false;
+    bool positions_changed = false;
+    // Scales, rotations, opacities or the 3D filter.
+    bool shapes_changed = false;
+    // Colors or higher SH bands.
+    bool appearance_changed = false;
+};
+
+// Brings `cloud` up to date with a rewritten file, comparing it chunk by
+// chunk and writing only the chunks that differ, so an unchanged file
+// keeps the cloud's version and caches keyed on it. A failed reload leaves
+// `cloud` untouched.
+bool reload_gaussians(const std::string& path, GaussianCloud& cloud, GaussianReloadStats& stats);
+
+}
+
+#endif
\ No newline at end of file
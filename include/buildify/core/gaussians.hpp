@@ -0,0 +1,144 @@
+#ifndef BUILDIFY_CORE_GAUSSIANS_HPP
+#define BUILDIFY_CORE_GAUSSIANS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "buildify/utils/huge_pages.hpp"
+#include "buildify/utils/math.hpp"
+#include "buildify/utils/numa.hpp"
+
+namespace buildify::core {
+
+class Camera;
+
+enum class GaussianAttribute : std::size_t {
+    PositionX,
+    PositionY,
+    PositionZ,
+    ScaleX,
+    ScaleY,
+    ScaleZ,
+    RotationX,
+    RotationY,
+    RotationZ,
+    RotationW,
+    Opacity,
+    ColorR,
+    ColorG,
+    ColorB,
+    Count
+};
+
+// Structure-of-arrays storage for Gaussian splats. Scales and opacity are
+// stored activated (linear scale, opacity in [0, 1]); the color columns hold
+// the degree-0 spherical harmonic coefficient and sh_rest() holds the higher
+// bands interleaved per splat as [coefficient][rgb].
+class GaussianCloud {
+public:
+    static constexpr std::size_t attribute_count = static_cast<std::size_t>(GaussianAttribute::Count);
+    static constexpr std::uint32_t max_sh_degree = 3;
+    static constexpr float sh_c0 = 0.28209479177387814f;
+
+    // Large columns are mapped on huge pages: culling and blending read
+    // them in splat order that is random with respect to memory.
+    using Column = utils::HugePageVector<float>;
+
+    explicit GaussianCloud(std::uint32_t sh_degree = 0);
+
+    static constexpr std::size_t sh_rest_coefficients(std::uint32_t degree) {
+        return (degree + 1) * (degree + 1) - 1;
+    }
+
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    std::uint32_t get_sh_degree() const { return sh_degree_; }
+    std::size_t get_sh_rest_stride() const { return sh_rest_coefficients(sh_degree_) * 3; }
+
+    void reserve(std::size_t count);
+    void resize(std::size_t count);
+    void clear();
+    // Keeps only the listed splats, in the given order; indices must be
+    // unique and in range.
+    void retain(std::span<const std::uint32_t> indices);
+
+    std::size_t add(const utils::Vector3f& position,
+                    const utils::Vector3f& scale,
+                    const utils::Quaternionf& rotation,
+                    float opacity,
+                    const utils::Vector3f& color);
+
+    std::span<const float> column(GaussianAttribute attribute) const {
+        return columns_[static_cast<std::size_t>(attribute)];
+    }
+
+    std::span<float> column(GaussianAttribute attribute) {
+        ++version_;
+        return columns_[static_cast<std::size_t>(attribute)];
+    }
+
+    std::span<const float> sh_rest() const { return sh_rest_; }
+    std::span<float> sh_rest() {
+        ++version_;
+        return sh_rest_;
+    }
+
+    // Mip-Splatting 3D smoothing filter: a per-splat standard deviation
+    // added in quadrature to every scale axis at render time. Empty until
+    // computed, and kept sized with the cloud once present.
+    bool has_filter_3d() const { return !filter_3d_.empty(); }
+    std::span<const float> filter_3d() const { return filter_3d_; }
+    std::span<float> filter_3d() {
+        ++version_;
+        return filter_3d_;
+    }
+
+    // Sets each splat's filter from the highest sampling rate (pixels per
+    // world unit) at which any of the training cameras, rendered at
+    // width x height, sees it. Splats no camera sees get the largest filter.
+    void compute_filter_3d(std::span<const Camera> cameras, std::uint32_t width, std::uint32_t height);
+    // Zero-filled filter sized with the cloud, for loading filters computed
+    // elsewhere.
+    void allocate_filter_3d();
+    void clear_filter_3d();
+
+    utils::Vector3f get_position(std::size_t index) const;
+    utils::Vector3f get_color(std::size_t index) const;
+
+    std::size_t memory_footprint() const;
+
+    // NUMA placement of the attribute columns. Partitioned splits them the
+    // way ThreadPool::parallel_for_partitioned splits splat loops. Applied
+    // now and again after reserve, resize and retain; splats appended with
+    // add() beyond the reserved capacity keep the default policy.
+    void set_memory_placement(utils::MemoryPlacement placement);
+    utils::MemoryPlacement get_memory_placement() const { return placement_; }
+
+    // Bumped by every mutable access so caches keyed on the cloud can tell
+    // when the splat data may have changed.
+    std::uint64_t get_version() const { return version_; }
+    void mark_modified() { ++version_; }
+    // For a cloud moved into the place of another: moves the version past
+    // the replaced one's so caches never mistake the two.
+    void mark_modified_after(std::uint64_t version) { version_ = std::max(version_, version) + 1; }
+
+private:
+    std::size_t count_ = 0;
+    std::uint32_t sh_degree_ = 0;
+    std::uint64_t version_ = 0;
+    utils::MemoryPlacement placement_ = utils::MemoryPlacement::Default;
+    std::array<Column, attribute_count> columns_;
+    Column sh_rest_;
+    Column filter_3d_;
+
+    void apply_placement();
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef BUILDIFY_CORE_KD_TREE_HPP
+#define BUILDIFY_CORE_KD_TREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "buildify/utils/math.hpp"
+
+namespace buildify::core {
+
+// 3D k-d tree over a point set, split at the median of the widest axis.
+// The points are copied in tree order, so queries only touch the tree.
+// Indices returned by queries refer to the span passed to build().
+class KdTree {
+public:
+    static constexpr std::uint32_t max_leaf_size = 16;
+
+    void build(std::span<const utils::Vector3f> points);
+    void clear();
+
+    bool empty() const { return points_.empty(); }
+    std::size_t size() const { return points_.size(); }
+
+    // Points in tree order and the index each had in build(). Queries issued
+    // in this order walk neighbouring leaves back to back.
+    std::span<const utils::Vector3f> ordered_points() const { return points_; }
+    std::span<const std::uint32_t> ordered_indices() const { return indices_; }
+
+    // Closest point within max_distance. Returns false when there is none.
+    bool nearest(const utils::Vector3f& query, std::uint32_t& index, float& distance2,
+                 float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    // Up to k closest points within max_distance, nearest first. Returns how
+    // many were found; indices and distances2 must hold k entries.
+    std::uint32_t knn(const utils::Vector3f& query, std::uint32_t k, std::uint32_t* indices, float* distances2,
+                      float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    // nearest() for every query in parallel. Queries without a point in
+    // range get index UINT32_MAX and an infinite distance.
+    void nearest_batch(std::span<const utils::Vector3f> queries, std::span<std::uint32_t> indices,
+                       std::span<float> distances2,
+                       float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    // knn() for every query in parallel, writing k entries per query to
+    // indices and distances2 (queries.size() * k each). Missing neighbours
+    // get index UINT32_MAX and an infinite distance.
+    void knn_batch(std::span<const utils::Vector3f> queries, std::uint32_t k, std::span<std::uint32_t> indices,
+                   std::span<float> distances2,
+                   float max_distance = std::numeric_limits<float>::infinity()) const;
+
+private:
+    // Interior nodes split at `split` along `axis`, with children first and
+    // second. Leaves (axis 3) hold points [first, first + second).
+    struct Node {
+        float split;
+        std::uint32_t axis;
+        std::uint32_t first;
+        std::uint32_t second;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<utils::Vector3f> points_;
+    std::vector<std::uint32_t> indices_;
+};
+
+}
+
+#endif
\ No newline at end of file
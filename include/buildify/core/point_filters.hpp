@@ -0,0 +1,41 @@
+#ifndef BUILDIFY_CORE_POINT_FILTERS_HPP
+#define BUILDIFY_CORE_POINT_FILTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "buildify/utils/math.hpp"
+
+namespace buildify::core {
+
+class GaussianCloud;
+
+// Voxel-grid downsampling. Points are binned into cubic voxels of the given
+// size through a hash partitioned across threads, and every occupied voxel
+// becomes the centroid of its points (colors, when given, are averaged the
+// same way). Voxel coordinates are clamped to +-2^20 cells.
+std::vector<utils::Vector3f> voxel_downsample(std::span<const utils::Vector3f> points, float voxel_size);
+void voxel_downsample(std::span<const utils::Vector3f> points, std::span<const utils::Vector3f> colors,
+                      float voxel_size, std::vector<utils::Vector3f>& out_points,
+                      std::vector<utils::Vector3f>& out_colors);
+
+// Keeps the most opaque splat of every voxel, in their original order.
+// Returns how many splats were removed.
+std::size_t voxel_downsample(GaussianCloud& cloud, float voxel_size);
+
+// Statistical outlier removal: a point is an outlier when the mean distance
+// to its k nearest neighbours exceeds the mean over all points by more than
+// std_ratio standard deviations. Returns 1 for inliers, 0 for outliers.
+std::vector<std::uint8_t> statistical_inlier_mask(std::span<const utils::Vector3f> points,
+                                                  std::uint32_t neighbors = 20, float std_ratio = 2.0f);
+
+// Drops outlying splats by the same test, applied to splat centers.
+// Returns how many splats were removed.
+std::size_t remove_statistical_outliers(GaussianCloud& cloud, std::uint32_t neighbors = 20,
+                                        float std_ratio = 2.0f);
+
+}
+
+#endif
\ No newline at end of file
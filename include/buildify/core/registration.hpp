@@ -0,0 +1,66 @@
+#ifndef BUILDIFY_CORE_REGISTRATION_HPP
+#define BUILDIFY_CORE_REGISTRATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "buildify/utils/math.hpp"
+
+namespace buildify::core {
+
+class KdTree;
+
+// M-estimators that down-weight correspondences with large residuals.
+enum class RobustKernel {
+    None,
+    Huber,
+    Tukey,
+    Cauchy
+};
+
+// Point-to-plane ICP, run coarse to fine. Each level downsamples both
+// clouds to voxel centroids of the given size (0: full resolution) and
+// iterates until the update falls below the tolerances.
+//
+// With no voxel sizes, levels are derived from the target's extent and end
+// at full resolution. A zero correspondence distance uses three times the
+// level's voxel size, and a zero kernel scale a third of the correspondence
+// distance.
+struct IcpSettings {
+    std::vector<float> voxel_sizes;
+    std::uint32_t max_iterations = 30;
+    float max_correspondence_distance = 0.0f;
+    RobustKernel kernel = RobustKernel::Huber;
+    float kernel_scale = 0.0f;
+    std::uint32_t normal_neighbors = 10;
+    float rotation_tolerance = 1e-5f;
+    float translation_tolerance = 1e-6f;
+};
+
+struct IcpResult {
+    // Maps source points onto the target.
+    utils::Matrix4f transform;
+    // Point-to-plane residual over the correspondences of the last iteration
+    // on the finest level.
+    float rmse = 0.0f;
+    // Fraction of source points with a correspondence in range.
+    float fitness = 0.0f;
+    std::uint32_t iterations = 0;
+    bool converged = false;
+};
+
+IcpResult align_point_to_plane(std::span<const utils::Vector3f> source,
+                               std::span<const utils::Vector3f> target,
+                               const IcpSettings& settings = {},
+                               const utils::Matrix4f& initial = utils::Matrix4f::identity());
+
+// Unit normals from the covariance of each point's k nearest neighbours in
+// `tree`, which must have been built over `points`. Orientation is arbitrary.
+std::vector<utils::Vector3f> estimate_normals(std::span<const utils::Vector3f> points, const KdTree& tree,
+                                              std::uint32_t neighbors);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,178 @@
+#ifndef BUILDIFY_CORE_RENDER_SERVER_HPP
+#define BUILDIFY_CORE_RENDER_SERVER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "buildify/core/scene.hpp"
+
+namespace buildify::core {
+
+// Wire format of the render server. Every message is a header followed by
+// `payload_bytes` of payload; all fields are little-endian and the structs
+// have no padding. A client sends Hello once, with the largest frame it
+// will ask for and how many frames it keeps in flight, and the server
+// replies with the name of a shared-memory segment holding that many frame
+// slots. Render replies point at a slot: the color image, [height, width, 4]
+// floats, lies at `offset` in the segment and stays valid until the client
+// has `slots` more renders outstanding. Renders beyond `slots` in flight
+// are refused with Busy.
+namespace render_protocol {
+
+inline constexpr std::uint32_t request_magic = 0x51524642;   // "BFRQ"
+inline constexpr std::uint32_t response_magic = 0x53524642;  // "BFRS"
+inline constexpr std::uint16_t version = 1;
+
+enum class MessageType : std::uint16_t {
+    Hello = 1,
+    Render = 2
+};
+
+enum class Status : std::uint16_t {
+    Ok = 0,
+    BadRequest = 1,
+    UnknownScene = 2,
+    FrameTooLarge = 3,
+    Busy = 4
+};
+
+struct MessageHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    // MessageType in requests, Status in responses.
+    std::uint16_t code;
+    std::uint32_t request_id;
+    std::uint32_t payload_bytes;
+};
+
+struct HelloRequest {
+    std::uint32_t max_width;
+    std::uint32_t max_height;
+    std::uint32_t slots;
+};
+
+// Followed by name_bytes of segment name.
+struct HelloResponse {
+    std::uint64_t slot_bytes;
+    std::uint32_t slots;
+    std::uint32_t name_bytes;
+};
+
+// Followed by scene_name_bytes of scene name. `fov` is the vertical field
+// of view in degrees, as for Camera::set_perspective.
+struct RenderRequest {
+    std::uint32_t width;
+    std::uint32_t height;
+    float position[3];
+    float rotation[4];
+    float fov;
+    float near_plane;
+    float far_plane;
+    std::uint32_t scene_name_bytes;
+};
+
+struct RenderResponse {
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t slot;
+    // Views rendered together with this one.
+    std::uint32_t batch_size;
+    std::uint64_t offset;
+};
+
+}
+
+// Requests for the same scene and frame size that arrive within
+// batch_window of each other are rendered as one multi-view batch of at
+// most max_batch_views.
+struct RenderServerSettings {
+    std::string socket_path = "/tmp/buildify_render.sock";
+    std::uint32_t max_batch_views = 8;
+    std::chrono::microseconds batch_window{2'000};
+    std::uint32_t max_frame_pixels = 3840 * 2160;
+    std::uint32_t max_slots = 8;
+    // Renderers kept for distinct frame sizes, each with its own frame
+    // buffers; the least recently used is freed past this.
+    std::uint32_t max_cached_renderers = 2;
+};
+
+struct RenderServerStats {
+    std::uint64_t connections = 0;
+    std::uint64_t requests = 0;
+    std::uint64_t batches = 0;
+    std::uint32_t largest_batch = 0;
+    std::uint64_t rejected = 0;
+    std::uint32_t cached_renderers = 0;
+};
+
+// Render service for other processes: keeps scenes loaded and answers
+// camera requests over a Unix domain socket, so scene load cost is paid
+// once per machine instead of once per client. Served scenes must not be
+// modified while the server runs.
+//
+// Sockets are non-blocking and replies are queued per client, so a client
+// that stops reading never holds up the render thread; one whose backlog
+// of unread replies grows past a limit is disconnected.
+class RenderServer {
+public:
+    RenderServer();
+    ~RenderServer();
+
+    RenderServer(const RenderServer&) = delete;
+    RenderServer& operator=(const RenderServer&) = delete;
+
+    void add_scene(const std::string& name, std::shared_ptr<const Scene> scene);
+    void remove_scene(const std::string& name);
+
+    bool start(const RenderServerSettings& settings = {});
+    void stop();
+    bool is_running() const;
+
+    RenderServerStats get_stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// Blocking client for RenderServer. Frames are read in place from the
+// server's shared memory.
+class RenderClient {
+public:
+    RenderClient() = default;
+    ~RenderClient();
+
+    RenderClient(const RenderClient&) = delete;
+    RenderClient& operator=(const RenderClient&) = delete;
+
+    bool connect(const std::string& socket_path, std::uint32_t max_width, std::uint32_t max_height,
+                 std::uint32_t slots = 2);
+    void close();
+    bool is_connected() const { return socket_ >= 0; }
+
+    // Renders the scene from the camera's pose and perspective settings.
+    // The returned [height, width, 4] color image aliases a frame slot and
+    // is valid until `slots` further renders; empty on failure.
+    std::span<const float> render(const std::string& scene, const Camera& camera,
+                                  std::uint32_t width, std::uint32_t height);
+    // Batch size of the last successful render.
+    std::uint32_t get_last_batch_size() const { return last_batch_size_; }
+
+private:
+    bool exchange(render_protocol::MessageType type, const void* payload, std::size_t bytes,
+                  render_protocol::MessageHeader& reply, std::string& reply_payload);
+
+    int socket_ = -1;
+    std::uint32_t next_request_ = 1;
+    std::uint32_t last_batch_size_ = 0;
+    const std::byte* frames_ = nullptr;
+    std::size_t frames_bytes_ = 0;
+};
+
+}
+
+#endif
\ No newline at end of file
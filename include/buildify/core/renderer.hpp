@@ -3,8 +3,12 @@
 
 #include <memory>
 #include <span>
+#include <chrono>
 #include <array>
 #include <cstdint>
+#include <vector>
+
+#include "buildify/core/scene.hpp"
 
 #ifdef WITH_PYTORCH
 #include <torch/torch.h>
@@ -12,13 +16,36 @@
 
 namespace buildify::core {
 
-class Scene;
+enum class ShadingRate : std::uint8_t {
+    Full = 1,
+    Half = 2,
+    Quarter = 4
+};
+
+// Variable-rate shading for renderers that work in screen tiles. Reduced-rate
+// tiles are shaded on a coarser grid and upsampled, evaluate view-dependent
+// color with at most reduced_sh_degree bands and drop contributions below
+// reduced_min_alpha. Rates come from tile_rates when it matches the tile grid,
+// otherwise from the fovea: full rate within inner_radius of the fovea, half
+// rate up to outer_radius, quarter rate beyond. Fovea coordinates and radii
+// are normalized to the larger image dimension.
+struct VariableRateShading {
+    bool enabled = false;
+    std::vector<ShadingRate> tile_rates;
+    float fovea_x = 0.5f;
+    float fovea_y = 0.5f;
+    float inner_radius = 0.25f;
+    float outer_radius = 0.5f;
+    std::uint32_t reduced_sh_degree = 0;
+    float reduced_min_alpha = 1.0f / 64.0f;
+};
 
 struct RenderTarget {
     std::uint32_t width;
     std::uint32_t height;
     std::uint32_t samples = 1;
     void* native_handle = nullptr;
+    VariableRateShading variable_rate{};
 };
 
 class Renderer {
@@ -34,15 +61,32 @@ public:
 
     virtual void render_scene(const Scene& scene) = 0;
 
+    // Renders as much of the frame as fits in `budget` and keeps refining
+    // on later calls while the view is unchanged. Returns true once the
+    // image is converged; renderers without a progressive path render the
+    // whole frame at once. Per-view setup such as projection runs whole
+    // on the first call after a change, on top of the budget.
+    virtual bool render_scene_progressive(const Scene& scene, [[maybe_unused]] std::chrono::microseconds budget) {
+        render_scene(scene);
+        return true;
+    }
+
     virtual void set_viewport(std::uint32_t x, std::uint32_t y, 
                              std::uint32_t width, std::uint32_t height) = 0;
 
     virtual void clear(std::array<float, 4> color = {0.0f, 0.0f, 0.0f, 1.0f}) = 0;
 
+    const RenderTarget& get_target() const { return target_; }
+
 #ifdef WITH_PYTORCH
     virtual torch::Tensor render_to_tensor(const Scene& scene) {
         return torch::empty({0});
     }
+
+    // Renders every camera into one [views, height, width, channels] tensor.
+    virtual torch::Tensor render_to_tensor_batch(const Scene& scene, std::span<const Camera> cameras) {
+        return torch::empty({0});
+    }
 #endif
 
 protected:
@@ -1,6 +1,7 @@
 #ifndef BUILDIFY_CORE_SCENE_HPP
 #define BUILDIFY_CORE_SCENE_HPP
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -16,6 +17,10 @@ class Entity;
 class Camera;
 class Light;
 class Mesh;
+class GaussianCloud;
+class GaussianBVH;
+class GaussianAnimation;
+struct GaussianReloadStats;
 
 template<typename T>
 concept SceneObject = std::derived_from<T, Entity>;
@@ -59,14 +64,39 @@ public:
     void set_active_camera(std::shared_ptr<Camera> camera);
     std::shared_ptr<Camera> get_active_camera() const;
 
+    GaussianCloud& get_gaussians();
+    const GaussianCloud& get_gaussians() const;
+
+    // Spatial index over the Gaussian cloud for ray queries, rebuilt on
+    // first use after the cloud has changed.
+    const GaussianBVH& get_gaussian_bvh() const;
+    // For deforming scenes: refits the existing index to moved splats
+    // instead of rebuilding it. Only positions may have changed.
+    const GaussianBVH& refit_gaussian_bvh() const;
+
+    // Plays a deformation stream on the Gaussian cloud: update() advances
+    // it and writes the deformed splats. Binds the stream to the cloud's
+    // current pose unless it is already bound; fails on a size mismatch.
+    bool set_gaussian_animation(std::shared_ptr<GaussianAnimation> animation);
+    std::shared_ptr<GaussianAnimation> get_gaussian_animation() const;
+
     void update(double delta_time);
 
     auto get_entities() const { 
         return entities_ | std::views::all;
     }
 
-    void load_from_file(const std::string& path);
-    void save_to_file(const std::string& path) const;
+    // The Gaussian cloud, in the format of save_gaussians().
+    bool load_from_file(const std::string& path);
+    bool save_to_file(const std::string& path) const;
+    // The path of the last successful load_from_file, empty if none.
+    const std::string& get_source_path() const;
+    // Applies the changes in the source file since it was loaded (see
+    // reload_gaussians). The BVH is kept for color-only edits and refit
+    // when only positions moved; a Gaussian animation is bound to the
+    // reloaded rest pose. The cloud is modified in place, so no other
+    // thread may be rendering the scene meanwhile.
+    bool reload_from_file(GaussianReloadStats& stats);
 
 #ifdef WITH_BLENDER
     void import_from_blender(const std::string& blend_file);
@@ -101,20 +131,63 @@ protected:
     utils::Transform transform_;
 };
 
+// One consistent snapshot of a camera for render kernels. Matrices are
+// row-major and take world to view to clip space. Frustum planes are
+// world-space (a, b, c, d) with normalized inward normals, ordered left,
+// right, bottom, top, near, far.
+struct CameraParams {
+    utils::Matrix4f view;
+    utils::Matrix4f projection;
+    utils::Matrix4f view_projection;
+    std::array<utils::Vector4f, 6> frustum;
+    utils::Vector3f position;
+    float near = 0.0f;
+    float far = 0.0f;
+    bool orthographic = false;
+
+    bool sphere_in_frustum(const utils::Vector3f& center, float radius) const {
+        for (const auto& plane : frustum) {
+            if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Matrices and frustum are cached and recomputed by the setters, look_at
+// and update(). A transform edited in place through get_transform() is
+// still honoured: the getters detect the stale pose and compute from it
+// without touching the cache, so they stay safe to call from many threads.
 class Camera : public Entity {
 public:
     Camera(const std::string& name = "Camera");
 
+    void set_transform(const utils::Transform& transform);
     void set_perspective(float fov, float aspect_ratio, float near, float far);
     void set_orthographic(float left, float right, float bottom, float top, float near, float far);
+    // Vertical field of view in degrees of the perspective projection.
+    float get_fov() const { return fov_; }
 
+    CameraParams get_params() const;
+    // Read from the cache without copying the rest of the parameters; a
+    // stale pose recomputes the view matrix only.
     utils::Matrix4<float> get_view_matrix() const;
-    utils::Matrix4<float> get_projection_matrix() const;
+    utils::Matrix4<float> get_projection_matrix() const { return params_.projection; }
+    utils::Matrix4<float> get_view_projection_matrix() const;
 
     void look_at(const utils::Vector3<float>& target, const utils::Vector3<float>& up = {0, 1, 0});
 
+    void update(double delta_time) override;
+
 private:
     enum class ProjectionType { Perspective, Orthographic };
+
+    CameraParams compute_params() const;
+    utils::Matrix4<float> compute_view_matrix() const;
+    bool is_cache_valid() const;
+    void refresh();
+
     ProjectionType projection_type_ = ProjectionType::Perspective;
     
     float fov_ = 45.0f;
@@ -126,8 +199,12 @@ private:
     float ortho_right_ = 1.0f;
     float ortho_bottom_ = -1.0f;
     float ortho_top_ = 1.0f;
-};
 
+    // Pose the cached parameters were computed for.
+    utils::Vector3f cached_position_;
+    utils::Quaternionf cached_rotation_;
+    CameraParams params_;
+};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef BUILDIFY_CORE_SCENE_RESIDENCY_HPP
+#define BUILDIFY_CORE_SCENE_RESIDENCY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace buildify::core {
+
+class Scene;
+
+// memory_budget bounds the Gaussian data of all resident scenes in bytes
+// (0 = unlimited). Evicted clouds are written to spill_directory, a fresh
+// directory under the system temp path when empty.
+struct SceneResidencySettings {
+    std::size_t memory_budget = 0;
+    std::string spill_directory;
+};
+
+enum class SceneResidencyState {
+    Resident,
+    // Being written out; the memory is counted as released already.
+    Evicting,
+    Evicted,
+    // Being read back, or read and waiting to be installed.
+    Loading
+};
+
+struct SceneResidencyStats {
+    std::size_t resident_bytes = 0;
+    std::size_t resident_scenes = 0;
+    std::size_t evicted_scenes = 0;
+    std::uint64_t evictions = 0;
+    std::uint64_t reloads = 0;
+    // Reloads a caller had to wait for because no prefetch covered them.
+    std::uint64_t stalls = 0;
+};
+
+// Keeps the Gaussian clouds of many scenes within a memory budget. When
+// the budget is exceeded the least recently used scenes lose their cloud
+// to a compact file on disk; acquire() and touch() bring it back. Scenes
+// themselves, their entities and every shared_ptr to them stay valid
+// throughout, only the cloud is swapped for an empty one while evicted.
+//
+// Disk I/O runs on a background thread, but clouds are swapped in and out
+// on whichever thread calls add(), acquire(), touch() or set_settings().
+// Any of these may evict another scene, so with renderers on other threads
+// the caller must keep them from running while a scene is being drawn;
+// with a single owning thread a scene never changes behind its back.
+class SceneResidency {
+public:
+    SceneResidency();
+    ~SceneResidency();
+
+    SceneResidency(const SceneResidency&) = delete;
+    SceneResidency& operator=(const SceneResidency&) = delete;
+
+    void set_settings(const SceneResidencySettings& settings);
+    SceneResidencySettings get_settings() const;
+
+    // Replaces a scene of the same name.
+    void add(const std::string& name, std::shared_ptr<Scene> scene);
+    // An evicted scene that is still referenced elsewhere gets its cloud
+    // back before the spill file is deleted.
+    void remove(const std::string& name);
+    // Waits for pending I/O and deletes the spill files.
+    void clear();
+
+    // Returns the scene with its cloud resident and marks it used; null
+    // for unknown names.
+    std::shared_ptr<Scene> acquire(const std::string& name);
+    // Same for a scene already at hand; scenes not added here are ignored.
+    void touch(const Scene& scene);
+    // Starts reading an evicted scene back without waiting for it.
+    void prefetch(const std::string& name);
+    // For a scene that is not resident: drops its spill file, now stale,
+    // so the next acquire reads `source_path` instead. Returns false for a
+    // resident scene, which the caller has to update in place.
+    bool refresh_evicted(const std::string& name, const std::string& source_path);
+
+    SceneResidencyState get_state(const std::string& name) const;
+    std::vector<std::shared_ptr<Scene>> get_scenes() const;
+    SceneResidencyStats get_stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}
+
+#endif
\ No newline at end of file
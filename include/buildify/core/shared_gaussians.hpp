@@ -0,0 +1,114 @@
+#ifndef BUILDIFY_CORE_SHARED_GAUSSIANS_HPP
+#define BUILDIFY_CORE_SHARED_GAUSSIANS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "buildify/core/gaussians.hpp"
+
+namespace buildify::core {
+
+// Start of a shared Gaussian segment (/dev/shm/<name>). Each column follows
+// at its offset as `capacity` floats: the GaussianAttribute columns in
+// order, then sh_rest (capacity * stride floats) and filter_3d. Offsets are
+// 64-byte aligned and every field is little-endian, so readers without this
+// library can map the file and index it directly.
+//
+// `generation` is a seqlock: odd while the writer is copying, bumped to the
+// next even value once an update is complete. A reader that sees the same
+// even generation before and after reading got a consistent snapshot.
+// The writer stores everything it changes after creation, the columns
+// included, as relaxed atomic words and read() loads them the same way,
+// so the two may overlap even within one process.
+struct SharedGaussianHeader {
+    static constexpr char expected_magic[8] = {'B', 'F', 'Y', 'G', 'S', 'H', 'M', '\0'};
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::size_t column_count = GaussianCloud::attribute_count + 2;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_bytes;
+    std::uint64_t capacity;
+    std::uint32_t sh_degree;
+    std::uint32_t stored_columns;
+    std::uint64_t generation;
+    std::uint64_t count;
+    // GaussianCloud::get_version() of the published cloud.
+    std::uint64_t source_version;
+    std::uint32_t has_filter_3d;
+    // Process that created the segment.
+    std::uint32_t writer_pid;
+    std::uint64_t column_offsets[column_count];
+};
+
+// Gaussian splats in named POSIX shared memory, written by one process and
+// mapped read-only, without copies, by any number of others. The creator
+// owns the name and unlinks it on close().
+class SharedGaussianSegment {
+public:
+    SharedGaussianSegment() = default;
+    ~SharedGaussianSegment();
+
+    SharedGaussianSegment(const SharedGaussianSegment&) = delete;
+    SharedGaussianSegment& operator=(const SharedGaussianSegment&) = delete;
+
+    // Creates the segment for up to `capacity` splats, replacing a stale
+    // one of the same name whose writer is gone. Fails while the writer of
+    // an existing segment is alive. A leading '/' is added when missing.
+    bool create(const std::string& name, std::size_t capacity, std::uint32_t sh_degree);
+    // Maps an existing segment read-only; fails on a foreign or newer
+    // layout.
+    bool open(const std::string& name);
+    void close();
+
+    bool is_open() const { return header_ != nullptr; }
+    bool is_writable() const { return owner_; }
+    const std::string& get_name() const { return name_; }
+    std::size_t get_capacity() const;
+    std::uint32_t get_sh_degree() const;
+    std::uint64_t get_generation() const;
+    const SharedGaussianHeader* header() const { return header_; }
+
+    // Copies the cloud into the segment and publishes it. Fails when the
+    // cloud is larger than the capacity or has another SH degree.
+    bool publish(const GaussianCloud& cloud);
+
+    // How long a reader waits for a publish to finish. A writer that dies
+    // mid-publish leaves the generation odd for good, so reads give up.
+    static constexpr std::chrono::milliseconds default_read_timeout{1000};
+
+    // Zero-copy reads: take the generation, read the spans, and keep the
+    // data only if end_read() confirms no update overlapped. Empty when
+    // no publish finished within the timeout. The spans are plain memory:
+    // in the writer's own process, read them only while it is not
+    // publishing, or use read().
+    std::optional<std::uint64_t> begin_read(std::chrono::milliseconds timeout = default_read_timeout) const;
+    bool end_read(std::uint64_t generation) const;
+    std::size_t size() const;
+    std::span<const float> column(GaussianAttribute attribute) const;
+    std::span<const float> sh_rest() const;
+    // Empty when the published cloud had no 3D filter.
+    std::span<const float> filter_3d() const;
+
+    // Copies a consistent snapshot into `cloud`, retrying while updates
+    // overlap. Fails on an SH degree mismatch or when no consistent
+    // snapshot was had within the timeout.
+    bool read(GaussianCloud& cloud, std::chrono::milliseconds timeout = default_read_timeout) const;
+
+private:
+    bool map(int fd, std::size_t bytes, bool writable);
+    const float* column_data(std::size_t index) const;
+
+    std::string name_;
+    SharedGaussianHeader* header_ = nullptr;
+    std::size_t mapped_bytes_ = 0;
+    bool owner_ = false;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef BUILDIFY_CORE_TENSOR_POOL_HPP
+#define BUILDIFY_CORE_TENSOR_POOL_HPP
+
+#ifdef WITH_PYTORCH
+
+#include <torch/torch.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace buildify::core {
+
+// Preallocated output tensors keyed by shape. acquire() hands back a pooled
+// tensor whose storage nobody else references any more, so loops that drop
+// their previous outputs never allocate after warm-up. At most
+// max_per_shape tensors are kept per shape; extra requests get a fresh,
+// unpooled tensor.
+class TensorPool {
+public:
+    explicit TensorPool(std::size_t max_per_shape = 4,
+                        torch::TensorOptions options = torch::TensorOptions().dtype(torch::kFloat32));
+
+    torch::Tensor acquire(const std::vector<std::int64_t>& shape);
+
+    void clear();
+    std::size_t size() const;
+
+private:
+    std::size_t max_per_shape_;
+    torch::TensorOptions options_;
+    std::map<std::vector<std::int64_t>, std::vector<torch::Tensor>> tensors_;
+    mutable std::mutex mutex_;
+};
+
+}
+
+#endif
+
+#endif
\ No newline at end of file
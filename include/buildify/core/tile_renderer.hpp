@@ -0,0 +1,159 @@
+#ifndef BUILDIFY_CORE_TILE_RENDERER_HPP
+#define BUILDIFY_CORE_TILE_RENDERER_HPP
+
+#include "buildify/core/renderer.hpp"
+#include "buildify/utils/numa.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace buildify::core {
+
+// Reuses the previous frame's tiles while the camera moves slowly. A tile is
+// reprojected instead of re-blended when the set of splats overlapping it
+// changed by at most max_splat_change (as a fraction of its list) and no
+// pixel of it moves further than max_pixel_motion. max_reuse_frames bounds
+// how long a tile can drift before it is rendered again.
+struct TemporalCacheSettings {
+    bool enabled = false;
+    float max_pixel_motion = 1.5f;
+    float max_splat_change = 0.25f;
+    std::uint32_t max_reuse_frames = 8;
+};
+
+// Auxiliary per-pixel outputs produced by the color blending pass. Expected
+// depth is always available through get_depth_buffer(); the channels below
+// are only accumulated when enabled.
+enum class AuxChannel : std::uint32_t {
+    None = 0,
+    Alpha = 1u << 0,
+    MedianDepth = 1u << 1,
+    Normal = 1u << 2,
+};
+
+constexpr AuxChannel operator|(AuxChannel a, AuxChannel b) {
+    return static_cast<AuxChannel>(static_cast<std::uint32_t>(a) | static_cast<std::uint32_t>(b));
+}
+
+constexpr AuxChannel operator&(AuxChannel a, AuxChannel b) {
+    return static_cast<AuxChannel>(static_cast<std::uint32_t>(a) & static_cast<std::uint32_t>(b));
+}
+
+// Mip-Splatting anti-aliasing. filter_3d applies the per-splat smoothing
+// from GaussianCloud::compute_filter_3d() when the cloud carries one. The
+// 2D Mip filter replaces the fixed screen-space dilation with a pixel-sized
+// filter of the given variance and rescales opacity so that splats smaller
+// than a pixel fade out instead of aliasing.
+struct AntiAliasingSettings {
+    bool filter_3d = true;
+    bool mip_filter_2d = false;
+    float filter_2d_variance = 0.1f;
+};
+
+// Per-tile depth sort. Both modes sort packed depth/index keys and give the
+// same order; Radix uses an LSD radix sort, Comparison std::sort, and Auto
+// picks radix once a tile list is long enough to pay for its histograms.
+enum class TileSortMode {
+    Auto,
+    Comparison,
+    Radix
+};
+
+struct TileFrameStats {
+    std::size_t visible_splats = 0;
+    // GaussianInstances kept and rejected by bounding-sphere culling.
+    std::size_t instances_visible = 0;
+    std::size_t instances_culled = 0;
+    std::size_t tile_count = 0;
+    std::size_t tiles_rendered = 0;
+    std::size_t tiles_reused = 0;
+    std::size_t tiles_reduced_rate = 0;
+    std::size_t pixels_shaded = 0;
+    double frame_ms = 0.0;
+};
+
+// CPU rasterizer for the scene's Gaussian cloud and its GaussianInstances.
+// Splats are projected with EWA splatting, binned into screen tiles, depth
+// sorted per tile and alpha blended front to back.
+class TileRenderer : public Renderer {
+public:
+    static constexpr std::uint32_t tile_size = 16;
+
+    TileRenderer();
+    ~TileRenderer() override;
+
+    bool initialize(const RenderTarget& target) override;
+    void shutdown() override;
+
+    void begin_frame() override;
+    void end_frame() override;
+
+    void render_scene(const Scene& scene) override;
+    bool render_scene_progressive(const Scene& scene, std::chrono::microseconds budget) override;
+
+    // Resizes the frame buffers to width x height. Offsets are not
+    // supported: a non-zero x or y is logged and ignored.
+    void set_viewport(std::uint32_t x, std::uint32_t y,
+                     std::uint32_t width, std::uint32_t height) override;
+
+    void clear(std::array<float, 4> color) override;
+
+    // Renders one frame per camera into `color` ([views, height, width, 4])
+    // and, when non-empty, `depth`, `alpha` and `median_depth` (each
+    // [views, height, width]). Views are processed concurrently and their
+    // scratch storage is reused.
+    void render_views(const Scene& scene, std::span<const Camera> cameras,
+                      std::span<float> color, std::span<float> depth = {},
+                      std::span<float> alpha = {}, std::span<float> median_depth = {});
+
+#ifdef WITH_PYTORCH
+    // Both return tensors drawn from a pool keyed by shape; a tensor is
+    // reused once the caller has released every reference to it.
+    torch::Tensor render_to_tensor(const Scene& scene) override;
+    torch::Tensor render_to_tensor_batch(const Scene& scene, std::span<const Camera> cameras) override;
+#endif
+
+    void set_temporal_cache(const TemporalCacheSettings& settings);
+    const TemporalCacheSettings& get_temporal_cache() const;
+    void invalidate_temporal_cache();
+
+    void set_variable_rate(const VariableRateShading& settings);
+
+    void set_anti_aliasing(const AntiAliasingSettings& settings);
+    const AntiAliasingSettings& get_anti_aliasing() const;
+
+    void set_sort_mode(TileSortMode mode);
+    TileSortMode get_sort_mode() const;
+
+    // NUMA placement of the frame buffers, applied now and on every resize.
+    // Partitioned splits them by the worker pool's node weights, and only
+    // while the pool is pinned.
+    void set_memory_placement(utils::MemoryPlacement placement);
+    utils::MemoryPlacement get_memory_placement() const;
+
+    void set_aux_channels(AuxChannel channels);
+    AuxChannel get_aux_channels() const;
+
+    // RGBA, row-major, width * height * 4 floats.
+    std::span<const float> get_color_buffer() const;
+    // Expected view-space depth per pixel, 0 where nothing was hit.
+    std::span<const float> get_depth_buffer() const;
+    // Accumulated opacity without the background, width * height floats.
+    std::span<const float> get_alpha_buffer() const;
+    // Depth of the splat at which transmittance first drops below 0.5.
+    std::span<const float> get_median_depth_buffer() const;
+    // Blended view-space splat normals, width * height * 3 floats.
+    std::span<const float> get_normal_buffer() const;
+
+    const TileFrameStats& get_frame_stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef BUILDIFY_CORE_TRIANGLE_MESH_HPP
+#define BUILDIFY_CORE_TRIANGLE_MESH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "buildify/utils/math.hpp"
+
+namespace buildify::core {
+
+// Indexed triangle mesh with optional per-vertex normals and colors (RGB in
+// [0, 1]); those arrays are either empty or sized like vertices.
+struct TriangleMesh {
+    std::vector<utils::Vector3f> vertices;
+    std::vector<utils::Vector3f> normals;
+    std::vector<utils::Vector3f> colors;
+    std::vector<std::uint32_t> indices;
+
+    std::size_t vertex_count() const { return vertices.size(); }
+    std::size_t triangle_count() const { return indices.size() / 3; }
+    bool empty() const { return indices.empty(); }
+
+    // Binary little-endian PLY, which Blender imports with normals and
+    // vertex colors.
+    bool save_ply(const std::string& path) const;
+    // Wavefront OBJ with vertex colors appended to the v lines.
+    bool save_obj(const std::string& path) const;
+    // Picks the format from the extension (.ply or .obj).
+    bool save(const std::string& path) const;
+};
+
+}
+
+#endif
\ No newline at end of file
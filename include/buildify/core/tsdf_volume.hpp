@@ -0,0 +1,71 @@
+#ifndef BUILDIFY_CORE_TSDF_VOLUME_HPP
+#define BUILDIFY_CORE_TSDF_VOLUME_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "buildify/core/triangle_mesh.hpp"
+
+namespace buildify::core {
+
+class Camera;
+class Scene;
+
+// truncation is the distance behind and in front of the observed surface
+// that a depth sample updates; 0 uses four voxels. Depth beyond max_depth
+// (0: no limit) and pixels whose coverage is below min_alpha are ignored.
+struct TsdfSettings {
+    float voxel_size = 0.01f;
+    float truncation = 0.0f;
+    float max_depth = 0.0f;
+    float min_alpha = 0.5f;
+    // Voxels observed with less total weight are treated as unknown when
+    // meshing, which drops fragments seen by a single noisy sample.
+    float min_weight = 1.0f;
+};
+
+// Truncated signed distance field over a sparse set of 8^3 voxel blocks,
+// allocated on demand through a spatial hash. Depth maps are fused with a
+// running weighted average and the zero level set is meshed with marching
+// cubes. Both integration and extraction run over blocks in parallel.
+class TsdfVolume {
+public:
+    static constexpr std::uint32_t block_size = 8;
+
+    explicit TsdfVolume(const TsdfSettings& settings = {});
+    ~TsdfVolume();
+
+    TsdfVolume(TsdfVolume&&) noexcept;
+    TsdfVolume& operator=(TsdfVolume&&) noexcept;
+
+    const TsdfSettings& get_settings() const;
+
+    // Fuses a view-space depth map (width * height, 0 where empty) taken
+    // from `camera`. color (RGBA) and alpha are optional and, when given,
+    // sized like the image.
+    void integrate(const Camera& camera, std::uint32_t width, std::uint32_t height,
+                   std::span<const float> depth, std::span<const float> color = {},
+                   std::span<const float> alpha = {});
+
+    TriangleMesh extract_mesh() const;
+
+    std::size_t block_count() const;
+    std::size_t memory_footprint() const;
+    void clear();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// Renders color and median depth of the scene's Gaussians from every camera
+// at width x height, fuses them into a TSDF and meshes it.
+TriangleMesh extract_gaussian_mesh(const Scene& scene, std::span<const Camera> cameras,
+                                   std::uint32_t width, std::uint32_t height,
+                                   const TsdfSettings& settings = {});
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef BUILDIFY_UTILS_CONFIG_HPP
+#define BUILDIFY_UTILS_CONFIG_HPP
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace buildify::utils {
+
+// Flat key/value view of a JSON configuration file. Nested objects become
+// dotted keys ("render.sort_mode"); values are scalars (strings, numbers,
+// booleans), arrays are rejected. Lookups convert on demand and return
+// nullopt for missing keys or values of the wrong type.
+class Config {
+public:
+    bool load_file(const std::string& path);
+    // Merges `text` over the current values. On a syntax error nothing is
+    // changed and the error is logged with its line.
+    bool parse(std::string_view text);
+
+    // Overrides keys from the environment: BUILDIFY_RENDER__SORT_MODE=radix
+    // sets render.sort_mode. After the prefix, "__" separates levels and the
+    // name is lower-cased. Returns how many variables were applied.
+    std::size_t apply_environment(std::string_view prefix = "BUILDIFY_");
+
+    bool contains(const std::string& key) const { return values_.contains(key); }
+    std::vector<std::string> keys() const;
+
+    std::optional<std::string> get_string(const std::string& key) const;
+    std::optional<std::int64_t> get_int(const std::string& key) const;
+    std::optional<double> get_double(const std::string& key) const;
+    std::optional<bool> get_bool(const std::string& key) const;
+
+    void set(const std::string& key, const std::string& value);
+    void set(const std::string& key, const char* value) { set(key, std::string(value)); }
+    void set(const std::string& key, std::int64_t value);
+    void set(const std::string& key, double value);
+    void set(const std::string& key, bool value);
+
+    void clear() { values_.clear(); }
+    // Nested, indented JSON that parse() reads back to the same values.
+    std::string dump() const;
+
+private:
+    // Scalars keep their JSON text; strings are stored unescaped.
+    struct Value {
+        std::string text;
+        bool is_string = false;
+    };
+
+    std::map<std::string, Value> values_;
+};
+
+}
+
+#endif
\ No newline at end of file
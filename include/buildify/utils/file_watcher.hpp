@@ -0,0 +1,45 @@
+#ifndef BUILDIFY_UTILS_FILE_WATCHER_HPP
+#define BUILDIFY_UTILS_FILE_WATCHER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace buildify::utils {
+
+// Reports files that were rewritten, through inotify. The parent directory
+// is watched rather than the file, so exporters that write a temporary
+// file and rename it over the original are seen as well. A file counts as
+// changed once closed after writing or renamed into place, never while it
+// is still being written.
+//
+// poll() does not block and is meant to be called once per frame.
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Watching a file twice is harmless; false if its directory cannot be
+    // watched.
+    bool watch(const std::string& path);
+    void unwatch(const std::string& path);
+    bool is_watching(const std::string& path) const;
+
+    // Watched files changed since the last call, each once, as absolute
+    // normalized paths.
+    std::vector<std::string> poll();
+
+    // Absolute normalized form of `path`, as returned by poll().
+    static std::string normalize(const std::string& path);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef BUILDIFY_UTILS_HUGE_PAGES_HPP
+#define BUILDIFY_UTILS_HUGE_PAGES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace buildify::utils {
+
+inline constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+// How allocations of at least huge_page_size bytes are backed. Transparent
+// maps them 2 MB aligned and asks for transparent huge pages with madvise;
+// Explicit takes pages from the hugetlbfs pool (vm.nr_hugepages) and falls
+// back to Transparent when the pool is empty. Off asks the kernel not to
+// use huge pages, which is mostly useful for measuring their effect.
+enum class HugePageMode {
+    Off,
+    Transparent,
+    Explicit
+};
+
+void set_huge_page_mode(HugePageMode mode);
+HugePageMode get_huge_page_mode();
+
+// Bytes held by live large allocations; the explicit counts are totals
+// since startup, fallbacks being requests the hugetlbfs pool could not
+// serve.
+struct HugePageStats {
+    std::size_t mapped_bytes = 0;
+    std::size_t explicit_allocations = 0;
+    std::size_t explicit_fallbacks = 0;
+};
+
+HugePageStats get_huge_page_stats();
+
+// mmap-backed allocation following the current mode. Never returns null;
+// throws std::bad_alloc like operator new. `bytes` must be passed back
+// unchanged to deallocate_large.
+void* allocate_large(std::size_t bytes);
+void deallocate_large(void* data, std::size_t bytes);
+
+// Allocator for the big attribute columns and render arenas: small
+// requests go to operator new, large ones to allocate_large.
+template<typename T>
+struct HugePageAllocator {
+    using value_type = T;
+
+    HugePageAllocator() = default;
+    template<typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        const std::size_t bytes = count * sizeof(T);
+        if (bytes < huge_page_size) {
+            return std::allocator<T>().allocate(count);
+        }
+        return static_cast<T*>(allocate_large(bytes));
+    }
+
+    void deallocate(T* data, std::size_t count) {
+        const std::size_t bytes = count * sizeof(T);
+        if (bytes < huge_page_size) {
+            std::allocator<T>().deallocate(data, count);
+        } else {
+            deallocate_large(data, bytes);
+        }
+    }
+
+    template<typename U>
+    bool operator==(const HugePageAllocator<U>&) const noexcept { return true; }
+};
+
+template<typename T>
+using HugePageVector = std::vector<T, HugePageAllocator<T>>;
+
+// Counts data-TLB load misses of the calling thread through perf events.
+// start() fails where perf is unavailable (perf_event_paranoid, containers).
+class TlbMissCounter {
+public:
+    TlbMissCounter() = default;
+    ~TlbMissCounter();
+
+    TlbMissCounter(const TlbMissCounter&) = delete;
+    TlbMissCounter& operator=(const TlbMissCounter&) = delete;
+
+    bool start();
+    // Misses since start(), or nullopt when counting never started.
+    std::optional<std::uint64_t> stop();
+
+private:
+    int fd_ = -1;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include <numbers>
 #include <algorithm>
 #include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
 
 namespace buildify::utils {
 
@@ -180,6 +183,113 @@ struct Quaternion {
         );
     }
 
+    // Rotation of a proper rotation matrix (upper 3x3 of m), by Shepperd's
+    // method: the largest of the four diagonal combinations is the pivot.
+    static Quaternion from_matrix(const Matrix4<T>& m) {
+        const auto& r = m.m;
+        T trace = r[0][0] + r[1][1] + r[2][2];
+        Quaternion q;
+        if (trace > r[0][0] && trace > r[1][1] && trace > r[2][2]) {
+            T s = std::sqrt(trace + 1) * 2;
+            q = Quaternion((r[2][1] - r[1][2]) / s, (r[0][2] - r[2][0]) / s, (r[1][0] - r[0][1]) / s, s / 4);
+        } else if (r[0][0] >= r[1][1] && r[0][0] >= r[2][2]) {
+            T s = std::sqrt(1 + r[0][0] - r[1][1] - r[2][2]) * 2;
+            q = Quaternion(s / 4, (r[0][1] + r[1][0]) / s, (r[0][2] + r[2][0]) / s, (r[2][1] - r[1][2]) / s);
+        } else if (r[1][1] >= r[2][2]) {
+            T s = std::sqrt(1 + r[1][1] - r[0][0] - r[2][2]) * 2;
+            q = Quaternion((r[0][1] + r[1][0]) / s, s / 4, (r[1][2] + r[2][1]) / s, (r[0][2] - r[2][0]) / s);
+        } else {
+            T s = std::sqrt(1 + r[2][2] - r[0][0] - r[1][1]) * 2;
+            q = Quaternion((r[0][2] + r[2][0]) / s, (r[1][2] + r[2][1]) / s, s / 4, (r[1][0] - r[0][1]) / s);
+        }
+        return q.normalized();
+    }
+
+    // Hamilton product: the rotation `other` followed by this one.
+    Quaternion operator*(const Quaternion& other) const {
+        return Quaternion(
+            w * other.x + x * other.w + y * other.z - z * other.y,
+            w * other.y - x * other.z + y * other.w + z * other.x,
+            w * other.z + x * other.y - y * other.x + z * other.w,
+            w * other.w - x * other.x - y * other.y - z * other.z
+        );
+    }
+
+    T dot(const Quaternion& other) const {
+        return x * other.x + y * other.y + z * other.z + w * other.w;
+    }
+
+    T length() const {
+        return std::sqrt(dot(*this));
+    }
+
+    Quaternion normalized() const {
+        T len = length();
+        return len > 0 ? Quaternion(x / len, y / len, z / len, w / len) : Quaternion();
+    }
+
+    Quaternion conjugate() const {
+        return Quaternion(-x, -y, -z, w);
+    }
+
+    Quaternion inverse() const {
+        T len2 = dot(*this);
+        return len2 > 0 ? Quaternion(-x / len2, -y / len2, -z / len2, w / len2) : Quaternion();
+    }
+
+    Vector3<T> rotate(const Vector3<T>& v) const {
+        // v + 2 u x (u x v + w v), with u the vector part.
+        Vector3<T> u(x, y, z);
+        Vector3<T> t = u.cross(v) * T(2);
+        return v + t * w + u.cross(t);
+    }
+
+    // Logarithm of a unit quaternion, as a pure quaternion (w = 0).
+    Quaternion log() const {
+        T v = std::sqrt(x * x + y * y + z * z);
+        if (v <= std::numeric_limits<T>::epsilon()) {
+            return Quaternion(0, 0, 0, 0);
+        }
+        T scale = std::atan2(v, w) / v;
+        return Quaternion(x * scale, y * scale, z * scale, 0);
+    }
+
+    // Exponential of a pure quaternion, the inverse of log().
+    Quaternion exp() const {
+        T angle = std::sqrt(x * x + y * y + z * z);
+        if (angle <= std::numeric_limits<T>::epsilon()) {
+            return Quaternion(x, y, z, 1).normalized();
+        }
+        T scale = std::sin(angle) / angle;
+        return Quaternion(x * scale, y * scale, z * scale, std::cos(angle));
+    }
+
+    // Spherical interpolation of unit quaternions. With shortest_path the
+    // sign of b is chosen to take the shorter arc; SQUAD-style blends
+    // need the operands taken as given.
+    static Quaternion slerp(const Quaternion& a, const Quaternion& b, T t, bool shortest_path = true) {
+        T cosine = a.dot(b);
+        T sign = 1;
+        if (shortest_path && cosine < 0) {
+            cosine = -cosine;
+            sign = -1;
+        }
+        cosine = std::clamp<T>(cosine, -1, 1);
+        T wa = 1 - t;
+        T wb = t;
+        // Close rotations fall back to a normalized lerp, which is exact in
+        // the limit and avoids dividing by a vanishing sine.
+        if (1 - std::abs(cosine) > T(1e-4)) {
+            T angle = std::acos(cosine);
+            T inverse_sine = 1 / std::sin(angle);
+            wa = std::sin(wa * angle) * inverse_sine;
+            wb = std::sin(wb * angle) * inverse_sine;
+        }
+        wb *= sign;
+        return Quaternion(wa * a.x + wb * b.x, wa * a.y + wb * b.y,
+                          wa * a.z + wb * b.z, wa * a.w + wb * b.w).normalized();
+    }
+
     Matrix4<T> to_matrix() const {
         Matrix4<T> result;
         
@@ -221,6 +331,26 @@ struct Transform {
     }
 };
 
+// Batch kernels over quaternions stored as separate x, y, z and w columns,
+// the layout of the Gaussian rotation attributes. Each is a straight loop
+// the compiler vectorizes; callers split large columns across threads.
+template<typename T>
+struct QuaternionColumns {
+    std::span<T> x, y, z, w;
+
+    std::size_t size() const { return x.size(); }
+};
+
+// Zero quaternions become the identity.
+void normalize_quaternions(QuaternionColumns<float> q);
+// out = a * b per element; out may alias a or b.
+void multiply_quaternions(QuaternionColumns<const float> a, QuaternionColumns<const float> b,
+                          QuaternionColumns<float> out);
+// Rotation matrices of the normalized quaternions into nine columns of
+// q.size() floats each, element (r, c) in column 3 * r + c. Zero
+// quaternions give zero matrices.
+void quaternions_to_matrices(QuaternionColumns<const float> q, std::span<float> matrices);
+
 // Type aliases for common types
 using Vector3f = Vector3<float>;
 using Vector4f = Vector4<float>;
@@ -0,0 +1,66 @@
+#ifndef BUILDIFY_UTILS_NUMA_HPP
+#define BUILDIFY_UTILS_NUMA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace buildify::utils {
+
+struct NumaNode {
+    std::uint32_t id = 0;
+    // CPUs of the node this process may run on.
+    std::vector<std::uint32_t> cpus;
+};
+
+// Memory nodes and their CPUs, read from sysfs. Nodes without usable CPUs
+// are left out; a machine without NUMA information is one node holding
+// every allowed CPU, so callers need no special case.
+class NumaTopology {
+public:
+    static const NumaTopology& system();
+    // Reads <root>/node*/cpulist, keeping only CPUs in `allowed` when it is
+    // non-empty.
+    static NumaTopology from_sysfs(const std::string& root, std::span<const std::uint32_t> allowed = {});
+
+    std::span<const NumaNode> nodes() const { return nodes_; }
+    std::size_t node_count() const { return nodes_.size(); }
+    bool is_numa() const { return nodes_.size() > 1; }
+    // Index into nodes() of the node owning `cpu`, 0 when unknown.
+    std::size_t node_of_cpu(std::uint32_t cpu) const;
+
+private:
+    std::vector<NumaNode> nodes_;
+};
+
+// Index into NumaTopology::system().nodes() of the CPU the caller runs on.
+std::size_t current_numa_node();
+
+// How a large buffer's pages are spread over the nodes. Interleave deals
+// pages round-robin, for data every node reads at random. Partitioned
+// splits the buffer into one contiguous part per node, sized by `weights`
+// (equal parts when empty), and binds part k to node k: the layout
+// first-touch by each node's threads would give, matching
+// ThreadPool::parallel_for_partitioned over the same range.
+enum class MemoryPlacement {
+    Default,
+    Interleave,
+    Partitioned
+};
+
+// Applies the placement to the whole pages inside [data, data + bytes),
+// migrating pages already touched. A no-op returning true on single-node
+// machines and for Default; false when the kernel refuses the policy.
+bool place_memory(void* data, std::size_t bytes, MemoryPlacement placement,
+                  std::span<const std::size_t> weights = {});
+
+// Start of part `part` when [0, count) is split into weights.size() parts
+// proportional to the weights, the split used for partitioned loops and
+// memory.
+std::size_t partition_begin(std::size_t count, std::size_t part, std::span<const std::size_t> weights);
+
+}
+
+#endif
\ No newline at end of file
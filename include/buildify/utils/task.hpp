@@ -0,0 +1,330 @@
+#ifndef BUILDIFY_UTILS_TASK_HPP
+#define BUILDIFY_UTILS_TASK_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "buildify/utils/thread_pool.hpp"
+
+namespace buildify::utils {
+
+// Fraction of an operation done, in [0, 1]. Called from whichever thread
+// runs the operation.
+using ProgressCallback = std::function<void(float)>;
+
+// Cancellation is cooperative: operations poll the token between chunks of
+// work and give up with their usual failure result. A default token is
+// never cancelled.
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    bool is_cancelled() const { return state_ && state_->load(std::memory_order_relaxed); }
+
+private:
+    friend class CancellationSource;
+    explicit CancellationToken(std::shared_ptr<std::atomic<bool>> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<std::atomic<bool>> state_;
+};
+
+class CancellationSource {
+public:
+    CancellationSource() : state_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() { state_->store(true, std::memory_order_relaxed); }
+    bool is_cancelled() const { return state_->load(std::memory_order_relaxed); }
+    CancellationToken token() const { return CancellationToken(state_); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> state_;
+};
+
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+struct TaskPromiseBase {
+    // Finishing resumes whoever awaited the task, by symmetric transfer so
+    // long chains of awaits do not grow the stack.
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            return handle.promise().continuation;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() { exception = std::current_exception(); }
+
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr exception;
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+    Task<T> get_return_object();
+
+    template<typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T take() {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*value);
+    }
+
+    std::optional<T> value;
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+    void return_void() const noexcept {}
+
+    void take() {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+// Eagerly started, self-destroying coroutine that drives a Task to the end.
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+}
+
+// Lazily started coroutine producing a T. Nothing runs until the task is
+// awaited (or handed to start() or sync_wait()); the awaiting coroutine is
+// resumed on the thread that finishes the task.
+template<typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task() = default;
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    bool valid() const { return static_cast<bool>(handle_); }
+
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() { return handle.promise().take(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+}
+
+// `co_await schedule_on(pool)` continues the coroutine on one of the pool's
+// workers, or right away when the pool has none.
+inline auto schedule_on(ThreadPool& pool) {
+    struct Awaiter {
+        ThreadPool& pool;
+
+        bool await_ready() const noexcept { return pool.size() == 0; }
+        void await_suspend(std::coroutine_handle<> handle) { pool.post([handle]() { handle.resume(); }); }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{pool};
+}
+
+namespace detail {
+
+template<typename T, typename F>
+DetachedTask run_detached(Task<T> task, F on_done) {
+    std::exception_ptr error;
+    if constexpr (std::is_void_v<T>) {
+        try {
+            co_await task;
+        } catch (...) {
+            error = std::current_exception();
+        }
+        on_done(error);
+    } else {
+        std::optional<T> value;
+        try {
+            value.emplace(co_await task);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        on_done(error, std::move(value));
+    }
+}
+
+}
+
+// Runs the task without waiting for it; on_done is called on the thread
+// that finishes it with the exception the task threw, null on success,
+// and for a Task<T> an optional holding the result unless it threw. An
+// exception escaping on_done itself terminates.
+template<typename T, typename F>
+void start(Task<T> task, F on_done) {
+    detail::run_detached(std::move(task), std::move(on_done));
+}
+
+// Blocks the calling thread until the task is done and rethrows anything
+// the task threw.
+template<typename T>
+T sync_wait(Task<T> task) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool done = false;
+    std::exception_ptr error;
+    // Notifying under the lock keeps the waiter from returning, and these
+    // locals from going away, before the notifying thread is finished.
+    auto finish = [&](std::exception_ptr thrown) {
+        std::lock_guard lock(mutex);
+        error = std::move(thrown);
+        done = true;
+        condition.notify_one();
+    };
+
+    if constexpr (std::is_void_v<T>) {
+        start(std::move(task), finish);
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [&]() { return done; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    } else {
+        std::optional<T> result;
+        start(std::move(task), [&](std::exception_ptr thrown, std::optional<T> value) {
+            result = std::move(value);
+            finish(std::move(thrown));
+        });
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [&]() { return done; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*result);
+    }
+}
+
+// Awaits every task concurrently: all are started before the first one is
+// waited for, and the results come back in the order of `tasks`. If any
+// task throws, the first exception is rethrown once all have finished.
+template<typename T>
+Task<std::vector<T>> when_all(std::vector<Task<T>> tasks) {
+    // Lives in this frame: children touch it only before their final
+    // decrement, and the parent cannot finish until the last one.
+    struct State {
+        std::atomic<std::size_t> remaining;
+        std::vector<std::optional<T>> results;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+    State state;
+    state.results.resize(tasks.size());
+
+    struct Awaiter {
+        std::vector<Task<T>>& tasks;
+        State& state;
+
+        bool await_ready() const noexcept { return tasks.empty(); }
+        // One extra count for this call, so children finishing while it is
+        // still starting the others cannot resume the parent early.
+        bool await_suspend(std::coroutine_handle<> parent) {
+            state.remaining.store(tasks.size() + 1, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < tasks.size(); ++i) {
+                start(std::move(tasks[i]), [state = &state, parent, i](std::exception_ptr error,
+                                                                     std::optional<T> value) {
+                    if (error) {
+                        std::lock_guard lock(state->error_mutex);
+                        if (!state->error) {
+                            state->error = std::move(error);
+                        }
+                    }
+                    state->results[i] = std::move(value);
+                    if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        parent.resume();
+                    }
+                });
+            }
+            return state.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+        }
+        void await_resume() const noexcept {}
+    };
+    co_await Awaiter{tasks, state};
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+
+    std::vector<T> results;
+    results.reserve(state.results.size());
+    for (auto& result : state.results) {
+        results.push_back(std::move(*result));
+    }
+    co_return results;
+}
+
+}
+
+#endif
\ No newline at end of file
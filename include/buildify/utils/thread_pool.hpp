@@ -0,0 +1,103 @@
+#ifndef BUILDIFY_UTILS_THREAD_POOL_HPP
+#define BUILDIFY_UTILS_THREAD_POOL_HPP
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace buildify::utils {
+
+class ThreadPool {
+public:
+    static ThreadPool& instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // Workers for blocking file I/O, kept apart from instance() so reads
+    // and writes never occupy the compute threads.
+    static ThreadPool& io_instance() {
+        static ThreadPool pool(io_threads + 1);
+        return pool;
+    }
+    static constexpr std::size_t io_threads = 4;
+
+    explicit ThreadPool(std::size_t thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return workers_.size(); }
+    bool is_pinned() const { return pinned_; }
+    // Threads (caller included) per NUMA node, in NumaTopology order. A
+    // single entry unless the pool is pinned on a multi-node machine.
+    std::span<const std::size_t> node_weights() const { return node_threads_; }
+
+    // Restarts the workers with a new count (0 = hardware concurrency),
+    // optionally pinning each to its own CPU. On NUMA machines pinned
+    // threads are spread over the nodes in proportion to their CPUs.
+    // Only for startup: fails, keeping the current workers, once any task
+    // has been submitted, since other threads may still be using the pool.
+    bool resize(std::size_t thread_count, bool pin = false);
+
+    // Runs the task on a worker without a future to wait on; inline when
+    // the pool has no workers.
+    void post(std::function<void()> task) { enqueue(std::move(task)); }
+
+    template<typename F>
+        requires std::invocable<F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<F>> {
+        using Result = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        auto future = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    // Splits [begin, end) into chunks of at most `grain` indices and runs
+    // body(chunk_begin, chunk_end) on the workers. The calling thread takes
+    // part in the loop, so nested calls from inside a worker cannot deadlock.
+    void parallel_for(std::size_t begin, std::size_t end,
+                      const std::function<void(std::size_t, std::size_t)>& body,
+                      std::size_t grain = 1);
+
+    // parallel_for that splits [begin, end) into one contiguous part per
+    // node, sized by node_weights(). Threads take chunks from their own
+    // node's part first and only then help with the others, so data placed
+    // with MemoryPlacement::Partitioned over the same range is mostly read
+    // locally. Same as parallel_for when node_weights() has one entry.
+    void parallel_for_partitioned(std::size_t begin, std::size_t end,
+                                  const std::function<void(std::size_t, std::size_t)>& body,
+                                  std::size_t grain = 1);
+
+private:
+    void start(std::size_t thread_count, bool pin);
+    void stop();
+    void enqueue(std::function<void()> task);
+    void worker_loop(std::size_t node);
+    void run_parts(std::size_t begin, std::size_t end,
+                   const std::function<void(std::size_t, std::size_t)>& body,
+                   std::size_t grain, std::span<const std::size_t> weights);
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_ = false;
+    bool pinned_ = false;
+    // Set by the first task handed to the workers; resize() refuses after.
+    bool used_ = false;
+    std::vector<std::size_t> node_threads_;
+};
+
+}
+
+#endif
\ No newline at end of file
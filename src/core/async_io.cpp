@@ -0,0 +1,71 @@
+#include "buildify/core/async_io.hpp"
+#include "buildify/core/gaussian_bvh.hpp"
+#include "buildify/core/gaussian_io.hpp"
+#include "buildify/core/gaussians.hpp"
+#include "buildify/core/scene.hpp"
+#include "buildify/core/triangle_mesh.hpp"
+
+namespace buildify::core {
+
+namespace {
+
+// Share of load_scene_async's progress taken by reading the file; the BVH
+// build covers the rest.
+constexpr float scene_read_share = 0.8f;
+
+}
+
+utils::Task<std::shared_ptr<GaussianCloud>> load_gaussians_async(std::string path, utils::CancellationToken cancel,
+                                                                 utils::ProgressCallback progress) {
+    co_await utils::schedule_on(utils::ThreadPool::io_instance());
+    auto cloud = std::make_shared<GaussianCloud>();
+    if (!load_gaussians(path, *cloud, progress, cancel)) {
+        co_return nullptr;
+    }
+    co_return cloud;
+}
+
+utils::Task<bool> save_gaussians_async(std::string path, std::shared_ptr<const GaussianCloud> cloud,
+                                       utils::CancellationToken cancel, utils::ProgressCallback progress) {
+    co_await utils::schedule_on(utils::ThreadPool::io_instance());
+    co_return save_gaussians(path, *cloud, progress, cancel);
+}
+
+utils::Task<std::shared_ptr<Scene>> load_scene_async(std::string name, std::string path,
+                                                     utils::CancellationToken cancel,
+                                                     utils::ProgressCallback progress) {
+    utils::ProgressCallback read_progress;
+    if (progress) {
+        read_progress = [&progress](float done) { progress(done * scene_read_share); };
+    }
+    auto cloud = co_await load_gaussians_async(path, cancel, read_progress);
+    if (!cloud || cancel.is_cancelled()) {
+        co_return nullptr;
+    }
+
+    co_await utils::schedule_on(utils::ThreadPool::instance());
+    auto scene = std::make_shared<Scene>(name);
+    scene->get_gaussians() = std::move(*cloud);
+    scene->get_gaussian_bvh();
+    if (progress) {
+        progress(1.0f);
+    }
+    co_return scene;
+}
+
+utils::Task<bool> save_scene_async(std::string path, std::shared_ptr<const Scene> scene,
+                                   utils::CancellationToken cancel, utils::ProgressCallback progress) {
+    co_await utils::schedule_on(utils::ThreadPool::io_instance());
+    co_return save_gaussians(path, scene->get_gaussians(), progress, cancel);
+}
+
+utils::Task<bool> save_mesh_async(std::string path, std::shared_ptr<const TriangleMesh> mesh,
+                                  utils::CancellationToken cancel) {
+    co_await utils::schedule_on(utils::ThreadPool::io_instance());
+    if (cancel.is_cancelled()) {
+        co_return false;
+    }
+    co_return mesh->save(path);
+}
+
+}
\ No newline at end of file
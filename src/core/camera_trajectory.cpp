@@ -0,0 +1,251 @@
+#include "buildify/core/camera_trajectory.hpp"
+#include "buildify/core/scene.hpp"
+#include "buildify/utils/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace buildify::core {
+
+namespace {
+
+constexpr std::size_t evaluate_grain = 512;
+using Quat = utils::Quaternionf;
+
+// Inner SQUAD control point at q given its neighbours.
+Quat squad_control(const Quat& previous, const Quat& q, const Quat& next) {
+    Quat inverse = q.conjugate();
+    Quat a = (inverse * next).log();
+    Quat b = (inverse * previous).log();
+    return (q * Quat(-(a.x + b.x) * 0.25f, -(a.y + b.y) * 0.25f, -(a.z + b.z) * 0.25f, 0.0f).exp()).normalized();
+}
+
+}
+
+CameraTrajectory::CameraTrajectory(TrajectoryInterpolation interpolation) : interpolation_(interpolation) {}
+
+void CameraTrajectory::add_keyframe(double time, const utils::Vector3f& position, const utils::Quaternionf& rotation) {
+    auto it = std::lower_bound(keyframes_.begin(), keyframes_.end(), time,
+                               [](const CameraKeyframe& keyframe, double t) { return keyframe.time < t; });
+    CameraKeyframe keyframe{time, position, rotation.normalized()};
+    if (it != keyframes_.end() && it->time == time) {
+        *it = keyframe;
+    } else {
+        keyframes_.insert(it, keyframe);
+    }
+    rebuild();
+}
+
+void CameraTrajectory::add_keyframe(double time, const Camera& camera) {
+    const auto& transform = camera.get_transform();
+    add_keyframe(time, transform.position, transform.rotation);
+}
+
+void CameraTrajectory::set_keyframes(std::vector<CameraKeyframe> keyframes) {
+    std::stable_sort(keyframes.begin(), keyframes.end(),
+                     [](const CameraKeyframe& a, const CameraKeyframe& b) { return a.time < b.time; });
+    // Later duplicates win, as with add_keyframe.
+    keyframes_.clear();
+    for (auto& keyframe : keyframes) {
+        keyframe.rotation = keyframe.rotation.normalized();
+        if (!keyframes_.empty() && keyframes_.back().time == keyframe.time) {
+            keyframes_.back() = keyframe;
+        } else {
+            keyframes_.push_back(keyframe);
+        }
+    }
+    rebuild();
+}
+
+void CameraTrajectory::clear() {
+    keyframes_.clear();
+    segments_.clear();
+}
+
+double CameraTrajectory::get_start_time() const {
+    return keyframes_.empty() ? 0.0 : keyframes_.front().time;
+}
+
+double CameraTrajectory::get_end_time() const {
+    return keyframes_.empty() ? 0.0 : keyframes_.back().time;
+}
+
+void CameraTrajectory::set_interpolation(TrajectoryInterpolation interpolation) {
+    interpolation_ = interpolation;
+    rebuild();
+}
+
+void CameraTrajectory::rebuild() {
+    segments_.clear();
+    const std::size_t n = keyframes_.size();
+    if (n < 2) {
+        return;
+    }
+
+    // Neighbouring rotations on the same hemisphere, so every segment
+    // takes the short way round.
+    std::vector<Quat> rotations(n);
+    rotations[0] = keyframes_[0].rotation;
+    for (std::size_t i = 1; i < n; ++i) {
+        const Quat& q = keyframes_[i].rotation;
+        rotations[i] = rotations[i - 1].dot(q) < 0.0f ? Quat(-q.x, -q.y, -q.z, -q.w) : q;
+    }
+
+    // Position tangents (per unit time) at every keyframe.
+    std::vector<utils::Vector3f> tangents(n);
+    auto chord = [&](std::size_t i) {
+        auto delta = keyframes_[i + 1].position - keyframes_[i].position;
+        return delta * static_cast<float>(1.0 / (keyframes_[i + 1].time - keyframes_[i].time));
+    };
+    if (interpolation_ == TrajectoryInterpolation::CatmullRom) {
+        tangents[0] = chord(0);
+        tangents[n - 1] = chord(n - 2);
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            auto delta = keyframes_[i + 1].position - keyframes_[i - 1].position;
+            tangents[i] = delta * static_cast<float>(1.0 / (keyframes_[i + 1].time - keyframes_[i - 1].time));
+        }
+    } else if (interpolation_ == TrajectoryInterpolation::CubicSpline) {
+        // Natural spline: second derivatives m from the tridiagonal system
+        // h[i-1] m[i-1] + 2 (h[i-1] + h[i]) m[i] + h[i] m[i+1] = 6 (chord[i] - chord[i-1]),
+        // with m zero at both ends, solved by the Thomas algorithm.
+        std::vector<double> h(n - 1);
+        std::vector<utils::Vector3f> chords(n - 1);
+        for (std::size_t i = 0; i + 1 < n; ++i) {
+            h[i] = keyframes_[i + 1].time - keyframes_[i].time;
+            chords[i] = chord(i);
+        }
+        std::vector<utils::Vector3f> second(n);
+        std::vector<double> upper(n, 0.0);
+        std::vector<utils::Vector3f> rhs(n);
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            double diagonal = 2.0 * (h[i - 1] + h[i]) - h[i - 1] * upper[i - 1];
+            upper[i] = h[i] / diagonal;
+            auto r = (chords[i] - chords[i - 1]) * 6.0f - rhs[i - 1] * static_cast<float>(h[i - 1]);
+            rhs[i] = r * static_cast<float>(1.0 / diagonal);
+        }
+        for (std::size_t i = n - 2; i >= 1; --i) {
+            second[i] = rhs[i] - second[i + 1] * static_cast<float>(upper[i]);
+        }
+        for (std::size_t i = 0; i + 1 < n; ++i) {
+            tangents[i] = chords[i] - (second[i] * 2.0f + second[i + 1]) * static_cast<float>(h[i] / 6.0);
+        }
+        tangents[n - 1] = chords[n - 2] + (second[n - 2] + second[n - 1] * 2.0f) * static_cast<float>(h[n - 2] / 6.0);
+    }
+
+    std::vector<Quat> controls(rotations);
+    if (interpolation_ != TrajectoryInterpolation::Linear) {
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            controls[i] = squad_control(rotations[i - 1], rotations[i], rotations[i + 1]);
+        }
+    }
+
+    segments_.resize(n - 1);
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        Segment& segment = segments_[i];
+        const double duration = keyframes_[i + 1].time - keyframes_[i].time;
+        const auto& p0 = keyframes_[i].position;
+        const auto& p1 = keyframes_[i + 1].position;
+        segment.start = keyframes_[i].time;
+        segment.inverse_duration = 1.0 / duration;
+        segment.a = p0;
+        if (interpolation_ == TrajectoryInterpolation::Linear) {
+            segment.b = p1 - p0;
+            segment.c = {};
+            segment.d = {};
+        } else {
+            // Cubic Hermite with tangents scaled to the unit parameter.
+            auto m0 = tangents[i] * static_cast<float>(duration);
+            auto m1 = tangents[i + 1] * static_cast<float>(duration);
+            segment.b = m0;
+            segment.c = (p1 - p0) * 3.0f - m0 * 2.0f - m1;
+            segment.d = (p0 - p1) * 2.0f + m0 + m1;
+        }
+        segment.q0 = rotations[i];
+        segment.q1 = rotations[i + 1];
+        segment.s0 = controls[i];
+        segment.s1 = controls[i + 1];
+    }
+}
+
+double CameraTrajectory::wrap(double time) const {
+    const double start = get_start_time();
+    const double duration = get_duration();
+    if (looping_ && duration > 0.0) {
+        double offset = std::fmod(time - start, duration);
+        return start + (offset < 0.0 ? offset + duration : offset);
+    }
+    return std::clamp(time, start, get_end_time());
+}
+
+std::size_t CameraTrajectory::find_segment(double time, std::size_t hint) const {
+    if (hint < segments_.size() && segments_[hint].start <= time) {
+        while (hint + 1 < segments_.size() && segments_[hint + 1].start <= time) {
+            ++hint;
+        }
+        return hint;
+    }
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), time,
+                               [](double t, const Segment& segment) { return t < segment.start; });
+    return it == segments_.begin() ? 0 : static_cast<std::size_t>(it - segments_.begin()) - 1;
+}
+
+void CameraTrajectory::evaluate_segment(const Segment& segment, double time, utils::Vector3f& position,
+                                        utils::Quaternionf& rotation) const {
+    const auto u = static_cast<float>(std::clamp((time - segment.start) * segment.inverse_duration, 0.0, 1.0));
+    position = segment.a + (segment.b + (segment.c + segment.d * u) * u) * u;
+    if (interpolation_ == TrajectoryInterpolation::Linear) {
+        rotation = Quat::slerp(segment.q0, segment.q1, u, false);
+    } else {
+        Quat outer = Quat::slerp(segment.q0, segment.q1, u, false);
+        Quat inner = Quat::slerp(segment.s0, segment.s1, u, false);
+        rotation = Quat::slerp(outer, inner, 2.0f * u * (1.0f - u), false);
+    }
+}
+
+utils::Transform CameraTrajectory::evaluate(double time) const {
+    utils::Transform transform;
+    if (keyframes_.size() == 1) {
+        transform.position = keyframes_[0].position;
+        transform.rotation = keyframes_[0].rotation;
+    } else if (!segments_.empty()) {
+        double t = wrap(time);
+        evaluate_segment(segments_[find_segment(t, 0)], t, transform.position, transform.rotation);
+    }
+    return transform;
+}
+
+void CameraTrajectory::evaluate(std::span<const double> times, std::span<utils::Vector3f> positions,
+                                std::span<utils::Quaternionf> rotations) const {
+    if (segments_.empty()) {
+        const CameraKeyframe keyframe = keyframes_.empty() ? CameraKeyframe{} : keyframes_[0];
+        std::fill_n(positions.begin(), times.size(), keyframe.position);
+        std::fill_n(rotations.begin(), times.size(), keyframe.rotation);
+        return;
+    }
+
+    utils::ThreadPool::instance().parallel_for(0, times.size(), [&](std::size_t begin, std::size_t end) {
+        std::size_t segment = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            double t = wrap(times[i]);
+            segment = find_segment(t, segment);
+            evaluate_segment(segments_[segment], t, positions[i], rotations[i]);
+        }
+    }, evaluate_grain);
+}
+
+std::vector<Camera> CameraTrajectory::sample_cameras(const Camera& prototype, std::span<const double> times) const {
+    std::vector<utils::Vector3f> positions(times.size());
+    std::vector<utils::Quaternionf> rotations(times.size());
+    evaluate(times, positions, rotations);
+
+    std::vector<Camera> cameras(times.size(), prototype);
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        auto transform = cameras[i].get_transform();
+        transform.position = positions[i];
+        transform.rotation = rotations[i];
+        cameras[i].set_transform(transform);
+    }
+    return cameras;
+}
+
+}
\ No newline at end of file
@@ -1,18 +1,268 @@
 #include "buildify/core/engine.hpp"
 #include "buildify/core/scene.hpp"
+#include "buildify/core/gaussians.hpp"
+#include "buildify/core/gaussian_io.hpp"
 #include "buildify/core/renderer.hpp"
+#include "buildify/core/tile_renderer.hpp"
+#include "buildify/utils/file_watcher.hpp"
 #include "buildify/utils/logger.hpp"
+#include "buildify/utils/thread_pool.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 #include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 namespace buildify::core {
 
+namespace {
+
+constexpr std::array<std::pair<const char*, utils::LogLevel>, 6> log_levels = {{
+    {"trace", utils::LogLevel::Trace},
+    {"debug", utils::LogLevel::Debug},
+    {"info", utils::LogLevel::Info},
+    {"warning", utils::LogLevel::Warning},
+    {"error", utils::LogLevel::Error},
+    {"critical", utils::LogLevel::Critical},
+}};
+
+constexpr std::array<std::pair<const char*, TileSortMode>, 3> sort_modes = {{
+    {"auto", TileSortMode::Auto},
+    {"comparison", TileSortMode::Comparison},
+    {"radix", TileSortMode::Radix},
+}};
+
+constexpr std::array<std::pair<const char*, utils::MemoryPlacement>, 3> memory_placements = {{
+    {"default", utils::MemoryPlacement::Default},
+    {"interleave", utils::MemoryPlacement::Interleave},
+    {"partitioned", utils::MemoryPlacement::Partitioned},
+}};
+
+constexpr std::array<std::pair<const char*, utils::HugePageMode>, 3> huge_page_modes = {{
+    {"off", utils::HugePageMode::Off},
+    {"transparent", utils::HugePageMode::Transparent},
+    {"explicit", utils::HugePageMode::Explicit},
+}};
+
+constexpr std::array known_keys = {
+    "threads.count", "threads.pin", "memory.placement", "memory.huge_pages", "memory.scene_budget_mb",
+    "memory.spill_directory", "scene.hot_reload", "log.level", "render.sort_mode", "render.frame_budget_us",
+    "render.temporal_cache.enabled", "render.temporal_cache.max_pixel_motion",
+    "render.temporal_cache.max_splat_change", "render.temporal_cache.max_reuse_frames",
+};
+
+// The percentile sorts the window, so run() refreshes it only every few
+// frames; the other window figures are kept current every frame.
+constexpr std::uint64_t percentile_interval = 16;
+
+double p99_frame_ms(const std::vector<double>& frame_times, std::size_t window) {
+    std::vector<double> recent(frame_times.begin(), frame_times.begin() + window);
+    auto p99 = recent.begin() + std::min(window - 1, static_cast<std::size_t>(std::ceil(0.99 * window)) - 1);
+    std::nth_element(recent.begin(), p99, recent.end());
+    return *p99;
+}
+
+template<typename T, std::size_t N>
+bool lookup(const std::array<std::pair<const char*, T>, N>& table, const std::string& name, T& value) {
+    for (const auto& [entry, entry_value] : table) {
+        if (name == entry) {
+            value = entry_value;
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T, std::size_t N>
+const char* name_of(const std::array<std::pair<const char*, T>, N>& table, T value) {
+    for (const auto& [entry, entry_value] : table) {
+        if (entry_value == value) {
+            return entry;
+        }
+    }
+    return table[0].first;
+}
+
+}
+
+EngineConfig EngineConfig::from_config(const utils::Config& config) {
+    EngineConfig result;
+    auto invalid = [](const std::string& key) {
+        utils::log_warning("Ignoring invalid value for config key {}", key);
+    };
+    auto read_count = [&](const char* key, auto& target) {
+        if (!config.contains(key)) {
+            return;
+        }
+        auto value = config.get_int(key);
+        if (value && *value >= 0) {
+            target = static_cast<std::remove_reference_t<decltype(target)>>(*value);
+        } else {
+            invalid(key);
+        }
+    };
+    auto read_bool = [&](const char* key, bool& target) {
+        if (!config.contains(key)) {
+            return;
+        }
+        if (auto value = config.get_bool(key)) {
+            target = *value;
+        } else {
+            invalid(key);
+        }
+    };
+    auto read_fraction = [&](const char* key, float& target) {
+        if (!config.contains(key)) {
+            return;
+        }
+        auto value = config.get_double(key);
+        if (value && *value >= 0.0) {
+            target = static_cast<float>(*value);
+        } else {
+            invalid(key);
+        }
+    };
+
+    for (const auto& key : config.keys()) {
+        if (std::find_if(known_keys.begin(), known_keys.end(), [&](const char* known) { return key == known; }) ==
+            known_keys.end()) {
+            utils::log_warning("Unknown config key: {}", key);
+        }
+    }
+
+    read_count("threads.count", result.worker_threads);
+    read_bool("threads.pin", result.pin_threads);
+    if (config.contains("memory.placement") &&
+        !lookup(memory_placements, config.get_string("memory.placement").value_or(""), result.memory_placement)) {
+        invalid("memory.placement");
+    }
+    if (config.contains("memory.huge_pages") &&
+        !lookup(huge_page_modes, config.get_string("memory.huge_pages").value_or(""), result.huge_pages)) {
+        invalid("memory.huge_pages");
+    }
+    std::size_t budget_mb = result.scene_memory_budget >> 20;
+    read_count("memory.scene_budget_mb", budget_mb);
+    result.scene_memory_budget = budget_mb << 20;
+    if (config.contains("memory.spill_directory")) {
+        if (auto value = config.get_string("memory.spill_directory")) {
+            result.spill_directory = *value;
+        } else {
+            invalid("memory.spill_directory");
+        }
+    }
+    read_bool("scene.hot_reload", result.hot_reload_scenes);
+    if (config.contains("log.level") && !lookup(log_levels, config.get_string("log.level").value_or(""),
+                                                result.log_level)) {
+        invalid("log.level");
+    }
+    if (config.contains("render.sort_mode") &&
+        !lookup(sort_modes, config.get_string("render.sort_mode").value_or(""), result.sort_mode)) {
+        invalid("render.sort_mode");
+    }
+    std::size_t budget_us = 0;
+    read_count("render.frame_budget_us", budget_us);
+    result.frame_budget = std::chrono::microseconds(budget_us);
+    read_bool("render.temporal_cache.enabled", result.temporal_cache.enabled);
+    read_fraction("render.temporal_cache.max_pixel_motion", result.temporal_cache.max_pixel_motion);
+    read_fraction("render.temporal_cache.max_splat_change", result.temporal_cache.max_splat_change);
+    read_count("render.temporal_cache.max_reuse_frames", result.temporal_cache.max_reuse_frames);
+    return result;
+}
+
+utils::Config EngineConfig::to_config() const {
+    utils::Config config;
+    config.set("threads.count", static_cast<std::int64_t>(worker_threads));
+    config.set("threads.pin", pin_threads);
+    config.set("memory.placement", name_of(memory_placements, memory_placement));
+    config.set("memory.huge_pages", name_of(huge_page_modes, huge_pages));
+    config.set("memory.scene_budget_mb", static_cast<std::int64_t>(scene_memory_budget >> 20));
+    config.set("memory.spill_directory", spill_directory);
+    config.set("scene.hot_reload", hot_reload_scenes);
+    config.set("log.level", name_of(log_levels, log_level));
+    config.set("render.sort_mode", name_of(sort_modes, sort_mode));
+    config.set("render.frame_budget_us", static_cast<std::int64_t>(frame_budget.count()));
+    config.set("render.temporal_cache.enabled", temporal_cache.enabled);
+    config.set("render.temporal_cache.max_pixel_motion", static_cast<double>(temporal_cache.max_pixel_motion));
+    config.set("render.temporal_cache.max_splat_change", static_cast<double>(temporal_cache.max_splat_change));
+    config.set("render.temporal_cache.max_reuse_frames", static_cast<std::int64_t>(temporal_cache.max_reuse_frames));
+    return config;
+}
+
 struct Engine::Impl {
-    std::unordered_map<std::string, std::shared_ptr<Scene>> scenes;
+    SceneResidency scenes;
     std::shared_ptr<Scene> active_scene;
     std::unique_ptr<Renderer> renderer;
-    std::chrono::steady_clock::time_point last_update_time;
+    std::atomic<bool> running{false};
+    // Written by run() under the mutex so other threads can read it.
+    mutable std::mutex timing_mutex;
+    FrameTimingStats timing;
+    std::vector<double> frame_times;
+    double interpolation_alpha = 0.0;
+    std::chrono::microseconds frame_budget{0};
+    bool frame_converged = true;
+    EngineConfig config;
+    bool configured = false;
+    utils::FileWatcher watcher;
+    std::unordered_set<std::string> watched_paths;
+    // Set while run() drives update(); it checks for changed scene files
+    // once per frame instead of on every catch-up step.
+    bool stepping = false;
+
+    // Applies rewritten source files of scenes loaded with
+    // Scene::load_from_file, chunks that changed only.
+    void reload_changed_scenes() {
+        if (!config.hot_reload_scenes) {
+            return;
+        }
+        const auto all = scenes.get_scenes();
+        for (const auto& scene : all) {
+            const auto& path = scene->get_source_path();
+            if (!path.empty() && !watched_paths.contains(path) && watcher.watch(path)) {
+                watched_paths.insert(path);
+            }
+        }
+        const auto changed = watcher.poll();
+        if (changed.empty()) {
+            return;
+        }
+
+        for (const auto& scene : all) {
+            const auto& path = scene->get_source_path();
+            if (path.empty() ||
+                std::find(changed.begin(), changed.end(), utils::FileWatcher::normalize(path)) == changed.end()) {
+                continue;
+            }
+            // An evicted scene is not worth reading back just to diff it:
+            // its stale spill file goes and the next use loads the new one.
+            if (scenes.refresh_evicted(scene->get_name(), path)) {
+                utils::log_info("Scene '{}' changed on disk while evicted", scene->get_name());
+                continue;
+            }
+            GaussianReloadStats stats;
+            if (scene->reload_from_file(stats)) {
+                utils::log_info("Reloaded scene '{}': {} of {} chunks changed", scene->get_name(),
+                                stats.changed_chunks, stats.chunks);
+            }
+        }
+    }
+
+    // Until a configuration is applied the renderer keeps its own settings.
+    void configure_renderer() {
+        if (!configured) {
+            return;
+        }
+        if (auto* tile_renderer = dynamic_cast<TileRenderer*>(renderer.get())) {
+            tile_renderer->set_sort_mode(config.sort_mode);
+            tile_renderer->set_temporal_cache(config.temporal_cache);
+            tile_renderer->set_memory_placement(config.memory_placement);
+        }
+    }
 };
 
 Engine::Engine() : impl_(std::make_unique<Impl>()) {
@@ -20,7 +270,7 @@ Engine::Engine() : impl_(std::make_unique<Impl>()) {
 }
 
 Engine::~Engine() {
-    if (running_) {
+    if (impl_ && impl_->running) {
         shutdown();
     }
 }
@@ -29,24 +279,72 @@ Engine::Engine(Engine&&) noexcept = default;
 Engine& Engine::operator=(Engine&&) noexcept = default;
 
 bool Engine::initialize(const std::string& config_path) {
-    if (running_) {
+    utils::Config config;
+    if (!config_path.empty() && !config.load_file(config_path)) {
+        return false;
+    }
+    config.apply_environment();
+    return initialize(EngineConfig::from_config(config));
+}
+
+bool Engine::initialize(const EngineConfig& config) {
+    if (impl_->running) {
         utils::log_warning("Engine already initialized");
         return true;
     }
 
-    impl_->last_update_time = std::chrono::steady_clock::now();
-    running_ = true;
+    apply_config(config);
+    utils::log_info("Effective configuration:\n{}", dump_config());
+
+    impl_->running = true;
 
     utils::log_info("Engine initialized successfully");
     return true;
 }
 
+void Engine::apply_config(const EngineConfig& config) {
+    impl_->config = config;
+    impl_->configured = true;
+    utils::Logger::instance().set_level(config.log_level);
+    // Only allocations made from here on follow the new mode.
+    utils::set_huge_page_mode(config.huge_pages);
+
+    // Restarting the pool is only worth it when the layout changes.
+    auto& pool = utils::ThreadPool::instance();
+    const std::size_t threads = config.worker_threads > 0
+        ? config.worker_threads : std::max(1u, std::thread::hardware_concurrency());
+    if (threads != pool.size() + 1 || config.pin_threads != pool.is_pinned()) {
+        if (!pool.resize(threads, config.pin_threads)) {
+            utils::log_warning("Worker pool already in use; keeping {} threads", pool.size() + 1);
+        } else if (config.pin_threads && !pool.is_pinned()) {
+            utils::log_warning("Could not pin worker threads");
+        }
+    }
+
+    // After the pool, since partitioned placement follows its node split.
+    for (auto& scene : impl_->scenes.get_scenes()) {
+        scene->get_gaussians().set_memory_placement(config.memory_placement);
+    }
+    impl_->scenes.set_settings({config.scene_memory_budget, config.spill_directory});
+
+    impl_->frame_budget = config.frame_budget;
+    impl_->configure_renderer();
+}
+
+const EngineConfig& Engine::get_config() const {
+    return impl_->config;
+}
+
+std::string Engine::dump_config() const {
+    return impl_->config.to_config().dump();
+}
+
 void Engine::shutdown() {
-    if (!running_) {
+    if (!impl_->running) {
         return;
     }
 
-    running_ = false;
+    impl_->running = false;
     
     if (impl_->renderer) {
         impl_->renderer->shutdown();
@@ -59,11 +357,15 @@ void Engine::shutdown() {
 }
 
 void Engine::update(double delta_time) {
-    if (!running_) {
+    if (!impl_->running) {
         return;
     }
 
+    if (!impl_->stepping) {
+        impl_->reload_changed_scenes();
+    }
     if (impl_->active_scene) {
+        impl_->scenes.touch(*impl_->active_scene);
         impl_->active_scene->update(delta_time);
     }
 
@@ -73,18 +375,174 @@ void Engine::update(double delta_time) {
 }
 
 void Engine::render() {
-    if (!running_ || !impl_->renderer || !impl_->active_scene) {
+    if (!impl_->running || !impl_->renderer || !impl_->active_scene) {
         return;
     }
 
+    impl_->scenes.touch(*impl_->active_scene);
     impl_->renderer->begin_frame();
-    impl_->renderer->render_scene(*impl_->active_scene);
+    if (impl_->frame_budget.count() > 0) {
+        impl_->frame_converged = impl_->renderer->render_scene_progressive(*impl_->active_scene, impl_->frame_budget);
+    } else {
+        impl_->renderer->render_scene(*impl_->active_scene);
+        impl_->frame_converged = true;
+    }
     impl_->renderer->end_frame();
 }
 
+bool Engine::run(const RunSettings& settings) {
+    using clock = std::chrono::steady_clock;
+    if (!impl_->running) {
+        utils::log_error("Engine::run() called before initialize()");
+        return false;
+    }
+
+    auto& impl = *impl_;
+    FrameTimingStats timing;
+    {
+        std::lock_guard lock(impl.timing_mutex);
+        impl.timing = timing;
+    }
+    impl.frame_times.assign(FrameTimingStats::frame_window, 0.0);
+    double window_total = 0.0;
+
+    const auto step = std::chrono::duration_cast<clock::duration>(
+        std::max(settings.fixed_timestep, std::chrono::microseconds(1)));
+    const double step_seconds = std::chrono::duration<double>(step).count();
+    const auto period = settings.target_frame_rate > 0.0
+        ? std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / settings.target_frame_rate))
+        : clock::duration::zero();
+    const auto spin = std::chrono::duration_cast<clock::duration>(settings.spin_threshold);
+    const std::uint32_t max_steps = std::max<std::uint32_t>(settings.max_catch_up_steps, 1);
+
+    auto milliseconds = [](clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+
+    clock::duration accumulator = clock::duration::zero();
+    auto previous = clock::now();
+    auto deadline = previous + period;
+    double pacing_error_total = 0.0;
+    std::uint64_t paced_frames = 0;
+
+    while (impl.running.load(std::memory_order_relaxed) &&
+           (settings.max_frames == 0 || timing.frames < settings.max_frames)) {
+        const auto frame_start = clock::now();
+        accumulator += frame_start - previous;
+        previous = frame_start;
+
+        impl.reload_changed_scenes();
+        impl.stepping = true;
+        std::uint32_t steps = 0;
+        while (accumulator >= step && steps < max_steps) {
+            update(step_seconds);
+            accumulator -= step;
+            ++steps;
+        }
+        impl.stepping = false;
+        if (accumulator >= step) {
+            // Too far behind to catch up: keep the fractional step so the
+            // interpolation stays smooth and drop whole steps.
+            timing.dropped_updates += static_cast<std::uint64_t>(accumulator / step);
+            accumulator %= step;
+        }
+        timing.updates += steps;
+        impl.interpolation_alpha = std::chrono::duration<double>(accumulator).count() / step_seconds;
+        const auto updated = clock::now();
+
+        render();
+        const auto rendered = clock::now();
+
+        if (period > clock::duration::zero()) {
+            if (rendered < deadline) {
+                if (deadline - rendered > spin) {
+                    std::this_thread::sleep_until(deadline - spin);
+                }
+                while (clock::now() < deadline) {
+                    std::this_thread::yield();
+                }
+                pacing_error_total += milliseconds(clock::now() - deadline);
+                ++paced_frames;
+                deadline += period;
+            } else {
+                // Missed the deadline: start a new cadence instead of
+                // rendering a burst of frames to catch up.
+                deadline = rendered + period;
+            }
+        }
+
+        const auto frame_end = clock::now();
+        const double frame_ms = milliseconds(frame_end - frame_start);
+        double& slot = impl.frame_times[timing.frames % FrameTimingStats::frame_window];
+        window_total += frame_ms - slot;
+        slot = frame_ms;
+        ++timing.frames;
+        timing.last_frame_ms = frame_ms;
+        timing.max_frame_ms = std::max(timing.max_frame_ms, frame_ms);
+        timing.update_ms = milliseconds(updated - frame_start);
+        timing.render_ms = milliseconds(rendered - updated);
+        timing.pacing_error_ms = paced_frames > 0 ? pacing_error_total / paced_frames : 0.0;
+
+        const std::size_t window = std::min<std::size_t>(timing.frames, FrameTimingStats::frame_window);
+        timing.average_frame_ms = window_total / window;
+        timing.frames_per_second = window_total > 0.0 ? 1000.0 * window / window_total : 0.0;
+        if (timing.frames % percentile_interval == 0) {
+            timing.p99_frame_ms = p99_frame_ms(impl.frame_times, window);
+        }
+        std::lock_guard lock(impl.timing_mutex);
+        impl.timing = timing;
+    }
+
+    // The running total drifts by rounding; finish with exact figures.
+    const std::size_t window = std::min<std::size_t>(timing.frames, FrameTimingStats::frame_window);
+    if (window > 0) {
+        double total = 0.0;
+        for (std::size_t i = 0; i < window; ++i) {
+            total += impl.frame_times[i];
+        }
+        timing.average_frame_ms = total / window;
+        timing.frames_per_second = total > 0.0 ? 1000.0 * window / total : 0.0;
+        timing.p99_frame_ms = p99_frame_ms(impl.frame_times, window);
+    }
+    std::lock_guard lock(impl.timing_mutex);
+    impl.timing = timing;
+    return true;
+}
+
+FrameTimingStats Engine::get_timing_stats() const {
+    std::lock_guard lock(impl_->timing_mutex);
+    return impl_->timing;
+}
+
+double Engine::get_interpolation_alpha() const {
+    return impl_->interpolation_alpha;
+}
+
+bool Engine::is_running() const {
+    return impl_->running.load(std::memory_order_relaxed);
+}
+
+void Engine::stop() {
+    impl_->running = false;
+}
+
+void Engine::set_frame_budget(std::chrono::microseconds budget) {
+    impl_->frame_budget = budget;
+    impl_->config.frame_budget = budget;
+}
+
+std::chrono::microseconds Engine::get_frame_budget() const {
+    return impl_->frame_budget;
+}
+
+bool Engine::is_frame_converged() const {
+    return impl_->frame_converged;
+}
+
 std::shared_ptr<Scene> Engine::create_scene(const std::string& name) {
     auto scene = std::make_shared<Scene>(name);
-    impl_->scenes[name] = scene;
+    scene->get_gaussians().set_memory_placement(impl_->config.memory_placement);
+    impl_->scenes.add(name, scene);
     
     if (!impl_->active_scene) {
         impl_->active_scene = scene;
@@ -95,8 +553,15 @@ std::shared_ptr<Scene> Engine::create_scene(const std::string& name) {
 }
 
 std::shared_ptr<Scene> Engine::get_scene(const std::string& name) const {
-    auto it = impl_->scenes.find(name);
-    return (it != impl_->scenes.end()) ? it->second : nullptr;
+    return impl_->scenes.acquire(name);
+}
+
+void Engine::prefetch_scene(const std::string& name) {
+    impl_->scenes.prefetch(name);
+}
+
+SceneResidencyStats Engine::get_residency_stats() const {
+    return impl_->scenes.get_stats();
 }
 
 void Engine::set_active_scene(std::shared_ptr<Scene> scene) {
@@ -108,6 +573,7 @@ void Engine::set_active_scene(std::shared_ptr<Scene> scene) {
 
 void Engine::set_renderer(std::unique_ptr<Renderer> renderer) {
     impl_->renderer = std::move(renderer);
+    impl_->configure_renderer();
 }
 
 Renderer* Engine::get_renderer() const {
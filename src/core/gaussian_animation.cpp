@@ -0,0 +1,661 @@
+#include "buildify/core/gaussian_animation.hpp"
+#include "buildify/core/gaussians.hpp"
+#include "buildify/utils/thread_pool.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace buildify::core {
+
+namespace {
+
+constexpr char stream_magic[4] = {'B', '4', 'D', 'G'};
+constexpr std::uint32_t stream_version = 1;
+// Component columns are padded to this many splats so every column and
+// frame starts 16-byte aligned within a block.
+constexpr std::size_t column_alignment = 8;
+constexpr float quantization_levels = 65535.0f;
+constexpr std::size_t evaluate_grain = 16384;
+
+struct StreamHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t splat_count;
+    std::uint32_t frame_count;
+    std::uint32_t block_frames;
+    float frame_rate;
+    std::uint32_t channels;
+};
+static_assert(sizeof(StreamHeader) == 32);
+
+// value = offset + q * step for the 16-bit q stored in the column.
+struct ComponentRange {
+    float offset;
+    float step;
+};
+
+std::uint32_t component_count(DeformationChannel channels) {
+    return (channels & DeformationChannel::Position ? 3u : 0u) +
+           (channels & DeformationChannel::Rotation ? 4u : 0u) +
+           (channels & DeformationChannel::Scale ? 3u : 0u);
+}
+
+std::size_t padded_splats(std::size_t splat_count) {
+    return (splat_count + column_alignment - 1) / column_alignment * column_alignment;
+}
+
+std::size_t frame_bytes(std::size_t splat_count, DeformationChannel channels) {
+    std::size_t components = component_count(channels);
+    return components * sizeof(ComponentRange) + components * padded_splats(splat_count) * sizeof(std::uint16_t);
+}
+
+// A run of consecutive frames read with one seek.
+struct Block {
+    std::uint32_t index = 0;
+    std::uint32_t first_frame = 0;
+    std::uint32_t frames = 0;
+    std::vector<std::byte> data;
+};
+
+// One frame of a block, split into its range table and component columns.
+struct FrameView {
+    const ComponentRange* ranges = nullptr;
+    const std::uint16_t* columns = nullptr;
+    std::size_t stride = 0;
+
+    const std::uint16_t* column(std::uint32_t component) const { return columns + component * stride; }
+};
+
+}
+
+DeformationStreamWriter::~DeformationStreamWriter() {
+    close();
+}
+
+bool DeformationStreamWriter::open(const std::string& path, std::size_t splat_count, float frame_rate,
+                                   DeformationChannel channels, std::uint32_t block_frames) {
+    close();
+    if (splat_count == 0 || frame_rate <= 0.0f || block_frames == 0 || component_count(channels) == 0) {
+        utils::log_error("Invalid deformation stream parameters for {}", path);
+        return false;
+    }
+
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        utils::log_error("Failed to create deformation stream: {}", path);
+        return false;
+    }
+
+    StreamHeader header{};
+    std::memcpy(header.magic, stream_magic, sizeof(stream_magic));
+    header.version = stream_version;
+    header.splat_count = splat_count;
+    header.block_frames = block_frames;
+    header.frame_rate = frame_rate;
+    header.channels = static_cast<std::uint32_t>(channels);
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    splat_count_ = splat_count;
+    channels_ = channels;
+    frame_count_ = 0;
+    return static_cast<bool>(file_);
+}
+
+bool DeformationStreamWriter::append_frame(const DeformationFrame& frame) {
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    std::vector<std::span<const float>> components;
+    if (channels_ & DeformationChannel::Position) {
+        components.insert(components.end(), std::begin(frame.position), std::end(frame.position));
+    }
+    if (channels_ & DeformationChannel::Rotation) {
+        components.insert(components.end(), std::begin(frame.rotation), std::end(frame.rotation));
+    }
+    if (channels_ & DeformationChannel::Scale) {
+        components.insert(components.end(), std::begin(frame.scale), std::end(frame.scale));
+    }
+    for (const auto& component : components) {
+        if (component.size() != splat_count_) {
+            utils::log_error("Deformation frame has {} values per component, expected {}",
+                             component.size(), splat_count_);
+            return false;
+        }
+    }
+
+    std::vector<ComponentRange> ranges(components.size());
+    std::vector<std::uint16_t> columns(components.size() * padded_splats(splat_count_), 0);
+    for (std::size_t c = 0; c < components.size(); ++c) {
+        auto [low, high] = std::minmax_element(components[c].begin(), components[c].end());
+        float range = *high - *low;
+        ranges[c] = {*low, range / quantization_levels};
+        float inverse = range > 0.0f ? quantization_levels / range : 0.0f;
+
+        std::uint16_t* column = columns.data() + c * padded_splats(splat_count_);
+        for (std::size_t i = 0; i < splat_count_; ++i) {
+            column[i] = static_cast<std::uint16_t>(std::lround((components[c][i] - *low) * inverse));
+        }
+    }
+
+    file_.write(reinterpret_cast<const char*>(ranges.data()), ranges.size() * sizeof(ComponentRange));
+    file_.write(reinterpret_cast<const char*>(columns.data()), columns.size() * sizeof(std::uint16_t));
+    if (!file_) {
+        utils::log_error("Failed to write deformation frame {}", frame_count_);
+        return false;
+    }
+    ++frame_count_;
+    return true;
+}
+
+bool DeformationStreamWriter::close() {
+    if (!file_.is_open()) {
+        return true;
+    }
+
+    file_.seekp(offsetof(StreamHeader, frame_count));
+    file_.write(reinterpret_cast<const char*>(&frame_count_), sizeof(frame_count_));
+    file_.close();
+    return !file_.fail();
+}
+
+struct GaussianAnimation::Impl {
+    std::string path;
+    StreamHeader header{};
+    std::size_t frame_size = 0;
+    std::size_t block_count = 0;
+
+    // Rest pose, one column per deformed component.
+    std::vector<std::vector<float>> rest;
+    bool bound = false;
+
+    double time = 0.0;
+    double playback_rate = 1.0;
+    bool looping = true;
+    bool playing = true;
+
+    // Evaluation reads missing blocks through `file`; the loader thread has
+    // its own stream so the two never share a file position.
+    std::ifstream file;
+    std::ifstream loader_file;
+    std::thread loader;
+
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    std::map<std::uint32_t, std::shared_ptr<const Block>> resident;
+    std::map<std::uint32_t, std::uint64_t> last_used;
+    std::deque<std::uint32_t> requests;
+    std::uint32_t loading = std::numeric_limits<std::uint32_t>::max();
+    std::uint64_t use_tick = 0;
+    std::size_t max_resident_blocks = 4;
+    bool stopping = false;
+    GaussianAnimationStats stats;
+
+    std::uint32_t components() const { return component_count(static_cast<DeformationChannel>(header.channels)); }
+
+    std::shared_ptr<Block> read_block(std::ifstream& stream, std::uint32_t index) const {
+        auto block = std::make_shared<Block>();
+        block->index = index;
+        block->first_frame = index * header.block_frames;
+        block->frames = std::min(header.block_frames, header.frame_count - block->first_frame);
+        block->data.resize(block->frames * frame_size);
+
+        stream.clear();
+        stream.seekg(static_cast<std::streamoff>(sizeof(StreamHeader) + block->first_frame * frame_size));
+        stream.read(reinterpret_cast<char*>(block->data.data()), static_cast<std::streamsize>(block->data.size()));
+        if (!stream) {
+            utils::log_error("Failed to read deformation block {} from {}", index, path);
+            return nullptr;
+        }
+        return block;
+    }
+
+    // Caller holds the mutex.
+    void insert(std::shared_ptr<const Block> block) {
+        ++stats.blocks_loaded;
+        stats.resident_bytes += block->data.size();
+        last_used[block->index] = ++use_tick;
+        resident[block->index] = std::move(block);
+
+        while (resident.size() > max_resident_blocks) {
+            auto oldest = std::min_element(last_used.begin(), last_used.end(),
+                                           [](const auto& a, const auto& b) { return a.second < b.second; });
+            stats.resident_bytes -= resident[oldest->first]->data.size();
+            resident.erase(oldest->first);
+            last_used.erase(oldest);
+        }
+    }
+
+    std::shared_ptr<const Block> acquire(std::uint32_t index) {
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [&] { return loading != index; });
+        if (auto it = resident.find(index); it != resident.end()) {
+            last_used[index] = ++use_tick;
+            return it->second;
+        }
+
+        ++stats.stalls;
+        lock.unlock();
+        std::shared_ptr<const Block> block = read_block(file, index);
+        lock.lock();
+        if (block && !resident.contains(index)) {
+            insert(block);
+        }
+        return block;
+    }
+
+    void request(std::uint32_t index) {
+        {
+            std::lock_guard lock(mutex);
+            if (resident.contains(index) || loading == index ||
+                std::find(requests.begin(), requests.end(), index) != requests.end()) {
+                return;
+            }
+            requests.push_back(index);
+        }
+        condition.notify_all();
+    }
+
+    void loader_loop() {
+        std::unique_lock lock(mutex);
+        while (true) {
+            condition.wait(lock, [&] { return stopping || !requests.empty(); });
+            if (stopping) {
+                return;
+            }
+            loading = requests.front();
+            requests.pop_front();
+            if (resident.contains(loading)) {
+                loading = std::numeric_limits<std::uint32_t>::max();
+                continue;
+            }
+
+            std::uint32_t index = loading;
+            lock.unlock();
+            std::shared_ptr<const Block> block = read_block(loader_file, index);
+            lock.lock();
+            if (block) {
+                insert(std::move(block));
+            }
+            loading = std::numeric_limits<std::uint32_t>::max();
+            condition.notify_all();
+        }
+    }
+
+    void stop_loader() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        if (loader.joinable()) {
+            loader.join();
+        }
+        stopping = false;
+    }
+
+    FrameView frame_view(const Block& block, std::uint32_t frame) const {
+        const std::byte* base = block.data.data() + (frame - block.first_frame) * frame_size;
+        FrameView view;
+        view.ranges = reinterpret_cast<const ComponentRange*>(base);
+        view.columns = reinterpret_cast<const std::uint16_t*>(base + components() * sizeof(ComponentRange));
+        view.stride = padded_splats(header.splat_count);
+        return view;
+    }
+};
+
+GaussianAnimation::GaussianAnimation() : impl_(std::make_unique<Impl>()) {}
+
+GaussianAnimation::~GaussianAnimation() {
+    close();
+}
+
+bool GaussianAnimation::open(const std::string& path) {
+    close();
+
+    auto& impl = *impl_;
+    impl.file.open(path, std::ios::binary);
+    if (!impl.file) {
+        utils::log_error("Failed to open deformation stream: {}", path);
+        return false;
+    }
+
+    StreamHeader header{};
+    impl.file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!impl.file || std::memcmp(header.magic, stream_magic, sizeof(stream_magic)) != 0 ||
+        header.version != stream_version) {
+        utils::log_error("Not a deformation stream: {}", path);
+        impl.file.close();
+        return false;
+    }
+    if (header.splat_count == 0 || header.frame_count == 0 || header.block_frames == 0 ||
+        header.frame_rate <= 0.0f || component_count(static_cast<DeformationChannel>(header.channels)) == 0) {
+        utils::log_error("Deformation stream {} is empty or corrupt", path);
+        impl.file.close();
+        return false;
+    }
+
+    impl.path = path;
+    impl.header = header;
+    impl.frame_size = frame_bytes(header.splat_count, static_cast<DeformationChannel>(header.channels));
+    impl.block_count = (header.frame_count + header.block_frames - 1) / header.block_frames;
+    impl.loader_file.open(path, std::ios::binary);
+    impl.loader = std::thread([&impl]() { impl.loader_loop(); });
+    impl.request(0);
+
+    utils::log_info("Opened deformation stream {}: {} splats, {} frames at {} fps",
+                    path, header.splat_count, header.frame_count, header.frame_rate);
+    return true;
+}
+
+void GaussianAnimation::close() {
+    auto& impl = *impl_;
+    impl.stop_loader();
+    impl.file.close();
+    impl.loader_file.close();
+    impl.resident.clear();
+    impl.last_used.clear();
+    impl.requests.clear();
+    impl.rest.clear();
+    impl.bound = false;
+    impl.header = {};
+    impl.time = 0.0;
+    impl.stats = {};
+}
+
+bool GaussianAnimation::is_open() const {
+    return impl_->header.frame_count > 0;
+}
+
+std::size_t GaussianAnimation::get_splat_count() const {
+    return impl_->header.splat_count;
+}
+
+std::uint32_t GaussianAnimation::get_frame_count() const {
+    return impl_->header.frame_count;
+}
+
+float GaussianAnimation::get_frame_rate() const {
+    return impl_->header.frame_rate;
+}
+
+double GaussianAnimation::get_duration() const {
+    if (!is_open()) {
+        return 0.0;
+    }
+    return static_cast<double>(impl_->header.frame_count - 1) / impl_->header.frame_rate;
+}
+
+DeformationChannel GaussianAnimation::get_channels() const {
+    return static_cast<DeformationChannel>(impl_->header.channels);
+}
+
+bool GaussianAnimation::bind(const GaussianCloud& cloud) {
+    auto& impl = *impl_;
+    if (!is_open()) {
+        utils::log_error("Cannot bind a deformation stream that is not open");
+        return false;
+    }
+    if (cloud.size() != impl.header.splat_count) {
+        utils::log_error("Deformation stream has {} splats but the cloud has {}",
+                         impl.header.splat_count, cloud.size());
+        return false;
+    }
+
+    std::vector<GaussianAttribute> attributes;
+    auto channels = get_channels();
+    if (channels & DeformationChannel::Position) {
+        attributes.insert(attributes.end(), {GaussianAttribute::PositionX, GaussianAttribute::PositionY,
+                                             GaussianAttribute::PositionZ});
+    }
+    if (channels & DeformationChannel::Rotation) {
+        attributes.insert(attributes.end(), {GaussianAttribute::RotationX, GaussianAttribute::RotationY,
+                                             GaussianAttribute::RotationZ, GaussianAttribute::RotationW});
+    }
+    if (channels & DeformationChannel::Scale) {
+        attributes.insert(attributes.end(), {GaussianAttribute::ScaleX, GaussianAttribute::ScaleY,
+                                             GaussianAttribute::ScaleZ});
+    }
+
+    impl.rest.clear();
+    for (auto attribute : attributes) {
+        auto column = cloud.column(attribute);
+        impl.rest.emplace_back(column.begin(), column.end());
+    }
+    impl.bound = true;
+    return true;
+}
+
+bool GaussianAnimation::is_bound() const {
+    return impl_->bound;
+}
+
+void GaussianAnimation::set_time(double seconds) {
+    double duration = get_duration();
+    if (impl_->looping && duration > 0.0) {
+        seconds = std::fmod(seconds, duration);
+        if (seconds < 0.0) {
+            seconds += duration;
+        }
+    } else {
+        seconds = std::clamp(seconds, 0.0, duration);
+    }
+    impl_->time = seconds;
+}
+
+double GaussianAnimation::get_time() const {
+    return impl_->time;
+}
+
+void GaussianAnimation::set_playback_rate(double rate) {
+    impl_->playback_rate = rate;
+}
+
+double GaussianAnimation::get_playback_rate() const {
+    return impl_->playback_rate;
+}
+
+void GaussianAnimation::set_looping(bool looping) {
+    impl_->looping = looping;
+}
+
+bool GaussianAnimation::is_looping() const {
+    return impl_->looping;
+}
+
+void GaussianAnimation::set_playing(bool playing) {
+    impl_->playing = playing;
+}
+
+bool GaussianAnimation::is_playing() const {
+    return impl_->playing;
+}
+
+void GaussianAnimation::advance(double delta_time) {
+    if (impl_->playing) {
+        set_time(impl_->time + delta_time * impl_->playback_rate);
+    }
+}
+
+bool GaussianAnimation::evaluate(GaussianCloud& cloud) {
+    auto& impl = *impl_;
+    if (!impl.bound || cloud.size() != impl.header.splat_count) {
+        utils::log_error("Deformation stream is not bound to this cloud");
+        return false;
+    }
+
+    const auto& header = impl.header;
+    double frame_time = impl.time * header.frame_rate;
+    auto frame0 = std::min(static_cast<std::uint32_t>(frame_time), header.frame_count - 1);
+    std::uint32_t frame1 = std::min(frame0 + 1, header.frame_count - 1);
+    float weight = frame1 == frame0 ? 0.0f : static_cast<float>(frame_time - frame0);
+
+    std::uint32_t block0 = frame0 / header.block_frames;
+    std::uint32_t block1 = frame1 / header.block_frames;
+    auto first = impl.acquire(block0);
+    auto second = block1 == block0 ? first : impl.acquire(block1);
+    if (!first || !second) {
+        return false;
+    }
+
+    // Queue the block playback enters next so it is resident in time.
+    auto block_count = static_cast<std::int64_t>(impl.block_count);
+    std::int64_t ahead = static_cast<std::int64_t>(block1) + (impl.playback_rate < 0.0 ? -1 : 1);
+    if (impl.looping) {
+        ahead = (ahead + block_count) % block_count;
+    }
+    if (ahead >= 0 && ahead < block_count) {
+        impl.request(static_cast<std::uint32_t>(ahead));
+    }
+
+    FrameView view0 = impl.frame_view(*first, frame0);
+    FrameView view1 = impl.frame_view(*second, frame1);
+
+    // The blend of two dequantized keyframes folds into one multiply-add
+    // per keyframe: offset + q0 * scale0 + q1 * scale1.
+    struct Blend {
+        float offset;
+        float scale0;
+        float scale1;
+    };
+    std::vector<Blend> blends(impl.components());
+    for (std::uint32_t c = 0; c < blends.size(); ++c) {
+        blends[c].offset = (1.0f - weight) * view0.ranges[c].offset + weight * view1.ranges[c].offset;
+        blends[c].scale0 = (1.0f - weight) * view0.ranges[c].step;
+        blends[c].scale1 = weight * view1.ranges[c].step;
+    }
+
+    auto channels = get_channels();
+    std::vector<std::span<float>> targets;
+    std::uint32_t position = 0;
+    std::uint32_t rotation = 0;
+    std::uint32_t scale = 0;
+    if (channels & DeformationChannel::Position) {
+        position = static_cast<std::uint32_t>(targets.size());
+        targets.push_back(cloud.column(GaussianAttribute::PositionX));
+        targets.push_back(cloud.column(GaussianAttribute::PositionY));
+        targets.push_back(cloud.column(GaussianAttribute::PositionZ));
+    }
+    if (channels & DeformationChannel::Rotation) {
+        rotation = static_cast<std::uint32_t>(targets.size());
+        targets.push_back(cloud.column(GaussianAttribute::RotationX));
+        targets.push_back(cloud.column(GaussianAttribute::RotationY));
+        targets.push_back(cloud.column(GaussianAttribute::RotationZ));
+        targets.push_back(cloud.column(GaussianAttribute::RotationW));
+    }
+    if (channels & DeformationChannel::Scale) {
+        scale = static_cast<std::uint32_t>(targets.size());
+        targets.push_back(cloud.column(GaussianAttribute::ScaleX));
+        targets.push_back(cloud.column(GaussianAttribute::ScaleY));
+        targets.push_back(cloud.column(GaussianAttribute::ScaleZ));
+    }
+
+    utils::ThreadPool::instance().parallel_for(0, header.splat_count, [&](std::size_t begin, std::size_t end) {
+        if (channels & DeformationChannel::Position) {
+            for (std::uint32_t c = position; c < position + 3; ++c) {
+                const Blend b = blends[c];
+                const std::uint16_t* q0 = view0.column(c);
+                const std::uint16_t* q1 = view1.column(c);
+                const float* rest = impl.rest[c].data();
+                float* out = targets[c].data();
+                for (std::size_t i = begin; i < end; ++i) {
+                    out[i] = rest[i] + b.offset + static_cast<float>(q0[i]) * b.scale0 +
+                             static_cast<float>(q1[i]) * b.scale1;
+                }
+            }
+        }
+
+        if (channels & DeformationChannel::Scale) {
+            for (std::uint32_t c = scale; c < scale + 3; ++c) {
+                const Blend b = blends[c];
+                const std::uint16_t* q0 = view0.column(c);
+                const std::uint16_t* q1 = view1.column(c);
+                const float* rest = impl.rest[c].data();
+                float* out = targets[c].data();
+                for (std::size_t i = begin; i < end; ++i) {
+                    out[i] = rest[i] * (b.offset + static_cast<float>(q0[i]) * b.scale0 +
+                                        static_cast<float>(q1[i]) * b.scale1);
+                }
+            }
+        }
+
+        if (channels & DeformationChannel::Rotation) {
+            // Normalized lerp of the delta quaternions, taking the shorter
+            // arc, then composed with the rest rotation as delta * rest.
+            const std::uint16_t* q0[4];
+            const std::uint16_t* q1[4];
+            const float* rest[4];
+            float* out[4];
+            ComponentRange r0[4], r1[4];
+            for (std::uint32_t k = 0; k < 4; ++k) {
+                q0[k] = view0.column(rotation + k);
+                q1[k] = view1.column(rotation + k);
+                rest[k] = impl.rest[rotation + k].data();
+                out[k] = targets[rotation + k].data();
+                r0[k] = view0.ranges[rotation + k];
+                r1[k] = view1.ranges[rotation + k];
+            }
+            // Deltas are blended into a local buffer a run at a time, then
+            // composed and renormalized by the batch quaternion kernels.
+            constexpr std::size_t run = 256;
+            float delta[4][run];
+            for (std::size_t first = begin; first < end; first += run) {
+                const std::size_t n = std::min(first + run, end) - first;
+                for (std::size_t j = 0; j < n; ++j) {
+                    const std::size_t i = first + j;
+                    float ax = r0[0].offset + static_cast<float>(q0[0][i]) * r0[0].step;
+                    float ay = r0[1].offset + static_cast<float>(q0[1][i]) * r0[1].step;
+                    float az = r0[2].offset + static_cast<float>(q0[2][i]) * r0[2].step;
+                    float aw = r0[3].offset + static_cast<float>(q0[3][i]) * r0[3].step;
+                    float bx = r1[0].offset + static_cast<float>(q1[0][i]) * r1[0].step;
+                    float by = r1[1].offset + static_cast<float>(q1[1][i]) * r1[1].step;
+                    float bz = r1[2].offset + static_cast<float>(q1[2][i]) * r1[2].step;
+                    float bw = r1[3].offset + static_cast<float>(q1[3][i]) * r1[3].step;
+
+                    float wb = std::copysign(weight, ax * bx + ay * by + az * bz + aw * bw);
+                    delta[0][j] = (1.0f - weight) * ax + wb * bx;
+                    delta[1][j] = (1.0f - weight) * ay + wb * by;
+                    delta[2][j] = (1.0f - weight) * az + wb * bz;
+                    delta[3][j] = (1.0f - weight) * aw + wb * bw;
+                }
+                utils::QuaternionColumns<float> composed{{out[0] + first, n}, {out[1] + first, n},
+                                                         {out[2] + first, n}, {out[3] + first, n}};
+                utils::multiply_quaternions({{delta[0], n}, {delta[1], n}, {delta[2], n}, {delta[3], n}},
+                                            {{rest[0] + first, n}, {rest[1] + first, n},
+                                             {rest[2] + first, n}, {rest[3] + first, n}},
+                                            composed);
+                utils::normalize_quaternions(composed);
+            }
+        }
+    }, evaluate_grain);
+
+    return true;
+}
+
+void GaussianAnimation::set_max_resident_blocks(std::size_t count) {
+    std::lock_guard lock(impl_->mutex);
+    impl_->max_resident_blocks = std::max<std::size_t>(count, 2);
+}
+
+std::size_t GaussianAnimation::get_max_resident_blocks() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->max_resident_blocks;
+}
+
+GaussianAnimationStats GaussianAnimation::get_stats() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->stats;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,780 @@
+#include "buildify/core/gaussian_bvh.hpp"
+#include "buildify/core/gaussians.hpp"
+#include "buildify/utils/thread_pool.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+
+namespace buildify::core {
+
+namespace {
+
+constexpr float sigma_extent = 3.0f;
+constexpr float min_alpha = 1.0f / 255.0f;
+constexpr float max_alpha = 0.99f;
+constexpr float min_scale = 1e-6f;
+constexpr std::size_t packet_grain = 16;
+
+constexpr std::uint32_t sah_bins = 16;
+// Past this depth splits fall back to the median, which bounds the final
+// depth (and so the traversal stack) for any input.
+constexpr std::uint32_t max_sah_depth = 48;
+constexpr std::uint32_t max_tree_depth = max_sah_depth + 32;
+constexpr std::size_t stack_capacity = (GaussianBVH::branching - 1) * max_tree_depth + 1;
+constexpr std::size_t parallel_build_threshold = 32768;
+constexpr std::size_t reduce_grain = 16384;
+constexpr std::size_t refit_grain = 1024;
+constexpr std::size_t refit_prefetch_distance = 16;
+constexpr std::uint32_t empty_slot = std::numeric_limits<std::uint32_t>::max();
+
+struct Bounds {
+    float min[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                    std::numeric_limits<float>::max()};
+    float max[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                    std::numeric_limits<float>::lowest()};
+
+    void extend(const float lo[3], const float hi[3]) {
+        for (int a = 0; a < 3; ++a) {
+            min[a] = std::min(min[a], lo[a]);
+            max[a] = std::max(max[a], hi[a]);
+        }
+    }
+
+    void extend(const Bounds& other) { extend(other.min, other.max); }
+
+    // Half the surface area, which is all SAH needs.
+    float area() const {
+        float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+        return dx < 0.0f ? 0.0f : dx * dy + dy * dz + dz * dx;
+    }
+};
+
+struct BuildItem {
+    Bounds bounds;
+    float centroid[3];
+    std::uint32_t primitive;
+};
+
+struct BinaryNode {
+    Bounds bounds;
+    // Interior nodes: left child, with the right child at left + 1.
+    std::uint32_t left = 0;
+    std::uint32_t begin = 0;
+    // Number of primitives for leaves, 0 for interior nodes.
+    std::uint32_t count = 0;
+};
+
+// Top-down binned SAH builder. Children are allocated in pairs from a
+// preallocated array, so large subtrees can be built concurrently.
+class SahBuilder {
+public:
+    explicit SahBuilder(std::vector<BuildItem>& items)
+        : items_(items), nodes_(std::max<std::size_t>(2 * items.size(), 1)) {}
+
+    std::vector<BinaryNode>& build() {
+        next_node_ = 1;
+        build_node(0, 0, items_.size(), 0);
+        nodes_.resize(next_node_.load());
+        return nodes_;
+    }
+
+private:
+    struct Bin {
+        Bounds bounds;
+        std::uint32_t count = 0;
+    };
+    using Bins = std::array<std::array<Bin, sah_bins>, 3>;
+
+    void build_node(std::uint32_t index, std::size_t begin, std::size_t end, std::uint32_t depth);
+
+    std::vector<BuildItem>& items_;
+    std::vector<BinaryNode> nodes_;
+    std::atomic<std::uint32_t> next_node_{1};
+};
+
+void SahBuilder::build_node(std::uint32_t index, std::size_t begin, std::size_t end, std::uint32_t depth) {
+    auto& pool = utils::ThreadPool::instance();
+    const std::size_t count = end - begin;
+    const bool large = count >= parallel_build_threshold;
+
+    // Large ranges reduce per chunk in parallel; chunk results are merged
+    // serially so the reduction is deterministic.
+    auto reduce = [&](auto&& init, auto&& accumulate, auto&& merge) {
+        auto result = init();
+        if (!large) {
+            accumulate(result, begin, end);
+            return result;
+        }
+        std::size_t chunks = (count + reduce_grain - 1) / reduce_grain;
+        std::vector<decltype(result)> partial(chunks, init());
+        pool.parallel_for(0, chunks, [&](std::size_t chunk_begin, std::size_t chunk_end) {
+            for (std::size_t c = chunk_begin; c < chunk_end; ++c) {
+                std::size_t first = begin + c * reduce_grain;
+                accumulate(partial[c], first, std::min(end, first + reduce_grain));
+            }
+        });
+        for (const auto& part : partial) {
+            merge(result, part);
+        }
+        return result;
+    };
+
+    auto [bounds, centroids] = reduce(
+        []() { return std::pair<Bounds, Bounds>(); },
+        [&](std::pair<Bounds, Bounds>& out, std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                out.first.extend(items_[i].bounds);
+                out.second.extend(items_[i].centroid, items_[i].centroid);
+            }
+        },
+        [](std::pair<Bounds, Bounds>& out, const std::pair<Bounds, Bounds>& part) {
+            out.first.extend(part.first);
+            out.second.extend(part.second);
+        });
+
+    BinaryNode& node = nodes_[index];
+    node.bounds = bounds;
+    if (count <= GaussianBVH::max_leaf_size) {
+        node.begin = static_cast<std::uint32_t>(begin);
+        node.count = static_cast<std::uint32_t>(count);
+        return;
+    }
+
+    float scale[3];
+    for (int a = 0; a < 3; ++a) {
+        float extent = centroids.max[a] - centroids.min[a];
+        scale[a] = extent > 0.0f ? static_cast<float>(sah_bins) / extent : 0.0f;
+    }
+    auto bin_of = [&](const BuildItem& item, int axis) {
+        auto bin = static_cast<std::uint32_t>((item.centroid[axis] - centroids.min[axis]) * scale[axis]);
+        return std::min(bin, sah_bins - 1);
+    };
+
+    int best_axis = -1;
+    std::uint32_t best_split = 0;
+    if (depth < max_sah_depth) {
+        Bins bins = reduce(
+            []() { return Bins{}; },
+            [&](Bins& out, std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; ++i) {
+                    for (int a = 0; a < 3; ++a) {
+                        auto& bin = out[a][bin_of(items_[i], a)];
+                        bin.bounds.extend(items_[i].bounds);
+                        ++bin.count;
+                    }
+                }
+            },
+            [](Bins& out, const Bins& part) {
+                for (int a = 0; a < 3; ++a) {
+                    for (std::uint32_t b = 0; b < sah_bins; ++b) {
+                        out[a][b].bounds.extend(part[a][b].bounds);
+                        out[a][b].count += part[a][b].count;
+                    }
+                }
+            });
+
+        float best_cost = std::numeric_limits<float>::max();
+        for (int a = 0; a < 3; ++a) {
+            if (scale[a] == 0.0f) {
+                continue;
+            }
+
+            std::array<float, sah_bins> right_area{};
+            std::array<std::uint32_t, sah_bins> right_count{};
+            Bounds right;
+            std::uint32_t right_total = 0;
+            for (std::uint32_t b = sah_bins - 1; b > 0; --b) {
+                right.extend(bins[a][b].bounds);
+                right_total += bins[a][b].count;
+                right_area[b] = right.area();
+                right_count[b] = right_total;
+            }
+
+            Bounds left;
+            std::uint32_t left_total = 0;
+            for (std::uint32_t split = 1; split < sah_bins; ++split) {
+                left.extend(bins[a][split - 1].bounds);
+                left_total += bins[a][split - 1].count;
+                if (left_total == 0 || right_count[split] == 0) {
+                    continue;
+                }
+                float cost = left.area() * static_cast<float>(left_total) +
+                             right_area[split] * static_cast<float>(right_count[split]);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_axis = a;
+                    best_split = split;
+                }
+            }
+        }
+    }
+
+    std::size_t mid = begin;
+    if (best_axis >= 0) {
+        auto middle = std::partition(items_.begin() + begin, items_.begin() + end,
+                                     [&](const BuildItem& item) { return bin_of(item, best_axis) < best_split; });
+        mid = static_cast<std::size_t>(middle - items_.begin());
+    }
+    if (mid == begin || mid == end) {
+        int axis = 0;
+        for (int a = 1; a < 3; ++a) {
+            if (centroids.max[a] - centroids.min[a] > centroids.max[axis] - centroids.min[axis]) {
+                axis = a;
+            }
+        }
+        mid = begin + count / 2;
+        std::nth_element(items_.begin() + begin, items_.begin() + mid, items_.begin() + end,
+                         [axis](const BuildItem& a, const BuildItem& b) { return a.centroid[axis] < b.centroid[axis]; });
+    }
+
+    std::uint32_t left = next_node_.fetch_add(2, std::memory_order_relaxed);
+    node.left = left;
+    node.count = 0;
+
+    if (large) {
+        pool.parallel_for(0, 2, [&](std::size_t first, std::size_t last) {
+            for (std::size_t side = first; side < last; ++side) {
+                build_node(left + static_cast<std::uint32_t>(side), side == 0 ? begin : mid,
+                           side == 0 ? mid : end, depth + 1);
+            }
+        });
+    } else {
+        build_node(left, begin, mid, depth + 1);
+        build_node(left + 1, mid, end, depth + 1);
+    }
+}
+
+// Density peak of the splat along the ray, in the ray's parameter.
+template<typename Primitive>
+bool intersect(const Primitive& p, const utils::Vector3f& center, float ox, float oy, float oz,
+               float dx, float dy, float dz, float& t, float& alpha) {
+    ox -= center.x;
+    oy -= center.y;
+    oz -= center.z;
+
+    float lo[3], ld[3];
+    for (int a = 0; a < 3; ++a) {
+        lo[a] = p.to_local[a][0] * ox + p.to_local[a][1] * oy + p.to_local[a][2] * oz;
+        ld[a] = p.to_local[a][0] * dx + p.to_local[a][1] * dy + p.to_local[a][2] * dz;
+    }
+
+    float dd = ld[0] * ld[0] + ld[1] * ld[1] + ld[2] * ld[2];
+    if (dd <= 0.0f) {
+        return false;
+    }
+    float od = lo[0] * ld[0] + lo[1] * ld[1] + lo[2] * ld[2];
+    float oo = lo[0] * lo[0] + lo[1] * lo[1] + lo[2] * lo[2];
+    float distance2 = oo - od * od / dd;
+    if (distance2 > sigma_extent * sigma_extent) {
+        return false;
+    }
+
+    alpha = std::min(max_alpha, p.opacity * std::exp(-0.5f * distance2));
+    if (alpha < min_alpha) {
+        return false;
+    }
+    t = -od / dd;
+    return true;
+}
+
+// Keeps the nearest `max_hits` hits sorted by t.
+void insert_hit(RayHit* hits, std::uint32_t& count, std::uint32_t max_hits, const RayHit& hit) {
+    if (count == max_hits) {
+        if (hit.t >= hits[count - 1].t) {
+            return;
+        }
+        --count;
+    }
+    std::uint32_t slot = count++;
+    while (slot > 0 && hits[slot - 1].t > hit.t) {
+        hits[slot] = hits[slot - 1];
+        --slot;
+    }
+    hits[slot] = hit;
+}
+
+}
+
+void GaussianBVH::build(const GaussianCloud& cloud) {
+    clear();
+    source_version_ = cloud.get_version();
+    source_count_ = cloud.size();
+
+    const std::size_t count = cloud.size();
+    if (count == 0) {
+        return;
+    }
+
+    auto pos_x = cloud.column(GaussianAttribute::PositionX);
+    auto pos_y = cloud.column(GaussianAttribute::PositionY);
+    auto pos_z = cloud.column(GaussianAttribute::PositionZ);
+    auto scale_x = cloud.column(GaussianAttribute::ScaleX);
+    auto scale_y = cloud.column(GaussianAttribute::ScaleY);
+    auto scale_z = cloud.column(GaussianAttribute::ScaleZ);
+    auto rot_x = cloud.column(GaussianAttribute::RotationX);
+    auto rot_y = cloud.column(GaussianAttribute::RotationY);
+    auto rot_z = cloud.column(GaussianAttribute::RotationZ);
+    auto rot_w = cloud.column(GaussianAttribute::RotationW);
+    auto opacity = cloud.column(GaussianAttribute::Opacity);
+
+    std::vector<Primitive> unordered(count);
+    std::vector<utils::Vector3f> unordered_extents(count);
+    std::vector<BuildItem> items(count);
+    std::vector<std::uint8_t> keep(count, 0);
+
+    utils::ThreadPool::instance().parallel_for(0, count, [&](std::size_t begin, std::size_t end) {
+        // Rotation matrices are converted a run at a time by the batch
+        // kernel, which normalizes on the way.
+        constexpr std::size_t run = 256;
+        float matrices[9 * run];
+        for (std::size_t first = begin; first < end; first += run) {
+            const std::size_t n = std::min(run, end - first);
+            utils::quaternions_to_matrices({rot_x.subspan(first, n), rot_y.subspan(first, n),
+                                            rot_z.subspan(first, n), rot_w.subspan(first, n)},
+                                           std::span<float>(matrices, 9 * n));
+            for (std::size_t i = first; i < first + n; ++i) {
+                float qx = rot_x[i], qy = rot_y[i], qz = rot_z[i], qw = rot_w[i];
+                if (opacity[i] < min_alpha || qx * qx + qy * qy + qz * qz + qw * qw <= 0.0f) {
+                    continue;
+                }
+
+                float r[3][3];
+                for (std::size_t k = 0; k < 9; ++k) {
+                    r[k / 3][k % 3] = matrices[k * n + (i - first)];
+                }
+                const float s[3] = {std::max(scale_x[i], min_scale), std::max(scale_y[i], min_scale),
+                                    std::max(scale_z[i], min_scale)};
+
+                const float c[3] = {pos_x[i], pos_y[i], pos_z[i]};
+                float extent[3];
+                auto& primitive = unordered[i];
+                auto& item = items[i];
+                for (int a = 0; a < 3; ++a) {
+                    for (int b = 0; b < 3; ++b) {
+                        primitive.to_local[a][b] = r[b][a] / s[a];
+                    }
+                    extent[a] = sigma_extent * std::sqrt(r[a][0] * r[a][0] * s[0] * s[0] +
+                                                         r[a][1] * r[a][1] * s[1] * s[1] +
+                                                         r[a][2] * r[a][2] * s[2] * s[2]);
+                    item.bounds.min[a] = c[a] - extent[a];
+                    item.bounds.max[a] = c[a] + extent[a];
+                    item.centroid[a] = c[a];
+                }
+                primitive.opacity = opacity[i];
+                unordered_extents[i] = {extent[0], extent[1], extent[2]};
+                item.primitive = static_cast<std::uint32_t>(i);
+                keep[i] = 1;
+            }
+        }
+    }, reduce_grain);
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (keep[i]) {
+            items[kept++] = items[i];
+        }
+    }
+    items.resize(kept);
+    if (items.empty()) {
+        return;
+    }
+
+    SahBuilder builder(items);
+    const auto& binary = builder.build();
+
+    // Collapse the binary tree by repeatedly opening the child with the
+    // largest surface area until a node has four children. Nodes are
+    // emitted breadth first, so each level is a contiguous range and a
+    // refit can sweep the levels bottom-up, each one in parallel.
+    Node empty_node;
+    for (std::uint32_t c = 0; c < branching; ++c) {
+        empty_node.min_x[c] = empty_node.min_y[c] = empty_node.min_z[c] = std::numeric_limits<float>::max();
+        empty_node.max_x[c] = empty_node.max_y[c] = empty_node.max_z[c] = std::numeric_limits<float>::lowest();
+        empty_node.child[c] = empty_slot;
+        empty_node.count[c] = 0;
+    }
+
+    struct Pending {
+        std::uint32_t binary;
+        std::uint32_t depth;
+    };
+    std::vector<Pending> queue;
+    queue.reserve(binary.size() / 2 + 1);
+    queue.push_back({0, 0});
+    nodes_.reserve(binary.size() / 2 + 1);
+    nodes_.push_back(empty_node);
+    level_offsets_.assign(1, 0);
+
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const auto [root, depth] = queue[head];
+
+        std::array<std::uint32_t, branching> slots{};
+        std::uint32_t used = 0;
+        if (binary[root].count > 0) {
+            slots[used++] = root;
+        } else {
+            slots[used++] = binary[root].left;
+            slots[used++] = binary[root].left + 1;
+            while (used < branching) {
+                int widest = -1;
+                float widest_area = -1.0f;
+                for (std::uint32_t c = 0; c < used; ++c) {
+                    if (binary[slots[c]].count == 0 && binary[slots[c]].bounds.area() > widest_area) {
+                        widest = static_cast<int>(c);
+                        widest_area = binary[slots[c]].bounds.area();
+                    }
+                }
+                if (widest < 0) {
+                    break;
+                }
+                std::uint32_t opened = slots[widest];
+                slots[widest] = binary[opened].left;
+                slots[used++] = binary[opened].left + 1;
+            }
+        }
+
+        for (std::uint32_t c = 0; c < used; ++c) {
+            const auto& child = binary[slots[c]];
+            std::uint32_t target = child.begin;
+            if (child.count == 0) {
+                target = static_cast<std::uint32_t>(nodes_.size());
+                if (depth + 1 == level_offsets_.size()) {
+                    level_offsets_.push_back(target);
+                }
+                nodes_.push_back(empty_node);
+                queue.push_back({slots[c], depth + 1});
+            }
+
+            Node& out = nodes_[head];
+            out.min_x[c] = child.bounds.min[0];
+            out.min_y[c] = child.bounds.min[1];
+            out.min_z[c] = child.bounds.min[2];
+            out.max_x[c] = child.bounds.max[0];
+            out.max_y[c] = child.bounds.max[1];
+            out.max_z[c] = child.bounds.max[2];
+            out.child[c] = target;
+            out.count[c] = static_cast<std::uint8_t>(child.count);
+        }
+    }
+
+    primitives_.resize(items.size());
+    centers_.resize(items.size());
+    extents_.resize(items.size());
+    indices_.resize(items.size());
+    utils::ThreadPool::instance().parallel_for(0, items.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            std::uint32_t source = items[i].primitive;
+            primitives_[i] = unordered[source];
+            centers_[i] = {pos_x[source], pos_y[source], pos_z[source]};
+            extents_[i] = unordered_extents[source];
+            indices_[i] = source;
+        }
+    }, reduce_grain);
+
+    utils::log_debug("Gaussian BVH built: {} splats, {} nodes", primitives_.size(), nodes_.size());
+}
+
+void GaussianBVH::refit(const GaussianCloud& cloud) {
+    if (empty() || cloud.size() != source_count_) {
+        build(cloud);
+        return;
+    }
+
+    auto pos_x = cloud.column(GaussianAttribute::PositionX);
+    auto pos_y = cloud.column(GaussianAttribute::PositionY);
+    auto pos_z = cloud.column(GaussianAttribute::PositionZ);
+
+    // Every primitive belongs to exactly one leaf slot, so moving centres
+    // and recomputing leaf boxes is one parallel pass over the nodes. The
+    // position gather follows tree order rather than cloud order, so the
+    // next leaves' positions are prefetched to keep loads in flight.
+    utils::ThreadPool::instance().parallel_for(0, nodes_.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t n = begin; n < end; ++n) {
+            Node& node = nodes_[n];
+            for (std::uint32_t c = 0; c < branching; ++c) {
+                if (node.count[c] == 0) {
+                    continue;
+                }
+                Bounds box;
+                for (std::uint32_t p = node.child[c]; p < node.child[c] + node.count[c]; ++p) {
+                    if (p + refit_prefetch_distance < indices_.size()) {
+                        std::uint32_t ahead = indices_[p + refit_prefetch_distance];
+                        __builtin_prefetch(pos_x.data() + ahead);
+                        __builtin_prefetch(pos_y.data() + ahead);
+                        __builtin_prefetch(pos_z.data() + ahead);
+                    }
+                    std::uint32_t index = indices_[p];
+                    const float center[3] = {pos_x[index], pos_y[index], pos_z[index]};
+                    const auto& extent = extents_[p];
+                    const float lo[3] = {center[0] - extent.x, center[1] - extent.y, center[2] - extent.z};
+                    const float hi[3] = {center[0] + extent.x, center[1] + extent.y, center[2] + extent.z};
+                    centers_[p] = {center[0], center[1], center[2]};
+                    box.extend(lo, hi);
+                }
+                node.min_x[c] = box.min[0];
+                node.min_y[c] = box.min[1];
+                node.min_z[c] = box.min[2];
+                node.max_x[c] = box.max[0];
+                node.max_y[c] = box.max[1];
+                node.max_z[c] = box.max[2];
+            }
+        }
+    }, refit_grain);
+
+    // Levels are swept deepest first, so every interior child already has
+    // its final boxes when its parent folds them together.
+    for (std::size_t level = level_offsets_.size(); level-- > 0;) {
+        std::size_t level_begin = level_offsets_[level];
+        std::size_t level_end = level + 1 < level_offsets_.size() ? level_offsets_[level + 1] : nodes_.size();
+        utils::ThreadPool::instance().parallel_for(level_begin, level_end, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t n = begin; n < end; ++n) {
+                Node& node = nodes_[n];
+                for (std::uint32_t c = 0; c < branching; ++c) {
+                    if (node.count[c] != 0 || node.child[c] == empty_slot) {
+                        continue;
+                    }
+
+                    // Unused slots hold inverted boxes, which leave min/max alone.
+                    const Node& child = nodes_[node.child[c]];
+                    float lo[3] = {child.min_x[0], child.min_y[0], child.min_z[0]};
+                    float hi[3] = {child.max_x[0], child.max_y[0], child.max_z[0]};
+                    for (std::uint32_t k = 1; k < branching; ++k) {
+                        lo[0] = std::min(lo[0], child.min_x[k]);
+                        lo[1] = std::min(lo[1], child.min_y[k]);
+                        lo[2] = std::min(lo[2], child.min_z[k]);
+                        hi[0] = std::max(hi[0], child.max_x[k]);
+                        hi[1] = std::max(hi[1], child.max_y[k]);
+                        hi[2] = std::max(hi[2], child.max_z[k]);
+                    }
+                    node.min_x[c] = lo[0];
+                    node.min_y[c] = lo[1];
+                    node.min_z[c] = lo[2];
+                    node.max_x[c] = hi[0];
+                    node.max_y[c] = hi[1];
+                    node.max_z[c] = hi[2];
+                }
+            }
+        }, refit_grain);
+    }
+
+    source_version_ = cloud.get_version();
+}
+
+void GaussianBVH::retarget(const GaussianCloud& cloud) {
+    source_version_ = cloud.get_version();
+}
+
+void GaussianBVH::clear() {
+    nodes_.clear();
+    level_offsets_.clear();
+    primitives_.clear();
+    centers_.clear();
+    extents_.clear();
+    indices_.clear();
+    source_count_ = 0;
+    source_version_ = 0;
+}
+
+void GaussianBVH::trace_packet(const Ray* rays, std::uint32_t count, std::uint32_t max_hits,
+                               RayHit* hits, std::uint32_t* hit_counts) const {
+    // Lanes are stored as structure-of-arrays so the slab test over a packet
+    // is a straight loop the compiler can vectorize.
+    alignas(32) float ox[packet_size], oy[packet_size], oz[packet_size];
+    alignas(32) float ix[packet_size], iy[packet_size], iz[packet_size];
+    alignas(32) float t_min[packet_size], t_limit[packet_size];
+
+    for (std::uint32_t lane = 0; lane < packet_size; ++lane) {
+        const Ray& ray = rays[std::min(lane, count - 1)];
+        ox[lane] = ray.origin.x;
+        oy[lane] = ray.origin.y;
+        oz[lane] = ray.origin.z;
+        ix[lane] = 1.0f / ray.direction.x;
+        iy[lane] = 1.0f / ray.direction.y;
+        iz[lane] = 1.0f / ray.direction.z;
+        t_min[lane] = ray.t_min;
+        t_limit[lane] = lane < count ? ray.t_max : -std::numeric_limits<float>::infinity();
+    }
+
+    std::array<std::uint32_t, stack_capacity> stack;
+    std::uint32_t stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0) {
+        const Node& node = nodes_[stack[--stack_size]];
+
+        std::uint32_t masks[branching] = {};
+        std::uint32_t any = 0;
+        for (std::uint32_t c = 0; c < branching; ++c) {
+            if (node.child[c] == empty_slot) {
+                continue;
+            }
+            for (std::uint32_t lane = 0; lane < packet_size; ++lane) {
+                float tx0 = (node.min_x[c] - ox[lane]) * ix[lane];
+                float tx1 = (node.max_x[c] - ox[lane]) * ix[lane];
+                float ty0 = (node.min_y[c] - oy[lane]) * iy[lane];
+                float ty1 = (node.max_y[c] - oy[lane]) * iy[lane];
+                float tz0 = (node.min_z[c] - oz[lane]) * iz[lane];
+                float tz1 = (node.max_z[c] - oz[lane]) * iz[lane];
+                float near = std::max({std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), t_min[lane]});
+                float far = std::min({std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1), t_limit[lane]});
+                masks[c] |= static_cast<std::uint32_t>(near <= far) << lane;
+            }
+            any |= masks[c];
+        }
+        if (any == 0) {
+            continue;
+        }
+
+        for (std::uint32_t c = 0; c < branching; ++c) {
+            if (masks[c] == 0 || node.count[c] == 0) {
+                continue;
+            }
+            for (std::uint32_t p = node.child[c]; p < node.child[c] + node.count[c]; ++p) {
+                const Primitive& primitive = primitives_[p];
+                const utils::Vector3f& center = centers_[p];
+                for (std::uint32_t bits = masks[c]; bits != 0; bits &= bits - 1) {
+                    auto lane = static_cast<std::uint32_t>(std::countr_zero(bits));
+                    const Ray& ray = rays[lane];
+                    float t, alpha;
+                    if (!intersect(primitive, center, ox[lane], oy[lane], oz[lane],
+                                   ray.direction.x, ray.direction.y, ray.direction.z, t, alpha) ||
+                        t < t_min[lane] || t > t_limit[lane]) {
+                        continue;
+                    }
+
+                    RayHit* lane_hits = hits + static_cast<std::size_t>(lane) * max_hits;
+                    insert_hit(lane_hits, hit_counts[lane], max_hits, {indices_[p], t, alpha, 1.0f});
+                    if (hit_counts[lane] == max_hits) {
+                        t_limit[lane] = lane_hits[max_hits - 1].t;
+                    }
+                }
+            }
+        }
+
+        // Interior children are pushed far to near along the packet's
+        // leading ray so the hit lists fill front to back and prune later
+        // subtrees sooner.
+        auto lead = static_cast<std::uint32_t>(std::countr_zero(any));
+        std::uint32_t order[branching];
+        float distance[branching];
+        std::uint32_t interior = 0;
+        for (std::uint32_t c = 0; c < branching; ++c) {
+            if (masks[c] == 0 || node.count[c] != 0) {
+                continue;
+            }
+            float tx = std::min((node.min_x[c] - ox[lead]) * ix[lead], (node.max_x[c] - ox[lead]) * ix[lead]);
+            float ty = std::min((node.min_y[c] - oy[lead]) * iy[lead], (node.max_y[c] - oy[lead]) * iy[lead]);
+            float tz = std::min((node.min_z[c] - oz[lead]) * iz[lead], (node.max_z[c] - oz[lead]) * iz[lead]);
+            float near = std::max({tx, ty, tz});
+            std::uint32_t slot = interior++;
+            while (slot > 0 && distance[slot - 1] < near) {
+                order[slot] = order[slot - 1];
+                distance[slot] = distance[slot - 1];
+                --slot;
+            }
+            order[slot] = node.child[c];
+            distance[slot] = near;
+        }
+        for (std::uint32_t i = 0; i < interior; ++i) {
+            stack[stack_size++] = order[i];
+        }
+    }
+}
+
+RayQueryResult GaussianBVH::cast_rays(std::span<const Ray> rays, std::uint32_t max_hits) const {
+    RayQueryResult result;
+    cast_rays(rays, max_hits, result);
+    return result;
+}
+
+void GaussianBVH::cast_rays(std::span<const Ray> rays, std::uint32_t max_hits, RayQueryResult& result) const {
+    max_hits = std::max<std::uint32_t>(max_hits, 1);
+    result.max_hits = max_hits;
+    result.hits.resize(rays.size() * max_hits);
+    result.hit_counts.assign(rays.size(), 0);
+    result.transmittance.assign(rays.size(), 1.0f);
+    if (empty() || rays.empty()) {
+        return;
+    }
+
+    const std::size_t packets = (rays.size() + packet_size - 1) / packet_size;
+    utils::ThreadPool::instance().parallel_for(0, packets, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t packet = begin; packet < end; ++packet) {
+            std::size_t first = packet * packet_size;
+            auto count = static_cast<std::uint32_t>(std::min<std::size_t>(packet_size, rays.size() - first));
+            trace_packet(rays.data() + first, count, max_hits,
+                         result.hits.data() + first * max_hits, result.hit_counts.data() + first);
+
+            for (std::size_t r = first; r < first + count; ++r) {
+                float transmittance = 1.0f;
+                for (auto& hit : std::span(result.hits.data() + r * max_hits, result.hit_counts[r])) {
+                    hit.transmittance = transmittance;
+                    transmittance *= 1.0f - hit.alpha;
+                }
+                result.transmittance[r] = transmittance;
+            }
+        }
+    }, packet_grain);
+}
+
+bool GaussianBVH::occluded(const Ray& ray, float max_transmittance) const {
+    if (empty()) {
+        return false;
+    }
+
+    // Transmittance is a product, so hits can be taken in any order and the
+    // walk stops as soon as the threshold is crossed.
+    const float inv[3] = {1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z};
+    const float origin[3] = {ray.origin.x, ray.origin.y, ray.origin.z};
+    float transmittance = 1.0f;
+
+    std::array<std::uint32_t, stack_capacity> stack;
+    std::uint32_t stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0) {
+        const Node& node = nodes_[stack[--stack_size]];
+
+        bool hit[branching];
+        for (std::uint32_t c = 0; c < branching; ++c) {
+            float tx0 = (node.min_x[c] - origin[0]) * inv[0];
+            float tx1 = (node.max_x[c] - origin[0]) * inv[0];
+            float ty0 = (node.min_y[c] - origin[1]) * inv[1];
+            float ty1 = (node.max_y[c] - origin[1]) * inv[1];
+            float tz0 = (node.min_z[c] - origin[2]) * inv[2];
+            float tz1 = (node.max_z[c] - origin[2]) * inv[2];
+            float near = std::max({std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), ray.t_min});
+            float far = std::min({std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1), ray.t_max});
+            hit[c] = near <= far;
+        }
+
+        for (std::uint32_t c = 0; c < branching; ++c) {
+            if (!hit[c] || node.child[c] == empty_slot) {
+                continue;
+            }
+            if (node.count[c] == 0) {
+                stack[stack_size++] = node.child[c];
+                continue;
+            }
+
+            for (std::uint32_t p = node.child[c]; p < node.child[c] + node.count[c]; ++p) {
+                float t, alpha;
+                if (intersect(primitives_[p], centers_[p], origin[0], origin[1], origin[2],
+                              ray.direction.x, ray.direction.y, ray.direction.z, t, alpha) &&
+                    t >= ray.t_min && t <= ray.t_max) {
+                    transmittance *= 1.0f - alpha;
+                    if (transmittance < max_transmittance) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "buildify/core/gaussian_instance.hpp"
+#include "buildify/utils/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace buildify::core {
+
+namespace {
+
+// Spreads the low 10 bits of v so two zero bits follow each one.
+std::uint32_t spread_bits(std::uint32_t v) {
+    v &= 0x3ff;
+    v = (v | (v << 16)) & 0x030000ff;
+    v = (v | (v << 8)) & 0x0300f00f;
+    v = (v | (v << 4)) & 0x030c30c3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+}
+
+}
+
+GaussianAsset::GaussianAsset(GaussianCloud cloud, std::size_t cluster_size) : cloud_(std::move(cloud)) {
+    const std::size_t count = cloud_.size();
+    if (count == 0) {
+        return;
+    }
+    cluster_size = std::max<std::size_t>(cluster_size, 1);
+
+    const GaussianCloud& source = cloud_;
+    auto pos_x = source.column(GaussianAttribute::PositionX);
+    auto pos_y = source.column(GaussianAttribute::PositionY);
+    auto pos_z = source.column(GaussianAttribute::PositionZ);
+    utils::Vector3f lo(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                       std::numeric_limits<float>::max());
+    utils::Vector3f hi = lo * -1.0f;
+    for (std::size_t i = 0; i < count; ++i) {
+        lo = {std::min(lo.x, pos_x[i]), std::min(lo.y, pos_y[i]), std::min(lo.z, pos_z[i])};
+        hi = {std::max(hi.x, pos_x[i]), std::max(hi.y, pos_y[i]), std::max(hi.z, pos_z[i])};
+    }
+
+    // Morton order keeps each fixed-size run of splats compact in space.
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> keys(count);
+    auto quantize = [](float value, float min, float max) {
+        float extent = max - min;
+        float t = extent > 0.0f ? (value - min) / extent : 0.0f;
+        return static_cast<std::uint32_t>(std::clamp(t, 0.0f, 1.0f) * 1023.0f);
+    };
+    utils::ThreadPool::instance().parallel_for(0, count, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            std::uint32_t key = spread_bits(quantize(pos_x[i], lo.x, hi.x)) |
+                                (spread_bits(quantize(pos_y[i], lo.y, hi.y)) << 1) |
+                                (spread_bits(quantize(pos_z[i], lo.z, hi.z)) << 2);
+            keys[i] = {key, static_cast<std::uint32_t>(i)};
+        }
+    }, 16384);
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::uint32_t> order(count);
+    std::transform(keys.begin(), keys.end(), order.begin(), [](const auto& key) { return key.second; });
+    cloud_.retain(order);
+
+    pos_x = source.column(GaussianAttribute::PositionX);
+    pos_y = source.column(GaussianAttribute::PositionY);
+    pos_z = source.column(GaussianAttribute::PositionZ);
+    auto scale_x = source.column(GaussianAttribute::ScaleX);
+    auto scale_y = source.column(GaussianAttribute::ScaleY);
+    auto scale_z = source.column(GaussianAttribute::ScaleZ);
+    auto filter_3d = source.filter_3d();
+
+    auto bound = [&](std::size_t first, std::size_t n) {
+        GaussianCluster cluster;
+        cluster.first = static_cast<std::uint32_t>(first);
+        cluster.count = static_cast<std::uint32_t>(n);
+        utils::Vector3f box_lo = {pos_x[first], pos_y[first], pos_z[first]};
+        utils::Vector3f box_hi = box_lo;
+        for (std::size_t i = first; i < first + n; ++i) {
+            box_lo = {std::min(box_lo.x, pos_x[i]), std::min(box_lo.y, pos_y[i]), std::min(box_lo.z, pos_z[i])};
+            box_hi = {std::max(box_hi.x, pos_x[i]), std::max(box_hi.y, pos_y[i]), std::max(box_hi.z, pos_z[i])};
+        }
+        cluster.center = (box_lo + box_hi) * 0.5f;
+        for (std::size_t i = first; i < first + n; ++i) {
+            float extent = std::max({scale_x[i], scale_y[i], scale_z[i]});
+            if (!filter_3d.empty()) {
+                extent = std::sqrt(extent * extent + filter_3d[i] * filter_3d[i]);
+            }
+            float distance = (utils::Vector3f(pos_x[i], pos_y[i], pos_z[i]) - cluster.center).length();
+            cluster.radius = std::max(cluster.radius, distance + 3.0f * extent);
+        }
+        return cluster;
+    };
+
+    clusters_.resize((count + cluster_size - 1) / cluster_size);
+    utils::ThreadPool::instance().parallel_for(0, clusters_.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            clusters_[c] = bound(c * cluster_size, std::min(cluster_size, count - c * cluster_size));
+        }
+    });
+
+    center_ = (lo + hi) * 0.5f;
+    for (const auto& cluster : clusters_) {
+        radius_ = std::max(radius_, (cluster.center - center_).length() + cluster.radius);
+    }
+}
+
+GaussianInstance::GaussianInstance(const std::string& name, std::shared_ptr<const GaussianAsset> asset)
+    : Entity(name), asset_(std::move(asset)) {}
+
+}
\ No newline at end of file
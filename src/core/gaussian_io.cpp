@@ -0,0 +1,225 @@
+#include "buildify/core/gaussian_io.hpp"
+#include "buildify/core/gaussians.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace buildify::core {
+
+namespace {
+
+constexpr char gaussian_magic[4] = {'B', 'G', 'S', 'C'};
+constexpr std::uint32_t gaussian_version = 1;
+constexpr std::size_t chunk_bytes = std::size_t(4) << 20;
+constexpr std::size_t diff_chunk_floats = 16384;
+
+struct GaussianFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t splat_count;
+    std::uint32_t sh_degree;
+    std::uint32_t has_filter_3d;
+};
+static_assert(sizeof(GaussianFileHeader) == 24);
+
+// Attribute columns, then SH rest and the 3D filter, in file order.
+template<typename Cloud>
+auto file_columns(Cloud& cloud) {
+    std::vector<decltype(cloud.sh_rest())> columns;
+    for (std::size_t i = 0; i < GaussianCloud::attribute_count; ++i) {
+        columns.push_back(cloud.column(static_cast<GaussianAttribute>(i)));
+    }
+    columns.push_back(cloud.sh_rest());
+    columns.push_back(cloud.filter_3d());
+    return columns;
+}
+
+// Calls io(pointer, bytes) chunk by chunk over every column; false when
+// io fails or the operation is cancelled.
+template<typename Column, typename Io>
+bool transfer_chunks(const std::vector<Column>& columns, const utils::ProgressCallback& progress,
+                     const utils::CancellationToken& cancel, Io&& io) {
+    std::size_t total = 0;
+    for (const auto& column : columns) {
+        total += column.size_bytes();
+    }
+    std::size_t done = 0;
+    for (const auto& column : columns) {
+        auto* data = reinterpret_cast<std::conditional_t<std::is_const_v<typename Column::element_type>,
+                                                         const char*, char*>>(column.data());
+        for (std::size_t offset = 0; offset < column.size_bytes(); offset += chunk_bytes) {
+            if (cancel.is_cancelled()) {
+                return false;
+            }
+            const std::size_t bytes = std::min(chunk_bytes, column.size_bytes() - offset);
+            if (!io(data + offset, bytes)) {
+                return false;
+            }
+            done += bytes;
+            if (progress) {
+                progress(static_cast<float>(done) / static_cast<float>(total));
+            }
+        }
+    }
+    if (progress && total == 0) {
+        progress(1.0f);
+    }
+    return true;
+}
+
+// Reads and validates the header; a corrupt count must not turn into a
+// huge allocation.
+bool read_header(std::ifstream& file, const std::string& path, GaussianFileHeader& header) {
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || !std::equal(std::begin(gaussian_magic), std::end(gaussian_magic), header.magic) ||
+        header.version != gaussian_version || header.sh_degree > GaussianCloud::max_sh_degree) {
+        utils::log_error("{} is not a Gaussian file", path);
+        return false;
+    }
+    const std::size_t floats_per_splat = GaussianCloud::attribute_count +
+                                         GaussianCloud::sh_rest_coefficients(header.sh_degree) * 3 +
+                                         (header.has_filter_3d != 0 ? 1 : 0);
+    std::error_code error;
+    const auto file_bytes = std::filesystem::file_size(path, error);
+    if (error || (file_bytes - sizeof(header)) / (floats_per_splat * sizeof(float)) < header.splat_count) {
+        utils::log_error("{} is truncated", path);
+        return false;
+    }
+    return true;
+}
+
+}
+
+bool save_gaussians(const std::string& path, const GaussianCloud& cloud,
+                    const utils::ProgressCallback& progress, const utils::CancellationToken& cancel) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        utils::log_error("Failed to open {} for writing", path);
+        return false;
+    }
+
+    GaussianFileHeader header{};
+    std::copy(std::begin(gaussian_magic), std::end(gaussian_magic), header.magic);
+    header.version = gaussian_version;
+    header.splat_count = cloud.size();
+    header.sh_degree = cloud.get_sh_degree();
+    header.has_filter_3d = cloud.has_filter_3d() ? 1 : 0;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const bool written = transfer_chunks(file_columns(cloud), progress, cancel, [&](const char* data, std::size_t bytes) {
+        return static_cast<bool>(file.write(data, static_cast<std::streamsize>(bytes)));
+    }) && file.flush();
+    if (!written) {
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        if (!cancel.is_cancelled()) {
+            utils::log_error("Failed to write Gaussians to {}", path);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool load_gaussians(const std::string& path, GaussianCloud& cloud,
+                    const utils::ProgressCallback& progress, const utils::CancellationToken& cancel) {
+    std::ifstream file(path, std::ios::binary);
+    GaussianFileHeader header{};
+    if (!read_header(file, path, header)) {
+        return false;
+    }
+
+    GaussianCloud loaded(header.sh_degree);
+    loaded.resize(header.splat_count);
+    if (header.has_filter_3d != 0) {
+        loaded.allocate_filter_3d();
+    }
+    const bool read = transfer_chunks(file_columns(loaded), progress, cancel, [&](char* data, std::size_t bytes) {
+        return static_cast<bool>(file.read(data, static_cast<std::streamsize>(bytes)));
+    });
+    if (!read) {
+        if (!cancel.is_cancelled()) {
+            utils::log_error("{} is truncated", path);
+        }
+        return false;
+    }
+
+    // Like an in-place edit for whoever holds `cloud`: same placement, and
+    // a version no cache has seen.
+    const auto placement = cloud.get_memory_placement();
+    const auto version = cloud.get_version();
+    cloud = std::move(loaded);
+    cloud.set_memory_placement(placement);
+    cloud.mark_modified_after(version);
+    return true;
+}
+
+bool reload_gaussians(const std::string& path, GaussianCloud& cloud, GaussianReloadStats& stats) {
+    stats = {};
+    std::ifstream file(path, std::ios::binary);
+    GaussianFileHeader header{};
+    if (!read_header(file, path, header)) {
+        return false;
+    }
+    if (header.splat_count != cloud.size() || header.sh_degree != cloud.get_sh_degree() ||
+        (header.has_filter_3d != 0) != cloud.has_filter_3d()) {
+        if (!load_gaussians(path, cloud)) {
+            return false;
+        }
+        stats.full_load = true;
+        stats.positions_changed = stats.shapes_changed = stats.appearance_changed = true;
+        return true;
+    }
+
+    // Differing chunks are staged so that a failed read leaves the cloud
+    // alone. Bitwise comparison, so NaNs and signed zeros count as data.
+    struct ChangedChunk {
+        std::size_t column;
+        std::size_t offset;
+        std::vector<float> data;
+    };
+    std::vector<ChangedChunk> changed;
+    std::vector<float> buffer(diff_chunk_floats);
+    const auto resident = file_columns(std::as_const(cloud));
+    for (std::size_t c = 0; c < resident.size(); ++c) {
+        const auto column = resident[c];
+        for (std::size_t offset = 0; offset < column.size(); offset += diff_chunk_floats) {
+            const std::size_t count = std::min(diff_chunk_floats, column.size() - offset);
+            const auto bytes = static_cast<std::streamsize>(count * sizeof(float));
+            if (!file.read(reinterpret_cast<char*>(buffer.data()), bytes)) {
+                utils::log_error("{} is truncated", path);
+                return false;
+            }
+            ++stats.chunks;
+            if (std::memcmp(buffer.data(), column.data() + offset, count * sizeof(float)) != 0) {
+                changed.push_back({c, offset, std::vector<float>(buffer.begin(), buffer.begin() + count)});
+            }
+        }
+    }
+
+    stats.changed_chunks = changed.size();
+    if (changed.empty()) {
+        return true;
+    }
+    const auto columns = file_columns(cloud);
+    for (const auto& chunk : changed) {
+        std::copy(chunk.data.begin(), chunk.data.end(), columns[chunk.column].begin() + chunk.offset);
+        if (chunk.column < 3) {
+            stats.positions_changed = true;
+        } else if (chunk.column < static_cast<std::size_t>(GaussianAttribute::ColorR) ||
+                   chunk.column == GaussianCloud::attribute_count + 1) {
+            stats.shapes_changed = true;
+        } else {
+            stats.appearance_changed = true;
+        }
+    }
+    return true;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "buildify/core/gaussians.hpp"
+#include "buildify/core/scene.hpp"
+#include "buildify/utils/thread_pool.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace buildify::core {
+
+GaussianCloud::GaussianCloud(std::uint32_t sh_degree)
+    : sh_degree_(std::min(sh_degree, max_sh_degree)) {
+    if (sh_degree > max_sh_degree) {
+        utils::log_warning("SH degree {} clamped to {}", sh_degree, max_sh_degree);
+    }
+}
+
+void GaussianCloud::reserve(std::size_t count) {
+    for (auto& column : columns_) {
+        column.reserve(count);
+    }
+    sh_rest_.reserve(count * get_sh_rest_stride());
+    if (has_filter_3d()) {
+        filter_3d_.reserve(count);
+    }
+    apply_placement();
+}
+
+void GaussianCloud::resize(std::size_t count) {
+    for (auto& column : columns_) {
+        column.resize(count, 0.0f);
+    }
+
+    // New splats start as unit-scale, identity-rotation Gaussians.
+    for (auto attribute : {GaussianAttribute::ScaleX, GaussianAttribute::ScaleY,
+                           GaussianAttribute::ScaleZ, GaussianAttribute::RotationW}) {
+        auto& column = columns_[static_cast<std::size_t>(attribute)];
+        std::fill(column.begin() + std::min(count_, count), column.end(), 1.0f);
+    }
+
+    sh_rest_.resize(count * get_sh_rest_stride(), 0.0f);
+    if (has_filter_3d()) {
+        filter_3d_.resize(count, 0.0f);
+    }
+    count_ = count;
+    apply_placement();
+    ++version_;
+}
+
+void GaussianCloud::clear() {
+    for (auto& column : columns_) {
+        column.clear();
+    }
+    sh_rest_.clear();
+    filter_3d_.clear();
+    count_ = 0;
+    ++version_;
+}
+
+void GaussianCloud::retain(std::span<const std::uint32_t> indices) {
+    const std::size_t stride = get_sh_rest_stride();
+    auto gather = [&](Column& column, std::size_t width) {
+        Column kept(indices.size() * width);
+        utils::ThreadPool::instance().parallel_for(0, indices.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                std::copy_n(column.begin() + indices[i] * width, width, kept.begin() + i * width);
+            }
+        }, 16384);
+        column = std::move(kept);
+    };
+
+    for (auto& column : columns_) {
+        gather(column, 1);
+    }
+    if (stride > 0) {
+        gather(sh_rest_, stride);
+    }
+    if (has_filter_3d()) {
+        gather(filter_3d_, 1);
+    }
+    count_ = indices.size();
+    apply_placement();
+    ++version_;
+}
+
+std::size_t GaussianCloud::add(const utils::Vector3f& position,
+                               const utils::Vector3f& scale,
+                               const utils::Quaternionf& rotation,
+                               float opacity,
+                               const utils::Vector3f& color) {
+    const std::array<float, attribute_count> values = {
+        position.x, position.y, position.z,
+        scale.x, scale.y, scale.z,
+        rotation.x, rotation.y, rotation.z, rotation.w,
+        opacity,
+        (color.x - 0.5f) / sh_c0,
+        (color.y - 0.5f) / sh_c0,
+        (color.z - 0.5f) / sh_c0,
+    };
+
+    for (std::size_t i = 0; i < attribute_count; ++i) {
+        columns_[i].push_back(values[i]);
+    }
+    sh_rest_.resize(sh_rest_.size() + get_sh_rest_stride(), 0.0f);
+    if (has_filter_3d()) {
+        filter_3d_.push_back(0.0f);
+    }
+
+    ++version_;
+    return count_++;
+}
+
+void GaussianCloud::compute_filter_3d(std::span<const Camera> cameras, std::uint32_t width, std::uint32_t height) {
+    if (count_ == 0) {
+        return;
+    }
+    if (cameras.empty() || width == 0 || height == 0) {
+        utils::log_warning("3D filter needs at least one training camera and a resolution");
+        return;
+    }
+
+    struct TrainingView {
+        utils::Matrix4f view;
+        utils::Matrix4f projection;
+        float focal;
+        bool orthographic;
+    };
+
+    std::vector<TrainingView> views;
+    views.reserve(cameras.size());
+    for (const auto& camera : cameras) {
+        const CameraParams params = camera.get_params();
+        const auto& projection = params.projection;
+        float focal = 0.5f * std::max(width * projection.m[0][0], height * projection.m[1][1]);
+        views.push_back({params.view, projection, focal, params.orthographic});
+    }
+
+    // Matches the Mip-Splatting reference: the filter variance is 0.2 pixels
+    // squared at the finest rate, and points slightly outside the frame still
+    // count so the filter does not jump at the image border.
+    constexpr float filter_variance = 0.2f;
+    constexpr float frame_margin = 1.15f;
+    const float pixel_std = std::sqrt(filter_variance);
+
+    const auto& self = std::as_const(*this);
+    auto pos_x = self.column(GaussianAttribute::PositionX);
+    auto pos_y = self.column(GaussianAttribute::PositionY);
+    auto pos_z = self.column(GaussianAttribute::PositionZ);
+    filter_3d_.assign(count_, 0.0f);
+    apply_placement();
+
+    utils::ThreadPool::instance().parallel_for(0, count_, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            float max_rate = 0.0f;
+            for (const auto& view : views) {
+                const auto& v = view.view.m;
+                const auto& p = view.projection.m;
+                float x = v[0][0] * pos_x[i] + v[0][1] * pos_y[i] + v[0][2] * pos_z[i] + v[0][3];
+                float y = v[1][0] * pos_x[i] + v[1][1] * pos_y[i] + v[1][2] * pos_z[i] + v[1][3];
+                float z = v[2][0] * pos_x[i] + v[2][1] * pos_y[i] + v[2][2] * pos_z[i] + v[2][3];
+
+                float clip_x = p[0][0] * x + p[0][1] * y + p[0][2] * z + p[0][3];
+                float clip_y = p[1][0] * x + p[1][1] * y + p[1][2] * z + p[1][3];
+                float clip_z = p[2][0] * x + p[2][1] * y + p[2][2] * z + p[2][3];
+                float clip_w = p[3][0] * x + p[3][1] * y + p[3][2] * z + p[3][3];
+                if (clip_w <= 0.0f || std::abs(clip_z) > clip_w ||
+                    std::abs(clip_x) > frame_margin * clip_w || std::abs(clip_y) > frame_margin * clip_w) {
+                    continue;
+                }
+
+                float rate = view.orthographic ? view.focal : view.focal / -z;
+                max_rate = std::max(max_rate, rate);
+            }
+            filter_3d_[i] = max_rate > 0.0f ? pixel_std / max_rate : 0.0f;
+        }
+    });
+
+    float largest = *std::max_element(filter_3d_.begin(), filter_3d_.end());
+    std::size_t unseen = 0;
+    for (auto& filter : filter_3d_) {
+        if (filter == 0.0f) {
+            filter = largest;
+            ++unseen;
+        }
+    }
+    if (unseen > 0) {
+        utils::log_debug("{} of {} splats are outside every training view", unseen, count_);
+    }
+
+    ++version_;
+}
+
+void GaussianCloud::set_memory_placement(utils::MemoryPlacement placement) {
+    placement_ = placement;
+    apply_placement();
+}
+
+void GaussianCloud::apply_placement() {
+    if (placement_ == utils::MemoryPlacement::Default || count_ == 0) {
+        return;
+    }
+    const auto weights = utils::ThreadPool::instance().node_weights();
+    auto place = [&](Column& column) {
+        if (!utils::place_memory(column.data(), column.size() * sizeof(float), placement_, weights)) {
+            utils::log_debug("Could not apply the NUMA placement to a Gaussian column");
+        }
+    };
+    for (auto& column : columns_) {
+        place(column);
+    }
+    place(sh_rest_);
+    place(filter_3d_);
+}
+
+void GaussianCloud::allocate_filter_3d() {
+    filter_3d_.assign(count_, 0.0f);
+    apply_placement();
+    ++version_;
+}
+
+void GaussianCloud::clear_filter_3d() {
+    filter_3d_ = {};
+    ++version_;
+}
+
+utils::Vector3f GaussianCloud::get_position(std::size_t index) const {
+    return {column(GaussianAttribute::PositionX)[index],
+            column(GaussianAttribute::PositionY)[index],
+            column(GaussianAttribute::PositionZ)[index]};
+}
+
+utils::Vector3f GaussianCloud::get_color(std::size_t index) const {
+    return {0.5f + sh_c0 * column(GaussianAttribute::ColorR)[index],
+            0.5f + sh_c0 * column(GaussianAttribute::ColorG)[index],
+            0.5f + sh_c0 * column(GaussianAttribute::ColorB)[index]};
+}
+
+std::size_t GaussianCloud::memory_footprint() const {
+    std::size_t bytes = (sh_rest_.capacity() + filter_3d_.capacity()) * sizeof(float);
+    for (const auto& column : columns_) {
+        bytes += column.capacity() * sizeof(float);
+    }
+    return bytes;
+}
+
+}
\ No newline at end of file
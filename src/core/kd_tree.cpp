@@ -0,0 +1,234 @@
+#include "buildify/core/kd_tree.hpp"
+#include "buildify/utils/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace buildify::core {
+
+namespace {
+
+constexpr std::size_t parallel_build_threshold = 65536;
+constexpr std::size_t query_grain = 1024;
+// Deep enough for any median-split tree over 32-bit point counts.
+constexpr std::size_t stack_capacity = 64;
+
+constexpr std::uint32_t leaf_axis = 3;
+
+float axis_value(const utils::Vector3f& p, std::uint32_t axis) {
+    return axis == 0 ? p.x : (axis == 1 ? p.y : p.z);
+}
+
+struct BuildNode {
+    float split = 0.0f;
+    std::uint32_t axis = leaf_axis;
+    std::uint32_t first = 0;
+    std::uint32_t second = 0;
+};
+
+struct BuildPoint {
+    utils::Vector3f position;
+    std::uint32_t index;
+};
+
+// Works on a copy of the points carried alongside their indices, so the
+// median selections stream through contiguous memory.
+class Builder {
+public:
+    Builder(std::vector<BuildPoint>& points, std::vector<BuildNode>& nodes) : points_(points), nodes_(nodes) {}
+
+    std::uint32_t node_count() const { return next_.load(); }
+
+    void build(std::uint32_t node, std::size_t begin, std::size_t end) {
+        const std::size_t count = end - begin;
+        if (count <= KdTree::max_leaf_size) {
+            nodes_[node] = {0.0f, leaf_axis, static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(count)};
+            return;
+        }
+
+        utils::Vector3f lo = points_[begin].position;
+        utils::Vector3f hi = lo;
+        for (std::size_t i = begin + 1; i < end; ++i) {
+            const auto& p = points_[i].position;
+            lo = {std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+            hi = {std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+        }
+        const utils::Vector3f extent = hi - lo;
+        std::uint32_t axis = extent.x >= extent.y ? (extent.x >= extent.z ? 0 : 2) : (extent.y >= extent.z ? 1 : 2);
+
+        std::size_t mid = begin + count / 2;
+        std::nth_element(points_.begin() + begin, points_.begin() + mid, points_.begin() + end,
+                         [axis](const BuildPoint& a, const BuildPoint& b) {
+                             return axis_value(a.position, axis) < axis_value(b.position, axis);
+                         });
+
+        std::uint32_t left = next_.fetch_add(2, std::memory_order_relaxed);
+        std::uint32_t right = left + 1;
+        nodes_[node] = {axis_value(points_[mid].position, axis), axis, left, right};
+
+        if (count >= parallel_build_threshold) {
+            utils::ThreadPool::instance().parallel_for(0, 2, [&](std::size_t first, std::size_t last) {
+                for (std::size_t side = first; side < last; ++side) {
+                    if (side == 0) {
+                        build(left, begin, mid);
+                    } else {
+                        build(right, mid, end);
+                    }
+                }
+            });
+        } else {
+            build(left, begin, mid);
+            build(right, mid, end);
+        }
+    }
+
+private:
+    std::vector<BuildPoint>& points_;
+    std::vector<BuildNode>& nodes_;
+    std::atomic<std::uint32_t> next_{1};
+};
+
+float squared_distance(const utils::Vector3f& a, const utils::Vector3f& b) {
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    float dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+}
+
+void KdTree::build(std::span<const utils::Vector3f> points) {
+    clear();
+    if (points.empty()) {
+        return;
+    }
+
+    // Leaves hold at least max_leaf_size / 2 points, which bounds the node
+    // count; the builder claims nodes from that budget concurrently.
+    const std::size_t capacity = 4 * points.size() / max_leaf_size + 2;
+    std::vector<BuildNode> nodes(capacity);
+    std::vector<BuildPoint> ordered(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        ordered[i] = {points[i], static_cast<std::uint32_t>(i)};
+    }
+
+    Builder builder(ordered, nodes);
+    builder.build(0, 0, points.size());
+
+    nodes_.resize(builder.node_count());
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        nodes_[i] = {nodes[i].split, nodes[i].axis, nodes[i].first, nodes[i].second};
+    }
+    points_.resize(points.size());
+    indices_.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        points_[i] = ordered[i].position;
+        indices_[i] = ordered[i].index;
+    }
+}
+
+void KdTree::clear() {
+    nodes_.clear();
+    points_.clear();
+    indices_.clear();
+}
+
+bool KdTree::nearest(const utils::Vector3f& query, std::uint32_t& index, float& distance2, float max_distance) const {
+    std::uint32_t count = knn(query, 1, &index, &distance2, max_distance);
+    return count == 1;
+}
+
+std::uint32_t KdTree::knn(const utils::Vector3f& query, std::uint32_t k, std::uint32_t* indices,
+                          float* distances2, float max_distance) const {
+    if (nodes_.empty() || k == 0) {
+        return 0;
+    }
+
+    // Worst kept distance bounds the search; until k points are found it is
+    // the range limit. Each pending subtree carries its squared distance
+    // from the query along with the per-axis offsets that make it up, so
+    // the bound tightens as the search crosses more splitting planes.
+    const float limit2 = max_distance * max_distance;
+    std::uint32_t found = 0;
+    float worst2 = limit2;
+
+    struct Entry {
+        std::uint32_t node;
+        float distance2;
+        float offset[3];
+    };
+    Entry stack[stack_capacity];
+    std::size_t top = 0;
+    stack[top++] = {0, 0.0f, {0.0f, 0.0f, 0.0f}};
+
+    while (top > 0) {
+        Entry entry = stack[--top];
+        if (entry.distance2 > worst2) {
+            continue;
+        }
+
+        std::uint32_t node_index = entry.node;
+        while (nodes_[node_index].axis != leaf_axis) {
+            const Node& node = nodes_[node_index];
+            float delta = axis_value(query, node.axis) - node.split;
+            std::uint32_t near = delta < 0.0f ? node.first : node.second;
+            std::uint32_t far = delta < 0.0f ? node.second : node.first;
+            float far2 = entry.distance2 - entry.offset[node.axis] * entry.offset[node.axis] + delta * delta;
+            if (far2 <= worst2) {
+                Entry& pending = stack[top++];
+                pending = entry;
+                pending.node = far;
+                pending.distance2 = far2;
+                pending.offset[node.axis] = delta;
+            }
+            node_index = near;
+        }
+
+        const Node& node = nodes_[node_index];
+        for (std::uint32_t i = node.first; i < node.first + node.second; ++i) {
+            float d2 = squared_distance(points_[i], query);
+            if (d2 > worst2 || (found == k && d2 >= worst2)) {
+                continue;
+            }
+            std::uint32_t slot = found < k ? found++ : k - 1;
+            while (slot > 0 && distances2[slot - 1] > d2) {
+                distances2[slot] = distances2[slot - 1];
+                indices[slot] = indices[slot - 1];
+                --slot;
+            }
+            distances2[slot] = d2;
+            indices[slot] = indices_[i];
+            if (found == k) {
+                worst2 = distances2[k - 1];
+            }
+        }
+    }
+    return found;
+}
+
+void KdTree::nearest_batch(std::span<const utils::Vector3f> queries, std::span<std::uint32_t> indices,
+                           std::span<float> distances2, float max_distance) const {
+    utils::ThreadPool::instance().parallel_for(0, queries.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t q = begin; q < end; ++q) {
+            if (!nearest(queries[q], indices[q], distances2[q], max_distance)) {
+                indices[q] = std::numeric_limits<std::uint32_t>::max();
+                distances2[q] = std::numeric_limits<float>::infinity();
+            }
+        }
+    }, query_grain);
+}
+
+void KdTree::knn_batch(std::span<const utils::Vector3f> queries, std::uint32_t k, std::span<std::uint32_t> indices,
+                       std::span<float> distances2, float max_distance) const {
+    utils::ThreadPool::instance().parallel_for(0, queries.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t q = begin; q < end; ++q) {
+            std::uint32_t* query_indices = indices.data() + q * k;
+            float* query_distances2 = distances2.data() + q * k;
+            std::uint32_t found = knn(queries[q], k, query_indices, query_distances2, max_distance);
+            std::fill(query_indices + found, query_indices + k, std::numeric_limits<std::uint32_t>::max());
+            std::fill(query_distances2 + found, query_distances2 + k, std::numeric_limits<float>::infinity());
+        }
+    }, query_grain);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include "buildify/core/point_filters.hpp"
+#include "buildify/core/gaussians.hpp"
+#include "buildify/core/kd_tree.hpp"
+#include "buildify/utils/thread_pool.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace buildify::core {
+
+namespace {
+
+// Points per partitioning task; each task keeps one counter per bucket.
+constexpr std::size_t partition_chunk = 65536;
+// Buckets are sized for about this many points, up to max_buckets.
+constexpr std::size_t points_per_bucket = 4096;
+constexpr std::size_t max_buckets = 1024;
+// Queries per kNN batch in outlier removal, bounding the neighbour buffers.
+constexpr std::size_t outlier_batch = 262144;
+constexpr std::size_t reduce_grain = 65536;
+constexpr std::uint32_t max_neighbors = 64;
+
+constexpr std::int64_t cell_bias = std::int64_t{1} << 20;
+constexpr std::int64_t cell_max = (std::int64_t{1} << 21) - 1;
+constexpr std::uint64_t empty_key = std::numeric_limits<std::uint64_t>::max();
+
+std::uint64_t hash_key(std::uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return key;
+}
+
+// Points grouped by bucket, then by voxel within each bucket. A voxel never
+// spans buckets, so per-voxel reductions can run bucket by bucket.
+struct VoxelPartition {
+    std::vector<std::uint32_t> order;
+    // Global voxel of order[i]; voxels are numbered by first appearance.
+    std::vector<std::uint32_t> voxel;
+    std::vector<std::size_t> point_offsets;
+    std::vector<std::size_t> voxel_offsets;
+
+    std::size_t bucket_count() const { return point_offsets.size() - 1; }
+    std::size_t voxel_count() const { return voxel_offsets.back(); }
+};
+
+template<typename Position>
+VoxelPartition partition_voxels(std::size_t count, Position position, float voxel_size) {
+    VoxelPartition partition;
+    const float inverse = 1.0f / voxel_size;
+    auto key_of = [&](std::size_t i) {
+        utils::Vector3f p = position(i);
+        auto cell = [&](float v) {
+            auto c = static_cast<std::int64_t>(std::floor(v * inverse)) + cell_bias;
+            return static_cast<std::uint64_t>(std::clamp<std::int64_t>(c, 0, cell_max));
+        };
+        return (cell(p.x) << 42) | (cell(p.y) << 21) | cell(p.z);
+    };
+
+    const std::size_t buckets = std::bit_ceil(std::clamp<std::size_t>(count / points_per_bucket, 1, max_buckets));
+    const int bucket_shift = 64 - std::countr_zero(buckets);
+    auto bucket_of = [&](std::uint64_t key) {
+        return buckets == 1 ? std::size_t{0} : static_cast<std::size_t>(hash_key(key) >> bucket_shift);
+    };
+
+    // Counting pass, then a stable scatter of point indices and keys into
+    // bucket order.
+    const std::size_t chunks = (count + partition_chunk - 1) / partition_chunk;
+    std::vector<std::size_t> offsets(chunks * buckets, 0);
+    std::vector<std::uint64_t> keys(count);
+    auto& pool = utils::ThreadPool::instance();
+    pool.parallel_for(0, chunks, [&](std::size_t first, std::size_t last) {
+        for (std::size_t chunk = first; chunk < last; ++chunk) {
+            std::size_t* counts = offsets.data() + chunk * buckets;
+            const std::size_t end = std::min(count, (chunk + 1) * partition_chunk);
+            for (std::size_t i = chunk * partition_chunk; i < end; ++i) {
+                keys[i] = key_of(i);
+                ++counts[bucket_of(keys[i])];
+            }
+        }
+    });
+
+    partition.point_offsets.assign(buckets + 1, 0);
+    std::size_t running = 0;
+    for (std::size_t b = 0; b < buckets; ++b) {
+        partition.point_offsets[b] = running;
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            std::size_t n = offsets[chunk * buckets + b];
+            offsets[chunk * buckets + b] = running;
+            running += n;
+        }
+    }
+    partition.point_offsets[buckets] = running;
+
+    partition.order.resize(count);
+    std::vector<std::uint64_t> sorted_keys(count);
+    pool.parallel_for(0, chunks, [&](std::size_t first, std::size_t last) {
+        for (std::size_t chunk = first; chunk < last; ++chunk) {
+            std::size_t* cursor = offsets.data() + chunk * buckets;
+            const std::size_t end = std::min(count, (chunk + 1) * partition_chunk);
+            for (std::size_t i = chunk * partition_chunk; i < end; ++i) {
+                std::size_t slot = cursor[bucket_of(keys[i])]++;
+                partition.order[slot] = static_cast<std::uint32_t>(i);
+                sorted_keys[slot] = keys[i];
+            }
+        }
+    });
+    keys = {};
+
+    // Each bucket numbers its voxels through a private open-addressing table.
+    partition.voxel.resize(count);
+    std::vector<std::size_t> bucket_voxels(buckets + 1, 0);
+    pool.parallel_for(0, buckets, [&](std::size_t first, std::size_t last) {
+        std::vector<std::uint64_t> table_keys;
+        std::vector<std::uint32_t> table_ids;
+        for (std::size_t b = first; b < last; ++b) {
+            const std::size_t begin = partition.point_offsets[b];
+            const std::size_t end = partition.point_offsets[b + 1];
+            const std::size_t capacity = std::bit_ceil(std::max<std::size_t>(2 * (end - begin), 16));
+            table_keys.assign(capacity, empty_key);
+            table_ids.resize(capacity);
+            std::uint32_t next = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::uint64_t key = sorted_keys[i];
+                std::size_t slot = hash_key(key) & (capacity - 1);
+                while (table_keys[slot] != key && table_keys[slot] != empty_key) {
+                    slot = (slot + 1) & (capacity - 1);
+                }
+                if (table_keys[slot] == empty_key) {
+                    table_keys[slot] = key;
+                    table_ids[slot] = next++;
+                }
+                partition.voxel[i] = table_ids[slot];
+            }
+            bucket_voxels[b + 1] = next;
+        }
+    });
+
+    for (std::size_t b = 0; b < buckets; ++b) {
+        bucket_voxels[b + 1] += bucket_voxels[b];
+    }
+    pool.parallel_for(0, buckets, [&](std::size_t first, std::size_t last) {
+        for (std::size_t b = first; b < last; ++b) {
+            for (std::size_t i = partition.point_offsets[b]; i < partition.point_offsets[b + 1]; ++i) {
+                partition.voxel[i] += static_cast<std::uint32_t>(bucket_voxels[b]);
+            }
+        }
+    });
+    partition.voxel_offsets = std::move(bucket_voxels);
+    return partition;
+}
+
+// Mean distance from every point to its k nearest neighbours (itself
+// excluded), queried in tree order so consecutive queries share leaves.
+std::vector<float> mean_neighbor_distances(std::span<const utils::Vector3f> points, std::uint32_t neighbors) {
+    KdTree tree;
+    tree.build(points);
+    const std::uint32_t k = std::clamp<std::uint32_t>(neighbors, 1, max_neighbors - 1) + 1;
+    auto queries = tree.ordered_points();
+    auto original = tree.ordered_indices();
+
+    std::vector<float> means(points.size(), 0.0f);
+    std::vector<std::uint32_t> indices(std::min(outlier_batch, points.size()) * k);
+    std::vector<float> distances2(indices.size());
+    for (std::size_t begin = 0; begin < points.size(); begin += outlier_batch) {
+        const std::size_t end = std::min(points.size(), begin + outlier_batch);
+        tree.knn_batch(queries.subspan(begin, end - begin), k, indices, distances2);
+        utils::ThreadPool::instance().parallel_for(begin, end, [&](std::size_t first, std::size_t last) {
+            for (std::size_t q = first; q < last; ++q) {
+                const float* d2 = distances2.data() + (q - begin) * k;
+                float sum = 0.0f;
+                std::uint32_t found = 0;
+                for (std::uint32_t j = 1; j < k && std::isfinite(d2[j]); ++j) {
+                    sum += std::sqrt(d2[j]);
+                    ++found;
+                }
+                means[original[q]] = found > 0 ? sum / static_cast<float>(found) : 0.0f;
+            }
+        }, reduce_grain);
+    }
+    return means;
+}
+
+}
+
+std::vector<utils::Vector3f> voxel_downsample(std::span<const utils::Vector3f> points, float voxel_size) {
+    std::vector<utils::Vector3f> result;
+    std::vector<utils::Vector3f> colors;
+    voxel_downsample(points, {}, voxel_size, result, colors);
+    return result;
+}
+
+void voxel_downsample(std::span<const utils::Vector3f> points, std::span<const utils::Vector3f> colors,
+                      float voxel_size, std::vector<utils::Vector3f>& out_points,
+                      std::vector<utils::Vector3f>& out_colors) {
+    out_points.clear();
+    out_colors.clear();
+    if (!(voxel_size > 0.0f)) {
+        utils::log_error("Voxel size must be positive, got {}", voxel_size);
+        return;
+    }
+    const bool with_colors = !colors.empty();
+    if (with_colors && colors.size() != points.size()) {
+        utils::log_error("Expected {} colors, got {}", points.size(), colors.size());
+        return;
+    }
+
+    auto partition = partition_voxels(points.size(), [&](std::size_t i) { return points[i]; }, voxel_size);
+    out_points.resize(partition.voxel_count());
+    if (with_colors) {
+        out_colors.resize(partition.voxel_count());
+    }
+
+    utils::ThreadPool::instance().parallel_for(0, partition.bucket_count(), [&](std::size_t first, std::size_t last) {
+        std::vector<double> sums;
+        std::vector<std::uint32_t> counts;
+        for (std::size_t b = first; b < last; ++b) {
+            const std::size_t voxel_begin = partition.voxel_offsets[b];
+            const std::size_t voxels = partition.voxel_offsets[b + 1] - voxel_begin;
+            sums.assign(voxels * 6, 0.0);
+            counts.assign(voxels, 0);
+            for (std::size_t i = partition.point_offsets[b]; i < partition.point_offsets[b + 1]; ++i) {
+                const std::size_t v = partition.voxel[i] - voxel_begin;
+                const std::uint32_t index = partition.order[i];
+                double* sum = sums.data() + v * 6;
+                sum[0] += points[index].x;
+                sum[1] += points[index].y;
+                sum[2] += points[index].z;
+                if (with_colors) {
+                    sum[3] += colors[index].x;
+                    sum[4] += colors[index].y;
+                    sum[5] += colors[index].z;
+                }
+                ++counts[v];
+            }
+            for (std::size_t v = 0; v < voxels; ++v) {
+                const double* sum = sums.data() + v * 6;
+                const double scale = 1.0 / counts[v];
+                out_points[voxel_begin + v] = {static_cast<float>(sum[0] * scale), static_cast<float>(sum[1] * scale),
+                                               static_cast<float>(sum[2] * scale)};
+                if (with_colors) {
+                    out_colors[voxel_begin + v] = {static_cast<float>(sum[3] * scale),
+                                                   static_cast<float>(sum[4] * scale),
+                                                   static_cast<float>(sum[5] * scale)};
+                }
+            }
+        }
+    });
+}
+
+std::size_t voxel_downsample(GaussianCloud& cloud, float voxel_size) {
+    if (!(voxel_size > 0.0f)) {
+        utils::log_error("Voxel size must be positive, got {}", voxel_size);
+        return 0;
+    }
+    const auto& splats = std::as_const(cloud);
+    auto x = splats.column(GaussianAttribute::PositionX);
+    auto y = splats.column(GaussianAttribute::PositionY);
+    auto z = splats.column(GaussianAttribute::PositionZ);
+    auto opacity = splats.column(GaussianAttribute::Opacity);
+    auto partition = partition_voxels(cloud.size(), [&](std::size_t i) { return utils::Vector3f(x[i], y[i], z[i]); },
+                                      voxel_size);
+
+    std::vector<std::uint32_t> kept(partition.voxel_count(), std::numeric_limits<std::uint32_t>::max());
+    utils::ThreadPool::instance().parallel_for(0, partition.bucket_count(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t b = first; b < last; ++b) {
+            for (std::size_t i = partition.point_offsets[b]; i < partition.point_offsets[b + 1]; ++i) {
+                std::uint32_t& best = kept[partition.voxel[i]];
+                const std::uint32_t index = partition.order[i];
+                // Points within a bucket keep their input order, so ties go
+                // to the earlier splat.
+                if (best == std::numeric_limits<std::uint32_t>::max() || opacity[index] > opacity[best]) {
+                    best = index;
+                }
+            }
+        }
+    });
+    std::sort(kept.begin(), kept.end());
+
+    const std::size_t removed = cloud.size() - kept.size();
+    if (removed > 0) {
+        cloud.retain(kept);
+    }
+    return removed;
+}
+
+std::vector<std::uint8_t> statistical_inlier_mask(std::span<const utils::Vector3f> points, std::uint32_t neighbors,
+                                                  float std_ratio) {
+    std::vector<std::uint8_t> mask(points.size(), 1);
+    if (points.size() <= neighbors) {
+        return mask;
+    }
+
+    std::vector<float> means = mean_neighbor_distances(points, neighbors);
+    const std::size_t chunks = (points.size() + reduce_grain - 1) / reduce_grain;
+    std::vector<double> sums(chunks * 2, 0.0);
+    utils::ThreadPool::instance().parallel_for(0, chunks, [&](std::size_t first, std::size_t last) {
+        for (std::size_t chunk = first; chunk < last; ++chunk) {
+            const std::size_t end = std::min(points.size(), (chunk + 1) * reduce_grain);
+            double sum = 0.0;
+            double sum2 = 0.0;
+            for (std::size_t i = chunk * reduce_grain; i < end; ++i) {
+                sum += means[i];
+                sum2 += static_cast<double>(means[i]) * means[i];
+            }
+            sums[chunk * 2] = sum;
+            sums[chunk * 2 + 1] = sum2;
+        }
+    });
+    double sum = 0.0;
+    double sum2 = 0.0;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        sum += sums[chunk * 2];
+        sum2 += sums[chunk * 2 + 1];
+    }
+    const double n = static_cast<double>(points.size());
+    const double mean = sum / n;
+    const double deviation = std::sqrt(std::max(0.0, sum2 / n - mean * mean));
+    const auto threshold = static_cast<float>(mean + std_ratio * deviation);
+
+    utils::ThreadPool::instance().parallel_for(0, points.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            mask[i] = means[i] <= threshold;
+        }
+    }, reduce_grain);
+    return mask;
+}
+
+std::size_t remove_statistical_outliers(GaussianCloud& cloud, std::uint32_t neighbors, float std_ratio) {
+    const auto& splats = std::as_const(cloud);
+    auto x = splats.column(GaussianAttribute::PositionX);
+    auto y = splats.column(GaussianAttribute::PositionY);
+    auto z = splats.column(GaussianAttribute::PositionZ);
+    std::vector<utils::Vector3f> centers(cloud.size());
+    utils::ThreadPool::instance().parallel_for(0, centers.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            centers[i] = {x[i], y[i], z[i]};
+        }
+    }, reduce_grain);
+
+    auto mask = statistical_inlier_mask(centers, neighbors, std_ratio);
+    std::vector<std::uint32_t> kept;
+    kept.reserve(mask.size());
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        if (mask[i]) {
+            kept.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    const std::size_t removed = cloud.size() - kept.size();
+    if (removed > 0) {
+        cloud.retain(kept);
+    }
+    return removed;
+}
+
+}
\ No newline at end of file
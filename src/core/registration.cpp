@@ -0,0 +1,468 @@
+#include "buildify/core/registration.hpp"
+#include "buildify/core/kd_tree.hpp"
+#include "buildify/core/point_filters.hpp"
+#include "buildify/utils/thread_pool.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace buildify::core {
+
+namespace {
+
+// Source points per correspondence chunk; partial sums are kept per chunk
+// so the reduction is deterministic regardless of scheduling.
+constexpr std::size_t chunk_size = 1024;
+constexpr std::size_t normal_grain = 4096;
+// Accumulators are kept per lane and summed at the end of a chunk, so the
+// inner loops are independent vertical adds the compiler can vectorize.
+constexpr std::size_t lanes = 8;
+// JtJ upper triangle (21), Jtr (6), then squared residuals.
+constexpr std::size_t hessian_terms = 21;
+constexpr std::size_t system_terms = hessian_terms + 6 + 1;
+constexpr std::uint32_t max_neighbors = 64;
+// Levels derived from the target's extent when none are given, as multiples
+// of its diagonal / default_voxel_divisions; 0 is full resolution.
+constexpr float default_voxel_divisions = 256.0f;
+constexpr float default_levels[] = {4.0f, 2.0f, 1.0f, 0.0f};
+constexpr float correspondence_voxels = 3.0f;
+
+struct Pose {
+    double rotation[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    double translation[3] = {0, 0, 0};
+};
+
+Pose pose_from_matrix(const utils::Matrix4f& m) {
+    Pose pose;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            pose.rotation[r][c] = m.m[r][c];
+        }
+        pose.translation[r] = m.m[r][3];
+    }
+    return pose;
+}
+
+utils::Matrix4f pose_to_matrix(const Pose& pose) {
+    utils::Matrix4f m;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            m.m[r][c] = static_cast<float>(pose.rotation[r][c]);
+        }
+        m.m[r][3] = static_cast<float>(pose.translation[r]);
+    }
+    return m;
+}
+
+// Applies the rotation exp([omega]x) and translation t on the left of pose.
+void compose_update(Pose& pose, const double omega[3], const double t[3]) {
+    double angle = std::sqrt(omega[0] * omega[0] + omega[1] * omega[1] + omega[2] * omega[2]);
+    double delta[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    if (angle > 0.0) {
+        double k[3] = {omega[0] / angle, omega[1] / angle, omega[2] / angle};
+        double s = std::sin(angle);
+        double c = 1.0 - std::cos(angle);
+        double kx[3][3] = {{0, -k[2], k[1]}, {k[2], 0, -k[0]}, {-k[1], k[0], 0}};
+        for (int r = 0; r < 3; ++r) {
+            for (int col = 0; col < 3; ++col) {
+                double kx2 = 0.0;
+                for (int i = 0; i < 3; ++i) {
+                    kx2 += kx[r][i] * kx[i][col];
+                }
+                delta[r][col] += s * kx[r][col] + c * kx2;
+            }
+        }
+    }
+
+    Pose result;
+    for (int r = 0; r < 3; ++r) {
+        for (int col = 0; col < 3; ++col) {
+            result.rotation[r][col] = delta[r][0] * pose.rotation[0][col] + delta[r][1] * pose.rotation[1][col] +
+                                      delta[r][2] * pose.rotation[2][col];
+        }
+        result.translation[r] = delta[r][0] * pose.translation[0] + delta[r][1] * pose.translation[1] +
+                                delta[r][2] * pose.translation[2] + t[r];
+    }
+    pose = result;
+}
+
+// Solves the 6x6 system in place by Cholesky; false when it is singular.
+bool solve_6x6(double a[6][6], double b[6]) {
+    for (int j = 0; j < 6; ++j) {
+        double d = a[j][j];
+        for (int k = 0; k < j; ++k) {
+            d -= a[j][k] * a[j][k];
+        }
+        if (!(d > 0.0)) {
+            return false;
+        }
+        a[j][j] = std::sqrt(d);
+        for (int i = j + 1; i < 6; ++i) {
+            double s = a[i][j];
+            for (int k = 0; k < j; ++k) {
+                s -= a[i][k] * a[j][k];
+            }
+            a[i][j] = s / a[j][j];
+        }
+    }
+    for (int i = 0; i < 6; ++i) {
+        for (int k = 0; k < i; ++k) {
+            b[i] -= a[i][k] * b[k];
+        }
+        b[i] /= a[i][i];
+    }
+    for (int i = 5; i >= 0; --i) {
+        for (int k = i + 1; k < 6; ++k) {
+            b[i] -= a[k][i] * b[k];
+        }
+        b[i] /= a[i][i];
+    }
+    return true;
+}
+
+// Eigenvector of the smallest eigenvalue of a symmetric 3x3 matrix, by
+// cyclic Jacobi rotations.
+utils::Vector3f smallest_eigenvector(double a[3][3]) {
+    double v[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    for (int sweep = 0; sweep < 16; ++sweep) {
+        double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        double scale = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+        if (off <= 1e-24 * scale || off == 0.0) {
+            break;
+        }
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (a[p][q] == 0.0) {
+                    continue;
+                }
+                double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                double t = std::copysign(1.0, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                double c = 1.0 / std::sqrt(t * t + 1.0);
+                double s = t * c;
+                for (int k = 0; k < 3; ++k) {
+                    double akp = a[k][p];
+                    double akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    double apk = a[p][k];
+                    double aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    double vkp = v[k][p];
+                    double vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    int smallest = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (a[i][i] < a[smallest][smallest]) {
+            smallest = i;
+        }
+    }
+    utils::Vector3f n(static_cast<float>(v[0][smallest]), static_cast<float>(v[1][smallest]),
+                      static_cast<float>(v[2][smallest]));
+    return n.normalized();
+}
+
+float robust_weight(RobustKernel kernel, float residual, float scale) {
+    float a = std::abs(residual);
+    switch (kernel) {
+        case RobustKernel::Huber:
+            return a <= scale ? 1.0f : scale / a;
+        case RobustKernel::Tukey: {
+            if (a >= scale) {
+                return 0.0f;
+            }
+            float u = 1.0f - (residual / scale) * (residual / scale);
+            return u * u;
+        }
+        case RobustKernel::Cauchy:
+            return 1.0f / (1.0f + (residual / scale) * (residual / scale));
+        case RobustKernel::None:
+            break;
+    }
+    return 1.0f;
+}
+
+struct LevelResult {
+    std::uint32_t iterations = 0;
+    std::size_t correspondences = 0;
+    double squared_residuals = 0.0;
+    bool converged = false;
+};
+
+using Partial = std::array<double, system_terms + 1>;
+
+// Linearizes the point-to-plane error of every source point against its
+// nearest target point under `pose`, summed per chunk.
+void accumulate(std::span<const utils::Vector3f> source, const KdTree& tree,
+                std::span<const utils::Vector3f> target, std::span<const utils::Vector3f> normals,
+                const Pose& pose, float max_distance, RobustKernel kernel, float kernel_scale,
+                std::vector<Partial>& partials) {
+    float r[3][3];
+    float t[3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            r[i][j] = static_cast<float>(pose.rotation[i][j]);
+        }
+        t[i] = static_cast<float>(pose.translation[i]);
+    }
+
+    const std::size_t chunks = (source.size() + chunk_size - 1) / chunk_size;
+    partials.assign(chunks, Partial{});
+    utils::ThreadPool::instance().parallel_for(0, chunks, [&](std::size_t first_chunk, std::size_t last_chunk) {
+        // Jacobian rows [p' x n, n], residual and weight for the chunk, padded
+        // to whole lanes with zero weight.
+        alignas(32) float jac[6][chunk_size];
+        alignas(32) float res[chunk_size];
+        alignas(32) float weight[chunk_size];
+
+        for (std::size_t chunk = first_chunk; chunk < last_chunk; ++chunk) {
+            const std::size_t begin = chunk * chunk_size;
+            const std::size_t count = std::min(chunk_size, source.size() - begin);
+            const std::size_t padded = (count + lanes - 1) / lanes * lanes;
+            std::size_t matched = 0;
+
+            for (std::size_t i = 0; i < padded; ++i) {
+                weight[i] = 0.0f;
+                res[i] = 0.0f;
+                for (int k = 0; k < 6; ++k) {
+                    jac[k][i] = 0.0f;
+                }
+                if (i >= count) {
+                    continue;
+                }
+                const auto& s = source[begin + i];
+                utils::Vector3f p(r[0][0] * s.x + r[0][1] * s.y + r[0][2] * s.z + t[0],
+                                  r[1][0] * s.x + r[1][1] * s.y + r[1][2] * s.z + t[1],
+                                  r[2][0] * s.x + r[2][1] * s.y + r[2][2] * s.z + t[2]);
+                std::uint32_t index;
+                float distance2;
+                if (!tree.nearest(p, index, distance2, max_distance)) {
+                    continue;
+                }
+                const auto& n = normals[index];
+                float residual = (p - target[index]).dot(n);
+                utils::Vector3f c = p.cross(n);
+                jac[0][i] = c.x;
+                jac[1][i] = c.y;
+                jac[2][i] = c.z;
+                jac[3][i] = n.x;
+                jac[4][i] = n.y;
+                jac[5][i] = n.z;
+                res[i] = residual;
+                weight[i] = robust_weight(kernel, residual, kernel_scale);
+                ++matched;
+            }
+
+            alignas(32) float acc[system_terms][lanes] = {};
+            for (std::size_t i = 0; i < padded; i += lanes) {
+                std::size_t term = 0;
+                for (int a = 0; a < 6; ++a) {
+                    for (int b = a; b < 6; ++b, ++term) {
+                        for (std::size_t l = 0; l < lanes; ++l) {
+                            acc[term][l] += weight[i + l] * jac[a][i + l] * jac[b][i + l];
+                        }
+                    }
+                }
+                for (int a = 0; a < 6; ++a, ++term) {
+                    for (std::size_t l = 0; l < lanes; ++l) {
+                        acc[term][l] += weight[i + l] * jac[a][i + l] * res[i + l];
+                    }
+                }
+                for (std::size_t l = 0; l < lanes; ++l) {
+                    acc[term][l] += res[i + l] * res[i + l];
+                }
+            }
+
+            Partial& partial = partials[chunk];
+            for (std::size_t term = 0; term < system_terms; ++term) {
+                double sum = 0.0;
+                for (std::size_t l = 0; l < lanes; ++l) {
+                    sum += acc[term][l];
+                }
+                partial[term] = sum;
+            }
+            partial[system_terms] = static_cast<double>(matched);
+        }
+    });
+}
+
+LevelResult align_level(std::span<const utils::Vector3f> source, std::span<const utils::Vector3f> target,
+                        const IcpSettings& settings, float max_distance, Pose& pose) {
+    LevelResult result;
+    KdTree tree;
+    tree.build(target);
+    std::vector<utils::Vector3f> normals = estimate_normals(target, tree, settings.normal_neighbors);
+
+    const float kernel_scale = settings.kernel_scale > 0.0f ? settings.kernel_scale : max_distance / 3.0f;
+    std::vector<Partial> partials;
+    for (std::uint32_t iteration = 0; iteration < settings.max_iterations; ++iteration) {
+        accumulate(source, tree, target, normals, pose, max_distance, settings.kernel, kernel_scale, partials);
+        Partial total{};
+        for (const auto& partial : partials) {
+            for (std::size_t term = 0; term < total.size(); ++term) {
+                total[term] += partial[term];
+            }
+        }
+        result.iterations = iteration + 1;
+        result.correspondences = static_cast<std::size_t>(total[system_terms]);
+        result.squared_residuals = total[system_terms - 1];
+        if (result.correspondences < 6) {
+            utils::log_warning("ICP: only {} correspondences within {}", result.correspondences, max_distance);
+            break;
+        }
+
+        double a[6][6];
+        double b[6];
+        std::size_t term = 0;
+        for (int i = 0; i < 6; ++i) {
+            for (int j = i; j < 6; ++j, ++term) {
+                a[i][j] = a[j][i] = total[term];
+            }
+        }
+        double trace = 0.0;
+        for (int i = 0; i < 6; ++i) {
+            b[i] = -total[hessian_terms + i];
+            trace += a[i][i];
+        }
+        // Light damping keeps degenerate geometry (a plane, a line) solvable.
+        for (int i = 0; i < 6; ++i) {
+            a[i][i] += 1e-9 * trace + 1e-12;
+        }
+        if (!solve_6x6(a, b)) {
+            utils::log_warning("ICP: singular point-to-plane system");
+            break;
+        }
+        compose_update(pose, b, b + 3);
+
+        double rotation = std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+        double translation = std::sqrt(b[3] * b[3] + b[4] * b[4] + b[5] * b[5]);
+        if (rotation < settings.rotation_tolerance && translation < settings.translation_tolerance) {
+            result.converged = true;
+            break;
+        }
+    }
+    return result;
+}
+
+}
+
+std::vector<utils::Vector3f> estimate_normals(std::span<const utils::Vector3f> points, const KdTree& tree,
+                                              std::uint32_t neighbors) {
+    const std::uint32_t k = std::clamp<std::uint32_t>(neighbors, 3, max_neighbors);
+    std::vector<utils::Vector3f> normals(points.size(), utils::Vector3f(0.0f, 0.0f, 1.0f));
+    utils::ThreadPool::instance().parallel_for(0, points.size(), [&](std::size_t begin, std::size_t end) {
+        std::uint32_t indices[max_neighbors];
+        float distances2[max_neighbors];
+        for (std::size_t i = begin; i < end; ++i) {
+            std::uint32_t found = tree.knn(points[i], k, indices, distances2);
+            if (found < 3) {
+                continue;
+            }
+            double mean[3] = {0, 0, 0};
+            for (std::uint32_t j = 0; j < found; ++j) {
+                const auto& p = points[indices[j]];
+                mean[0] += p.x;
+                mean[1] += p.y;
+                mean[2] += p.z;
+            }
+            for (double& m : mean) {
+                m /= found;
+            }
+            double cov[3][3] = {};
+            for (std::uint32_t j = 0; j < found; ++j) {
+                const auto& p = points[indices[j]];
+                double d[3] = {p.x - mean[0], p.y - mean[1], p.z - mean[2]};
+                for (int r = 0; r < 3; ++r) {
+                    for (int c = r; c < 3; ++c) {
+                        cov[r][c] += d[r] * d[c];
+                    }
+                }
+            }
+            cov[1][0] = cov[0][1];
+            cov[2][0] = cov[0][2];
+            cov[2][1] = cov[1][2];
+            normals[i] = smallest_eigenvector(cov);
+        }
+    }, normal_grain / 4);
+    return normals;
+}
+
+IcpResult align_point_to_plane(std::span<const utils::Vector3f> source, std::span<const utils::Vector3f> target,
+                               const IcpSettings& settings, const utils::Matrix4f& initial) {
+    IcpResult result;
+    result.transform = initial;
+    if (source.empty() || target.size() < 3) {
+        utils::log_warning("ICP: source or target cloud is empty");
+        return result;
+    }
+
+    utils::Vector3f lo = target[0];
+    utils::Vector3f hi = target[0];
+    for (const auto& p : target) {
+        lo = {std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+        hi = {std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+    }
+    const float base_voxel = (hi - lo).length() / default_voxel_divisions;
+
+    std::vector<float> levels = settings.voxel_sizes;
+    if (levels.empty()) {
+        for (float level : default_levels) {
+            levels.push_back(level * base_voxel);
+        }
+    }
+
+    Pose pose = pose_from_matrix(initial);
+    float reference_voxel = base_voxel;
+    LevelResult last;
+    std::size_t last_source_count = source.size();
+    for (float voxel : levels) {
+        if (voxel > 0.0f) {
+            reference_voxel = voxel;
+        }
+        const float max_distance = settings.max_correspondence_distance > 0.0f
+            ? settings.max_correspondence_distance
+            : correspondence_voxels * reference_voxel;
+
+        std::vector<utils::Vector3f> source_level;
+        std::vector<utils::Vector3f> target_level;
+        std::span<const utils::Vector3f> source_points = source;
+        std::span<const utils::Vector3f> target_points = target;
+        if (voxel > 0.0f) {
+            source_level = voxel_downsample(source, voxel);
+            target_level = voxel_downsample(target, voxel);
+            source_points = source_level;
+            target_points = target_level;
+        }
+        if (target_points.size() < 3) {
+            continue;
+        }
+
+        last = align_level(source_points, target_points, settings, max_distance, pose);
+        last_source_count = source_points.size();
+        result.iterations += last.iterations;
+        utils::log_debug("ICP level voxel {}: {} -> {} points, {} iterations, {} correspondences", voxel,
+                         source_points.size(), target_points.size(), last.iterations, last.correspondences);
+    }
+
+    result.transform = pose_to_matrix(pose);
+    result.converged = last.converged;
+    if (last.correspondences > 0) {
+        result.rmse = static_cast<float>(std::sqrt(last.squared_residuals / static_cast<double>(last.correspondences)));
+        result.fitness = static_cast<float>(last.correspondences) / static_cast<float>(last_source_count);
+    }
+    return result;
+}
+
+}
\ No newline at end of file
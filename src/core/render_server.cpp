@@ -0,0 +1,722 @@
+#include "buildify/core/render_server.hpp"
+#include "buildify/core/tile_renderer.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace buildify::core {
+
+namespace protocol = render_protocol;
+
+namespace {
+
+static_assert(sizeof(protocol::MessageHeader) == 16);
+static_assert(sizeof(protocol::HelloRequest) == 12);
+static_assert(sizeof(protocol::HelloResponse) == 16);
+static_assert(sizeof(protocol::RenderRequest) == 52);
+static_assert(sizeof(protocol::RenderResponse) == 24);
+
+bool send_all(int fd, const void* data, std::size_t bytes) {
+    const auto* cursor = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t sent = ::send(fd, cursor, bytes, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        cursor += sent;
+        bytes -= static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+bool receive_all(int fd, void* data, std::size_t bytes) {
+    auto* cursor = static_cast<char*>(data);
+    while (bytes > 0) {
+        ssize_t received = ::recv(fd, cursor, bytes, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        cursor += received;
+        bytes -= static_cast<std::size_t>(received);
+    }
+    return true;
+}
+
+// Replies a client has not read yet; past this it is disconnected.
+constexpr std::size_t max_outbox_bytes = 1 << 20;
+
+std::string encode_message(std::uint16_t code, std::uint32_t request_id, std::uint32_t magic,
+                           const void* payload, std::size_t payload_bytes, const void* tail = nullptr,
+                           std::size_t tail_bytes = 0) {
+    std::string message(sizeof(protocol::MessageHeader) + payload_bytes + tail_bytes, '\0');
+    protocol::MessageHeader header{magic, protocol::version, code, request_id,
+                                   static_cast<std::uint32_t>(payload_bytes + tail_bytes)};
+    std::memcpy(message.data(), &header, sizeof(header));
+    if (payload_bytes > 0) {
+        std::memcpy(message.data() + sizeof(header), payload, payload_bytes);
+    }
+    if (tail_bytes > 0) {
+        std::memcpy(message.data() + sizeof(header) + payload_bytes, tail, tail_bytes);
+    }
+    return message;
+}
+
+bool send_message(int fd, std::uint16_t code, std::uint32_t request_id, std::uint32_t magic,
+                  const void* payload, std::size_t payload_bytes) {
+    const auto message = encode_message(code, request_id, magic, payload, payload_bytes);
+    return send_all(fd, message.data(), message.size());
+}
+
+}
+
+struct RenderServer::Impl {
+    // One client. Replies come from both threads and are queued in the
+    // outbox, which is sent without blocking and drained by the I/O
+    // thread whatever cannot be sent right away.
+    struct Connection {
+        int fd = -1;
+        int wake_fd = -1;
+        std::mutex outbox_mutex;
+        std::string outbox;
+        bool broken = false;
+        // Renders queued or being rendered, at most `slots`.
+        std::atomic<std::uint32_t> in_flight{0};
+        std::string inbox;
+        std::string segment_name;
+        std::byte* frames = nullptr;
+        std::size_t slot_bytes = 0;
+        std::uint32_t slots = 0;
+        std::uint32_t next_slot = 0;
+
+        ~Connection() {
+            if (frames != nullptr) {
+                munmap(frames, slot_bytes * slots);
+                shm_unlink(segment_name.c_str());
+            }
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+
+        void reply(protocol::Status status, std::uint32_t request_id, const void* payload = nullptr,
+                   std::size_t bytes = 0, const void* tail = nullptr, std::size_t tail_bytes = 0) {
+            std::lock_guard lock(outbox_mutex);
+            if (broken) {
+                return;
+            }
+            outbox += encode_message(static_cast<std::uint16_t>(status), request_id, protocol::response_magic,
+                                     payload, bytes, tail, tail_bytes);
+            flush_locked();
+            if (outbox.size() > max_outbox_bytes) {
+                utils::log_warning("Dropping render client that does not read its replies");
+                broken = true;
+                outbox.clear();
+                ::shutdown(fd, SHUT_RDWR);
+            } else if (!outbox.empty()) {
+                // Have the I/O thread poll for writability.
+                char wake = 0;
+                [[maybe_unused]] auto written = ::write(wake_fd, &wake, 1);
+            }
+        }
+
+        void flush() {
+            std::lock_guard lock(outbox_mutex);
+            flush_locked();
+        }
+
+        bool has_output() {
+            std::lock_guard lock(outbox_mutex);
+            return !outbox.empty();
+        }
+
+        bool is_broken() {
+            std::lock_guard lock(outbox_mutex);
+            return broken;
+        }
+
+    private:
+        void flush_locked() {
+            std::size_t sent_total = 0;
+            while (!broken && sent_total < outbox.size()) {
+                ssize_t sent = ::send(fd, outbox.data() + sent_total, outbox.size() - sent_total,
+                                      MSG_NOSIGNAL | MSG_DONTWAIT);
+                if (sent > 0) {
+                    sent_total += static_cast<std::size_t>(sent);
+                } else if (sent < 0 && errno == EINTR) {
+                    continue;
+                } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    break;
+                } else {
+                    broken = true;
+                }
+            }
+            outbox.erase(0, broken ? outbox.size() : sent_total);
+        }
+    };
+
+    struct PendingRender {
+        std::shared_ptr<Connection> connection;
+        std::uint32_t request_id = 0;
+        protocol::RenderRequest request{};
+        std::string scene;
+        std::uint32_t slot = 0;
+    };
+
+    RenderServerSettings settings;
+    int listener = -1;
+    int wake_pipe[2] = {-1, -1};
+    std::thread io_thread;
+    std::thread render_thread;
+    std::atomic<bool> running{false};
+    std::uint64_t segment_counter = 0;
+
+    mutable std::mutex scenes_mutex;
+    std::unordered_map<std::string, std::shared_ptr<const Scene>> scenes;
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_ready;
+    std::deque<PendingRender> queue;
+
+    mutable std::mutex stats_mutex;
+    RenderServerStats stats;
+
+    struct CachedRenderer {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::unique_ptr<TileRenderer> renderer;
+    };
+    // Most recently used first.
+    std::vector<CachedRenderer> renderers;
+    std::vector<float> batch_color;
+    std::vector<Camera> batch_cameras;
+
+    void serve_connections();
+    void render_loop();
+    // Parses complete messages from the connection's inbox; false drops it.
+    bool handle_messages(const std::shared_ptr<Connection>& connection);
+    bool handle_hello(Connection& connection, std::uint32_t request_id, std::string_view payload);
+    void render_batch(std::vector<PendingRender>& batch);
+
+    void count(auto update) {
+        std::lock_guard lock(stats_mutex);
+        update(stats);
+    }
+};
+
+RenderServer::RenderServer() : impl_(std::make_unique<Impl>()) {}
+
+RenderServer::~RenderServer() {
+    stop();
+}
+
+void RenderServer::add_scene(const std::string& name, std::shared_ptr<const Scene> scene) {
+    std::lock_guard lock(impl_->scenes_mutex);
+    impl_->scenes[name] = std::move(scene);
+}
+
+void RenderServer::remove_scene(const std::string& name) {
+    std::lock_guard lock(impl_->scenes_mutex);
+    impl_->scenes.erase(name);
+}
+
+bool RenderServer::start(const RenderServerSettings& settings) {
+    if (impl_->running) {
+        utils::log_warning("Render server already running");
+        return true;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (settings.socket_path.empty() || settings.socket_path.size() >= sizeof(address.sun_path)) {
+        utils::log_error("Invalid render server socket path: {}", settings.socket_path);
+        return false;
+    }
+    std::memcpy(address.sun_path, settings.socket_path.c_str(), settings.socket_path.size());
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    ::unlink(settings.socket_path.c_str());
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, 64) != 0 || ::pipe2(impl_->wake_pipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+        utils::log_error("Failed to listen on {}: {}", settings.socket_path, std::strerror(errno));
+        if (listener >= 0) {
+            ::close(listener);
+        }
+        return false;
+    }
+
+    impl_->settings = settings;
+    impl_->settings.max_batch_views = std::max(settings.max_batch_views, 1u);
+    impl_->listener = listener;
+    impl_->running = true;
+    impl_->io_thread = std::thread([this]() { impl_->serve_connections(); });
+    impl_->render_thread = std::thread([this]() { impl_->render_loop(); });
+    utils::log_info("Render server listening on {}", settings.socket_path);
+    return true;
+}
+
+void RenderServer::stop() {
+    if (!impl_->running.exchange(false)) {
+        return;
+    }
+    char wake = 0;
+    [[maybe_unused]] auto written = ::write(impl_->wake_pipe[1], &wake, 1);
+    {
+        std::lock_guard lock(impl_->queue_mutex);
+    }
+    impl_->queue_ready.notify_all();
+    impl_->io_thread.join();
+    impl_->render_thread.join();
+
+    impl_->queue.clear();
+    impl_->renderers.clear();
+    impl_->batch_color = {};
+    impl_->count([](RenderServerStats& stats) { stats.cached_renderers = 0; });
+    ::close(impl_->listener);
+    ::close(impl_->wake_pipe[0]);
+    ::close(impl_->wake_pipe[1]);
+    ::unlink(impl_->settings.socket_path.c_str());
+    impl_->listener = -1;
+    utils::log_info("Render server stopped");
+}
+
+bool RenderServer::is_running() const {
+    return impl_->running;
+}
+
+RenderServerStats RenderServer::get_stats() const {
+    std::lock_guard lock(impl_->stats_mutex);
+    return impl_->stats;
+}
+
+void RenderServer::Impl::serve_connections() {
+    std::vector<std::shared_ptr<Connection>> connections;
+    std::vector<pollfd> polled;
+    char buffer[64 * 1024];
+
+    while (running) {
+        polled.assign({{wake_pipe[0], POLLIN, 0}, {listener, POLLIN, 0}});
+        for (const auto& connection : connections) {
+            const short events = POLLIN | (connection->has_output() ? POLLOUT : 0);
+            polled.push_back({connection->fd, events, 0});
+        }
+        if (::poll(polled.data(), polled.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            utils::log_error("Render server poll failed: {}", std::strerror(errno));
+            break;
+        }
+        if (polled[0].revents != 0) {
+            // Woken to stop, or to poll a connection for writability.
+            while (::read(wake_pipe[0], buffer, sizeof(buffer)) > 0) {
+            }
+            if (!running) {
+                break;
+            }
+        }
+
+        // Connections are closed in reverse so the indices stay valid.
+        for (std::size_t i = polled.size(); i-- > 2;) {
+            if (polled[i].revents == 0) {
+                continue;
+            }
+            auto& connection = connections[i - 2];
+            if (polled[i].revents & POLLOUT) {
+                connection->flush();
+            }
+            bool closed = false;
+            if (polled[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                ssize_t received = ::recv(connection->fd, buffer, sizeof(buffer), 0);
+                if (received > 0) {
+                    connection->inbox.append(buffer, static_cast<std::size_t>(received));
+                }
+                closed = received == 0 ||
+                         (received < 0 && errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) ||
+                         !handle_messages(connection);
+            }
+            if (closed || connection->is_broken()) {
+                // Queued renders keep the connection alive until answered.
+                ::shutdown(connection->fd, SHUT_RDWR);
+                connections.erase(connections.begin() + static_cast<std::ptrdiff_t>(i - 2));
+            }
+        }
+
+        if (polled[1].revents & POLLIN) {
+            int fd = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+            if (fd >= 0) {
+                auto connection = std::make_shared<Connection>();
+                connection->fd = fd;
+                connection->wake_fd = wake_pipe[1];
+                connections.push_back(std::move(connection));
+                count([](RenderServerStats& stats) { ++stats.connections; });
+            }
+        }
+    }
+}
+
+bool RenderServer::Impl::handle_messages(const std::shared_ptr<Connection>& connection) {
+    auto& inbox = connection->inbox;
+    std::size_t consumed = 0;
+    while (inbox.size() - consumed >= sizeof(protocol::MessageHeader)) {
+        protocol::MessageHeader header;
+        std::memcpy(&header, inbox.data() + consumed, sizeof(header));
+        if (header.magic != protocol::request_magic || header.version != protocol::version ||
+            header.payload_bytes > 64 * 1024) {
+            utils::log_warning("Dropping render client after a malformed message");
+            return false;
+        }
+        if (inbox.size() - consumed < sizeof(header) + header.payload_bytes) {
+            break;
+        }
+        std::string_view payload(inbox.data() + consumed + sizeof(header), header.payload_bytes);
+        consumed += sizeof(header) + header.payload_bytes;
+
+        const auto type = static_cast<protocol::MessageType>(header.code);
+        if (type == protocol::MessageType::Hello) {
+            if (!handle_hello(*connection, header.request_id, payload)) {
+                return false;
+            }
+            continue;
+        }
+
+        PendingRender pending;
+        pending.connection = connection;
+        pending.request_id = header.request_id;
+        const bool well_formed = type == protocol::MessageType::Render &&
+                                 payload.size() >= sizeof(protocol::RenderRequest);
+        if (well_formed) {
+            std::memcpy(&pending.request, payload.data(), sizeof(pending.request));
+        }
+        const auto& request = pending.request;
+        if (!well_formed || connection->slots == 0 ||
+            payload.size() != sizeof(request) + request.scene_name_bytes ||
+            request.width == 0 || request.height == 0) {
+            count([](RenderServerStats& stats) { ++stats.rejected; });
+            connection->reply(protocol::Status::BadRequest, header.request_id);
+            continue;
+        }
+        if (static_cast<std::size_t>(request.width) * request.height * 4 * sizeof(float) > connection->slot_bytes) {
+            count([](RenderServerStats& stats) { ++stats.rejected; });
+            connection->reply(protocol::Status::FrameTooLarge, header.request_id);
+            continue;
+        }
+        if (connection->in_flight.load(std::memory_order_acquire) >= connection->slots) {
+            count([](RenderServerStats& stats) { ++stats.rejected; });
+            connection->reply(protocol::Status::Busy, header.request_id);
+            continue;
+        }
+        connection->in_flight.fetch_add(1, std::memory_order_acq_rel);
+        pending.scene.assign(payload.substr(sizeof(request)));
+        pending.slot = connection->next_slot;
+        connection->next_slot = (connection->next_slot + 1) % connection->slots;
+
+        {
+            std::lock_guard lock(queue_mutex);
+            queue.push_back(std::move(pending));
+        }
+        queue_ready.notify_one();
+    }
+    inbox.erase(0, consumed);
+    return true;
+}
+
+bool RenderServer::Impl::handle_hello(Connection& connection, std::uint32_t request_id, std::string_view payload) {
+    protocol::HelloRequest hello{};
+    if (payload.size() != sizeof(hello) || connection.frames != nullptr) {
+        connection.reply(protocol::Status::BadRequest, request_id);
+        return true;
+    }
+    std::memcpy(&hello, payload.data(), sizeof(hello));
+    const std::size_t pixels = static_cast<std::size_t>(hello.max_width) * hello.max_height;
+    if (pixels == 0 || pixels > settings.max_frame_pixels || hello.slots == 0) {
+        connection.reply(protocol::Status::FrameTooLarge, request_id);
+        return true;
+    }
+
+    const std::uint32_t slots = std::min(hello.slots, std::max(settings.max_slots, 1u));
+    const std::size_t slot_bytes = (pixels * 4 * sizeof(float) + 63) / 64 * 64;
+    const std::string name = "/buildify_frames_" + std::to_string(::getpid()) + "_" +
+                             std::to_string(segment_counter++);
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    void* frames = MAP_FAILED;
+    if (fd >= 0) {
+        if (ftruncate(fd, static_cast<off_t>(slot_bytes * slots)) == 0) {
+            frames = mmap(nullptr, slot_bytes * slots, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+    }
+    if (frames == MAP_FAILED) {
+        utils::log_error("Failed to create frame segment {}: {}", name, std::strerror(errno));
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    connection.segment_name = name;
+    connection.frames = static_cast<std::byte*>(frames);
+    connection.slot_bytes = slot_bytes;
+    connection.slots = slots;
+    protocol::HelloResponse response{slot_bytes, slots, static_cast<std::uint32_t>(name.size())};
+    connection.reply(protocol::Status::Ok, request_id, &response, sizeof(response), name.data(), name.size());
+    return true;
+}
+
+void RenderServer::Impl::render_loop() {
+    std::vector<PendingRender> batch;
+    while (running) {
+        {
+            std::unique_lock lock(queue_mutex);
+            queue_ready.wait(lock, [&]() { return !running || !queue.empty(); });
+            if (!running) {
+                return;
+            }
+
+            // Give concurrent clients a moment to join the batch.
+            auto matches = [&](const PendingRender& pending) {
+                const auto& first = queue.front();
+                return pending.scene == first.scene && pending.request.width == first.request.width &&
+                       pending.request.height == first.request.height;
+            };
+            queue_ready.wait_for(lock, settings.batch_window, [&]() {
+                return !running ||
+                       static_cast<std::size_t>(std::count_if(queue.begin(), queue.end(), matches)) >=
+                           settings.max_batch_views;
+            });
+
+            batch.clear();
+            const PendingRender first = queue.front();
+            for (auto it = queue.begin(); it != queue.end() && batch.size() < settings.max_batch_views;) {
+                if (it->scene == first.scene && it->request.width == first.request.width &&
+                    it->request.height == first.request.height) {
+                    batch.push_back(std::move(*it));
+                    it = queue.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        render_batch(batch);
+    }
+}
+
+void RenderServer::Impl::render_batch(std::vector<PendingRender>& batch) {
+    std::shared_ptr<const Scene> scene;
+    {
+        std::lock_guard lock(scenes_mutex);
+        auto it = scenes.find(batch.front().scene);
+        if (it != scenes.end()) {
+            scene = it->second;
+        }
+    }
+    // Stats are updated before replying so a client sees its own request
+    // counted.
+    if (!scene) {
+        count([&](RenderServerStats& stats) { stats.rejected += batch.size(); });
+        for (auto& pending : batch) {
+            pending.connection->in_flight.fetch_sub(1, std::memory_order_acq_rel);
+            pending.connection->reply(protocol::Status::UnknownScene, pending.request_id);
+        }
+        return;
+    }
+
+    const std::uint32_t width = batch.front().request.width;
+    const std::uint32_t height = batch.front().request.height;
+    auto cached = std::find_if(renderers.begin(), renderers.end(), [&](const CachedRenderer& entry) {
+        return entry.width == width && entry.height == height;
+    });
+    if (cached != renderers.end()) {
+        std::rotate(renderers.begin(), cached, cached + 1);
+    } else {
+        const std::size_t limit = std::max<std::uint32_t>(settings.max_cached_renderers, 1);
+        if (renderers.size() >= limit) {
+            renderers.resize(limit - 1);
+            // The batch buffer may still be sized for an evicted renderer.
+            batch_color = {};
+        }
+        CachedRenderer entry{width, height, std::make_unique<TileRenderer>()};
+        RenderTarget target{};
+        target.width = width;
+        target.height = height;
+        entry.renderer->initialize(target);
+        renderers.insert(renderers.begin(), std::move(entry));
+        count([&](RenderServerStats& stats) { stats.cached_renderers = static_cast<std::uint32_t>(renderers.size()); });
+    }
+    auto& renderer = renderers.front().renderer;
+
+    batch_cameras.clear();
+    for (const auto& pending : batch) {
+        const auto& request = pending.request;
+        Camera camera;
+        camera.set_perspective(request.fov, static_cast<float>(width) / static_cast<float>(height),
+                               request.near_plane, request.far_plane);
+        utils::Transform transform;
+        transform.position = {request.position[0], request.position[1], request.position[2]};
+        transform.rotation = utils::Quaternionf(request.rotation[0], request.rotation[1],
+                                                request.rotation[2], request.rotation[3]).normalized();
+        camera.set_transform(transform);
+        batch_cameras.push_back(camera);
+    }
+
+    const std::size_t frame_floats = static_cast<std::size_t>(width) * height * 4;
+    batch_color.resize(frame_floats * batch.size());
+    renderer->render_views(*scene, batch_cameras, batch_color);
+
+    count([&](RenderServerStats& stats) {
+        stats.requests += batch.size();
+        ++stats.batches;
+        stats.largest_batch = std::max(stats.largest_batch, static_cast<std::uint32_t>(batch.size()));
+    });
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        auto& pending = batch[i];
+        auto& connection = *pending.connection;
+        const std::uint64_t offset = static_cast<std::uint64_t>(pending.slot) * connection.slot_bytes;
+        std::memcpy(connection.frames + offset, batch_color.data() + i * frame_floats, frame_floats * sizeof(float));
+        protocol::RenderResponse response{width, height, pending.slot, static_cast<std::uint32_t>(batch.size()), offset};
+        connection.in_flight.fetch_sub(1, std::memory_order_acq_rel);
+        connection.reply(protocol::Status::Ok, pending.request_id, &response, sizeof(response));
+    }
+}
+
+RenderClient::~RenderClient() {
+    close();
+}
+
+bool RenderClient::connect(const std::string& socket_path, std::uint32_t max_width, std::uint32_t max_height,
+                           std::uint32_t slots) {
+    close();
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        utils::log_error("Invalid render server socket path: {}", socket_path);
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+    socket_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socket_ < 0 || ::connect(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        utils::log_error("Failed to connect to render server {}: {}", socket_path, std::strerror(errno));
+        close();
+        return false;
+    }
+
+    protocol::HelloRequest hello{max_width, max_height, slots};
+    protocol::MessageHeader reply;
+    std::string payload;
+    protocol::HelloResponse response{};
+    if (!exchange(protocol::MessageType::Hello, &hello, sizeof(hello), reply, payload) ||
+        reply.code != static_cast<std::uint16_t>(protocol::Status::Ok) || payload.size() < sizeof(response)) {
+        utils::log_error("Render server refused a {}x{} client", max_width, max_height);
+        close();
+        return false;
+    }
+    std::memcpy(&response, payload.data(), sizeof(response));
+    const std::string name = payload.substr(sizeof(response), response.name_bytes);
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    frames_bytes_ = response.slot_bytes * response.slots;
+    void* frames = fd >= 0 ? mmap(nullptr, frames_bytes_, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    if (frames == MAP_FAILED) {
+        utils::log_error("Failed to map frame segment {}", name);
+        close();
+        return false;
+    }
+    frames_ = static_cast<const std::byte*>(frames);
+    return true;
+}
+
+void RenderClient::close() {
+    if (frames_ != nullptr) {
+        munmap(const_cast<std::byte*>(frames_), frames_bytes_);
+    }
+    frames_ = nullptr;
+    frames_bytes_ = 0;
+    if (socket_ >= 0) {
+        ::close(socket_);
+    }
+    socket_ = -1;
+}
+
+bool RenderClient::exchange(protocol::MessageType type, const void* payload, std::size_t bytes,
+                            protocol::MessageHeader& reply, std::string& reply_payload) {
+    const std::uint32_t request_id = next_request_++;
+    if (!send_message(socket_, static_cast<std::uint16_t>(type), request_id, protocol::request_magic,
+                      payload, bytes) ||
+        !receive_all(socket_, &reply, sizeof(reply)) || reply.magic != protocol::response_magic ||
+        reply.request_id != request_id) {
+        return false;
+    }
+    reply_payload.resize(reply.payload_bytes);
+    return receive_all(socket_, reply_payload.data(), reply_payload.size());
+}
+
+std::span<const float> RenderClient::render(const std::string& scene, const Camera& camera,
+                                            std::uint32_t width, std::uint32_t height) {
+    if (frames_ == nullptr) {
+        return {};
+    }
+
+    const auto params = camera.get_params();
+    const auto& transform = camera.get_transform();
+    protocol::RenderRequest request{};
+    request.width = width;
+    request.height = height;
+    request.position[0] = transform.position.x;
+    request.position[1] = transform.position.y;
+    request.position[2] = transform.position.z;
+    request.rotation[0] = transform.rotation.x;
+    request.rotation[1] = transform.rotation.y;
+    request.rotation[2] = transform.rotation.z;
+    request.rotation[3] = transform.rotation.w;
+    request.fov = camera.get_fov();
+    request.near_plane = params.near;
+    request.far_plane = params.far;
+    request.scene_name_bytes = static_cast<std::uint32_t>(scene.size());
+
+    std::string message(sizeof(request) + scene.size(), '\0');
+    std::memcpy(message.data(), &request, sizeof(request));
+    std::memcpy(message.data() + sizeof(request), scene.data(), scene.size());
+
+    protocol::MessageHeader reply;
+    std::string payload;
+    protocol::RenderResponse response{};
+    if (!exchange(protocol::MessageType::Render, message.data(), message.size(), reply, payload)) {
+        utils::log_error("Lost connection to the render server");
+        close();
+        return {};
+    }
+    if (reply.code != static_cast<std::uint16_t>(protocol::Status::Ok) || payload.size() != sizeof(response)) {
+        utils::log_warning("Render server rejected a request for scene {} (status {})", scene, reply.code);
+        return {};
+    }
+    std::memcpy(&response, payload.data(), sizeof(response));
+    const std::size_t floats = static_cast<std::size_t>(response.width) * response.height * 4;
+    if (response.offset + floats * sizeof(float) > frames_bytes_) {
+        return {};
+    }
+    last_batch_size_ = response.batch_size;
+    return {reinterpret_cast<const float*>(frames_ + response.offset), floats};
+}
+
+}
\ No newline at end of file
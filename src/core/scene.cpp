@@ -1,12 +1,27 @@
 #include "buildify/core/scene.hpp"
+#include "buildify/core/gaussians.hpp"
+#include "buildify/core/gaussian_animation.hpp"
+#include "buildify/core/gaussian_bvh.hpp"
+#include "buildify/core/gaussian_io.hpp"
 #include "buildify/utils/logger.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <mutex>
 
 namespace buildify::core {
 
 struct Scene::Impl {
+    GaussianCloud gaussians;
+    std::string source_path;
+
+    std::mutex bvh_mutex;
+    GaussianBVH bvh;
+    bool bvh_built = false;
+
+    std::shared_ptr<GaussianAnimation> animation;
+    double animation_time = -1.0;
 };
 
 Scene::Scene(const std::string& name) 
@@ -46,18 +61,109 @@ std::shared_ptr<Camera> Scene::get_active_camera() const {
     return active_camera_;
 }
 
+GaussianCloud& Scene::get_gaussians() {
+    return impl_->gaussians;
+}
+
+const GaussianCloud& Scene::get_gaussians() const {
+    return impl_->gaussians;
+}
+
+const GaussianBVH& Scene::get_gaussian_bvh() const {
+    std::lock_guard lock(impl_->bvh_mutex);
+    if (!impl_->bvh_built || impl_->bvh.get_source_version() != impl_->gaussians.get_version()) {
+        impl_->bvh.build(impl_->gaussians);
+        impl_->bvh_built = true;
+    }
+    return impl_->bvh;
+}
+
+const GaussianBVH& Scene::refit_gaussian_bvh() const {
+    std::lock_guard lock(impl_->bvh_mutex);
+    if (!impl_->bvh_built) {
+        impl_->bvh.build(impl_->gaussians);
+        impl_->bvh_built = true;
+    } else if (impl_->bvh.get_source_version() != impl_->gaussians.get_version()) {
+        impl_->bvh.refit(impl_->gaussians);
+    }
+    return impl_->bvh;
+}
+
+bool Scene::set_gaussian_animation(std::shared_ptr<GaussianAnimation> animation) {
+    if (animation && !animation->is_bound() && !animation->bind(impl_->gaussians)) {
+        return false;
+    }
+    impl_->animation = std::move(animation);
+    impl_->animation_time = -1.0;
+    return true;
+}
+
+std::shared_ptr<GaussianAnimation> Scene::get_gaussian_animation() const {
+    return impl_->animation;
+}
+
 void Scene::update(double delta_time) {
     for (auto& entity : entities_) {
         entity->update(delta_time);
     }
+
+    if (auto& animation = impl_->animation) {
+        animation->advance(delta_time);
+        if (animation->get_time() != impl_->animation_time && animation->evaluate(impl_->gaussians)) {
+            impl_->animation_time = animation->get_time();
+        }
+    }
 }
 
-void Scene::load_from_file(const std::string& path) {
+bool Scene::load_from_file(const std::string& path) {
     utils::log_info("Loading scene from: {}", path);
+    if (!load_gaussians(path, impl_->gaussians)) {
+        return false;
+    }
+    impl_->source_path = path;
+    return true;
+}
+
+const std::string& Scene::get_source_path() const {
+    return impl_->source_path;
+}
+
+bool Scene::reload_from_file(GaussianReloadStats& stats) {
+    stats = {};
+    if (impl_->source_path.empty()) {
+        return false;
+    }
+    const auto version = impl_->gaussians.get_version();
+    if (!reload_gaussians(impl_->source_path, impl_->gaussians, stats)) {
+        return false;
+    }
+
+    {
+        std::lock_guard lock(impl_->bvh_mutex);
+        if (impl_->bvh_built && impl_->bvh.get_source_version() == version && !stats.shapes_changed) {
+            if (stats.positions_changed) {
+                impl_->bvh.refit(impl_->gaussians);
+            } else {
+                impl_->bvh.retarget(impl_->gaussians);
+            }
+        }
+    }
+
+    // The file holds the rest pose, which replaced the deformed splats:
+    // bind the animation to it and deform again on the next update.
+    if (auto& animation = impl_->animation) {
+        if (!animation->bind(impl_->gaussians)) {
+            utils::log_error("Dropping the animation of scene '{}': it no longer fits the reloaded cloud", name_);
+            animation.reset();
+        }
+        impl_->animation_time = -1.0;
+    }
+    return true;
 }
 
-void Scene::save_to_file(const std::string& path) const {
+bool Scene::save_to_file(const std::string& path) const {
     utils::log_info("Saving scene to: {}", path);
+    return save_gaussians(path, impl_->gaussians);
 }
 
 #ifdef WITH_BLENDER
@@ -72,7 +178,14 @@ void Scene::export_to_blender(const std::string& blend_file) const {
 
 Entity::Entity(const std::string& name) : name_(name) {}
 
-Camera::Camera(const std::string& name) : Entity(name) {}
+Camera::Camera(const std::string& name) : Entity(name) {
+    refresh();
+}
+
+void Camera::set_transform(const utils::Transform& transform) {
+    transform_ = transform;
+    refresh();
+}
 
 void Camera::set_perspective(float fov, float aspect_ratio, float near, float far) {
     projection_type_ = ProjectionType::Perspective;
@@ -80,6 +193,7 @@ void Camera::set_perspective(float fov, float aspect_ratio, float near, float fa
     aspect_ratio_ = aspect_ratio;
     near_ = near;
     far_ = far;
+    refresh();
 }
 
 void Camera::set_orthographic(float left, float right, float bottom, float top, float near, float far) {
@@ -90,58 +204,124 @@ void Camera::set_orthographic(float left, float right, float bottom, float top,
     ortho_top_ = top;
     near_ = near;
     far_ = far;
+    refresh();
+}
+
+CameraParams Camera::get_params() const {
+    return is_cache_valid() ? params_ : compute_params();
 }
 
 utils::Matrix4<float> Camera::get_view_matrix() const {
-    auto& t = transform_;
-    auto pos = t.position;
-    auto forward = t.rotation.to_matrix() * utils::Vector4<float>(0, 0, -1, 0);
-    auto up = t.rotation.to_matrix() * utils::Vector4<float>(0, 1, 0, 0);
-    
-    utils::Vector3<float> f(forward.x, forward.y, forward.z);
-    utils::Vector3<float> u(up.x, up.y, up.z);
-    utils::Vector3<float> r = f.cross(u).normalized();
-    u = r.cross(f).normalized();
+    return is_cache_valid() ? params_.view : compute_view_matrix();
+}
 
-    utils::Matrix4<float> view;
-    view.m[0][0] = r.x; view.m[0][1] = r.y; view.m[0][2] = r.z; view.m[0][3] = -r.dot(pos);
-    view.m[1][0] = u.x; view.m[1][1] = u.y; view.m[1][2] = u.z; view.m[1][3] = -u.dot(pos);
-    view.m[2][0] = -f.x; view.m[2][1] = -f.y; view.m[2][2] = -f.z; view.m[2][3] = f.dot(pos);
-    view.m[3][0] = 0; view.m[3][1] = 0; view.m[3][2] = 0; view.m[3][3] = 1;
+utils::Matrix4<float> Camera::get_view_projection_matrix() const {
+    return is_cache_valid() ? params_.view_projection : params_.projection * compute_view_matrix();
+}
 
+void Camera::update(double delta_time) {
+    if (!is_cache_valid()) {
+        refresh();
+    }
+}
+
+bool Camera::is_cache_valid() const {
+    const auto& p = transform_.position;
+    const auto& q = transform_.rotation;
+    return p.x == cached_position_.x && p.y == cached_position_.y && p.z == cached_position_.z &&
+           q.x == cached_rotation_.x && q.y == cached_rotation_.y && q.z == cached_rotation_.z &&
+           q.w == cached_rotation_.w;
+}
+
+void Camera::refresh() {
+    params_ = compute_params();
+    cached_position_ = transform_.position;
+    cached_rotation_ = transform_.rotation;
+}
+
+utils::Matrix4<float> Camera::compute_view_matrix() const {
+    // The view rotation is the transpose of the camera's: its rows are the
+    // camera's right, up and backward axes.
+    const auto rotation = transform_.rotation.normalized().to_matrix();
+    const auto& pos = transform_.position;
+    utils::Matrix4<float> view;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            view.m[r][c] = rotation.m[c][r];
+        }
+        view.m[r][3] = -(view.m[r][0] * pos.x + view.m[r][1] * pos.y + view.m[r][2] * pos.z);
+    }
     return view;
 }
 
-utils::Matrix4<float> Camera::get_projection_matrix() const {
+CameraParams Camera::compute_params() const {
+    CameraParams params;
+    params.position = transform_.position;
+    params.near = near_;
+    params.far = far_;
+    params.orthographic = projection_type_ == ProjectionType::Orthographic;
+
+    params.view = compute_view_matrix();
+
     if (projection_type_ == ProjectionType::Perspective) {
-        return utils::Matrix4<float>::perspective(fov_, aspect_ratio_, near_, far_);
+        params.projection = utils::Matrix4<float>::perspective(fov_, aspect_ratio_, near_, far_);
     } else {
-        utils::Matrix4<float> ortho;
+        auto& ortho = params.projection;
         ortho.m[0][0] = 2.0f / (ortho_right_ - ortho_left_);
         ortho.m[1][1] = 2.0f / (ortho_top_ - ortho_bottom_);
         ortho.m[2][2] = -2.0f / (far_ - near_);
         ortho.m[0][3] = -(ortho_right_ + ortho_left_) / (ortho_right_ - ortho_left_);
         ortho.m[1][3] = -(ortho_top_ + ortho_bottom_) / (ortho_top_ - ortho_bottom_);
         ortho.m[2][3] = -(far_ + near_) / (far_ - near_);
-        return ortho;
     }
+    params.view_projection = params.projection * params.view;
+
+    // Planes from sums and differences of the clip matrix rows
+    // (Gribb and Hartmann).
+    const auto& m = params.view_projection.m;
+    for (int i = 0; i < 6; ++i) {
+        const int row = i / 2;
+        const float sign = i % 2 == 0 ? 1.0f : -1.0f;
+        utils::Vector4f plane(m[3][0] + sign * m[row][0], m[3][1] + sign * m[row][1],
+                              m[3][2] + sign * m[row][2], m[3][3] + sign * m[row][3]);
+        float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f) {
+            plane = {plane.x / length, plane.y / length, plane.z / length, plane.w / length};
+        }
+        params.frustum[i] = plane;
+    }
+    return params;
 }
 
 void Camera::look_at(const utils::Vector3<float>& target, const utils::Vector3<float>& up) {
-    utils::Vector3<float> forward = (target - transform_.position).normalized();
-    utils::Vector3<float> right = forward.cross(up).normalized();
+    utils::Vector3<float> forward = target - transform_.position;
+    if (forward.length() <= 0.0f) {
+        return;
+    }
+    forward = forward.normalized();
+    utils::Vector3<float> right = forward.cross(up);
+    if (right.length() < 1e-6f) {
+        // Looking along `up`: any perpendicular axis will do.
+        right = forward.cross(std::abs(forward.y) < 0.9f ? utils::Vector3<float>(0, 1, 0)
+                                                          : utils::Vector3<float>(1, 0, 0));
+    }
+    right = right.normalized();
     utils::Vector3<float> new_up = right.cross(forward);
 
+    // Columns are the camera axes in world space; get_view_matrix reads the
+    // view direction back as rotation * (0, 0, -1).
     utils::Matrix4<float> rotation_matrix;
     rotation_matrix.m[0][0] = right.x;
-    rotation_matrix.m[0][1] = right.y;
-    rotation_matrix.m[0][2] = right.z;
-    rotation_matrix.m[1][0] = new_up.x;
+    rotation_matrix.m[1][0] = right.y;
+    rotation_matrix.m[2][0] = right.z;
+    rotation_matrix.m[0][1] = new_up.x;
     rotation_matrix.m[1][1] = new_up.y;
-    rotation_matrix.m[1][2] = new_up.z;
-    rotation_matrix.m[2][0] = -forward.x;
-    rotation_matrix.m[2][1] = -forward.y;
+    rotation_matrix.m[2][1] = new_up.z;
+    rotation_matrix.m[0][2] = -forward.x;
+    rotation_matrix.m[1][2] = -forward.y;
     rotation_matrix.m[2][2] = -forward.z;
+    transform_.rotation = utils::Quaternionf::from_matrix(rotation_matrix);
+    refresh();
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,403 @@
+#include "buildify/core/scene_residency.hpp"
+#include "buildify/core/gaussian_io.hpp"
+#include "buildify/core/gaussians.hpp"
+#include "buildify/core/scene.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <unistd.h>
+
+namespace buildify::core {
+
+struct SceneResidency::Impl {
+    struct Entry {
+        std::string name;
+        std::shared_ptr<Scene> scene;
+        SceneResidencyState state = SceneResidencyState::Resident;
+        std::size_t bytes = 0;
+        std::uint64_t last_used = 0;
+        std::string spill_path;
+        // Read instead of the spill file after the scene's source changed
+        // while it was evicted.
+        std::string source_path;
+        // Cloud handed to the I/O thread for writing, or read back by it and
+        // not installed yet.
+        std::unique_ptr<GaussianCloud> outgoing;
+        std::unique_ptr<GaussianCloud> incoming;
+
+        const std::string& read_path() const { return source_path.empty() ? spill_path : source_path; }
+    };
+
+    enum class Job { Write, Read };
+
+    SceneResidencySettings settings;
+    std::string spill_directory;
+    bool created_spill_directory = false;
+    std::uint64_t spill_counter = 0;
+
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries;
+    std::unordered_map<const Scene*, std::shared_ptr<Entry>> by_scene;
+    std::deque<std::pair<Job, std::shared_ptr<Entry>>> jobs;
+    std::shared_ptr<Entry> busy;
+    std::uint64_t use_tick = 0;
+    bool stopping = false;
+    SceneResidencyStats stats;
+    std::thread io_thread;
+
+    // Caller holds the mutex for everything below.
+    void make_resident(std::unique_lock<std::mutex>& lock, const std::shared_ptr<Entry>& entry);
+    void install(Entry& entry);
+    void evict(const std::shared_ptr<Entry>& entry);
+    void enforce_budget(const Entry* keep);
+    void schedule(Job job, const std::shared_ptr<Entry>& entry);
+    void wait_idle(std::unique_lock<std::mutex>& lock, const Entry& entry);
+    std::string next_spill_path();
+
+    void io_loop();
+    void stop_io();
+};
+
+SceneResidency::SceneResidency() : impl_(std::make_unique<Impl>()) {
+    impl_->io_thread = std::thread([this]() { impl_->io_loop(); });
+}
+
+SceneResidency::~SceneResidency() {
+    clear();
+    impl_->stop_io();
+}
+
+void SceneResidency::set_settings(const SceneResidencySettings& settings) {
+    std::lock_guard lock(impl_->mutex);
+    impl_->settings = settings;
+    impl_->enforce_budget(nullptr);
+}
+
+SceneResidencySettings SceneResidency::get_settings() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->settings;
+}
+
+void SceneResidency::add(const std::string& name, std::shared_ptr<Scene> scene) {
+    remove(name);
+    auto entry = std::make_shared<Impl::Entry>();
+    entry->name = name;
+    entry->scene = std::move(scene);
+
+    std::lock_guard lock(impl_->mutex);
+    entry->last_used = ++impl_->use_tick;
+    impl_->by_scene[entry->scene.get()] = entry;
+    impl_->entries[name] = entry;
+    impl_->enforce_budget(entry.get());
+}
+
+void SceneResidency::remove(const std::string& name) {
+    std::unique_lock lock(impl_->mutex);
+    auto it = impl_->entries.find(name);
+    if (it == impl_->entries.end()) {
+        return;
+    }
+    auto entry = it->second;
+    impl_->entries.erase(it);
+    impl_->by_scene.erase(entry->scene.get());
+    std::erase_if(impl_->jobs, [&](const auto& job) { return job.second == entry; });
+    impl_->wait_idle(lock, *entry);
+    // Whoever still holds the scene keeps its cloud: bring it back before
+    // the spill file goes.
+    if (entry->state != SceneResidencyState::Resident && entry->scene.use_count() > 1) {
+        if (entry->outgoing) {
+            entry->incoming = std::move(entry->outgoing);
+        } else if (!entry->incoming && !entry->read_path().empty()) {
+            auto cloud = std::make_unique<GaussianCloud>();
+            if (load_gaussians(entry->read_path(), *cloud)) {
+                entry->incoming = std::move(cloud);
+                ++impl_->stats.reloads;
+            } else {
+                utils::log_error("Failed to reload scene {} from {}", entry->name, entry->read_path());
+            }
+        }
+        if (entry->incoming) {
+            impl_->install(*entry);
+        }
+    }
+    if (!entry->spill_path.empty()) {
+        std::error_code error;
+        std::filesystem::remove(entry->spill_path, error);
+    }
+}
+
+void SceneResidency::clear() {
+    std::vector<std::string> names;
+    {
+        std::lock_guard lock(impl_->mutex);
+        for (const auto& [name, entry] : impl_->entries) {
+            names.push_back(name);
+        }
+    }
+    for (const auto& name : names) {
+        remove(name);
+    }
+    std::lock_guard lock(impl_->mutex);
+    if (impl_->created_spill_directory) {
+        std::error_code error;
+        std::filesystem::remove(impl_->spill_directory, error);
+        impl_->created_spill_directory = false;
+    }
+    impl_->spill_directory.clear();
+}
+
+std::shared_ptr<Scene> SceneResidency::acquire(const std::string& name) {
+    std::unique_lock lock(impl_->mutex);
+    auto it = impl_->entries.find(name);
+    if (it == impl_->entries.end()) {
+        return nullptr;
+    }
+    auto entry = it->second;
+    impl_->make_resident(lock, entry);
+    return entry->scene;
+}
+
+void SceneResidency::touch(const Scene& scene) {
+    std::unique_lock lock(impl_->mutex);
+    auto it = impl_->by_scene.find(&scene);
+    if (it != impl_->by_scene.end()) {
+        auto entry = it->second;
+        impl_->make_resident(lock, entry);
+    }
+}
+
+void SceneResidency::prefetch(const std::string& name) {
+    std::lock_guard lock(impl_->mutex);
+    auto it = impl_->entries.find(name);
+    if (it != impl_->entries.end() && it->second->state == SceneResidencyState::Evicted) {
+        it->second->state = SceneResidencyState::Loading;
+        impl_->schedule(Impl::Job::Read, it->second);
+    }
+}
+
+bool SceneResidency::refresh_evicted(const std::string& name, const std::string& source_path) {
+    std::unique_lock lock(impl_->mutex);
+    auto it = impl_->entries.find(name);
+    if (it == impl_->entries.end() || it->second->state == SceneResidencyState::Resident) {
+        return false;
+    }
+    auto entry = it->second;
+    std::erase_if(impl_->jobs, [&](const auto& job) { return job.second == entry; });
+    impl_->wait_idle(lock, *entry);
+    if (entry->state == SceneResidencyState::Resident) {
+        return false;
+    }
+    entry->outgoing.reset();
+    entry->incoming.reset();
+    entry->state = SceneResidencyState::Evicted;
+    if (!entry->spill_path.empty()) {
+        std::error_code error;
+        std::filesystem::remove(entry->spill_path, error);
+        entry->spill_path.clear();
+    }
+    entry->source_path = source_path;
+    return true;
+}
+
+SceneResidencyState SceneResidency::get_state(const std::string& name) const {
+    std::lock_guard lock(impl_->mutex);
+    auto it = impl_->entries.find(name);
+    return it != impl_->entries.end() ? it->second->state : SceneResidencyState::Evicted;
+}
+
+std::vector<std::shared_ptr<Scene>> SceneResidency::get_scenes() const {
+    std::lock_guard lock(impl_->mutex);
+    std::vector<std::shared_ptr<Scene>> scenes;
+    for (const auto& [name, entry] : impl_->entries) {
+        scenes.push_back(entry->scene);
+    }
+    return scenes;
+}
+
+SceneResidencyStats SceneResidency::get_stats() const {
+    std::lock_guard lock(impl_->mutex);
+    SceneResidencyStats stats = impl_->stats;
+    for (const auto& [name, entry] : impl_->entries) {
+        if (entry->state == SceneResidencyState::Resident) {
+            stats.resident_bytes += entry->scene->get_gaussians().memory_footprint();
+            ++stats.resident_scenes;
+        } else {
+            ++stats.evicted_scenes;
+        }
+    }
+    return stats;
+}
+
+void SceneResidency::Impl::make_resident(std::unique_lock<std::mutex>& lock, const std::shared_ptr<Entry>& entry) {
+    entry->last_used = ++use_tick;
+    if (entry->state == SceneResidencyState::Evicting) {
+        // Still queued: take the cloud straight back instead of writing it.
+        auto queued = std::find_if(jobs.begin(), jobs.end(), [&](const auto& job) { return job.second == entry; });
+        if (queued != jobs.end()) {
+            jobs.erase(queued);
+            entry->incoming = std::move(entry->outgoing);
+            entry->state = SceneResidencyState::Loading;
+        }
+    }
+    if (entry->state == SceneResidencyState::Resident) {
+        return;
+    }
+
+    wait_idle(lock, *entry);
+    if (entry->state == SceneResidencyState::Evicted) {
+        entry->state = SceneResidencyState::Loading;
+        schedule(Job::Read, entry);
+        ++stats.stalls;
+        wait_idle(lock, *entry);
+    } else if (entry->state == SceneResidencyState::Loading && !entry->incoming) {
+        // Prefetched and still queued or being read.
+        ++stats.stalls;
+        condition.wait(lock, [&]() { return entry->incoming || entry->state != SceneResidencyState::Loading; });
+    }
+    if (entry->incoming) {
+        install(*entry);
+        enforce_budget(entry.get());
+    }
+}
+
+void SceneResidency::Impl::install(Entry& entry) {
+    auto& cloud = entry.scene->get_gaussians();
+    // The placeholder carries settings made while evicted.
+    const auto placement = cloud.get_memory_placement();
+    const auto version = cloud.get_version();
+    cloud = std::move(*entry.incoming);
+    cloud.set_memory_placement(placement);
+    cloud.mark_modified_after(version);
+    entry.incoming.reset();
+    entry.state = SceneResidencyState::Resident;
+}
+
+void SceneResidency::Impl::evict(const std::shared_ptr<Entry>& entry) {
+    auto& cloud = entry->scene->get_gaussians();
+    GaussianCloud placeholder(cloud.get_sh_degree());
+    placeholder.set_memory_placement(cloud.get_memory_placement());
+    placeholder.mark_modified_after(cloud.get_version());
+    entry->outgoing = std::make_unique<GaussianCloud>(std::move(cloud));
+    cloud = std::move(placeholder);
+    entry->state = SceneResidencyState::Evicting;
+    ++stats.evictions;
+    schedule(Job::Write, entry);
+}
+
+void SceneResidency::Impl::enforce_budget(const Entry* keep) {
+    if (settings.memory_budget == 0) {
+        return;
+    }
+    std::vector<std::shared_ptr<Entry>> resident;
+    std::size_t total = 0;
+    for (const auto& [name, entry] : entries) {
+        if (entry->state == SceneResidencyState::Resident) {
+            entry->bytes = entry->scene->get_gaussians().memory_footprint();
+            total += entry->bytes;
+            if (entry.get() != keep && entry->bytes > 0) {
+                resident.push_back(entry);
+            }
+        }
+    }
+    std::sort(resident.begin(), resident.end(), [](const auto& a, const auto& b) { return a->last_used < b->last_used; });
+    for (const auto& entry : resident) {
+        if (total <= settings.memory_budget) {
+            break;
+        }
+        total -= entry->bytes;
+        evict(entry);
+    }
+}
+
+void SceneResidency::Impl::schedule(Job job, const std::shared_ptr<Entry>& entry) {
+    jobs.emplace_back(job, entry);
+    condition.notify_all();
+}
+
+void SceneResidency::Impl::wait_idle(std::unique_lock<std::mutex>& lock, const Entry& entry) {
+    condition.wait(lock, [&]() {
+        return busy.get() != &entry &&
+               std::none_of(jobs.begin(), jobs.end(), [&](const auto& job) { return job.second.get() == &entry; });
+    });
+}
+
+std::string SceneResidency::Impl::next_spill_path() {
+    if (spill_directory.empty()) {
+        spill_directory = settings.spill_directory.empty()
+            ? (std::filesystem::temp_directory_path() / ("buildify_spill_" + std::to_string(::getpid()))).string()
+            : settings.spill_directory;
+        std::error_code error;
+        created_spill_directory = std::filesystem::create_directories(spill_directory, error);
+    }
+    return (std::filesystem::path(spill_directory) / (std::to_string(spill_counter++) + ".bspill")).string();
+}
+
+void SceneResidency::Impl::io_loop() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        condition.wait(lock, [&] { return stopping || !jobs.empty(); });
+        if (stopping) {
+            return;
+        }
+        auto [job, entry] = jobs.front();
+        jobs.pop_front();
+        busy = entry;
+
+        if (job == Job::Write) {
+            if (entry->spill_path.empty()) {
+                entry->spill_path = next_spill_path();
+            }
+            const std::string path = entry->spill_path;
+            const GaussianCloud* cloud = entry->outgoing.get();
+            lock.unlock();
+            const bool written = save_gaussians(path, *cloud);
+            lock.lock();
+            if (written) {
+                entry->outgoing.reset();
+                entry->state = SceneResidencyState::Evicted;
+            } else {
+                // Keep the data: the next acquire installs it again.
+                utils::log_error("Failed to spill scene {} to {}", entry->name, path);
+                entry->incoming = std::move(entry->outgoing);
+                entry->state = SceneResidencyState::Loading;
+            }
+        } else {
+            const std::string path = entry->read_path();
+            lock.unlock();
+            auto cloud = std::make_unique<GaussianCloud>();
+            const bool read = load_gaussians(path, *cloud);
+            lock.lock();
+            if (read) {
+                entry->incoming = std::move(cloud);
+                entry->source_path.clear();
+                ++stats.reloads;
+            } else {
+                utils::log_error("Failed to reload scene {} from {}", entry->name, path);
+                entry->state = SceneResidencyState::Evicted;
+            }
+        }
+        busy.reset();
+        condition.notify_all();
+    }
+}
+
+void SceneResidency::Impl::stop_io() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    if (io_thread.joinable()) {
+        io_thread.join();
+    }
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,362 @@
+#include "buildify/core/shared_gaussians.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace buildify::core {
+
+namespace {
+
+constexpr std::size_t column_alignment = 64;
+
+std::string shm_name(const std::string& name) {
+    return name.starts_with('/') ? name : "/" + name;
+}
+
+std::size_t align_up(std::size_t value) {
+    return (value + column_alignment - 1) / column_alignment * column_alignment;
+}
+
+// Floats per splat in column `index`: one for the attributes and the
+// filter, the SH stride for sh_rest.
+std::size_t column_width(std::size_t index, std::uint32_t sh_degree) {
+    return index == GaussianCloud::attribute_count ? GaussianCloud::sh_rest_coefficients(sh_degree) * 3 : 1;
+}
+
+// Words of the segment the writer changes while readers may look.
+// Readers map it read-only; only loads go through a const word.
+template<typename T>
+std::atomic_ref<T> shared_word(const T& word) {
+    return std::atomic_ref<T>(const_cast<T&>(word));
+}
+
+void store_words(float* to, std::span<const float> from) {
+    for (std::size_t i = 0; i < from.size(); ++i) {
+        std::atomic_ref<float>(to[i]).store(from[i], std::memory_order_relaxed);
+    }
+}
+
+void load_words(const float* from, std::size_t count, float* to) {
+    for (std::size_t i = 0; i < count; ++i) {
+        to[i] = shared_word(from[i]).load(std::memory_order_relaxed);
+    }
+}
+
+// True while the process that created the segment at `path` is alive, or
+// when the segment is not one of ours and must not be replaced.
+bool segment_in_use(const std::string& path) {
+    int fd = shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    void* data = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(SharedGaussianHeader)) {
+        data = mmap(nullptr, sizeof(SharedGaussianHeader), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        utils::log_error("Shared segment {} exists and is not a Gaussian segment", path);
+        return true;
+    }
+    const auto* header = static_cast<const SharedGaussianHeader*>(data);
+    bool in_use = true;
+    if (std::memcmp(header->magic, SharedGaussianHeader::expected_magic, sizeof(header->magic)) != 0) {
+        utils::log_error("Shared segment {} exists and is not a Gaussian segment", path);
+    } else {
+        const auto pid = static_cast<pid_t>(header->writer_pid);
+        in_use = pid > 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+        if (in_use) {
+            utils::log_error("Shared segment {} is in use by process {}", path, pid);
+        }
+    }
+    munmap(data, sizeof(SharedGaussianHeader));
+    return in_use;
+}
+
+}
+
+SharedGaussianSegment::~SharedGaussianSegment() {
+    close();
+}
+
+bool SharedGaussianSegment::create(const std::string& name, std::size_t capacity, std::uint32_t sh_degree) {
+    close();
+    if (sh_degree > GaussianCloud::max_sh_degree) {
+        utils::log_error("Invalid SH degree {} for shared segment {}", sh_degree, name);
+        return false;
+    }
+
+    SharedGaussianHeader layout{};
+    layout.version = SharedGaussianHeader::current_version;
+    layout.header_bytes = sizeof(SharedGaussianHeader);
+    layout.capacity = capacity;
+    layout.sh_degree = sh_degree;
+    layout.stored_columns = SharedGaussianHeader::column_count;
+    layout.writer_pid = static_cast<std::uint32_t>(::getpid());
+    std::size_t bytes = align_up(sizeof(SharedGaussianHeader));
+    for (std::size_t i = 0; i < SharedGaussianHeader::column_count; ++i) {
+        layout.column_offsets[i] = bytes;
+        bytes = align_up(bytes + capacity * column_width(i, sh_degree) * sizeof(float));
+    }
+
+    const std::string path = shm_name(name);
+    int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST) {
+        // Left behind by a writer that died; a live one keeps its name.
+        if (segment_in_use(path)) {
+            return false;
+        }
+        shm_unlink(path.c_str());
+        fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0) {
+        utils::log_error("Failed to create shared segment {}: {}", path, std::strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0 || !map(fd, bytes, true)) {
+        utils::log_error("Failed to size shared segment {}: {}", path, std::strerror(errno));
+        ::close(fd);
+        shm_unlink(path.c_str());
+        return false;
+    }
+    ::close(fd);
+
+    // The magic goes in last so a reader racing the creation rejects the
+    // segment instead of reading a half-written header.
+    std::memcpy(header_, &layout, sizeof(layout));
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header_->magic, SharedGaussianHeader::expected_magic, sizeof(header_->magic));
+    name_ = path;
+    owner_ = true;
+    utils::log_info("Created shared Gaussian segment {} ({} splats, {} bytes)", path, capacity, bytes);
+    return true;
+}
+
+bool SharedGaussianSegment::open(const std::string& name) {
+    close();
+    const std::string path = shm_name(name);
+    int fd = shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        utils::log_error("Failed to open shared segment {}: {}", path, std::strerror(errno));
+        return false;
+    }
+    struct stat info {};
+    const bool mapped = fstat(fd, &info) == 0 &&
+                        static_cast<std::size_t>(info.st_size) >= sizeof(SharedGaussianHeader) &&
+                        map(fd, static_cast<std::size_t>(info.st_size), false);
+    ::close(fd);
+    if (!mapped) {
+        utils::log_error("Shared segment {} is too small or cannot be mapped", path);
+        return false;
+    }
+
+    auto valid = [&]() {
+        if (std::memcmp(header_->magic, SharedGaussianHeader::expected_magic, sizeof(header_->magic)) != 0 ||
+            header_->version != SharedGaussianHeader::current_version ||
+            header_->header_bytes != sizeof(SharedGaussianHeader) ||
+            header_->stored_columns != SharedGaussianHeader::column_count ||
+            header_->sh_degree > GaussianCloud::max_sh_degree) {
+            return false;
+        }
+        for (std::size_t i = 0; i < SharedGaussianHeader::column_count; ++i) {
+            // Compared by subtraction so a hostile header cannot overflow.
+            const std::uint64_t offset = header_->column_offsets[i];
+            const std::uint64_t stride = column_width(i, header_->sh_degree) * sizeof(float);
+            if (offset % alignof(float) != 0 || offset > mapped_bytes_ ||
+                (stride != 0 && header_->capacity > (mapped_bytes_ - offset) / stride)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (!valid()) {
+        utils::log_error("Shared segment {} has an unknown layout", path);
+        close();
+        return false;
+    }
+    name_ = path;
+    return true;
+}
+
+void SharedGaussianSegment::close() {
+    if (header_ != nullptr) {
+        munmap(header_, mapped_bytes_);
+        if (owner_) {
+            shm_unlink(name_.c_str());
+        }
+    }
+    header_ = nullptr;
+    mapped_bytes_ = 0;
+    owner_ = false;
+    name_.clear();
+}
+
+bool SharedGaussianSegment::map(int fd, std::size_t bytes, bool writable) {
+    void* data = mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    header_ = static_cast<SharedGaussianHeader*>(data);
+    mapped_bytes_ = bytes;
+    return true;
+}
+
+std::size_t SharedGaussianSegment::get_capacity() const {
+    return header_ ? header_->capacity : 0;
+}
+
+std::uint32_t SharedGaussianSegment::get_sh_degree() const {
+    return header_ ? header_->sh_degree : 0;
+}
+
+std::uint64_t SharedGaussianSegment::get_generation() const {
+    return header_ ? shared_word(header_->generation).load(std::memory_order_acquire) : 0;
+}
+
+bool SharedGaussianSegment::publish(const GaussianCloud& cloud) {
+    if (!owner_) {
+        utils::log_error("Shared segment {} is not writable", name_);
+        return false;
+    }
+    if (cloud.size() > header_->capacity || cloud.get_sh_degree() != header_->sh_degree) {
+        utils::log_error("Cloud of {} splats (SH degree {}) does not fit shared segment {}",
+                         cloud.size(), cloud.get_sh_degree(), name_);
+        return false;
+    }
+
+    auto generation = shared_word(header_->generation);
+    const std::uint64_t start = generation.load(std::memory_order_relaxed);
+    generation.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto* base = reinterpret_cast<std::byte*>(header_);
+    auto write = [&](std::size_t index, std::span<const float> values) {
+        store_words(reinterpret_cast<float*>(base + header_->column_offsets[index]), values);
+    };
+    for (std::size_t i = 0; i < GaussianCloud::attribute_count; ++i) {
+        write(i, cloud.column(static_cast<GaussianAttribute>(i)));
+    }
+    write(GaussianCloud::attribute_count, cloud.sh_rest());
+    write(GaussianCloud::attribute_count + 1, cloud.filter_3d());
+    shared_word(header_->count).store(cloud.size(), std::memory_order_relaxed);
+    shared_word(header_->source_version).store(cloud.get_version(), std::memory_order_relaxed);
+    shared_word(header_->has_filter_3d).store(cloud.has_filter_3d() ? 1 : 0, std::memory_order_relaxed);
+
+    generation.store(start + 2, std::memory_order_release);
+    return true;
+}
+
+std::optional<std::uint64_t> SharedGaussianSegment::begin_read(std::chrono::milliseconds timeout) const {
+    if (!header_) {
+        return std::nullopt;
+    }
+    auto generation = shared_word(header_->generation);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        std::uint64_t value = generation.load(std::memory_order_acquire);
+        if ((value & 1) == 0) {
+            return value;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return std::nullopt;
+        }
+        std::this_thread::yield();
+    }
+}
+
+bool SharedGaussianSegment::end_read(std::uint64_t generation) const {
+    if (!header_) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return shared_word(header_->generation).load(std::memory_order_relaxed) == generation;
+}
+
+std::size_t SharedGaussianSegment::size() const {
+    // A torn read mid-update is caught by end_read(); clamping keeps the
+    // spans inside the mapping meanwhile.
+    return header_ ? std::min<std::uint64_t>(shared_word(header_->count).load(std::memory_order_relaxed),
+                                             header_->capacity)
+                   : 0;
+}
+
+const float* SharedGaussianSegment::column_data(std::size_t index) const {
+    return reinterpret_cast<const float*>(reinterpret_cast<const std::byte*>(header_) + header_->column_offsets[index]);
+}
+
+std::span<const float> SharedGaussianSegment::column(GaussianAttribute attribute) const {
+    if (!header_) {
+        return {};
+    }
+    return {column_data(static_cast<std::size_t>(attribute)), size()};
+}
+
+std::span<const float> SharedGaussianSegment::sh_rest() const {
+    if (!header_) {
+        return {};
+    }
+    return {column_data(GaussianCloud::attribute_count),
+            size() * column_width(GaussianCloud::attribute_count, header_->sh_degree)};
+}
+
+std::span<const float> SharedGaussianSegment::filter_3d() const {
+    if (!header_ || shared_word(header_->has_filter_3d).load(std::memory_order_relaxed) == 0) {
+        return {};
+    }
+    return {column_data(GaussianCloud::attribute_count + 1), size()};
+}
+
+bool SharedGaussianSegment::read(GaussianCloud& cloud, std::chrono::milliseconds timeout) const {
+    if (!header_) {
+        return false;
+    }
+    if (cloud.get_sh_degree() != header_->sh_degree) {
+        utils::log_error("Shared segment {} has SH degree {}, the cloud {}",
+                         name_, header_->sh_degree, cloud.get_sh_degree());
+        return false;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        const auto generation = begin_read(std::max(remaining, std::chrono::milliseconds(0)));
+        if (!generation) {
+            utils::log_error("Shared segment {} is stuck mid-update; its writer may have died", name_);
+            return false;
+        }
+        const std::size_t count = size();
+        cloud.resize(count);
+        for (std::size_t i = 0; i < GaussianCloud::attribute_count; ++i) {
+            const auto attribute = static_cast<GaussianAttribute>(i);
+            load_words(column(attribute).data(), count, cloud.column(attribute).data());
+        }
+        load_words(sh_rest().data(), cloud.sh_rest().size(), cloud.sh_rest().data());
+        auto filter = filter_3d();
+        if (filter.empty()) {
+            cloud.clear_filter_3d();
+        } else {
+            if (!cloud.has_filter_3d()) {
+                cloud.allocate_filter_3d();
+            }
+            load_words(filter.data(), count, cloud.filter_3d().data());
+        }
+        if (end_read(*generation)) {
+            return true;
+        }
+        std::this_thread::yield();
+    }
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "buildify/core/tensor_pool.hpp"
+#include "buildify/utils/logger.hpp"
+
+namespace buildify::core {
+
+TensorPool::TensorPool(std::size_t max_per_shape, torch::TensorOptions options)
+    : max_per_shape_(max_per_shape), options_(options) {}
+
+torch::Tensor TensorPool::acquire(const std::vector<std::int64_t>& shape) {
+    std::lock_guard lock(mutex_);
+    auto& bucket = tensors_[shape];
+
+    // Views keep the storage alive without holding the tensor itself, so
+    // both reference counts have to show the pool as the only owner.
+    for (const auto& tensor : bucket) {
+        if (tensor.use_count() == 1 && tensor.storage().use_count() == 1) {
+            return tensor;
+        }
+    }
+
+    auto tensor = torch::empty(shape, options_);
+    if (bucket.size() < max_per_shape_) {
+        bucket.push_back(tensor);
+    } else {
+        utils::log_debug("Tensor pool exhausted for shape of rank {}, allocating", shape.size());
+    }
+    return tensor;
+}
+
+void TensorPool::clear() {
+    std::lock_guard lock(mutex_);
+    tensors_.clear();
+}
+
+std::size_t TensorPool::size() const {
+    std::lock_guard lock(mutex_);
+    std::size_t count = 0;
+    for (const auto& [shape, bucket] : tensors_) {
+        count += bucket.size();
+    }
+    return count;
+}
+
+}
\ No newline at end of file
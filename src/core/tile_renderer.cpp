@@ -0,0 +1,1667 @@
+#include "buildify/core/tile_renderer.hpp"
+#include "buildify/core/scene.hpp"
+#ifdef WITH_PYTORCH
+#include "buildify/core/tensor_pool.hpp"
+#endif
+#include "buildify/core/gaussians.hpp"
+#include "buildify/core/gaussian_instance.hpp"
+#include "buildify/utils/thread_pool.hpp"
+#include "buildify/utils/huge_pages.hpp"
+#include "buildify/utils/numa.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace buildify::core {
+
+namespace {
+
+constexpr float min_alpha = 1.0f / 255.0f;
+constexpr float max_alpha = 0.99f;
+constexpr float min_transmittance = 1e-4f;
+constexpr float low_pass_filter = 0.3f;
+constexpr std::size_t projection_grain = 4096;
+
+constexpr float sh_c1 = 0.4886025119029199f;
+constexpr float sh_c2[] = {
+    1.0925484305920792f, -1.0925484305920792f, 0.31539156525252005f,
+    -1.0925484305920792f, 0.5462742152960396f
+};
+constexpr float sh_c3[] = {
+    -0.5900435899266435f, 2.890611442640554f, -0.4570457994644658f,
+    0.3731763325901154f, -0.4570457994644658f, 1.445305721320277f,
+    -0.5900435899266435f
+};
+
+struct ViewParams {
+    utils::Matrix4f view;
+    utils::Vector3f position;
+    float fx = 0.0f;
+    float fy = 0.0f;
+    float cx = 0.0f;
+    float cy = 0.0f;
+    float near = 0.0f;
+    float far = 0.0f;
+    bool orthographic = false;
+    // Snapshot the view was made from; culling uses its frustum.
+    CameraParams camera;
+
+    bool same_intrinsics(const ViewParams& other) const {
+        return fx == other.fx && fy == other.fy && cx == other.cx && cy == other.cy &&
+               orthographic == other.orthographic;
+    }
+};
+
+struct ProjectedSplat {
+    float x;
+    float y;
+    float conic_a;
+    float conic_b;
+    float conic_c;
+    float depth;
+    float opacity;
+    float radius;
+    float color[3];
+    float normal[3];
+    std::uint32_t tile_min_x;
+    std::uint32_t tile_min_y;
+    std::uint32_t tile_max_x;
+    std::uint32_t tile_max_y;
+};
+
+struct TileCacheEntry {
+    // Stable ids of the splats blended in the last full render of this
+    // tile, sorted so later frames can diff against it with a single merge.
+    std::vector<std::uint32_t> splats;
+    float mean_depth = 0.0f;
+    std::uint32_t age = 0;
+    bool valid = false;
+};
+
+// A cloud to project and the transform that takes its splats into view
+// space: the scene's own cloud, or an instanced asset.
+struct SplatSource {
+    const GaussianCloud* cloud = nullptr;
+    utils::Matrix4f to_view;
+    // Camera position in the cloud's frame, for view-dependent colour.
+    utils::Vector3f camera;
+    // The transform may scale, so view-space normals need normalizing.
+    bool instanced = false;
+    // Stable id of the source's first splat. Unlike projection slots, ids
+    // do not move when other instances or clusters are culled.
+    std::uint32_t id_base = 0;
+};
+
+// Splats [first, first + count) of a source, projected into slots starting
+// at `offset`.
+struct ProjectionSegment {
+    std::uint32_t source = 0;
+    std::size_t first = 0;
+    std::size_t count = 0;
+    std::size_t offset = 0;
+};
+
+// Projection and tile bins for one view. The main frame and each view of a
+// batch own one, so batched views can be prepared concurrently.
+struct FrameContext {
+    std::vector<SplatSource> sources;
+    std::vector<ProjectionSegment> segments;
+    // Ids handed out to every source that could be visible, culled or not.
+    std::size_t id_count = 0;
+    std::size_t instances_visible = 0;
+    std::size_t instances_culled = 0;
+    utils::HugePageVector<ProjectedSplat> projected;
+    std::vector<std::uint32_t> tile_offsets;
+    std::vector<std::uint32_t> tile_cursors;
+    utils::HugePageVector<std::uint32_t> tile_entries;
+    std::size_t visible_splats = 0;
+
+    std::span<std::uint32_t> tile_splats(std::size_t tile) {
+        return {tile_entries.data() + tile_offsets[tile], tile_offsets[tile + 1] - tile_offsets[tile]};
+    }
+};
+
+// Destination of a rendered view. Every pointer except color may be null,
+// in which case that channel is neither accumulated nor written.
+struct FrameOutput {
+    float* color;
+    float* depth;
+    float* alpha = nullptr;
+    float* median_depth = nullptr;
+    float* normal = nullptr;
+};
+
+struct AuxBuffers {
+    std::vector<float> alpha;
+    std::vector<float> median_depth;
+    std::vector<float> normal;
+};
+
+bool has_channel(AuxChannel channels, AuxChannel channel) {
+    return (channels & channel) != AuxChannel::None;
+}
+
+ViewParams make_view_params(const Camera& camera, std::uint32_t width, std::uint32_t height) {
+    const CameraParams camera_params = camera.get_params();
+    const auto& projection = camera_params.projection;
+    ViewParams params;
+    params.camera = camera_params;
+    params.view = camera_params.view;
+    params.position = camera_params.position;
+    params.orthographic = camera_params.orthographic;
+    params.near = camera_params.near;
+    params.far = camera_params.far;
+    params.fx = 0.5f * width * projection.m[0][0];
+    params.fy = 0.5f * height * projection.m[1][1];
+    params.cx = 0.5f * width * (params.orthographic ? 1.0f + projection.m[0][3] : 1.0f);
+    params.cy = 0.5f * height * (params.orthographic ? 1.0f - projection.m[1][3] : 1.0f);
+    return params;
+}
+
+utils::Vector3f transform_point(const utils::Matrix4f& m, float x, float y, float z) {
+    return {
+        m.m[0][0] * x + m.m[0][1] * y + m.m[0][2] * z + m.m[0][3],
+        m.m[1][0] * x + m.m[1][1] * y + m.m[1][2] * z + m.m[1][3],
+        m.m[2][0] * x + m.m[2][1] * y + m.m[2][2] * z + m.m[2][3]
+    };
+}
+
+utils::Matrix4f rigid_inverse(const utils::Matrix4f& m) {
+    utils::Matrix4f result;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            result.m[i][j] = m.m[j][i];
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        result.m[i][3] = -(result.m[i][0] * m.m[0][3] +
+                           result.m[i][1] * m.m[1][3] +
+                           result.m[i][2] * m.m[2][3]);
+    }
+    return result;
+}
+
+// View-space point for pixel coordinate (u, v) at view depth `depth`.
+utils::Vector3f unproject(const ViewParams& view, float u, float v, float depth) {
+    float x = (u - view.cx) / view.fx;
+    float y = -(v - view.cy) / view.fy;
+    if (!view.orthographic) {
+        x *= depth;
+        y *= depth;
+    }
+    return {x, y, -depth};
+}
+
+// -1 outside the frustum, 1 entirely inside, 0 crossing a plane.
+int classify_sphere(const CameraParams& camera, const utils::Vector3f& center, float radius) {
+    int result = 1;
+    for (const auto& plane : camera.frustum) {
+        float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+        if (distance < -radius) {
+            return -1;
+        }
+        if (distance < radius) {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+// Lists what to project for a view: the scene's cloud whole, then every
+// visible instance. Instances are culled by their bounding sphere and,
+// when that crosses the frustum, cluster by cluster; adjacent surviving
+// clusters merge into one segment.
+void gather_sources(FrameContext& frame, const Scene& scene, const ViewParams& view) {
+    frame.sources.clear();
+    frame.segments.clear();
+    frame.instances_visible = 0;
+    frame.instances_culled = 0;
+
+    std::size_t offset = 0;
+    auto add_segment = [&](std::size_t first, std::size_t count) {
+        auto source = static_cast<std::uint32_t>(frame.sources.size() - 1);
+        if (!frame.segments.empty() && frame.segments.back().source == source &&
+            frame.segments.back().first + frame.segments.back().count == first) {
+            frame.segments.back().count += count;
+        } else {
+            frame.segments.push_back({source, first, count, offset});
+        }
+        offset += count;
+    };
+
+    const auto& cloud = scene.get_gaussians();
+    frame.sources.push_back({&cloud, view.view, view.position, false, 0});
+    if (!cloud.empty()) {
+        add_segment(0, cloud.size());
+    }
+    frame.id_count = cloud.size();
+
+    for (const auto& entity : scene.get_entities()) {
+        auto* instance = dynamic_cast<const GaussianInstance*>(entity.get());
+        if (!instance || !instance->is_visible() || !instance->get_asset() ||
+            instance->get_asset()->get_gaussians().empty()) {
+            continue;
+        }
+        const auto& asset = *instance->get_asset();
+        const auto id_base = static_cast<std::uint32_t>(frame.id_count);
+        frame.id_count += asset.get_gaussians().size();
+        const auto& transform = instance->get_transform();
+        const utils::Matrix4f model = transform.to_matrix();
+        const float scale = std::max({std::abs(transform.scale.x), std::abs(transform.scale.y),
+                                      std::abs(transform.scale.z)});
+        auto to_world = [&](const utils::Vector3f& p) { return transform_point(model, p.x, p.y, p.z); };
+
+        const int placement = classify_sphere(view.camera, to_world(asset.get_center()), asset.get_radius() * scale);
+        if (placement < 0) {
+            ++frame.instances_culled;
+            continue;
+        }
+        ++frame.instances_visible;
+
+        // Camera into the local frame: undo translation, rotation, scale.
+        const auto r = transform.rotation.to_matrix();
+        const utils::Vector3f d = view.position - transform.position;
+        const float scales[3] = {transform.scale.x, transform.scale.y, transform.scale.z};
+        float local[3];
+        for (int a = 0; a < 3; ++a) {
+            local[a] = (r.m[0][a] * d.x + r.m[1][a] * d.y + r.m[2][a] * d.z) / (scales[a] != 0.0f ? scales[a] : 1.0f);
+        }
+        frame.sources.push_back({&asset.get_gaussians(), view.view * model, {local[0], local[1], local[2]}, true, id_base});
+
+        if (placement > 0) {
+            add_segment(0, asset.get_gaussians().size());
+            continue;
+        }
+        for (const auto& cluster : asset.get_clusters()) {
+            if (classify_sphere(view.camera, to_world(cluster.center), cluster.radius * scale) >= 0) {
+                add_segment(cluster.first, cluster.count);
+            }
+        }
+    }
+}
+
+// Changes whenever the splats a view of the scene projects may change:
+// the scene's cloud, or any instance's asset, visibility or transform.
+std::uint64_t content_version(const Scene& scene) {
+    std::uint64_t hash = scene.get_gaussians().get_version();
+    auto mix = [&](std::uint64_t value) { hash = (hash ^ value) * 0x100000001b3ull; };
+    for (const auto& entity : scene.get_entities()) {
+        auto* instance = dynamic_cast<const GaussianInstance*>(entity.get());
+        if (!instance) {
+            continue;
+        }
+        mix(reinterpret_cast<std::uintptr_t>(instance->get_asset().get()));
+        mix(instance->is_visible() ? 1 : 0);
+        const auto& transform = instance->get_transform();
+        for (float value : {transform.position.x, transform.position.y, transform.position.z,
+                            transform.rotation.x, transform.rotation.y, transform.rotation.z, transform.rotation.w,
+                            transform.scale.x, transform.scale.y, transform.scale.z}) {
+            mix(std::bit_cast<std::uint32_t>(value));
+        }
+    }
+    return hash;
+}
+
+bool project_point(const ViewParams& view, const utils::Vector3f& p, float& u, float& v) {
+    float depth = -p.z;
+    if (depth <= view.near) {
+        return false;
+    }
+    float inv = view.orthographic ? 1.0f : 1.0f / depth;
+    u = view.cx + view.fx * p.x * inv;
+    v = view.cy - view.fy * p.y * inv;
+    return true;
+}
+
+void evaluate_sh(std::uint32_t degree, const float dc[3], const float* rest,
+                 const utils::Vector3f& dir, float out[3]) {
+    for (int c = 0; c < 3; ++c) {
+        out[c] = GaussianCloud::sh_c0 * dc[c];
+    }
+
+    if (degree > 0) {
+        float x = dir.x, y = dir.y, z = dir.z;
+        for (int c = 0; c < 3; ++c) {
+            out[c] += -sh_c1 * y * rest[0 * 3 + c] +
+                       sh_c1 * z * rest[1 * 3 + c] -
+                       sh_c1 * x * rest[2 * 3 + c];
+        }
+
+        if (degree > 1) {
+            float xx = x * x, yy = y * y, zz = z * z;
+            float xy = x * y, yz = y * z, xz = x * z;
+            for (int c = 0; c < 3; ++c) {
+                out[c] += sh_c2[0] * xy * rest[3 * 3 + c] +
+                          sh_c2[1] * yz * rest[4 * 3 + c] +
+                          sh_c2[2] * (2.0f * zz - xx - yy) * rest[5 * 3 + c] +
+                          sh_c2[3] * xz * rest[6 * 3 + c] +
+                          sh_c2[4] * (xx - yy) * rest[7 * 3 + c];
+            }
+
+            if (degree > 2) {
+                for (int c = 0; c < 3; ++c) {
+                    out[c] += sh_c3[0] * y * (3.0f * xx - yy) * rest[8 * 3 + c] +
+                              sh_c3[1] * xy * z * rest[9 * 3 + c] +
+                              sh_c3[2] * y * (4.0f * zz - xx - yy) * rest[10 * 3 + c] +
+                              sh_c3[3] * z * (2.0f * zz - 3.0f * xx - 3.0f * yy) * rest[11 * 3 + c] +
+                              sh_c3[4] * x * (4.0f * zz - xx - yy) * rest[12 * 3 + c] +
+                              sh_c3[5] * z * (xx - yy) * rest[13 * 3 + c] +
+                              sh_c3[6] * x * (xx - 3.0f * yy) * rest[14 * 3 + c];
+                }
+            }
+        }
+    }
+
+    for (int c = 0; c < 3; ++c) {
+        out[c] = std::max(0.0f, out[c] + 0.5f);
+    }
+}
+
+// True when the splats in `current`, given as slots and compared by their
+// entry in `ids`, and the id-sorted `cached` list differ in at most
+// max_change * max(|current|, |cached|) splats.
+bool similar_splat_sets(std::span<const std::uint32_t> current,
+                        std::span<const std::uint32_t> ids,
+                        std::span<const std::uint32_t> cached,
+                        float max_change) {
+    std::size_t larger = std::max(current.size(), cached.size());
+    if (larger == 0) {
+        return true;
+    }
+
+    std::size_t allowed = static_cast<std::size_t>(max_change * static_cast<float>(larger));
+    std::size_t size_difference = current.size() > cached.size()
+        ? current.size() - cached.size() : cached.size() - current.size();
+    if (size_difference > allowed) {
+        return false;
+    }
+
+    thread_local std::vector<std::uint32_t> sorted_current;
+    sorted_current.clear();
+    for (std::uint32_t slot : current) {
+        sorted_current.push_back(ids[slot]);
+    }
+    std::sort(sorted_current.begin(), sorted_current.end());
+
+    std::size_t common = 0;
+    auto a = sorted_current.begin();
+    auto b = cached.begin();
+    while (a != sorted_current.end() && b != cached.end()) {
+        if (*a < *b) {
+            ++a;
+        } else if (*b < *a) {
+            ++b;
+        } else {
+            ++common;
+            ++a;
+            ++b;
+        }
+    }
+
+    return (current.size() - common) + (cached.size() - common) <= allowed;
+}
+
+// Lists shorter than this sort faster by comparison than by histogram.
+constexpr std::size_t radix_sort_threshold = 128;
+
+// Sorts a tile's splats front to back, ties broken by index. Positive float
+// depths order like their bit patterns, so depth in the high half and index
+// in the low half of a 64-bit key give the blend order, and the sort never
+// touches the projected splats again after gathering the keys.
+void sort_tile_splats(std::span<std::uint32_t> splats, std::span<const ProjectedSplat> projected,
+                      TileSortMode mode) {
+    const std::size_t count = splats.size();
+    if (count < 2) {
+        return;
+    }
+    thread_local std::vector<std::uint64_t> keys;
+    thread_local std::vector<std::uint64_t> scratch;
+    keys.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t depth_bits = std::bit_cast<std::uint32_t>(std::max(projected[splats[i]].depth, 0.0f));
+        keys[i] = static_cast<std::uint64_t>(depth_bits) << 32 | splats[i];
+    }
+
+    const bool radix = mode == TileSortMode::Radix ||
+                       (mode == TileSortMode::Auto && count >= radix_sort_threshold);
+    std::uint64_t* sorted = keys.data();
+    if (radix) {
+        // LSD over eight byte digits; digits shared by every key are skipped.
+        std::array<std::array<std::uint32_t, 256>, 8> histograms{};
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::uint64_t key = keys[i];
+            for (std::size_t digit = 0; digit < 8; ++digit) {
+                ++histograms[digit][(key >> (8 * digit)) & 0xff];
+            }
+        }
+        scratch.resize(count);
+        std::uint64_t* source = keys.data();
+        std::uint64_t* target = scratch.data();
+        for (std::size_t digit = 0; digit < 8; ++digit) {
+            auto& histogram = histograms[digit];
+            if (histogram[(source[0] >> (8 * digit)) & 0xff] == count) {
+                continue;
+            }
+            std::uint32_t offset = 0;
+            for (auto& bucket : histogram) {
+                const std::uint32_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::uint64_t key = source[i];
+                target[histogram[(key >> (8 * digit)) & 0xff]++] = key;
+            }
+            std::swap(source, target);
+        }
+        sorted = source;
+    } else {
+        std::sort(keys.begin(), keys.end());
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        splats[i] = static_cast<std::uint32_t>(sorted[i]);
+    }
+}
+
+}
+
+struct TileRenderer::Impl {
+    bool initialized = false;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::uint32_t tiles_x = 0;
+    std::uint32_t tiles_y = 0;
+    std::array<float, 4> background = {0.0f, 0.0f, 0.0f, 1.0f};
+
+    FrameContext frame;
+    std::vector<std::unique_ptr<FrameContext>> batch_frames;
+
+    utils::HugePageVector<float> color;
+    utils::HugePageVector<float> depth;
+    utils::HugePageVector<float> previous_color;
+    utils::HugePageVector<float> previous_depth;
+
+    AntiAliasingSettings anti_aliasing;
+    TileSortMode sort_mode = TileSortMode::Auto;
+    utils::MemoryPlacement memory_placement = utils::MemoryPlacement::Default;
+    AuxChannel aux_channels = AuxChannel::None;
+    AuxBuffers aux;
+    AuxBuffers previous_aux;
+
+    TemporalCacheSettings cache_settings;
+    std::vector<TileCacheEntry> tile_cache;
+    // Stable id of each projected slot of the main frame.
+    std::vector<std::uint32_t> splat_ids;
+    ViewParams previous_view;
+    const Scene* cached_scene = nullptr;
+    std::uint64_t cached_version = 0;
+    std::size_t cached_id_count = 0;
+    bool cache_valid = false;
+
+    // Per-tile shading rate (1, 2 or 4), empty when variable rate is off.
+    std::vector<std::uint8_t> tile_rates;
+    float reduced_min_alpha = min_alpha;
+    std::uint32_t reduced_sh_degree = 0;
+
+    // Progressive refinement: projection and bins stay valid while the view
+    // and scene are unchanged, so later frames only re-blend tiles.
+    bool progressive_active = false;
+    const Scene* progressive_scene = nullptr;
+    std::uint64_t progressive_version = 0;
+    ViewParams progressive_view;
+    std::vector<std::uint32_t> refine_order;
+    // Tiles of refine_order shaded at quarter rate, then at full rate.
+    std::size_t coarse_tiles = 0;
+    std::size_t refined_tiles = 0;
+
+    TileFrameStats stats;
+    std::atomic<std::size_t> shaded_samples{0};
+
+#ifdef WITH_PYTORCH
+    TensorPool tensor_pool;
+#endif
+
+    void resize(std::uint32_t new_width, std::uint32_t new_height) {
+        width = new_width;
+        height = new_height;
+        tiles_x = (width + tile_size - 1) / tile_size;
+        tiles_y = (height + tile_size - 1) / tile_size;
+
+        std::size_t pixels = static_cast<std::size_t>(width) * height;
+        color.assign(pixels * 4, 0.0f);
+        depth.assign(pixels, 0.0f);
+        previous_color.assign(pixels * 4, 0.0f);
+        previous_depth.assign(pixels, 0.0f);
+        place_buffers();
+        aux = {};
+        previous_aux = {};
+        allocate_aux();
+        tile_cache.assign(static_cast<std::size_t>(tiles_x) * tiles_y, TileCacheEntry{});
+        cache_valid = false;
+    }
+
+    // Tiles are numbered in row order like the pixels, so splitting the
+    // buffers by the pool's node weights keeps each node's tiles local.
+    // That split only holds while the workers are pinned; unpinned, the
+    // buffers keep the default first-touch policy.
+    void place_buffers() {
+        auto& pool = utils::ThreadPool::instance();
+        auto placement = memory_placement;
+        if (placement == utils::MemoryPlacement::Partitioned && !pool.is_pinned()) {
+            placement = utils::MemoryPlacement::Default;
+        }
+        if (placement == utils::MemoryPlacement::Default || color.empty()) {
+            return;
+        }
+        for (auto* buffer : {&color, &depth, &previous_color, &previous_depth}) {
+            if (!utils::place_memory(buffer->data(), buffer->size() * sizeof(float), placement, pool.node_weights())) {
+                utils::log_debug("Could not apply the NUMA placement to a frame buffer");
+            }
+        }
+    }
+
+    // Sizes the buffers of enabled channels and releases disabled ones.
+    void allocate_aux() {
+        std::size_t pixels = static_cast<std::size_t>(width) * height;
+        auto fit = [](std::vector<float>& buffer, bool enabled, std::size_t size) {
+            if (enabled) {
+                buffer.resize(size, 0.0f);
+            } else {
+                buffer = {};
+            }
+        };
+        fit(aux.alpha, has_channel(aux_channels, AuxChannel::Alpha), pixels);
+        fit(aux.median_depth, has_channel(aux_channels, AuxChannel::MedianDepth), pixels);
+        fit(aux.normal, has_channel(aux_channels, AuxChannel::Normal), pixels * 3);
+    }
+
+    FrameOutput main_output() {
+        auto data = [](std::vector<float>& buffer) { return buffer.empty() ? nullptr : buffer.data(); };
+        return {color.data(), depth.data(), data(aux.alpha), data(aux.median_depth), data(aux.normal)};
+    }
+
+    std::uint32_t tile_rate(std::size_t tile) const {
+        return tile_rates.empty() ? 1 : tile_rates[tile];
+    }
+
+    void project(FrameContext& frame, const Scene& scene, const ViewParams& view, bool with_normals);
+    void bin(FrameContext& frame);
+    void prepare_frame(const Scene& scene, const ViewParams& view,
+                       const VariableRateShading& variable_rate);
+    float render_tile(FrameContext& frame, FrameOutput out, std::uint32_t tile,
+                      std::span<std::uint32_t> splats, std::uint32_t rate);
+    template<bool WithMedian, bool WithNormal>
+    float blend_tile(FrameContext& frame, FrameOutput out, std::uint32_t tile,
+                     std::span<std::uint32_t> splats, std::uint32_t rate);
+    void build_rate_map(const VariableRateShading& settings);
+    float tile_motion(std::uint32_t tile, float mean_depth, const ViewParams& view,
+                      const utils::Matrix4f& to_previous) const;
+    bool reproject_tile(std::uint32_t tile, const ViewParams& view,
+                        const utils::Matrix4f& to_previous);
+    std::size_t shade_in_order(std::size_t next, std::chrono::steady_clock::time_point deadline, bool coarse);
+};
+
+void TileRenderer::Impl::project(FrameContext& frame, const Scene& scene, const ViewParams& view,
+                                 bool with_normals) {
+    gather_sources(frame, scene, view);
+    const std::size_t count = frame.segments.empty() ? 0 : frame.segments.back().offset + frame.segments.back().count;
+    frame.projected.resize(count);
+
+    const bool mip_2d = anti_aliasing.mip_filter_2d;
+    const float dilation = mip_2d ? std::max(anti_aliasing.filter_2d_variance, 0.0f) : low_pass_filter;
+    const float limit_x = 1.3f * 0.5f * width / view.fx;
+    const float limit_y = 1.3f * 0.5f * height / view.fy;
+
+    utils::ThreadPool::instance().parallel_for_partitioned(0, count, [&](std::size_t begin, std::size_t end) {
+        // Rotation matrices for a run of splats come from the batch kernel,
+        // which vectorizes where the per-splat normalization did not. A run
+        // never crosses a segment, so it reads one source.
+        constexpr std::size_t run = 256;
+        float rotations[9 * run];
+        auto segment = std::upper_bound(frame.segments.begin(), frame.segments.end(), begin,
+                                        [](std::size_t slot, const ProjectionSegment& s) { return slot < s.offset; }) - 1;
+        for (std::size_t first_slot = begin; first_slot < end;) {
+            if (first_slot >= segment->offset + segment->count) {
+                ++segment;
+            }
+            const SplatSource& source = frame.sources[segment->source];
+            const GaussianCloud& cloud = *source.cloud;
+            const std::size_t first = segment->first + (first_slot - segment->offset);
+            const std::size_t n = std::min({run, end - first_slot, segment->offset + segment->count - first_slot});
+            const std::size_t slot_base = first_slot - first;
+            first_slot += n;
+
+            auto pos_x = cloud.column(GaussianAttribute::PositionX);
+            auto pos_y = cloud.column(GaussianAttribute::PositionY);
+            auto pos_z = cloud.column(GaussianAttribute::PositionZ);
+            auto scale_x = cloud.column(GaussianAttribute::ScaleX);
+            auto scale_y = cloud.column(GaussianAttribute::ScaleY);
+            auto scale_z = cloud.column(GaussianAttribute::ScaleZ);
+            auto rot_x = cloud.column(GaussianAttribute::RotationX);
+            auto rot_y = cloud.column(GaussianAttribute::RotationY);
+            auto rot_z = cloud.column(GaussianAttribute::RotationZ);
+            auto rot_w = cloud.column(GaussianAttribute::RotationW);
+            auto opacity = cloud.column(GaussianAttribute::Opacity);
+            auto color_r = cloud.column(GaussianAttribute::ColorR);
+            auto color_g = cloud.column(GaussianAttribute::ColorG);
+            auto color_b = cloud.column(GaussianAttribute::ColorB);
+            auto sh_rest = cloud.sh_rest();
+            auto filter_3d = cloud.filter_3d();
+            const bool use_filter_3d = anti_aliasing.filter_3d && cloud.has_filter_3d();
+            const std::size_t sh_stride = cloud.get_sh_rest_stride();
+            const std::uint32_t sh_degree = cloud.get_sh_degree();
+            // For instances this folds the instance transform into the view.
+            const auto& w = source.to_view.m;
+
+            utils::quaternions_to_matrices({rot_x.subspan(first, n), rot_y.subspan(first, n),
+                                            rot_z.subspan(first, n), rot_w.subspan(first, n)},
+                                           std::span<float>(rotations, 9 * n));
+            for (std::size_t i = first; i < first + n; ++i) {
+                ProjectedSplat& out = frame.projected[slot_base + i];
+                out.radius = 0.0f;
+
+                if (opacity[i] < min_alpha) {
+                    continue;
+                }
+
+                auto p = transform_point(source.to_view, pos_x[i], pos_y[i], pos_z[i]);
+                float z = -p.z;
+                if (z <= view.near || z >= view.far) {
+                    continue;
+                }
+
+                // Rotation from the (normalized) quaternion, scaled per axis.
+                float qx = rot_x[i], qy = rot_y[i], qz = rot_z[i], qw = rot_w[i];
+                if (qx * qx + qy * qy + qz * qz + qw * qw <= 0.0f) {
+                    continue;
+                }
+
+                float r[3][3];
+                for (std::size_t k = 0; k < 9; ++k) {
+                    r[k / 3][k % 3] = rotations[k * n + (i - first)];
+                }
+                float s[3] = {scale_x[i], scale_y[i], scale_z[i]};
+                float splat_opacity = opacity[i];
+
+                // The 3D filter widens every axis in quadrature and scales
+                // opacity by the volume ratio so the splat keeps its energy.
+                if (use_filter_3d) {
+                    float f = filter_3d[i];
+                    float volume = s[0] * s[1] * s[2];
+                    for (float& axis : s) {
+                        axis = std::sqrt(std::fma(f, f, axis * axis));
+                    }
+                    float filtered_volume = s[0] * s[1] * s[2];
+                    if (filtered_volume > 0.0f) {
+                        splat_opacity *= volume / filtered_volume;
+                    }
+                }
+
+                float m[3][3];
+                for (int a = 0; a < 3; ++a) {
+                    for (int b = 0; b < 3; ++b) {
+                        m[a][b] = r[a][b] * s[b];
+                    }
+                }
+
+                float sigma[3][3];
+                for (int a = 0; a < 3; ++a) {
+                    for (int b = a; b < 3; ++b) {
+                        sigma[a][b] = m[a][0] * m[b][0] + m[a][1] * m[b][1] + m[a][2] * m[b][2];
+                        sigma[b][a] = sigma[a][b];
+                    }
+                }
+
+                float j[2][3] = {};
+                float u, v;
+                if (view.orthographic) {
+                    j[0][0] = view.fx;
+                    j[1][1] = -view.fy;
+                    u = view.cx + view.fx * p.x;
+                    v = view.cy - view.fy * p.y;
+                } else {
+                    float tx = std::clamp(p.x / z, -limit_x, limit_x) * z;
+                    float ty = std::clamp(p.y / z, -limit_y, limit_y) * z;
+                    j[0][0] = view.fx / z;
+                    j[0][2] = view.fx * tx / (z * z);
+                    j[1][1] = -view.fy / z;
+                    j[1][2] = -view.fy * ty / (z * z);
+                    u = view.cx + view.fx * p.x / z;
+                    v = view.cy - view.fy * p.y / z;
+                }
+
+                float t[2][3];
+                for (int a = 0; a < 2; ++a) {
+                    for (int b = 0; b < 3; ++b) {
+                        t[a][b] = j[a][0] * w[0][b] + j[a][1] * w[1][b] + j[a][2] * w[2][b];
+                    }
+                }
+
+                float ts[2][3];
+                for (int a = 0; a < 2; ++a) {
+                    for (int b = 0; b < 3; ++b) {
+                        ts[a][b] = t[a][0] * sigma[0][b] + t[a][1] * sigma[1][b] + t[a][2] * sigma[2][b];
+                    }
+                }
+
+                float cov_a = ts[0][0] * t[0][0] + ts[0][1] * t[0][1] + ts[0][2] * t[0][2];
+                float cov_b = ts[0][0] * t[1][0] + ts[0][1] * t[1][1] + ts[0][2] * t[1][2];
+                float cov_c = ts[1][0] * t[1][0] + ts[1][1] * t[1][1] + ts[1][2] * t[1][2];
+                float unfiltered_det = cov_a * cov_c - cov_b * cov_b;
+                cov_a += dilation;
+                cov_c += dilation;
+
+                float det = cov_a * cov_c - cov_b * cov_b;
+                if (det <= 0.0f) {
+                    continue;
+                }
+                if (mip_2d) {
+                    splat_opacity *= std::sqrt(std::max(unfiltered_det, 0.0f) / det);
+                    if (splat_opacity < min_alpha) {
+                        continue;
+                    }
+                }
+
+                float mid = 0.5f * (cov_a + cov_c);
+                float lambda = mid + std::sqrt(std::max(0.1f, mid * mid - det));
+                float radius = std::ceil(3.0f * std::sqrt(lambda));
+
+                auto tile_range = [](float center, float extent, std::uint32_t tiles) {
+                    float lo = std::floor((center - extent) / tile_size);
+                    float hi = std::floor((center + extent) / tile_size) + 1.0f;
+                    return std::pair<std::uint32_t, std::uint32_t>(
+                        static_cast<std::uint32_t>(std::clamp(lo, 0.0f, static_cast<float>(tiles))),
+                        static_cast<std::uint32_t>(std::clamp(hi, 0.0f, static_cast<float>(tiles))));
+                };
+                auto [min_x, max_x] = tile_range(u, radius, tiles_x);
+                auto [min_y, max_y] = tile_range(v, radius, tiles_y);
+                if (min_x >= max_x || min_y >= max_y) {
+                    continue;
+                }
+
+                // Splats centred in reduced-rate tiles get fewer SH bands.
+                std::uint32_t degree = sh_degree;
+                if (!tile_rates.empty()) {
+                    auto tx = static_cast<std::uint32_t>(std::clamp(u / tile_size, 0.0f, static_cast<float>(tiles_x - 1)));
+                    auto ty = static_cast<std::uint32_t>(std::clamp(v / tile_size, 0.0f, static_cast<float>(tiles_y - 1)));
+                    if (tile_rates[ty * tiles_x + tx] > 1) {
+                        degree = std::min(degree, reduced_sh_degree);
+                    }
+                }
+
+                utils::Vector3f dir = (utils::Vector3f(pos_x[i], pos_y[i], pos_z[i]) - source.camera).normalized();
+                float dc[3] = {color_r[i], color_g[i], color_b[i]};
+                evaluate_sh(degree, dc, sh_rest.data() + i * sh_stride, dir, out.color);
+
+                // The splat normal is its shortest axis, facing the camera.
+                if (with_normals) {
+                    int axis = s[0] <= s[1] ? (s[0] <= s[2] ? 0 : 2) : (s[1] <= s[2] ? 1 : 2);
+                    float sign = 1.0f;
+                    float n[3];
+                    for (int a = 0; a < 3; ++a) {
+                        n[a] = w[a][0] * r[0][axis] + w[a][1] * r[1][axis] + w[a][2] * r[2][axis];
+                    }
+                    if (source.instanced) {
+                        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                        for (float& value : n) {
+                            value = length > 0.0f ? value / length : 0.0f;
+                        }
+                    }
+                    if (n[0] * p.x + n[1] * p.y + n[2] * p.z > 0.0f) {
+                        sign = -1.0f;
+                    }
+                    for (int a = 0; a < 3; ++a) {
+                        out.normal[a] = sign * n[a];
+                    }
+                }
+
+                out.x = u;
+                out.y = v;
+                out.conic_a = cov_c / det;
+                out.conic_b = -cov_b / det;
+                out.conic_c = cov_a / det;
+                out.depth = z;
+                out.opacity = splat_opacity;
+                out.radius = radius;
+                out.tile_min_x = min_x;
+                out.tile_min_y = min_y;
+                out.tile_max_x = max_x;
+                out.tile_max_y = max_y;
+            }
+        }
+    }, projection_grain);
+}
+
+void TileRenderer::Impl::bin(FrameContext& frame) {
+    const std::size_t tile_count = static_cast<std::size_t>(tiles_x) * tiles_y;
+    const std::size_t count = frame.projected.size();
+    auto& pool = utils::ThreadPool::instance();
+
+    frame.tile_offsets.assign(tile_count + 1, 0);
+    std::atomic<std::size_t> visible{0};
+
+    pool.parallel_for(0, count, [&](std::size_t begin, std::size_t end) {
+        std::size_t local_visible = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto& splat = frame.projected[i];
+            if (splat.radius <= 0.0f) {
+                continue;
+            }
+            ++local_visible;
+            for (std::uint32_t ty = splat.tile_min_y; ty < splat.tile_max_y; ++ty) {
+                for (std::uint32_t tx = splat.tile_min_x; tx < splat.tile_max_x; ++tx) {
+                    std::atomic_ref<std::uint32_t>(frame.tile_offsets[ty * tiles_x + tx])
+                        .fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+        visible.fetch_add(local_visible, std::memory_order_relaxed);
+    }, projection_grain);
+
+    std::uint32_t running = 0;
+    for (std::size_t t = 0; t <= tile_count; ++t) {
+        std::uint32_t tile_splats = frame.tile_offsets[t];
+        frame.tile_offsets[t] = running;
+        running += tile_splats;
+    }
+
+    frame.tile_entries.resize(running);
+    frame.tile_cursors.assign(frame.tile_offsets.begin(), frame.tile_offsets.end() - 1);
+
+    pool.parallel_for(0, count, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto& splat = frame.projected[i];
+            if (splat.radius <= 0.0f) {
+                continue;
+            }
+            for (std::uint32_t ty = splat.tile_min_y; ty < splat.tile_max_y; ++ty) {
+                for (std::uint32_t tx = splat.tile_min_x; tx < splat.tile_max_x; ++tx) {
+                    std::uint32_t slot = std::atomic_ref<std::uint32_t>(frame.tile_cursors[ty * tiles_x + tx])
+                        .fetch_add(1, std::memory_order_relaxed);
+                    frame.tile_entries[slot] = static_cast<std::uint32_t>(i);
+                }
+            }
+        }
+    }, projection_grain);
+
+    frame.visible_splats = visible.load();
+}
+
+float TileRenderer::Impl::render_tile(FrameContext& frame, FrameOutput out, std::uint32_t tile,
+                                     std::span<std::uint32_t> splats, std::uint32_t rate) {
+    // Median depth and normals need extra per-sample state in the blend
+    // loop, so each combination gets its own instantiation and disabled
+    // channels add no work.
+    if (out.median_depth) {
+        return out.normal ? blend_tile<true, true>(frame, out, tile, splats, rate)
+                          : blend_tile<true, false>(frame, out, tile, splats, rate);
+    }
+    return out.normal ? blend_tile<false, true>(frame, out, tile, splats, rate)
+                      : blend_tile<false, false>(frame, out, tile, splats, rate);
+}
+
+template<bool WithMedian, bool WithNormal>
+float TileRenderer::Impl::blend_tile(FrameContext& frame, FrameOutput out, std::uint32_t tile,
+                                    std::span<std::uint32_t> splats, std::uint32_t rate) {
+    const std::uint32_t x0 = (tile % tiles_x) * tile_size;
+    const std::uint32_t y0 = (tile / tiles_x) * tile_size;
+    const std::uint32_t x1 = std::min(x0 + tile_size, width);
+    const std::uint32_t y1 = std::min(y0 + tile_size, height);
+    const std::uint32_t tile_width = x1 - x0;
+    const std::uint32_t tile_height = y1 - y0;
+
+    // Reduced-rate tiles shade one sample per rate x rate block and are
+    // upsampled afterwards.
+    const float cutoff = rate > 1 ? reduced_min_alpha : min_alpha;
+    const std::uint32_t grid_width = (tile_width + rate - 1) / rate;
+    const std::uint32_t grid_height = (tile_height + rate - 1) / rate;
+    const float step = static_cast<float>(rate);
+
+    // Ties broken by index so the blend order is deterministic.
+    sort_tile_splats(splats, frame.projected, sort_mode);
+
+    std::array<float, tile_size * tile_size> transmittance;
+    std::array<float, tile_size * tile_size * 3> accum_color{};
+    std::array<float, tile_size * tile_size> accum_depth{};
+    std::array<bool, tile_size * tile_size> done{};
+    std::array<float, WithMedian ? tile_size * tile_size : 1> median{};
+    std::array<float, WithNormal ? tile_size * tile_size * 3 : 1> accum_normal{};
+    transmittance.fill(1.0f);
+    std::uint32_t remaining = grid_width * grid_height;
+
+    auto grid_range = [step](float lo, float hi, std::uint32_t origin, std::uint32_t cells) {
+        float first = std::ceil((lo - static_cast<float>(origin)) / step - 0.5f);
+        float last = std::floor((hi - static_cast<float>(origin)) / step - 0.5f) + 1.0f;
+        return std::pair<std::uint32_t, std::uint32_t>(
+            static_cast<std::uint32_t>(std::clamp(first, 0.0f, static_cast<float>(cells))),
+            static_cast<std::uint32_t>(std::clamp(last, 0.0f, static_cast<float>(cells))));
+    };
+
+    for (std::uint32_t id : splats) {
+        const auto& s = frame.projected[id];
+        if (s.opacity < cutoff) {
+            continue;
+        }
+
+        auto [gx0, gx1] = grid_range(s.x - s.radius, s.x + s.radius, x0, grid_width);
+        auto [gy0, gy1] = grid_range(s.y - s.radius, s.y + s.radius, y0, grid_height);
+
+        for (std::uint32_t gy = gy0; gy < gy1; ++gy) {
+            float dy = s.y - (static_cast<float>(y0) + (static_cast<float>(gy) + 0.5f) * step);
+            for (std::uint32_t gx = gx0; gx < gx1; ++gx) {
+                std::uint32_t local = gy * grid_width + gx;
+                if (done[local]) {
+                    continue;
+                }
+
+                float dx = s.x - (static_cast<float>(x0) + (static_cast<float>(gx) + 0.5f) * step);
+                float power = -0.5f * (s.conic_a * dx * dx + s.conic_c * dy * dy) - s.conic_b * dx * dy;
+                if (power > 0.0f) {
+                    continue;
+                }
+
+                float alpha = std::min(max_alpha, s.opacity * std::exp(power));
+                if (alpha < cutoff) {
+                    continue;
+                }
+
+                float t = transmittance[local];
+                float next_t = t * (1.0f - alpha);
+                if (next_t < min_transmittance) {
+                    done[local] = true;
+                    --remaining;
+                    continue;
+                }
+
+                float weight = alpha * t;
+                accum_color[local * 3 + 0] += s.color[0] * weight;
+                accum_color[local * 3 + 1] += s.color[1] * weight;
+                accum_color[local * 3 + 2] += s.color[2] * weight;
+                accum_depth[local] += s.depth * weight;
+                if constexpr (WithMedian) {
+                    if (t >= 0.5f && next_t < 0.5f) {
+                        median[local] = s.depth;
+                    }
+                }
+                if constexpr (WithNormal) {
+                    accum_normal[local * 3 + 0] += s.normal[0] * weight;
+                    accum_normal[local * 3 + 1] += s.normal[1] * weight;
+                    accum_normal[local * 3 + 2] += s.normal[2] * weight;
+                }
+                transmittance[local] = next_t;
+            }
+        }
+
+        if (remaining == 0) {
+            break;
+        }
+    }
+
+    float depth_sum = 0.0f;
+    std::uint32_t depth_samples = 0;
+    for (std::uint32_t py = y0; py < y1; ++py) {
+        for (std::uint32_t px = x0; px < x1; ++px) {
+            float t;
+            float c[3];
+            float d_sum;
+            float m = 0.0f;
+            float n[3] = {0.0f, 0.0f, 0.0f};
+
+            if (rate == 1) {
+                std::uint32_t local = (py - y0) * grid_width + (px - x0);
+                t = transmittance[local];
+                c[0] = accum_color[local * 3 + 0];
+                c[1] = accum_color[local * 3 + 1];
+                c[2] = accum_color[local * 3 + 2];
+                d_sum = accum_depth[local];
+                if constexpr (WithMedian) {
+                    m = median[local];
+                }
+                if constexpr (WithNormal) {
+                    n[0] = accum_normal[local * 3 + 0];
+                    n[1] = accum_normal[local * 3 + 1];
+                    n[2] = accum_normal[local * 3 + 2];
+                }
+            } else {
+                // Bilinear upsample between the surrounding sample centers,
+                // clamped to the tile so no neighbour data is needed.
+                float gx = std::clamp((static_cast<float>(px - x0) + 0.5f) / step - 0.5f, 0.0f, static_cast<float>(grid_width - 1));
+                float gy = std::clamp((static_cast<float>(py - y0) + 0.5f) / step - 0.5f, 0.0f, static_cast<float>(grid_height - 1));
+                auto ix = static_cast<std::uint32_t>(gx);
+                auto iy = static_cast<std::uint32_t>(gy);
+                std::uint32_t ix1 = std::min(ix + 1, grid_width - 1);
+                std::uint32_t iy1 = std::min(iy + 1, grid_height - 1);
+                float fx = gx - static_cast<float>(ix);
+                float fy = gy - static_cast<float>(iy);
+
+                const std::uint32_t samples[4] = {
+                    iy * grid_width + ix, iy * grid_width + ix1,
+                    iy1 * grid_width + ix, iy1 * grid_width + ix1
+                };
+                const float weights[4] = {
+                    (1.0f - fx) * (1.0f - fy), fx * (1.0f - fy),
+                    (1.0f - fx) * fy, fx * fy
+                };
+
+                t = 0.0f;
+                c[0] = c[1] = c[2] = 0.0f;
+                d_sum = 0.0f;
+                for (int k = 0; k < 4; ++k) {
+                    t += weights[k] * transmittance[samples[k]];
+                    c[0] += weights[k] * accum_color[samples[k] * 3 + 0];
+                    c[1] += weights[k] * accum_color[samples[k] * 3 + 1];
+                    c[2] += weights[k] * accum_color[samples[k] * 3 + 2];
+                    d_sum += weights[k] * accum_depth[samples[k]];
+                    if constexpr (WithMedian) {
+                        m += weights[k] * median[samples[k]];
+                    }
+                    if constexpr (WithNormal) {
+                        n[0] += weights[k] * accum_normal[samples[k] * 3 + 0];
+                        n[1] += weights[k] * accum_normal[samples[k] * 3 + 1];
+                        n[2] += weights[k] * accum_normal[samples[k] * 3 + 2];
+                    }
+                }
+            }
+
+            std::size_t pixel = static_cast<std::size_t>(py) * width + px;
+            float coverage = 1.0f - t;
+
+            out.color[pixel * 4 + 0] = c[0] + t * background[0];
+            out.color[pixel * 4 + 1] = c[1] + t * background[1];
+            out.color[pixel * 4 + 2] = c[2] + t * background[2];
+            out.color[pixel * 4 + 3] = coverage + t * background[3];
+
+            float d = coverage > min_alpha ? d_sum / coverage : 0.0f;
+            if (out.depth) {
+                out.depth[pixel] = d;
+            }
+            if (out.alpha) {
+                out.alpha[pixel] = coverage;
+            }
+            if constexpr (WithMedian) {
+                out.median_depth[pixel] = m;
+            }
+            if constexpr (WithNormal) {
+                float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                float inv = length > 0.0f ? 1.0f / length : 0.0f;
+                out.normal[pixel * 3 + 0] = n[0] * inv;
+                out.normal[pixel * 3 + 1] = n[1] * inv;
+                out.normal[pixel * 3 + 2] = n[2] * inv;
+            }
+            if (d > 0.0f) {
+                depth_sum += d;
+                ++depth_samples;
+            }
+        }
+    }
+
+    shaded_samples.fetch_add(grid_width * grid_height, std::memory_order_relaxed);
+    return depth_samples > 0 ? depth_sum / static_cast<float>(depth_samples) : 0.0f;
+}
+
+void TileRenderer::Impl::prepare_frame(const Scene& scene, const ViewParams& view,
+                                       const VariableRateShading& variable_rate) {
+    stats = {};
+    shaded_samples = 0;
+    reduced_sh_degree = variable_rate.reduced_sh_degree;
+    build_rate_map(variable_rate);
+    project(frame, scene, view, has_channel(aux_channels, AuxChannel::Normal));
+    bin(frame);
+    stats.visible_splats = frame.visible_splats;
+    stats.instances_visible = frame.instances_visible;
+    stats.instances_culled = frame.instances_culled;
+    stats.tile_count = static_cast<std::size_t>(tiles_x) * tiles_y;
+}
+
+void TileRenderer::Impl::build_rate_map(const VariableRateShading& settings) {
+    tile_rates.clear();
+    stats.tiles_reduced_rate = 0;
+    if (!settings.enabled) {
+        return;
+    }
+
+    const std::size_t tile_count = static_cast<std::size_t>(tiles_x) * tiles_y;
+    reduced_min_alpha = std::max(settings.reduced_min_alpha, min_alpha);
+    tile_rates.resize(tile_count, 1);
+
+    if (settings.tile_rates.size() == tile_count) {
+        for (std::size_t t = 0; t < tile_count; ++t) {
+            tile_rates[t] = static_cast<std::uint8_t>(settings.tile_rates[t]);
+        }
+    } else {
+        if (!settings.tile_rates.empty()) {
+            utils::log_warning("Shading rate map has {} entries, expected {}; using fovea",
+                               settings.tile_rates.size(), tile_count);
+        }
+
+        const float extent = static_cast<float>(std::max(width, height));
+        const float fovea_x = settings.fovea_x * extent;
+        const float fovea_y = settings.fovea_y * extent;
+        for (std::uint32_t ty = 0; ty < tiles_y; ++ty) {
+            for (std::uint32_t tx = 0; tx < tiles_x; ++tx) {
+                float cx = (static_cast<float>(tx) + 0.5f) * tile_size;
+                float cy = (static_cast<float>(ty) + 0.5f) * tile_size;
+                float distance = std::hypot(cx - fovea_x, cy - fovea_y) / extent;
+                ShadingRate rate = distance <= settings.inner_radius ? ShadingRate::Full
+                                 : distance <= settings.outer_radius ? ShadingRate::Half
+                                 : ShadingRate::Quarter;
+                tile_rates[ty * tiles_x + tx] = static_cast<std::uint8_t>(rate);
+            }
+        }
+    }
+
+    for (auto& rate : tile_rates) {
+        if (rate != 1 && rate != 2 && rate != 4) {
+            rate = 1;
+        }
+        stats.tiles_reduced_rate += rate > 1 ? 1 : 0;
+    }
+}
+
+float TileRenderer::Impl::tile_motion(std::uint32_t tile, float mean_depth, const ViewParams& view,
+                                      const utils::Matrix4f& to_previous) const {
+    if (mean_depth <= 0.0f) {
+        return 0.0f;
+    }
+
+    const float x0 = static_cast<float>((tile % tiles_x) * tile_size);
+    const float y0 = static_cast<float>((tile / tiles_x) * tile_size);
+    const float corners[5][2] = {
+        {x0, y0}, {x0 + tile_size, y0}, {x0, y0 + tile_size},
+        {x0 + tile_size, y0 + tile_size}, {x0 + 0.5f * tile_size, y0 + 0.5f * tile_size}
+    };
+
+    float motion = 0.0f;
+    for (const auto& corner : corners) {
+        auto p = unproject(view, corner[0], corner[1], mean_depth);
+        auto q = transform_point(to_previous, p.x, p.y, p.z);
+        float u, v;
+        if (!project_point(previous_view, q, u, v)) {
+            return std::numeric_limits<float>::infinity();
+        }
+        motion = std::max(motion, std::hypot(u - corner[0], v - corner[1]));
+    }
+    return motion;
+}
+
+bool TileRenderer::Impl::reproject_tile(std::uint32_t tile, const ViewParams& view,
+                                        const utils::Matrix4f& to_previous) {
+    const std::uint32_t x0 = (tile % tiles_x) * tile_size;
+    const std::uint32_t y0 = (tile / tiles_x) * tile_size;
+    const std::uint32_t x1 = std::min(x0 + tile_size, width);
+    const std::uint32_t y1 = std::min(y0 + tile_size, height);
+
+    // Backward warp: each pixel is looked up in the previous frame using the
+    // previous depth at the same location, which is accurate for the small
+    // motions that pass the tile_motion test.
+    for (std::uint32_t py = y0; py < y1; ++py) {
+        for (std::uint32_t px = x0; px < x1; ++px) {
+            std::size_t pixel = static_cast<std::size_t>(py) * width + px;
+            std::size_t source = pixel;
+
+            float d = previous_depth[pixel];
+            if (d > 0.0f) {
+                float cu = static_cast<float>(px) + 0.5f;
+                float cv = static_cast<float>(py) + 0.5f;
+                auto p = unproject(view, cu, cv, d);
+                auto q = transform_point(to_previous, p.x, p.y, p.z);
+                float u, v;
+                if (!project_point(previous_view, q, u, v) ||
+                    u < 0.0f || v < 0.0f || u >= static_cast<float>(width) || v >= static_cast<float>(height)) {
+                    return false;
+                }
+                source = static_cast<std::size_t>(v) * width + static_cast<std::size_t>(u);
+            }
+
+            for (int c = 0; c < 4; ++c) {
+                color[pixel * 4 + c] = previous_color[source * 4 + c];
+            }
+            depth[pixel] = previous_depth[source];
+            if (!aux.alpha.empty()) {
+                aux.alpha[pixel] = previous_aux.alpha[source];
+            }
+            if (!aux.median_depth.empty()) {
+                aux.median_depth[pixel] = previous_aux.median_depth[source];
+            }
+            if (!aux.normal.empty()) {
+                for (int c = 0; c < 3; ++c) {
+                    aux.normal[pixel * 3 + c] = previous_aux.normal[source * 3 + c];
+                }
+            }
+        }
+    }
+    return true;
+}
+
+TileRenderer::TileRenderer() : impl_(std::make_unique<Impl>()) {}
+
+TileRenderer::~TileRenderer() {
+    if (impl_->initialized) {
+        shutdown();
+    }
+}
+
+bool TileRenderer::initialize(const RenderTarget& target) {
+    if (target.width == 0 || target.height == 0) {
+        utils::log_error("Invalid render target size {}x{}", target.width, target.height);
+        return false;
+    }
+
+    target_ = target;
+    impl_->resize(target.width, target.height);
+    impl_->initialized = true;
+
+    utils::log_info("Tile Renderer initialized ({}x{}, {} threads)",
+                    target.width, target.height, utils::ThreadPool::instance().size() + 1);
+    return true;
+}
+
+void TileRenderer::shutdown() {
+    if (!impl_->initialized) {
+        return;
+    }
+
+    impl_->frame = {};
+    impl_->batch_frames.clear();
+    impl_->tile_cache.clear();
+    impl_->cache_valid = false;
+    impl_->initialized = false;
+    utils::log_info("Tile Renderer shutdown");
+}
+
+void TileRenderer::begin_frame() {}
+
+void TileRenderer::end_frame() {}
+
+void TileRenderer::render_scene(const Scene& scene) {
+    if (!impl_->initialized) {
+        utils::log_warning("Tile Renderer used before initialization");
+        return;
+    }
+
+    auto camera = scene.get_active_camera();
+    if (!camera) {
+        utils::log_warning("No active camera in scene");
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto& impl = *impl_;
+    const std::uint64_t version = content_version(scene);
+    ViewParams view = make_view_params(*camera, impl.width, impl.height);
+
+    impl.prepare_frame(scene, view, target_.variable_rate);
+    impl.progressive_active = false;
+
+    const auto& settings = impl.cache_settings;
+    // Cached tiles name splats by stable id, so culling may reshuffle the
+    // projection slots between frames but the id layout must hold.
+    const bool reuse = settings.enabled && impl.cache_valid &&
+                       impl.cached_scene == &scene &&
+                       impl.cached_version == version &&
+                       impl.cached_id_count == impl.frame.id_count &&
+                       impl.previous_view.same_intrinsics(view);
+
+    if (settings.enabled) {
+        impl.splat_ids.resize(impl.frame.projected.size());
+        for (const auto& segment : impl.frame.segments) {
+            const auto first = static_cast<std::uint32_t>(impl.frame.sources[segment.source].id_base + segment.first);
+            std::iota(impl.splat_ids.begin() + segment.offset,
+                      impl.splat_ids.begin() + segment.offset + segment.count, first);
+        }
+        std::swap(impl.color, impl.previous_color);
+        std::swap(impl.depth, impl.previous_depth);
+        std::swap(impl.aux, impl.previous_aux);
+        impl.allocate_aux();
+    }
+
+    const utils::Matrix4f to_previous = impl.previous_view.view * rigid_inverse(view.view);
+    std::atomic<std::size_t> reused{0};
+
+    utils::ThreadPool::instance().parallel_for_partitioned(0, impl.stats.tile_count, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; ++t) {
+            auto tile = static_cast<std::uint32_t>(t);
+            auto splats = impl.frame.tile_splats(t);
+            auto& entry = impl.tile_cache[t];
+
+            if (reuse && entry.valid && entry.age < settings.max_reuse_frames &&
+                impl.tile_motion(tile, entry.mean_depth, view, to_previous) <= settings.max_pixel_motion &&
+                similar_splat_sets(splats, impl.splat_ids, entry.splats, settings.max_splat_change) &&
+                impl.reproject_tile(tile, view, to_previous)) {
+                ++entry.age;
+                reused.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            float mean_depth = impl.render_tile(impl.frame, impl.main_output(), tile, splats, impl.tile_rate(t));
+            if (settings.enabled) {
+                entry.splats.clear();
+                for (std::uint32_t slot : splats) {
+                    entry.splats.push_back(impl.splat_ids[slot]);
+                }
+                std::sort(entry.splats.begin(), entry.splats.end());
+                entry.mean_depth = mean_depth;
+                entry.age = 0;
+                entry.valid = true;
+            }
+        }
+    });
+
+    impl.cached_scene = &scene;
+    impl.cached_version = version;
+    impl.cached_id_count = impl.frame.id_count;
+    impl.previous_view = view;
+    impl.cache_valid = settings.enabled;
+
+    impl.stats.tiles_reused = reused.load();
+    impl.stats.tiles_rendered = impl.stats.tile_count - impl.stats.tiles_reused;
+    impl.stats.pixels_shaded = impl.shaded_samples.load();
+    impl.stats.frame_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+void TileRenderer::render_views(const Scene& scene, std::span<const Camera> cameras,
+                                std::span<float> color, std::span<float> depth,
+                                std::span<float> alpha, std::span<float> median_depth) {
+    if (!impl_->initialized) {
+        utils::log_warning("Tile Renderer used before initialization");
+        return;
+    }
+
+    auto& impl = *impl_;
+    const std::size_t pixels = static_cast<std::size_t>(impl.width) * impl.height;
+    const std::size_t views = cameras.size();
+    auto too_small = [&](std::span<float> plane) { return !plane.empty() && plane.size() < views * pixels; };
+    if (color.size() < views * pixels * 4 || too_small(depth) || too_small(alpha) || too_small(median_depth)) {
+        utils::log_error("Output buffers too small for {} views of {}x{}", views, impl.width, impl.height);
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto& pool = utils::ThreadPool::instance();
+    const std::size_t tile_count = static_cast<std::size_t>(impl.tiles_x) * impl.tiles_y;
+
+    impl.stats = {};
+    impl.shaded_samples = 0;
+    impl.reduced_sh_degree = target_.variable_rate.reduced_sh_degree;
+    impl.build_rate_map(target_.variable_rate);
+
+    // Per-view scratch is kept between calls so steady-state batches reuse
+    // the projection and bin storage instead of reallocating it.
+    while (impl.batch_frames.size() < views) {
+        impl.batch_frames.push_back(std::make_unique<FrameContext>());
+    }
+
+    std::atomic<std::size_t> visible{0};
+    std::atomic<std::size_t> instances_visible{0};
+    std::atomic<std::size_t> instances_culled{0};
+    pool.parallel_for(0, views, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t v = begin; v < end; ++v) {
+            auto& frame = *impl.batch_frames[v];
+            ViewParams view = make_view_params(cameras[v], impl.width, impl.height);
+            impl.project(frame, scene, view, false);
+            impl.bin(frame);
+
+            auto plane = [&](std::span<float> buffer) { return buffer.empty() ? nullptr : buffer.data() + v * pixels; };
+            FrameOutput out{color.data() + v * pixels * 4, plane(depth), plane(alpha), plane(median_depth)};
+            pool.parallel_for(0, tile_count, [&](std::size_t tile_begin, std::size_t tile_end) {
+                for (std::size_t t = tile_begin; t < tile_end; ++t) {
+                    impl.render_tile(frame, out, static_cast<std::uint32_t>(t),
+                                     frame.tile_splats(t), impl.tile_rate(t));
+                }
+            });
+            visible.fetch_add(frame.visible_splats, std::memory_order_relaxed);
+            instances_visible.fetch_add(frame.instances_visible, std::memory_order_relaxed);
+            instances_culled.fetch_add(frame.instances_culled, std::memory_order_relaxed);
+        }
+    });
+
+    impl.stats.visible_splats = visible.load();
+    impl.stats.instances_visible = instances_visible.load();
+    impl.stats.instances_culled = instances_culled.load();
+    impl.stats.tile_count = tile_count * views;
+    impl.stats.tiles_rendered = impl.stats.tile_count;
+    impl.stats.pixels_shaded = impl.shaded_samples.load();
+    impl.stats.frame_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// Shades tiles of refine_order from `next` on until the deadline, at least
+// one so that even a budget smaller than a tile makes progress. Returns
+// the index reached.
+std::size_t TileRenderer::Impl::shade_in_order(std::size_t next, std::chrono::steady_clock::time_point deadline,
+                                               bool coarse) {
+    auto& pool = utils::ThreadPool::instance();
+    std::atomic<std::size_t> cursor{next};
+    std::atomic<bool> progressed{false};
+    const std::size_t total = refine_order.size();
+
+    pool.parallel_for(0, pool.size() + 1, [&](std::size_t, std::size_t) {
+        while (!progressed.load(std::memory_order_relaxed) ||
+               std::chrono::steady_clock::now() < deadline) {
+            progressed.store(true, std::memory_order_relaxed);
+            std::size_t index = cursor.fetch_add(1, std::memory_order_relaxed);
+            if (index >= total) {
+                return;
+            }
+            std::uint32_t tile = refine_order[index];
+            std::uint32_t rate = coarse ? std::max<std::uint32_t>(tile_rate(tile), 4) : tile_rate(tile);
+            render_tile(frame, main_output(), tile, frame.tile_splats(tile), rate);
+        }
+    });
+    return std::min(cursor.load(), total);
+}
+
+bool TileRenderer::render_scene_progressive(const Scene& scene, std::chrono::microseconds budget) {
+    if (!impl_->initialized) {
+        utils::log_warning("Tile Renderer used before initialization");
+        return true;
+    }
+
+    auto camera = scene.get_active_camera();
+    if (!camera) {
+        utils::log_warning("No active camera in scene");
+        return true;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + budget;
+    auto& impl = *impl_;
+    const std::uint64_t version = content_version(scene);
+    ViewParams view = make_view_params(*camera, impl.width, impl.height);
+
+    const bool still = impl.progressive_active &&
+                       impl.progressive_scene == &scene &&
+                       impl.progressive_version == version &&
+                       impl.progressive_view.same_intrinsics(view) &&
+                       impl.progressive_view.view.m == view.view.m;
+
+    if (!still) {
+        // Projection and binning are the one cost a call cannot split; the
+        // shading below stops at the deadline.
+        impl.prepare_frame(scene, view, target_.variable_rate);
+        impl.cache_valid = false;
+
+        // Shade and refine from the image centre outwards.
+        impl.refine_order.resize(impl.stats.tile_count);
+        std::iota(impl.refine_order.begin(), impl.refine_order.end(), 0u);
+        const float center_x = 0.5f * static_cast<float>(impl.tiles_x);
+        const float center_y = 0.5f * static_cast<float>(impl.tiles_y);
+        auto distance = [&](std::uint32_t tile) {
+            float dx = static_cast<float>(tile % impl.tiles_x) + 0.5f - center_x;
+            float dy = static_cast<float>(tile / impl.tiles_x) + 0.5f - center_y;
+            return dx * dx + dy * dy;
+        };
+        std::stable_sort(impl.refine_order.begin(), impl.refine_order.end(),
+                         [&](std::uint32_t a, std::uint32_t b) { return distance(a) < distance(b); });
+
+        impl.progressive_active = true;
+        impl.progressive_scene = &scene;
+        impl.progressive_version = version;
+        impl.progressive_view = view;
+        impl.coarse_tiles = 0;
+        impl.refined_tiles = 0;
+    } else {
+        impl.shaded_samples = 0;
+    }
+
+    // Every tile gets a quarter-rate pass before any is refined, so the
+    // whole image turns coarse quickly; tiles not reached yet still show
+    // the previous frame.
+    const std::size_t total = impl.refine_order.size();
+    std::size_t rendered = 0;
+    if (impl.coarse_tiles < total) {
+        const std::size_t reached = impl.shade_in_order(impl.coarse_tiles, deadline, true);
+        rendered += reached - impl.coarse_tiles;
+        impl.coarse_tiles = reached;
+    }
+    if (impl.coarse_tiles == total && impl.refined_tiles < total &&
+        (rendered == 0 || std::chrono::steady_clock::now() < deadline)) {
+        const std::size_t reached = impl.shade_in_order(impl.refined_tiles, deadline, false);
+        rendered += reached - impl.refined_tiles;
+        impl.refined_tiles = reached;
+    }
+    impl.stats.tiles_rendered = std::min(rendered, impl.stats.tile_count);
+
+    impl.stats.tiles_reused = impl.stats.tile_count - impl.stats.tiles_rendered;
+    impl.stats.pixels_shaded = impl.shaded_samples.load();
+    impl.stats.frame_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    return impl.refined_tiles == impl.refine_order.size();
+}
+
+void TileRenderer::set_viewport(std::uint32_t x, std::uint32_t y,
+                                std::uint32_t width, std::uint32_t height) {
+    // The tile renderer owns its framebuffer and always fills all of it,
+    // so an offset cannot be honoured; only the extent is applied.
+    if (x != 0 || y != 0) {
+        utils::log_warning("TileRenderer viewport offsets are not supported; ignoring ({}, {})", x, y);
+    }
+    if (width == impl_->width && height == impl_->height) {
+        return;
+    }
+    target_.width = width;
+    target_.height = height;
+    impl_->resize(width, height);
+}
+
+void TileRenderer::clear(std::array<float, 4> color) {
+    impl_->background = color;
+    for (std::size_t i = 0; i < impl_->depth.size(); ++i) {
+        std::copy(color.begin(), color.end(), impl_->color.begin() + i * 4);
+    }
+    std::fill(impl_->depth.begin(), impl_->depth.end(), 0.0f);
+    impl_->cache_valid = false;
+    impl_->progressive_active = false;
+}
+
+#ifdef WITH_PYTORCH
+torch::Tensor TileRenderer::render_to_tensor(const Scene& scene) {
+    render_scene(scene);
+    auto tensor = impl_->tensor_pool.acquire({static_cast<std::int64_t>(impl_->height),
+                                              static_cast<std::int64_t>(impl_->width), 4});
+    std::copy(impl_->color.begin(), impl_->color.end(), tensor.data_ptr<float>());
+    return tensor;
+}
+
+torch::Tensor TileRenderer::render_to_tensor_batch(const Scene& scene, std::span<const Camera> cameras) {
+    auto tensor = impl_->tensor_pool.acquire({static_cast<std::int64_t>(cameras.size()),
+                                              static_cast<std::int64_t>(impl_->height),
+                                              static_cast<std::int64_t>(impl_->width), 4});
+    render_views(scene, cameras, {tensor.data_ptr<float>(), static_cast<std::size_t>(tensor.numel())});
+    return tensor;
+}
+#endif
+
+void TileRenderer::set_temporal_cache(const TemporalCacheSettings& settings) {
+    impl_->cache_settings = settings;
+    impl_->cache_valid = false;
+}
+
+void TileRenderer::set_anti_aliasing(const AntiAliasingSettings& settings) {
+    impl_->anti_aliasing = settings;
+    impl_->progressive_active = false;
+    impl_->cache_valid = false;
+}
+
+const AntiAliasingSettings& TileRenderer::get_anti_aliasing() const {
+    return impl_->anti_aliasing;
+}
+
+void TileRenderer::set_sort_mode(TileSortMode mode) {
+    impl_->sort_mode = mode;
+}
+
+TileSortMode TileRenderer::get_sort_mode() const {
+    return impl_->sort_mode;
+}
+
+void TileRenderer::set_memory_placement(utils::MemoryPlacement placement) {
+    impl_->memory_placement = placement;
+    impl_->place_buffers();
+}
+
+utils::MemoryPlacement TileRenderer::get_memory_placement() const {
+    return impl_->memory_placement;
+}
+
+void TileRenderer::set_aux_channels(AuxChannel channels) {
+    impl_->aux_channels = channels;
+    impl_->allocate_aux();
+    impl_->previous_aux = {};
+    impl_->progressive_active = false;
+    impl_->cache_valid = false;
+}
+
+AuxChannel TileRenderer::get_aux_channels() const {
+    return impl_->aux_channels;
+}
+
+void TileRenderer::set_variable_rate(const VariableRateShading& settings) {
+    target_.variable_rate = settings;
+    impl_->cache_valid = false;
+}
+
+const TemporalCacheSettings& TileRenderer::get_temporal_cache() const {
+    return impl_->cache_settings;
+}
+
+void TileRenderer::invalidate_temporal_cache() {
+    impl_->cache_valid = false;
+}
+
+std::span<const float> TileRenderer::get_color_buffer() const {
+    return impl_->color;
+}
+
+std::span<const float> TileRenderer::get_depth_buffer() const {
+    return impl_->depth;
+}
+
+std::span<const float> TileRenderer::get_alpha_buffer() const {
+    return impl_->aux.alpha;
+}
+
+std::span<const float> TileRenderer::get_median_depth_buffer() const {
+    return impl_->aux.median_depth;
+}
+
+std::span<const float> TileRenderer::get_normal_buffer() const {
+    return impl_->aux.normal;
+}
+
+const TileFrameStats& TileRenderer::get_frame_stats() const {
+    return impl_->stats;
+}
+
+}
\ No newline at end of file
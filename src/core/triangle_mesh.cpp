@@ -0,0 +1,141 @@
+#include "buildify/core/triangle_mesh.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace buildify::core {
+
+namespace {
+
+std::uint8_t to_byte(float value) {
+    return static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+}
+
+bool TriangleMesh::save_ply(const std::string& path) const {
+    static_assert(std::endian::native == std::endian::little, "PLY writer assumes a little-endian host");
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        utils::log_error("Failed to create mesh file: {}", path);
+        return false;
+    }
+
+    const bool has_normals = normals.size() == vertices.size();
+    const bool has_colors = colors.size() == vertices.size();
+
+    file << "ply\nformat binary_little_endian 1.0\ncomment buildify\n";
+    file << "element vertex " << vertices.size() << "\n";
+    file << "property float x\nproperty float y\nproperty float z\n";
+    if (has_normals) {
+        file << "property float nx\nproperty float ny\nproperty float nz\n";
+    }
+    if (has_colors) {
+        file << "property uchar red\nproperty uchar green\nproperty uchar blue\n";
+    }
+    file << "element face " << triangle_count() << "\n";
+    file << "property list uchar uint vertex_indices\nend_header\n";
+
+    // Vertices are written as packed records in one go.
+    const std::size_t stride = 12 + (has_normals ? 12 : 0) + (has_colors ? 3 : 0);
+    std::vector<char> records(vertices.size() * stride);
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        char* out = records.data() + i * stride;
+        float position[3] = {vertices[i].x, vertices[i].y, vertices[i].z};
+        std::memcpy(out, position, 12);
+        out += 12;
+        if (has_normals) {
+            float normal[3] = {normals[i].x, normals[i].y, normals[i].z};
+            std::memcpy(out, normal, 12);
+            out += 12;
+        }
+        if (has_colors) {
+            out[0] = static_cast<char>(to_byte(colors[i].x));
+            out[1] = static_cast<char>(to_byte(colors[i].y));
+            out[2] = static_cast<char>(to_byte(colors[i].z));
+        }
+    }
+    file.write(records.data(), static_cast<std::streamsize>(records.size()));
+
+    constexpr std::size_t face_stride = 1 + 3 * sizeof(std::uint32_t);
+    std::vector<char> faces(triangle_count() * face_stride);
+    for (std::size_t f = 0; f < triangle_count(); ++f) {
+        char* out = faces.data() + f * face_stride;
+        out[0] = 3;
+        std::memcpy(out + 1, indices.data() + f * 3, 3 * sizeof(std::uint32_t));
+    }
+    file.write(faces.data(), static_cast<std::streamsize>(faces.size()));
+
+    if (!file) {
+        utils::log_error("Failed to write mesh file: {}", path);
+        return false;
+    }
+    utils::log_info("Saved mesh with {} vertices and {} triangles to {}", vertices.size(), triangle_count(), path);
+    return true;
+}
+
+bool TriangleMesh::save_obj(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        utils::log_error("Failed to create mesh file: {}", path);
+        return false;
+    }
+
+    const bool has_normals = normals.size() == vertices.size();
+    const bool has_colors = colors.size() == vertices.size();
+
+    file << "# buildify\n";
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        file << "v " << vertices[i].x << ' ' << vertices[i].y << ' ' << vertices[i].z;
+        if (has_colors) {
+            file << ' ' << colors[i].x << ' ' << colors[i].y << ' ' << colors[i].z;
+        }
+        file << '\n';
+    }
+    if (has_normals) {
+        for (const auto& n : normals) {
+            file << "vn " << n.x << ' ' << n.y << ' ' << n.z << '\n';
+        }
+    }
+    for (std::size_t f = 0; f < triangle_count(); ++f) {
+        file << 'f';
+        for (int k = 0; k < 3; ++k) {
+            std::uint32_t index = indices[f * 3 + k] + 1;
+            file << ' ' << index;
+            if (has_normals) {
+                file << "//" << index;
+            }
+        }
+        file << '\n';
+    }
+
+    if (!file) {
+        utils::log_error("Failed to write mesh file: {}", path);
+        return false;
+    }
+    utils::log_info("Saved mesh with {} vertices and {} triangles to {}", vertices.size(), triangle_count(), path);
+    return true;
+}
+
+bool TriangleMesh::save(const std::string& path) const {
+    auto extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == ".ply") {
+        return save_ply(path);
+    }
+    if (extension == ".obj") {
+        return save_obj(path);
+    }
+    utils::log_error("Unsupported mesh format: {}", path);
+    return false;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,765 @@
+#include "buildify/core/tsdf_volume.hpp"
+#include "buildify/core/scene.hpp"
+#include "buildify/core/tile_renderer.hpp"
+#include "buildify/utils/thread_pool.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace buildify::core {
+
+namespace {
+
+constexpr std::size_t voxels_per_block = TsdfVolume::block_size * TsdfVolume::block_size * TsdfVolume::block_size;
+constexpr std::size_t integrate_row_grain = 8;
+constexpr std::size_t block_grain = 16;
+constexpr std::size_t recent_keys = 64;
+// Views rendered per batch when meshing a scene, bounding the size of the
+// intermediate color and depth images.
+constexpr std::size_t render_batch = 8;
+
+struct Voxel {
+    float tsdf = 1.0f;
+    float weight = 0.0f;
+    float color[3] = {0.0f, 0.0f, 0.0f};
+};
+
+struct Block {
+    std::array<Voxel, voxels_per_block> voxels;
+};
+
+struct BlockKey {
+    std::int32_t x, y, z;
+
+    bool operator==(const BlockKey&) const = default;
+    bool operator<(const BlockKey& other) const {
+        return std::tie(x, y, z) < std::tie(other.x, other.y, other.z);
+    }
+};
+
+struct BlockKeyHash {
+    std::size_t operator()(const BlockKey& key) const {
+        // Spatial hash from Teschner et al., "Optimized Spatial Hashing for
+        // Collision Detection of Deformable Objects".
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(key.x) * 73856093u) ^
+                                        (static_cast<std::uint64_t>(key.y) * 19349663u) ^
+                                        (static_cast<std::uint64_t>(key.z) * 83492791u));
+    }
+};
+
+// Pinhole (or orthographic) intrinsics implied by the camera's projection
+// at the given image size, matching the tile renderer.
+struct Intrinsics {
+    float fx, fy, cx, cy;
+    bool orthographic;
+};
+
+Intrinsics make_intrinsics(const Camera& camera, std::uint32_t width, std::uint32_t height) {
+    const CameraParams params = camera.get_params();
+    const auto& projection = params.projection;
+    Intrinsics result;
+    result.orthographic = params.orthographic;
+    result.fx = 0.5f * width * projection.m[0][0];
+    result.fy = 0.5f * height * projection.m[1][1];
+    result.cx = 0.5f * width * (result.orthographic ? 1.0f + projection.m[0][3] : 1.0f);
+    result.cy = 0.5f * height * (result.orthographic ? 1.0f - projection.m[1][3] : 1.0f);
+    return result;
+}
+
+utils::Vector3f transform_point(const utils::Matrix4f& m, const utils::Vector3f& p) {
+    return {
+        m.m[0][0] * p.x + m.m[0][1] * p.y + m.m[0][2] * p.z + m.m[0][3],
+        m.m[1][0] * p.x + m.m[1][1] * p.y + m.m[1][2] * p.z + m.m[1][3],
+        m.m[2][0] * p.x + m.m[2][1] * p.y + m.m[2][2] * p.z + m.m[2][3]
+    };
+}
+
+utils::Matrix4f rigid_inverse(const utils::Matrix4f& m) {
+    utils::Matrix4f result;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            result.m[i][j] = m.m[j][i];
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        result.m[i][3] = -(result.m[i][0] * m.m[0][3] + result.m[i][1] * m.m[1][3] + result.m[i][2] * m.m[2][3]);
+    }
+    return result;
+}
+
+// Marching cubes corners as (x, y, z) offsets and edges as corner pairs, in
+// the numbering of Paul Bourke's "Polygonising a scalar field".
+constexpr std::int32_t corner_offsets[8][3] = {
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+    {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}
+};
+
+constexpr std::uint8_t edge_corners[12][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6},
+    {6, 7}, {7, 4}, {0, 4}, {1, 5}, {2, 6}, {3, 7}
+};
+
+// Triangles per corner sign configuration as edge triples, -1 terminated.
+constexpr std::int8_t triangle_table[256][16] = {
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 8, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 8, 3, 9, 8, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 2, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 8, 3, 1, 2, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {9, 2, 10, 0, 2, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {2, 8, 3, 2, 10, 8, 10, 9, 8, -1, -1, -1, -1, -1, -1, -1},
+    {3, 11, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 11, 2, 8, 11, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 9, 0, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 11, 2, 1, 9, 11, 9, 8, 11, -1, -1, -1, -1, -1, -1, -1},
+    {3, 10, 1, 11, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 10, 1, 0, 8, 10, 8, 11, 10, -1, -1, -1, -1, -1, -1, -1},
+    {3, 9, 0, 3, 11, 9, 11, 10, 9, -1, -1, -1, -1, -1, -1, -1},
+    {9, 8, 10, 10, 8, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 7, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 3, 0, 7, 3, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 9, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 1, 9, 4, 7, 1, 7, 3, 1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 2, 10, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {3, 4, 7, 3, 0, 4, 1, 2, 10, -1, -1, -1, -1, -1, -1, -1},
+    {9, 2, 10, 9, 0, 2, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1},
+    {2, 10, 9, 2, 9, 7, 2, 7, 3, 7, 9, 4, -1, -1, -1, -1},
+    {8, 4, 7, 3, 11, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {11, 4, 7, 11, 2, 4, 2, 0, 4, -1, -1, -1, -1, -1, -1, -1},
+    {9, 0, 1, 8, 4, 7, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1},
+    {4, 7, 11, 9, 4, 11, 9, 11, 2, 9, 2, 1, -1, -1, -1, -1},
+    {3, 10, 1, 3, 11, 10, 7, 8, 4, -1, -1, -1, -1, -1, -1, -1},
+    {1, 11, 10, 1, 4, 11, 1, 0, 4, 7, 11, 4, -1, -1, -1, -1},
+    {4, 7, 8, 9, 0, 11, 9, 11, 10, 11, 0, 3, -1, -1, -1, -1},
+    {4, 7, 11, 4, 11, 9, 9, 11, 10, -1, -1, -1, -1, -1, -1, -1},
+    {9, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {9, 5, 4, 0, 8, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 5, 4, 1, 5, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {8, 5, 4, 8, 3, 5, 3, 1, 5, -1, -1, -1, -1, -1, -1, -1},
+    {1, 2, 10, 9, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {3, 0, 8, 1, 2, 10, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1},
+    {5, 2, 10, 5, 4, 2, 4, 0, 2, -1, -1, -1, -1, -1, -1, -1},
+    {2, 10, 5, 3, 2, 5, 3, 5, 4, 3, 4, 8, -1, -1, -1, -1},
+    {9, 5, 4, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 11, 2, 0, 8, 11, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1},
+    {0, 5, 4, 0, 1, 5, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1},
+    {2, 1, 5, 2, 5, 8, 2, 8, 11, 4, 8, 5, -1, -1, -1, -1},
+    {10, 3, 11, 10, 1, 3, 9, 5, 4, -1, -1, -1, -1, -1, -1, -1},
+    {4, 9, 5, 0, 8, 1, 8, 10, 1, 8, 11, 10, -1, -1, -1, -1},
+    {5, 4, 0, 5, 0, 11, 5, 11, 10, 11, 0, 3, -1, -1, -1, -1},
+    {5, 4, 8, 5, 8, 10, 10, 8, 11, -1, -1, -1, -1, -1, -1, -1},
+    {9, 7, 8, 5, 7, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {9, 3, 0, 9, 5, 3, 5, 7, 3, -1, -1, -1, -1, -1, -1, -1},
+    {0, 7, 8, 0, 1, 7, 1, 5, 7, -1, -1, -1, -1, -1, -1, -1},
+    {1, 5, 3, 3, 5, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {9, 7, 8, 9, 5, 7, 10, 1, 2, -1, -1, -1, -1, -1, -1, -1},
+    {10, 1, 2, 9, 5, 0, 5, 3, 0, 5, 7, 3, -1, -1, -1, -1},
+    {8, 0, 2, 8, 2, 5, 8, 5, 7, 10, 5, 2, -1, -1, -1, -1},
+    {2, 10, 5, 2, 5, 3, 3, 5, 7, -1, -1, -1, -1, -1, -1, -1},
+    {7, 9, 5, 7, 8, 9, 3, 11, 2, -1, -1, -1, -1, -1, -1, -1},
+    {9, 5, 7, 9, 7, 2, 9, 2, 0, 2, 7, 11, -1, -1, -1, -1},
+    {2, 3, 11, 0, 1, 8, 1, 7, 8, 1, 5, 7, -1, -1, -1, -1},
+    {11, 2, 1, 11, 1, 7, 7, 1, 5, -1, -1, -1, -1, -1, -1, -1},
+    {9, 5, 8, 8, 5, 7, 10, 1, 3, 10, 3, 11, -1, -1, -1, -1},
+    {5, 7, 0, 5, 0, 9, 7, 11, 0, 1, 0, 10, 11, 10, 0, -1},
+    {11, 10, 0, 11, 0, 3, 10, 5, 0, 8, 0, 7, 5, 7, 0, -1},
+    {11, 10, 5, 7, 11, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {10, 6, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 8, 3, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {9, 0, 1, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 8, 3, 1, 9, 8, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1},
+    {1, 6, 5, 2, 6, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 6, 5, 1, 2, 6, 3, 0, 8, -1, -1, -1, -1, -1, -1, -1},
+    {9, 6, 5, 9, 0, 6, 0, 2, 6, -1, -1, -1, -1, -1, -1, -1},
+    {5, 9, 8, 5, 8, 2, 5, 2, 6, 3, 2, 8, -1, -1, -1, -1},
+    {2, 3, 11, 10, 6, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {11, 0, 8, 11, 2, 0, 10, 6, 5, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 9, 2, 3, 11, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1},
+    {5, 10, 6, 1, 9, 2, 9, 11, 2, 9, 8, 11, -1, -1, -1, -1},
+    {6, 3, 11, 6, 5, 3, 5, 1, 3, -1, -1, -1, -1, -1, -1, -1},
+    {0, 8, 11, 0, 11, 5, 0, 5, 1, 5, 11, 6, -1, -1, -1, -1},
+    {3, 11, 6, 0, 3, 6, 0, 6, 5, 0, 5, 9, -1, -1, -1, -1},
+    {6, 5, 9, 6, 9, 11, 11, 9, 8, -1, -1, -1, -1, -1, -1, -1},
+    {5, 10, 6, 4, 7, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 3, 0, 4, 7, 3, 6, 5, 10, -1, -1, -1, -1, -1, -1, -1},
+    {1, 9, 0, 5, 10, 6, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1},
+    {10, 6, 5, 1, 9, 7, 1, 7, 3, 7, 9, 4, -1, -1, -1, -1},
+    {6, 1, 2, 6, 5, 1, 4, 7, 8, -1, -1, -1, -1, -1, -1, -1},
+    {1, 2, 5, 5, 2, 6, 3, 0, 4, 3, 4, 7, -1, -1, -1, -1},
+    {8, 4, 7, 9, 0, 5, 0, 6, 5, 0, 2, 6, -1, -1, -1, -1},
+    {7, 3, 9, 7, 9, 4, 3, 2, 9, 5, 9, 6, 2, 6, 9, -1},
+    {3, 11, 2, 7, 8, 4, 10, 6, 5, -1, -1, -1, -1, -1, -1, -1},
+    {5, 10, 6, 4, 7, 2, 4, 2, 0, 2, 7, 11, -1, -1, -1, -1},
+    {0, 1, 9, 4, 7, 8, 2, 3, 11, 5, 10, 6, -1, -1, -1, -1},
+    {9, 2, 1, 9, 11, 2, 9, 4, 11, 7, 11, 4, 5, 10, 6, -1},
+    {8, 4, 7, 3, 11, 5, 3, 5, 1, 5, 11, 6, -1, -1, -1, -1},
+    {5, 1, 11, 5, 11, 6, 1, 0, 11, 7, 11, 4, 0, 4, 11, -1},
+    {0, 5, 9, 0, 6, 5, 0, 3, 6, 11, 6, 3, 8, 4, 7, -1},
+    {6, 5, 9, 6, 9, 11, 4, 7, 9, 7, 11, 9, -1, -1, -1, -1},
+    {10, 4, 9, 6, 4, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 10, 6, 4, 9, 10, 0, 8, 3, -1, -1, -1, -1, -1, -1, -1},
+    {10, 0, 1, 10, 6, 0, 6, 4, 0, -1, -1, -1, -1, -1, -1, -1},
+    {8, 3, 1, 8, 1, 6, 8, 6, 4, 6, 1, 10, -1, -1, -1, -1},
+    {1, 4, 9, 1, 2, 4, 2, 6, 4, -1, -1, -1, -1, -1, -1, -1},
+    {3, 0, 8, 1, 2, 9, 2, 4, 9, 2, 6, 4, -1, -1, -1, -1},
+    {0, 2, 4, 4, 2, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {8, 3, 2, 8, 2, 4, 4, 2, 6, -1, -1, -1, -1, -1, -1, -1},
+    {10, 4, 9, 10, 6, 4, 11, 2, 3, -1, -1, -1, -1, -1, -1, -1},
+    {0, 8, 2, 2, 8, 11, 4, 9, 10, 4, 10, 6, -1, -1, -1, -1},
+    {3, 11, 2, 0, 1, 6, 0, 6, 4, 6, 1, 10, -1, -1, -1, -1},
+    {6, 4, 1, 6, 1, 10, 4, 8, 1, 2, 1, 11, 8, 11, 1, -1},
+    {9, 6, 4, 9, 3, 6, 9, 1, 3, 11, 6, 3, -1, -1, -1, -1},
+    {8, 11, 1, 8, 1, 0, 11, 6, 1, 9, 1, 4, 6, 4, 1, -1},
+    {3, 11, 6, 3, 6, 0, 0, 6, 4, -1, -1, -1, -1, -1, -1, -1},
+    {6, 4, 8, 11, 6, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {7, 10, 6, 7, 8, 10, 8, 9, 10, -1, -1, -1, -1, -1, -1, -1},
+    {0, 7, 3, 0, 10, 7, 0, 9, 10, 6, 7, 10, -1, -1, -1, -1},
+    {10, 6, 7, 1, 10, 7, 1, 7, 8, 1, 8, 0, -1, -1, -1, -1},
+    {10, 6, 7, 10, 7, 1, 1, 7, 3, -1, -1, -1, -1, -1, -1, -1},
+    {1, 2, 6, 1, 6, 8, 1, 8, 9, 8, 6, 7, -1, -1, -1, -1},
+    {2, 6, 9, 2, 9, 1, 6, 7, 9, 0, 9, 3, 7, 3, 9, -1},
+    {7, 8, 0, 7, 0, 6, 6, 0, 2, -1, -1, -1, -1, -1, -1, -1},
+    {7, 3, 2, 6, 7, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {2, 3, 11, 10, 6, 8, 10, 8, 9, 8, 6, 7, -1, -1, -1, -1},
+    {2, 0, 7, 2, 7, 11, 0, 9, 7, 6, 7, 10, 9, 10, 7, -1},
+    {1, 8, 0, 1, 7, 8, 1, 10, 7, 6, 7, 10, 2, 3, 11, -1},
+    {11, 2, 1, 11, 1, 7, 10, 6, 1, 6, 7, 1, -1, -1, -1, -1},
+    {8, 9, 6, 8, 6, 7, 9, 1, 6, 11, 6, 3, 1, 3, 6, -1},
+    {0, 9, 1, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {7, 8, 0, 7, 0, 6, 3, 11, 0, 11, 6, 0, -1, -1, -1, -1},
+    {7, 11, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {7, 6, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {3, 0, 8, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 9, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {8, 1, 9, 8, 3, 1, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1},
+    {10, 1, 2, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 2, 10, 3, 0, 8, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1},
+    {2, 9, 0, 2, 10, 9, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1},
+    {6, 11, 7, 2, 10, 3, 10, 8, 3, 10, 9, 8, -1, -1, -1, -1},
+    {7, 2, 3, 6, 2, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {7, 0, 8, 7, 6, 0, 6, 2, 0, -1, -1, -1, -1, -1, -1, -1},
+    {2, 7, 6, 2, 3, 7, 0, 1, 9, -1, -1, -1, -1, -1, -1, -1},
+    {1, 6, 2, 1, 8, 6, 1, 9, 8, 8, 7, 6, -1, -1, -1, -1},
+    {10, 7, 6, 10, 1, 7, 1, 3, 7, -1, -1, -1, -1, -1, -1, -1},
+    {10, 7, 6, 1, 7, 10, 1, 8, 7, 1, 0, 8, -1, -1, -1, -1},
+    {0, 3, 7, 0, 7, 10, 0, 10, 9, 6, 10, 7, -1, -1, -1, -1},
+    {7, 6, 10, 7, 10, 8, 8, 10, 9, -1, -1, -1, -1, -1, -1, -1},
+    {6, 8, 4, 11, 8, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {3, 6, 11, 3, 0, 6, 0, 4, 6, -1, -1, -1, -1, -1, -1, -1},
+    {8, 6, 11, 8, 4, 6, 9, 0, 1, -1, -1, -1, -1, -1, -1, -1},
+    {9, 4, 6, 9, 6, 3, 9, 3, 1, 11, 3, 6, -1, -1, -1, -1},
+    {6, 8, 4, 6, 11, 8, 2, 10, 1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 2, 10, 3, 0, 11, 0, 6, 11, 0, 4, 6, -1, -1, -1, -1},
+    {4, 11, 8, 4, 6, 11, 0, 2, 9, 2, 10, 9, -1, -1, -1, -1},
+    {10, 9, 3, 10, 3, 2, 9, 4, 3, 11, 3, 6, 4, 6, 3, -1},
+    {8, 2, 3, 8, 4, 2, 4, 6, 2, -1, -1, -1, -1, -1, -1, -1},
+    {0, 4, 2, 4, 6, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 9, 0, 2, 3, 4, 2, 4, 6, 4, 3, 8, -1, -1, -1, -1},
+    {1, 9, 4, 1, 4, 2, 2, 4, 6, -1, -1, -1, -1, -1, -1, -1},
+    {8, 1, 3, 8, 6, 1, 8, 4, 6, 6, 10, 1, -1, -1, -1, -1},
+    {10, 1, 0, 10, 0, 6, 6, 0, 4, -1, -1, -1, -1, -1, -1, -1},
+    {4, 6, 3, 4, 3, 8, 6, 10, 3, 0, 3, 9, 10, 9, 3, -1},
+    {10, 9, 4, 6, 10, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 9, 5, 7, 6, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 8, 3, 4, 9, 5, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1},
+    {5, 0, 1, 5, 4, 0, 7, 6, 11, -1, -1, -1, -1, -1, -1, -1},
+    {11, 7, 6, 8, 3, 4, 3, 5, 4, 3, 1, 5, -1, -1, -1, -1},
+    {9, 5, 4, 10, 1, 2, 7, 6, 11, -1, -1, -1, -1, -1, -1, -1},
+    {6, 11, 7, 1, 2, 10, 0, 8, 3, 4, 9, 5, -1, -1, -1, -1},
+    {7, 6, 11, 5, 4, 10, 4, 2, 10, 4, 0, 2, -1, -1, -1, -1},
+    {3, 4, 8, 3, 5, 4, 3, 2, 5, 10, 5, 2, 11, 7, 6, -1},
+    {7, 2, 3, 7, 6, 2, 5, 4, 9, -1, -1, -1, -1, -1, -1, -1},
+    {9, 5, 4, 0, 8, 6, 0, 6, 2, 6, 8, 7, -1, -1, -1, -1},
+    {3, 6, 2, 3, 7, 6, 1, 5, 0, 5, 4, 0, -1, -1, -1, -1},
+    {6, 2, 8, 6, 8, 7, 2, 1, 8, 4, 8, 5, 1, 5, 8, -1},
+    {9, 5, 4, 10, 1, 6, 1, 7, 6, 1, 3, 7, -1, -1, -1, -1},
+    {1, 6, 10, 1, 7, 6, 1, 0, 7, 8, 7, 0, 9, 5, 4, -1},
+    {4, 0, 10, 4, 10, 5, 0, 3, 10, 6, 10, 7, 3, 7, 10, -1},
+    {7, 6, 10, 7, 10, 8, 5, 4, 10, 4, 8, 10, -1, -1, -1, -1},
+    {6, 9, 5, 6, 11, 9, 11, 8, 9, -1, -1, -1, -1, -1, -1, -1},
+    {3, 6, 11, 0, 6, 3, 0, 5, 6, 0, 9, 5, -1, -1, -1, -1},
+    {0, 11, 8, 0, 5, 11, 0, 1, 5, 5, 6, 11, -1, -1, -1, -1},
+    {6, 11, 3, 6, 3, 5, 5, 3, 1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 2, 10, 9, 5, 11, 9, 11, 8, 11, 5, 6, -1, -1, -1, -1},
+    {0, 11, 3, 0, 6, 11, 0, 9, 6, 5, 6, 9, 1, 2, 10, -1},
+    {11, 8, 5, 11, 5, 6, 8, 0, 5, 10, 5, 2, 0, 2, 5, -1},
+    {6, 11, 3, 6, 3, 5, 2, 10, 3, 10, 5, 3, -1, -1, -1, -1},
+    {5, 8, 9, 5, 2, 8, 5, 6, 2, 3, 8, 2, -1, -1, -1, -1},
+    {9, 5, 6, 9, 6, 0, 0, 6, 2, -1, -1, -1, -1, -1, -1, -1},
+    {1, 5, 8, 1, 8, 0, 5, 6, 8, 3, 8, 2, 6, 2, 8, -1},
+    {1, 5, 6, 2, 1, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 3, 6, 1, 6, 10, 3, 8, 6, 5, 6, 9, 8, 9, 6, -1},
+    {10, 1, 0, 10, 0, 6, 9, 5, 0, 5, 6, 0, -1, -1, -1, -1},
+    {0, 3, 8, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {10, 5, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {11, 5, 10, 7, 5, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {11, 5, 10, 11, 7, 5, 8, 3, 0, -1, -1, -1, -1, -1, -1, -1},
+    {5, 11, 7, 5, 10, 11, 1, 9, 0, -1, -1, -1, -1, -1, -1, -1},
+    {10, 7, 5, 10, 11, 7, 9, 8, 1, 8, 3, 1, -1, -1, -1, -1},
+    {11, 1, 2, 11, 7, 1, 7, 5, 1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 8, 3, 1, 2, 7, 1, 7, 5, 7, 2, 11, -1, -1, -1, -1},
+    {9, 7, 5, 9, 2, 7, 9, 0, 2, 2, 11, 7, -1, -1, -1, -1},
+    {7, 5, 2, 7, 2, 11, 5, 9, 2, 3, 2, 8, 9, 8, 2, -1},
+    {2, 5, 10, 2, 3, 5, 3, 7, 5, -1, -1, -1, -1, -1, -1, -1},
+    {8, 2, 0, 8, 5, 2, 8, 7, 5, 10, 2, 5, -1, -1, -1, -1},
+    {9, 0, 1, 5, 10, 3, 5, 3, 7, 3, 10, 2, -1, -1, -1, -1},
+    {9, 8, 2, 9, 2, 1, 8, 7, 2, 10, 2, 5, 7, 5, 2, -1},
+    {1, 3, 5, 3, 7, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 8, 7, 0, 7, 1, 1, 7, 5, -1, -1, -1, -1, -1, -1, -1},
+    {9, 0, 3, 9, 3, 5, 5, 3, 7, -1, -1, -1, -1, -1, -1, -1},
+    {9, 8, 7, 5, 9, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {5, 8, 4, 5, 10, 8, 10, 11, 8, -1, -1, -1, -1, -1, -1, -1},
+    {5, 0, 4, 5, 11, 0, 5, 10, 11, 11, 3, 0, -1, -1, -1, -1},
+    {0, 1, 9, 8, 4, 10, 8, 10, 11, 10, 4, 5, -1, -1, -1, -1},
+    {10, 11, 4, 10, 4, 5, 11, 3, 4, 9, 4, 1, 3, 1, 4, -1},
+    {2, 5, 1, 2, 8, 5, 2, 11, 8, 4, 5, 8, -1, -1, -1, -1},
+    {0, 4, 11, 0, 11, 3, 4, 5, 11, 2, 11, 1, 5, 1, 11, -1},
+    {0, 2, 5, 0, 5, 9, 2, 11, 5, 4, 5, 8, 11, 8, 5, -1},
+    {9, 4, 5, 2, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {2, 5, 10, 3, 5, 2, 3, 4, 5, 3, 8, 4, -1, -1, -1, -1},
+    {5, 10, 2, 5, 2, 4, 4, 2, 0, -1, -1, -1, -1, -1, -1, -1},
+    {3, 10, 2, 3, 5, 10, 3, 8, 5, 4, 5, 8, 0, 1, 9, -1},
+    {5, 10, 2, 5, 2, 4, 1, 9, 2, 9, 4, 2, -1, -1, -1, -1},
+    {8, 4, 5, 8, 5, 3, 3, 5, 1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 4, 5, 1, 0, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {8, 4, 5, 8, 5, 3, 9, 0, 5, 0, 3, 5, -1, -1, -1, -1},
+    {9, 4, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 11, 7, 4, 9, 11, 9, 10, 11, -1, -1, -1, -1, -1, -1, -1},
+    {0, 8, 3, 4, 9, 7, 9, 11, 7, 9, 10, 11, -1, -1, -1, -1},
+    {1, 10, 11, 1, 11, 4, 1, 4, 0, 7, 4, 11, -1, -1, -1, -1},
+    {3, 1, 4, 3, 4, 8, 1, 10, 4, 7, 4, 11, 10, 11, 4, -1},
+    {4, 11, 7, 9, 11, 4, 9, 2, 11, 9, 1, 2, -1, -1, -1, -1},
+    {9, 7, 4, 9, 11, 7, 9, 1, 11, 2, 11, 1, 0, 8, 3, -1},
+    {11, 7, 4, 11, 4, 2, 2, 4, 0, -1, -1, -1, -1, -1, -1, -1},
+    {11, 7, 4, 11, 4, 2, 8, 3, 4, 3, 2, 4, -1, -1, -1, -1},
+    {2, 9, 10, 2, 7, 9, 2, 3, 7, 7, 4, 9, -1, -1, -1, -1},
+    {9, 10, 7, 9, 7, 4, 10, 2, 7, 8, 7, 0, 2, 0, 7, -1},
+    {3, 7, 10, 3, 10, 2, 7, 4, 10, 1, 10, 0, 4, 0, 10, -1},
+    {1, 10, 2, 8, 7, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 9, 1, 4, 1, 7, 7, 1, 3, -1, -1, -1, -1, -1, -1, -1},
+    {4, 9, 1, 4, 1, 7, 0, 8, 1, 8, 7, 1, -1, -1, -1, -1},
+    {4, 0, 3, 7, 4, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {4, 8, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {9, 10, 8, 10, 11, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {3, 0, 9, 3, 9, 11, 11, 9, 10, -1, -1, -1, -1, -1, -1, -1},
+    {0, 1, 10, 0, 10, 8, 8, 10, 11, -1, -1, -1, -1, -1, -1, -1},
+    {3, 1, 10, 11, 3, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 2, 11, 1, 11, 9, 9, 11, 8, -1, -1, -1, -1, -1, -1, -1},
+    {3, 0, 9, 3, 9, 11, 1, 2, 9, 2, 11, 9, -1, -1, -1, -1},
+    {0, 2, 11, 8, 0, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {3, 2, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {2, 3, 8, 2, 8, 10, 10, 8, 9, -1, -1, -1, -1, -1, -1, -1},
+    {9, 10, 2, 0, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {2, 3, 8, 2, 8, 10, 0, 1, 8, 1, 10, 8, -1, -1, -1, -1},
+    {1, 10, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {1, 3, 8, 9, 1, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 9, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {0, 3, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},};
+
+// Global id of a voxel-grid edge: its lower corner and axis. Used to weld
+// vertices that neighbouring cubes, possibly in other blocks, share.
+std::uint64_t edge_key(std::int32_t x, std::int32_t y, std::int32_t z, std::uint32_t axis) {
+    constexpr std::int32_t bias = 1 << 19;
+    constexpr std::uint64_t mask = (1u << 20) - 1;
+    return ((static_cast<std::uint64_t>(x + bias) & mask) << 42) |
+           ((static_cast<std::uint64_t>(y + bias) & mask) << 22) |
+           ((static_cast<std::uint64_t>(z + bias) & mask) << 2) | axis;
+}
+
+struct MeshVertex {
+    std::uint64_t key;
+    utils::Vector3f position;
+    utils::Vector3f color;
+};
+
+// Marching cubes output for one block; triangles index into vertices.
+struct BlockMesh {
+    std::vector<MeshVertex> vertices;
+    std::vector<std::uint32_t> triangles;
+};
+
+}
+
+struct TsdfVolume::Impl {
+    TsdfSettings settings;
+    std::unordered_map<BlockKey, std::uint32_t, BlockKeyHash> lookup;
+    std::vector<BlockKey> keys;
+    std::vector<std::unique_ptr<Block>> blocks;
+
+    float truncation() const {
+        return settings.truncation > 0.0f ? settings.truncation : 4.0f * settings.voxel_size;
+    }
+
+    const Block* find(const BlockKey& key) const {
+        auto it = lookup.find(key);
+        return it != lookup.end() ? blocks[it->second].get() : nullptr;
+    }
+
+    void mesh_block(std::size_t index, BlockMesh& out) const;
+};
+
+TsdfVolume::TsdfVolume(const TsdfSettings& settings) : impl_(std::make_unique<Impl>()) {
+    impl_->settings = settings;
+}
+
+TsdfVolume::~TsdfVolume() = default;
+TsdfVolume::TsdfVolume(TsdfVolume&&) noexcept = default;
+TsdfVolume& TsdfVolume::operator=(TsdfVolume&&) noexcept = default;
+
+const TsdfSettings& TsdfVolume::get_settings() const {
+    return impl_->settings;
+}
+
+void TsdfVolume::integrate(const Camera& camera, std::uint32_t width, std::uint32_t height,
+                           std::span<const float> depth, std::span<const float> color,
+                           std::span<const float> alpha) {
+    auto& impl = *impl_;
+    const std::size_t pixels = static_cast<std::size_t>(width) * height;
+    if (depth.size() < pixels || (!color.empty() && color.size() < pixels * 4) ||
+        (!alpha.empty() && alpha.size() < pixels)) {
+        utils::log_error("TSDF integration buffers are smaller than {}x{}", width, height);
+        return;
+    }
+
+    const auto& settings = impl.settings;
+    const float voxel = settings.voxel_size;
+    const float block_extent = voxel * block_size;
+    const float truncation = impl.truncation();
+    const Intrinsics intrinsics = make_intrinsics(camera, width, height);
+    const utils::Matrix4f view = camera.get_view_matrix();
+    const utils::Matrix4f camera_to_world = rigid_inverse(view);
+
+    auto valid = [&](std::size_t pixel) {
+        float d = depth[pixel];
+        return d > 0.0f && (settings.max_depth <= 0.0f || d <= settings.max_depth) &&
+               (alpha.empty() || alpha[pixel] >= settings.min_alpha);
+    };
+
+    // Blocks crossed by the truncation band around each depth sample, found
+    // per row range and merged.
+    auto& pool = utils::ThreadPool::instance();
+    std::vector<std::vector<BlockKey>> touched((height + integrate_row_grain - 1) / integrate_row_grain);
+    const std::uint32_t band_steps = static_cast<std::uint32_t>(std::ceil(2.0f * truncation / (0.5f * block_extent))) + 1;
+    pool.parallel_for(0, touched.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t chunk = first; chunk < last; ++chunk) {
+            auto& found = touched[chunk];
+            // Neighbouring pixels mostly hit the same blocks; a small
+            // direct-mapped filter drops those repeats before the sort.
+            std::array<BlockKey, recent_keys> recent;
+            recent.fill({std::numeric_limits<std::int32_t>::min(), 0, 0});
+            std::uint32_t row_end = std::min<std::uint32_t>(height, static_cast<std::uint32_t>((chunk + 1) * integrate_row_grain));
+            for (auto v = static_cast<std::uint32_t>(chunk * integrate_row_grain); v < row_end; ++v) {
+                for (std::uint32_t u = 0; u < width; ++u) {
+                    std::size_t pixel = static_cast<std::size_t>(v) * width + u;
+                    if (!valid(pixel)) {
+                        continue;
+                    }
+                    float x = (static_cast<float>(u) + 0.5f - intrinsics.cx) / intrinsics.fx;
+                    float y = -(static_cast<float>(v) + 0.5f - intrinsics.cy) / intrinsics.fy;
+                    for (std::uint32_t s = 0; s < band_steps; ++s) {
+                        float d = depth[pixel] - truncation + 2.0f * truncation * s / static_cast<float>(band_steps - 1);
+                        if (d <= 0.0f) {
+                            continue;
+                        }
+                        float scale = intrinsics.orthographic ? 1.0f : d;
+                        auto world = transform_point(camera_to_world, {x * scale, y * scale, -d});
+                        BlockKey key{static_cast<std::int32_t>(std::floor(world.x / block_extent)),
+                                     static_cast<std::int32_t>(std::floor(world.y / block_extent)),
+                                     static_cast<std::int32_t>(std::floor(world.z / block_extent))};
+                        auto& slot = recent[BlockKeyHash{}(key) % recent_keys];
+                        if (!(slot == key)) {
+                            slot = key;
+                            found.push_back(key);
+                        }
+                    }
+                }
+            }
+            std::sort(found.begin(), found.end());
+            found.erase(std::unique(found.begin(), found.end()), found.end());
+        }
+    });
+
+    std::vector<BlockKey> keys;
+    for (const auto& found : touched) {
+        keys.insert(keys.end(), found.begin(), found.end());
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<std::uint32_t> active(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        auto [it, inserted] = impl.lookup.try_emplace(keys[i], static_cast<std::uint32_t>(impl.blocks.size()));
+        if (inserted) {
+            impl.blocks.push_back(std::make_unique<Block>());
+            impl.keys.push_back(keys[i]);
+        }
+        active[i] = it->second;
+    }
+
+    // Each block is owned by one task, so voxel updates need no locking.
+    pool.parallel_for(0, active.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const BlockKey& key = impl.keys[active[i]];
+            Block& block = *impl.blocks[active[i]];
+            for (std::uint32_t index = 0; index < voxels_per_block; ++index) {
+                std::uint32_t vx = index % block_size;
+                std::uint32_t vy = (index / block_size) % block_size;
+                std::uint32_t vz = index / (block_size * block_size);
+                utils::Vector3f world{
+                    static_cast<float>(key.x * static_cast<std::int32_t>(block_size) + static_cast<std::int32_t>(vx)) * voxel,
+                    static_cast<float>(key.y * static_cast<std::int32_t>(block_size) + static_cast<std::int32_t>(vy)) * voxel,
+                    static_cast<float>(key.z * static_cast<std::int32_t>(block_size) + static_cast<std::int32_t>(vz)) * voxel};
+                auto p = transform_point(view, world);
+                float z = -p.z;
+                if (z <= 0.0f) {
+                    continue;
+                }
+                float inv = intrinsics.orthographic ? 1.0f : 1.0f / z;
+                float pu = intrinsics.cx + intrinsics.fx * p.x * inv;
+                float pv = intrinsics.cy - intrinsics.fy * p.y * inv;
+                if (pu < 0.0f || pv < 0.0f || pu >= static_cast<float>(width) || pv >= static_cast<float>(height)) {
+                    continue;
+                }
+                std::size_t pixel = static_cast<std::size_t>(pv) * width + static_cast<std::size_t>(pu);
+                if (!valid(pixel)) {
+                    continue;
+                }
+
+                float sdf = depth[pixel] - z;
+                if (sdf < -truncation) {
+                    continue;
+                }
+                float tsdf = std::min(1.0f, sdf / truncation);
+
+                Voxel& voxel_data = block.voxels[index];
+                float weight = voxel_data.weight + 1.0f;
+                voxel_data.tsdf = (voxel_data.tsdf * voxel_data.weight + tsdf) / weight;
+                if (!color.empty()) {
+                    // Renders over a transparent background are premultiplied.
+                    float a = color[pixel * 4 + 3];
+                    float inv_a = a > 0.0f ? 1.0f / a : 1.0f;
+                    for (int c = 0; c < 3; ++c) {
+                        voxel_data.color[c] = (voxel_data.color[c] * voxel_data.weight + color[pixel * 4 + c] * inv_a) / weight;
+                    }
+                }
+                voxel_data.weight = weight;
+            }
+        }
+    }, block_grain);
+}
+
+void TsdfVolume::Impl::mesh_block(std::size_t index, BlockMesh& out) const {
+    constexpr auto size = static_cast<std::int32_t>(block_size);
+    const BlockKey key = keys[index];
+
+    // The cubes of a block reach one voxel into the neighbours on the
+    // positive side, so those seven blocks are looked up once up front.
+    const Block* neighbours[2][2][2];
+    for (int dz = 0; dz < 2; ++dz) {
+        for (int dy = 0; dy < 2; ++dy) {
+            for (int dx = 0; dx < 2; ++dx) {
+                neighbours[dz][dy][dx] = find({key.x + dx, key.y + dy, key.z + dz});
+            }
+        }
+    }
+    auto voxel_at = [&](std::int32_t x, std::int32_t y, std::int32_t z) -> const Voxel* {
+        const Block* block = neighbours[z / size][y / size][x / size];
+        if (!block) {
+            return nullptr;
+        }
+        const Voxel& v = block->voxels[(z % size) * size * size + (y % size) * size + (x % size)];
+        return v.weight >= settings.min_weight ? &v : nullptr;
+    };
+
+    // Vertices on this block's edges, indexed by the edge's lower corner
+    // (which may lie on the far border) and axis.
+    constexpr std::int32_t span = size + 1;
+    std::array<std::uint32_t, span * span * span * 3> welded;
+    welded.fill(std::numeric_limits<std::uint32_t>::max());
+    const std::int32_t base[3] = {key.x * size, key.y * size, key.z * size};
+    for (std::int32_t z = 0; z < size; ++z) {
+        for (std::int32_t y = 0; y < size; ++y) {
+            for (std::int32_t x = 0; x < size; ++x) {
+                const Voxel* corners[8];
+                std::uint32_t cube = 0;
+                bool complete = true;
+                for (int c = 0; c < 8 && complete; ++c) {
+                    corners[c] = voxel_at(x + corner_offsets[c][0], y + corner_offsets[c][1], z + corner_offsets[c][2]);
+                    complete = corners[c] != nullptr;
+                    if (complete && corners[c]->tsdf < 0.0f) {
+                        cube |= 1u << c;
+                    }
+                }
+                if (!complete || cube == 0 || cube == 255) {
+                    continue;
+                }
+
+                std::uint32_t edge_vertex[12];
+                std::uint32_t needed = 0;
+                for (int t = 0; triangle_table[cube][t] >= 0; ++t) {
+                    needed |= 1u << triangle_table[cube][t];
+                }
+                for (std::uint32_t e = 0; e < 12; ++e) {
+                    if (!(needed & (1u << e))) {
+                        continue;
+                    }
+                    const auto* a = corner_offsets[edge_corners[e][0]];
+                    const auto* b = corner_offsets[edge_corners[e][1]];
+                    std::uint32_t axis = a[0] != b[0] ? 0 : (a[1] != b[1] ? 1 : 2);
+                    std::int32_t lower[3] = {x + std::min(a[0], b[0]), y + std::min(a[1], b[1]),
+                                             z + std::min(a[2], b[2])};
+                    auto& slot = welded[((lower[2] * span + lower[1]) * span + lower[0]) * 3 + axis];
+                    if (slot == std::numeric_limits<std::uint32_t>::max()) {
+                        slot = static_cast<std::uint32_t>(out.vertices.size());
+                        const Voxel& va = *corners[edge_corners[e][0]];
+                        const Voxel& vb = *corners[edge_corners[e][1]];
+                        float denominator = va.tsdf - vb.tsdf;
+                        float s = std::abs(denominator) > 1e-6f ? va.tsdf / denominator : 0.5f;
+                        auto corner_position = [&](const std::int32_t* offset) {
+                            return utils::Vector3f(static_cast<float>(base[0] + x + offset[0]),
+                                                   static_cast<float>(base[1] + y + offset[1]),
+                                                   static_cast<float>(base[2] + z + offset[2])) * settings.voxel_size;
+                        };
+                        auto pa = corner_position(a);
+                        auto pb = corner_position(b);
+                        MeshVertex vertex;
+                        vertex.key = edge_key(base[0] + lower[0], base[1] + lower[1], base[2] + lower[2], axis);
+                        vertex.position = pa + (pb - pa) * s;
+                        vertex.color = {va.color[0] + (vb.color[0] - va.color[0]) * s,
+                                        va.color[1] + (vb.color[1] - va.color[1]) * s,
+                                        va.color[2] + (vb.color[2] - va.color[2]) * s};
+                        out.vertices.push_back(vertex);
+                    }
+                    edge_vertex[e] = slot;
+                }
+
+                // The table winds triangles counter-clockwise seen from the
+                // negative side; emit them reversed so they face outwards,
+                // towards the observed free space.
+                for (int t = 0; triangle_table[cube][t] >= 0; t += 3) {
+                    out.triangles.push_back(edge_vertex[triangle_table[cube][t]]);
+                    out.triangles.push_back(edge_vertex[triangle_table[cube][t + 2]]);
+                    out.triangles.push_back(edge_vertex[triangle_table[cube][t + 1]]);
+                }
+            }
+        }
+    }
+}
+
+TriangleMesh TsdfVolume::extract_mesh() const {
+    const auto& impl = *impl_;
+    std::vector<BlockMesh> parts(impl.blocks.size());
+    utils::ThreadPool::instance().parallel_for(0, parts.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            impl.mesh_block(i, parts[i]);
+        }
+    }, block_grain);
+
+    // Weld vertices on block borders, which both blocks emitted.
+    std::size_t vertex_total = 0;
+    std::size_t index_total = 0;
+    for (const auto& part : parts) {
+        vertex_total += part.vertices.size();
+        index_total += part.triangles.size();
+    }
+    TriangleMesh mesh;
+    mesh.vertices.reserve(vertex_total);
+    mesh.colors.reserve(vertex_total);
+    mesh.indices.reserve(index_total);
+    std::unordered_map<std::uint64_t, std::uint32_t> welded;
+    welded.reserve(vertex_total);
+    std::vector<std::uint32_t> remap;
+    for (const auto& part : parts) {
+        remap.resize(part.vertices.size());
+        for (std::size_t v = 0; v < part.vertices.size(); ++v) {
+            const auto& vertex = part.vertices[v];
+            auto [it, inserted] = welded.try_emplace(vertex.key, static_cast<std::uint32_t>(mesh.vertices.size()));
+            if (inserted) {
+                mesh.vertices.push_back(vertex.position);
+                mesh.colors.push_back(vertex.color);
+            }
+            remap[v] = it->second;
+        }
+        for (std::uint32_t index : part.triangles) {
+            mesh.indices.push_back(remap[index]);
+        }
+    }
+
+    // Area-weighted vertex normals.
+    mesh.normals.assign(mesh.vertices.size(), {0.0f, 0.0f, 0.0f});
+    for (std::size_t f = 0; f < mesh.triangle_count(); ++f) {
+        std::uint32_t a = mesh.indices[f * 3 + 0];
+        std::uint32_t b = mesh.indices[f * 3 + 1];
+        std::uint32_t c = mesh.indices[f * 3 + 2];
+        auto normal = (mesh.vertices[b] - mesh.vertices[a]).cross(mesh.vertices[c] - mesh.vertices[a]);
+        mesh.normals[a] = mesh.normals[a] + normal;
+        mesh.normals[b] = mesh.normals[b] + normal;
+        mesh.normals[c] = mesh.normals[c] + normal;
+    }
+    for (auto& normal : mesh.normals) {
+        float length = normal.length();
+        normal = length > 0.0f ? normal * (1.0f / length) : utils::Vector3f(0.0f, 0.0f, 0.0f);
+    }
+    return mesh;
+}
+
+std::size_t TsdfVolume::block_count() const {
+    return impl_->blocks.size();
+}
+
+std::size_t TsdfVolume::memory_footprint() const {
+    return impl_->blocks.size() * (sizeof(Block) + sizeof(BlockKey)) +
+           impl_->lookup.size() * (sizeof(BlockKey) + sizeof(std::uint32_t));
+}
+
+void TsdfVolume::clear() {
+    impl_->lookup.clear();
+    impl_->keys.clear();
+    impl_->blocks.clear();
+}
+
+TriangleMesh extract_gaussian_mesh(const Scene& scene, std::span<const Camera> cameras,
+                                   std::uint32_t width, std::uint32_t height,
+                                   const TsdfSettings& settings) {
+    TileRenderer renderer;
+    if (cameras.empty() || !renderer.initialize({width, height})) {
+        utils::log_error("Mesh extraction needs at least one camera and a valid image size");
+        return {};
+    }
+    // A transparent background leaves color premultiplied by coverage,
+    // which integrate() divides back out.
+    renderer.clear({0.0f, 0.0f, 0.0f, 0.0f});
+
+    const std::size_t pixels = static_cast<std::size_t>(width) * height;
+    const std::size_t batch = std::min(cameras.size(), render_batch);
+    std::vector<float> color(batch * pixels * 4);
+    std::vector<float> alpha(batch * pixels);
+    std::vector<float> median_depth(batch * pixels);
+
+    TsdfVolume volume(settings);
+    for (std::size_t first = 0; first < cameras.size(); first += batch) {
+        auto views = cameras.subspan(first, std::min(batch, cameras.size() - first));
+        renderer.render_views(scene, views, color, {}, alpha, median_depth);
+        for (std::size_t v = 0; v < views.size(); ++v) {
+            volume.integrate(views[v], width, height,
+                             std::span<const float>(median_depth).subspan(v * pixels, pixels),
+                             std::span<const float>(color).subspan(v * pixels * 4, pixels * 4),
+                             std::span<const float>(alpha).subspan(v * pixels, pixels));
+        }
+    }
+
+    TriangleMesh mesh = volume.extract_mesh();
+    utils::log_info("Extracted mesh with {} vertices and {} triangles from {} views ({} TSDF blocks)",
+                    mesh.vertex_count(), mesh.triangle_count(), cameras.size(), volume.block_count());
+    return mesh;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,462 @@
+#include "buildify/utils/config.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+extern char** environ;
+
+namespace buildify::utils {
+
+namespace {
+
+class Parser {
+public:
+    explicit Parser(std::string_view text) : text_(text) {}
+
+    // Flattens the top-level object into `out`; `error` names the problem.
+    bool parse(std::map<std::string, std::pair<std::string, bool>>& out, std::string& error) {
+        skip_space();
+        if (!parse_object("", out)) {
+            error = error_;
+            return false;
+        }
+        skip_space();
+        if (position_ != text_.size()) {
+            error = "unexpected text after the top-level object";
+            return false;
+        }
+        return true;
+    }
+
+    std::size_t line() const {
+        return 1 + static_cast<std::size_t>(std::count(text_.begin(), text_.begin() + position_, '\n'));
+    }
+
+private:
+    bool fail(const char* message) {
+        if (error_.empty()) {
+            error_ = message;
+        }
+        return false;
+    }
+
+    void skip_space() {
+        while (position_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[position_]))) {
+            ++position_;
+        }
+    }
+
+    bool consume(char c) {
+        skip_space();
+        if (position_ < text_.size() && text_[position_] == c) {
+            ++position_;
+            return true;
+        }
+        return false;
+    }
+
+    bool parse_object(const std::string& prefix, std::map<std::string, std::pair<std::string, bool>>& out) {
+        if (!consume('{')) {
+            return fail("expected '{'");
+        }
+        if (consume('}')) {
+            return true;
+        }
+        do {
+            skip_space();
+            std::string name;
+            if (!parse_string(name)) {
+                return fail("expected a quoted key");
+            }
+            if (name.empty() || name.find('.') != std::string::npos) {
+                return fail("keys must be non-empty and may not contain '.'");
+            }
+            if (!consume(':')) {
+                return fail("expected ':'");
+            }
+            if (!parse_value(prefix + name, out)) {
+                return false;
+            }
+        } while (consume(','));
+        if (!consume('}')) {
+            return fail("expected ',' or '}'");
+        }
+        return true;
+    }
+
+    bool parse_value(const std::string& key, std::map<std::string, std::pair<std::string, bool>>& out) {
+        skip_space();
+        if (position_ >= text_.size()) {
+            return fail("unexpected end of input");
+        }
+        const char c = text_[position_];
+        if (c == '{') {
+            return parse_object(key + ".", out);
+        }
+        if (c == '[') {
+            return fail("arrays are not supported");
+        }
+        if (c == '"') {
+            std::string value;
+            if (!parse_string(value)) {
+                return fail("unterminated string");
+            }
+            out[key] = {std::move(value), true};
+            return true;
+        }
+        for (std::string_view literal : {"true", "false", "null"}) {
+            if (text_.substr(position_, literal.size()) == literal) {
+                position_ += literal.size();
+                out[key] = {std::string(literal), false};
+                return true;
+            }
+        }
+
+        // Numbers: validated by the JSON grammar, kept as written.
+        const std::size_t start = position_;
+        if (position_ < text_.size() && text_[position_] == '-') {
+            ++position_;
+        }
+        auto digits = [&]() {
+            std::size_t first = position_;
+            while (position_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[position_]))) {
+                ++position_;
+            }
+            return position_ > first;
+        };
+        if (!digits()) {
+            return fail("expected a value");
+        }
+        if (position_ < text_.size() && text_[position_] == '.') {
+            ++position_;
+            if (!digits()) {
+                return fail("malformed number");
+            }
+        }
+        if (position_ < text_.size() && (text_[position_] == 'e' || text_[position_] == 'E')) {
+            ++position_;
+            if (position_ < text_.size() && (text_[position_] == '+' || text_[position_] == '-')) {
+                ++position_;
+            }
+            if (!digits()) {
+                return fail("malformed number");
+            }
+        }
+        out[key] = {std::string(text_.substr(start, position_ - start)), false};
+        return true;
+    }
+
+    bool parse_string(std::string& out) {
+        if (position_ >= text_.size() || text_[position_] != '"') {
+            return false;
+        }
+        ++position_;
+        while (position_ < text_.size()) {
+            char c = text_[position_++];
+            if (c == '"') {
+                return true;
+            }
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (position_ >= text_.size()) {
+                return false;
+            }
+            char escape = text_[position_++];
+            switch (escape) {
+                case '"': case '\\': case '/': out.push_back(escape); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u': {
+                    std::uint32_t code = 0;
+                    if (!parse_hex(code)) {
+                        return false;
+                    }
+                    if (code >= 0xd800 && code < 0xdc00 && text_.substr(position_, 2) == "\\u") {
+                        position_ += 2;
+                        std::uint32_t low = 0;
+                        if (!parse_hex(low)) {
+                            return false;
+                        }
+                        code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+                    }
+                    append_utf8(out, code);
+                    break;
+                }
+                default: return false;
+            }
+        }
+        return false;
+    }
+
+    bool parse_hex(std::uint32_t& code) {
+        if (position_ + 4 > text_.size()) {
+            return false;
+        }
+        auto result = std::from_chars(text_.data() + position_, text_.data() + position_ + 4, code, 16);
+        if (result.ptr != text_.data() + position_ + 4) {
+            return false;
+        }
+        position_ += 4;
+        return true;
+    }
+
+    static void append_utf8(std::string& out, std::uint32_t code) {
+        if (code < 0x80) {
+            out.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.push_back(static_cast<char>(0xc0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+        } else if (code < 0x10000) {
+            out.push_back(static_cast<char>(0xe0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+        } else {
+            out.push_back(static_cast<char>(0xf0 | (code >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+        }
+    }
+
+    std::string_view text_;
+    std::size_t position_ = 0;
+    std::string error_;
+};
+
+void append_quoted(std::string& out, const std::string& value) {
+    out.push_back('"');
+    for (char c : value) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    constexpr char hex[] = "0123456789abcdef";
+                    out += "\\u00";
+                    out.push_back(hex[(c >> 4) & 0xf]);
+                    out.push_back(hex[c & 0xf]);
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+// Environment values carry no type; anything that reads as a JSON number
+// or boolean is stored as one.
+bool is_json_literal(const std::string& value) {
+    if (value == "true" || value == "false" || value == "null") {
+        return true;
+    }
+    double number = 0.0;
+    auto result = std::from_chars(value.data(), value.data() + value.size(), number);
+    return !value.empty() && result.ec == std::errc() && result.ptr == value.data() + value.size() &&
+           value.front() != '+' && value.back() != '.';
+}
+
+}
+
+bool Config::load_file(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        log_error("Cannot open config file: {}", path);
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parse(buffer.str());
+}
+
+bool Config::parse(std::string_view text) {
+    Parser parser(text);
+    std::map<std::string, std::pair<std::string, bool>> parsed;
+    std::string error;
+    if (!parser.parse(parsed, error)) {
+        log_error("Config parse error at line {}: {}", parser.line(), error);
+        return false;
+    }
+    for (auto& [key, value] : parsed) {
+        set(key, value.first);
+        values_[key].is_string = value.second;
+    }
+    return true;
+}
+
+std::size_t Config::apply_environment(std::string_view prefix) {
+    std::size_t applied = 0;
+    for (char** entry = environ; entry && *entry; ++entry) {
+        std::string_view variable(*entry);
+        std::size_t equals = variable.find('=');
+        if (equals == std::string_view::npos || !variable.starts_with(prefix) || equals == prefix.size()) {
+            continue;
+        }
+        std::string key;
+        std::string_view name = variable.substr(prefix.size(), equals - prefix.size());
+        for (std::size_t i = 0; i < name.size(); ++i) {
+            if (name.substr(i, 2) == "__") {
+                key.push_back('.');
+                ++i;
+            } else {
+                key.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(name[i]))));
+            }
+        }
+        std::string value(variable.substr(equals + 1));
+        const bool is_string = !is_json_literal(value);
+        set(key, value);
+        values_[key].is_string = is_string;
+        log_debug("Config override from environment: {} = {}", key, value);
+        ++applied;
+    }
+    return applied;
+}
+
+std::vector<std::string> Config::keys() const {
+    std::vector<std::string> result;
+    result.reserve(values_.size());
+    for (const auto& [key, value] : values_) {
+        result.push_back(key);
+    }
+    return result;
+}
+
+std::optional<std::string> Config::get_string(const std::string& key) const {
+    auto it = values_.find(key);
+    if (it == values_.end() || it->second.text == "null") {
+        return std::nullopt;
+    }
+    return it->second.text;
+}
+
+std::optional<std::int64_t> Config::get_int(const std::string& key) const {
+    auto it = values_.find(key);
+    if (it == values_.end()) {
+        return std::nullopt;
+    }
+    const std::string& text = it->second.text;
+    std::int64_t value = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<double> Config::get_double(const std::string& key) const {
+    auto it = values_.find(key);
+    if (it == values_.end() || it->second.is_string) {
+        return std::nullopt;
+    }
+    const std::string& text = it->second.text;
+    double value = 0.0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<bool> Config::get_bool(const std::string& key) const {
+    auto it = values_.find(key);
+    if (it == values_.end()) {
+        return std::nullopt;
+    }
+    const std::string& text = it->second.text;
+    if (text == "true" || text == "1" || text == "yes" || text == "on") {
+        return true;
+    }
+    if (text == "false" || text == "0" || text == "no" || text == "off") {
+        return false;
+    }
+    return std::nullopt;
+}
+
+void Config::set(const std::string& key, const std::string& value) {
+    // A key cannot be both a value and an object: drop whichever side
+    // this assignment replaces.
+    auto child = values_.lower_bound(key + ".");
+    while (child != values_.end() && child->first.starts_with(key + ".")) {
+        child = values_.erase(child);
+    }
+    for (std::size_t dot = key.find('.'); dot != std::string::npos; dot = key.find('.', dot + 1)) {
+        values_.erase(key.substr(0, dot));
+    }
+    values_[key] = {value, true};
+}
+
+void Config::set(const std::string& key, std::int64_t value) {
+    set(key, std::to_string(value));
+    values_[key].is_string = false;
+}
+
+void Config::set(const std::string& key, double value) {
+    // Shortest text that reads back to the same double.
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    set(key, std::string(buffer, result.ptr));
+    values_[key].is_string = false;
+}
+
+void Config::set(const std::string& key, bool value) {
+    set(key, std::string(value ? "true" : "false"));
+    values_[key].is_string = false;
+}
+
+std::string Config::dump() const {
+    std::string out;
+    // Keys sharing a prefix are contiguous in the sorted map, so each
+    // object is one run of keys.
+    auto write = [&](auto&& self, auto first, auto last, std::size_t prefix, std::size_t depth) -> void {
+        out += "{";
+        bool separator = false;
+        while (first != last) {
+            const std::string& key = first->first;
+            std::size_t dot = key.find('.', prefix);
+            std::string name = key.substr(prefix, dot == std::string::npos ? std::string::npos : dot - prefix);
+            out += separator ? ",\n" : "\n";
+            separator = true;
+            out.append(2 * (depth + 1), ' ');
+            append_quoted(out, name);
+            out += ": ";
+            if (dot == std::string::npos) {
+                if (first->second.is_string) {
+                    append_quoted(out, first->second.text);
+                } else {
+                    out += first->second.text;
+                }
+                ++first;
+                continue;
+            }
+            const std::string group = key.substr(0, dot + 1);
+            auto end = first;
+            while (end != last && end->first.starts_with(group)) {
+                ++end;
+            }
+            self(self, first, end, dot + 1, depth + 1);
+            first = end;
+        }
+        if (separator) {
+            out += "\n";
+            out.append(2 * depth, ' ');
+        }
+        out += "}";
+    };
+    write(write, values_.begin(), values_.end(), 0, 0);
+    out += "\n";
+    return out;
+}
+
+}
\ No newline at end of file
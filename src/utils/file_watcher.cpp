@@ -0,0 +1,124 @@
+#include "buildify/utils/file_watcher.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <set>
+#include <unordered_map>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace buildify::utils {
+
+namespace {
+
+constexpr std::uint32_t watch_events = IN_CLOSE_WRITE | IN_MOVED_TO;
+
+}
+
+struct FileWatcher::Impl {
+    struct Directory {
+        std::string path;
+        std::set<std::string> files;
+    };
+
+    int fd = -1;
+    std::unordered_map<int, Directory> directories;
+    std::unordered_map<std::string, int> descriptors;
+};
+
+FileWatcher::FileWatcher() : impl_(std::make_unique<Impl>()) {
+    impl_->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (impl_->fd < 0) {
+        log_error("inotify_init1 failed: {}", std::strerror(errno));
+    }
+}
+
+FileWatcher::~FileWatcher() {
+    if (impl_->fd >= 0) {
+        close(impl_->fd);
+    }
+}
+
+std::string FileWatcher::normalize(const std::string& path) {
+    std::error_code error;
+    auto absolute = std::filesystem::absolute(path, error);
+    return (error ? std::filesystem::path(path) : absolute).lexically_normal().string();
+}
+
+bool FileWatcher::watch(const std::string& path) {
+    if (impl_->fd < 0) {
+        return false;
+    }
+    const std::filesystem::path file(normalize(path));
+    const auto directory = file.parent_path().string();
+
+    auto it = impl_->descriptors.find(directory);
+    if (it == impl_->descriptors.end()) {
+        const int wd = inotify_add_watch(impl_->fd, directory.c_str(), watch_events);
+        if (wd < 0) {
+            log_error("Cannot watch {}: {}", directory, std::strerror(errno));
+            return false;
+        }
+        it = impl_->descriptors.emplace(directory, wd).first;
+        impl_->directories[wd].path = directory;
+    }
+    impl_->directories[it->second].files.insert(file.filename().string());
+    return true;
+}
+
+void FileWatcher::unwatch(const std::string& path) {
+    const std::filesystem::path file(normalize(path));
+    auto it = impl_->descriptors.find(file.parent_path().string());
+    if (it == impl_->descriptors.end()) {
+        return;
+    }
+    auto& directory = impl_->directories[it->second];
+    directory.files.erase(file.filename().string());
+    if (directory.files.empty()) {
+        inotify_rm_watch(impl_->fd, it->second);
+        impl_->directories.erase(it->second);
+        impl_->descriptors.erase(it);
+    }
+}
+
+bool FileWatcher::is_watching(const std::string& path) const {
+    const std::filesystem::path file(normalize(path));
+    auto it = impl_->descriptors.find(file.parent_path().string());
+    return it != impl_->descriptors.end() &&
+           impl_->directories.at(it->second).files.contains(file.filename().string());
+}
+
+std::vector<std::string> FileWatcher::poll() {
+    std::vector<std::string> changed;
+    if (impl_->fd < 0) {
+        return changed;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        const ssize_t bytes = read(impl_->fd, buffer, sizeof(buffer));
+        if (bytes <= 0) {
+            break;
+        }
+        for (ssize_t offset = 0; offset < bytes;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            auto it = impl_->directories.find(event->wd);
+            if (it == impl_->directories.end() || event->len == 0 || !it->second.files.contains(event->name)) {
+                continue;
+            }
+            auto path = (std::filesystem::path(it->second.path) / event->name).string();
+            if (std::find(changed.begin(), changed.end(), path) == changed.end()) {
+                changed.push_back(std::move(path));
+            }
+        }
+    }
+    return changed;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "buildify/utils/huge_pages.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << 26)
+#endif
+
+namespace buildify::utils {
+
+namespace {
+
+std::atomic<HugePageMode> current_mode{HugePageMode::Transparent};
+std::atomic<std::size_t> mapped_bytes{0};
+std::atomic<std::size_t> explicit_allocations{0};
+std::atomic<std::size_t> explicit_fallbacks{0};
+
+std::size_t mapping_length(std::size_t bytes) {
+    return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+}
+
+}
+
+void set_huge_page_mode(HugePageMode mode) {
+    current_mode.store(mode, std::memory_order_relaxed);
+}
+
+HugePageMode get_huge_page_mode() {
+    return current_mode.load(std::memory_order_relaxed);
+}
+
+HugePageStats get_huge_page_stats() {
+    HugePageStats stats;
+    stats.mapped_bytes = mapped_bytes.load(std::memory_order_relaxed);
+    stats.explicit_allocations = explicit_allocations.load(std::memory_order_relaxed);
+    stats.explicit_fallbacks = explicit_fallbacks.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void* allocate_large(std::size_t bytes) {
+    const std::size_t length = mapping_length(bytes);
+    const HugePageMode mode = get_huge_page_mode();
+
+    if (mode == HugePageMode::Explicit) {
+        void* data = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+        if (data != MAP_FAILED) {
+            explicit_allocations.fetch_add(1, std::memory_order_relaxed);
+            mapped_bytes.fetch_add(length, std::memory_order_relaxed);
+            return data;
+        }
+        if (explicit_fallbacks.fetch_add(1, std::memory_order_relaxed) == 0) {
+            log_warning("No hugetlbfs pages available, using transparent huge pages");
+        }
+    }
+
+    // Transparent huge pages only back 2 MB aligned ranges, so map one
+    // page more than needed and trim the ends.
+    void* raw = mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    const auto base = reinterpret_cast<std::uintptr_t>(raw);
+    const std::uintptr_t aligned = (base + huge_page_size - 1) / huge_page_size * huge_page_size;
+    if (aligned > base) {
+        munmap(raw, aligned - base);
+    }
+    if (const std::size_t tail = base + huge_page_size - aligned; tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + length), tail);
+    }
+
+    auto* data = reinterpret_cast<void*>(aligned);
+    // Advice is best effort: kernels without THP reject it and the mapping
+    // simply stays on 4 KB pages.
+    madvise(data, length, mode == HugePageMode::Off ? MADV_NOHUGEPAGE : MADV_HUGEPAGE);
+    mapped_bytes.fetch_add(length, std::memory_order_relaxed);
+    return data;
+}
+
+void deallocate_large(void* data, std::size_t bytes) {
+    if (data == nullptr) {
+        return;
+    }
+    const std::size_t length = mapping_length(bytes);
+    munmap(data, length);
+    mapped_bytes.fetch_sub(length, std::memory_order_relaxed);
+}
+
+TlbMissCounter::~TlbMissCounter() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool TlbMissCounter::start() {
+    if (fd_ < 0) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd_ < 0) {
+            return false;
+        }
+    }
+    ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+    return ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0) == 0;
+}
+
+std::optional<std::uint64_t> TlbMissCounter::stop() {
+    if (fd_ < 0) {
+        return std::nullopt;
+    }
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    std::uint64_t misses = 0;
+    if (read(fd_, &misses, sizeof(misses)) != sizeof(misses)) {
+        return std::nullopt;
+    }
+    return misses;
+}
+
+}
\ No newline at end of file
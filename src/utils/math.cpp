@@ -1,5 +1,107 @@
 #include "buildify/utils/math.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace buildify::utils {
 
+namespace {
+
+// Every stream is a separate restrict-qualified parameter: with the nine
+// output columns carved from one buffer the compiler would need more
+// runtime alias checks than it is willing to emit, and would not vectorize.
+void to_matrices(std::size_t count, const float* __restrict qx, const float* __restrict qy,
+                 const float* __restrict qz, const float* __restrict qw, float* __restrict m00,
+                 float* __restrict m01, float* __restrict m02, float* __restrict m10, float* __restrict m11,
+                 float* __restrict m12, float* __restrict m20, float* __restrict m21, float* __restrict m22) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const float x = qx[i], y = qy[i], z = qz[i], w = qw[i];
+        // Scaling by 2 / |q|^2 folds the normalization into the products.
+        const float length2 = x * x + y * y + z * z + w * w;
+        const float s = length2 > 0.0f ? 2.0f / length2 : 0.0f;
+        const float one = length2 > 0.0f ? 1.0f : 0.0f;
+        const float xx = s * x * x, yy = s * y * y, zz = s * z * z;
+        const float xy = s * x * y, xz = s * x * z, yz = s * y * z;
+        const float xw = s * x * w, yw = s * y * w, zw = s * z * w;
+        m00[i] = one - (yy + zz);
+        m01[i] = xy - zw;
+        m02[i] = xz + yw;
+        m10[i] = xy + zw;
+        m11[i] = one - (xx + zz);
+        m12[i] = yz - xw;
+        m20[i] = xz - yw;
+        m21[i] = yz + xw;
+        m22[i] = one - (xx + yy);
+    }
+}
+
+void multiply(std::size_t count, const float* __restrict ax, const float* __restrict ay,
+              const float* __restrict az, const float* __restrict aw, const float* __restrict bx,
+              const float* __restrict by, const float* __restrict bz, const float* __restrict bw,
+              float* __restrict ox, float* __restrict oy, float* __restrict oz, float* __restrict ow) {
+    for (std::size_t i = 0; i < count; ++i) {
+        ox[i] = aw[i] * bx[i] + ax[i] * bw[i] + ay[i] * bz[i] - az[i] * by[i];
+        oy[i] = aw[i] * by[i] - ax[i] * bz[i] + ay[i] * bw[i] + az[i] * bx[i];
+        oz[i] = aw[i] * bz[i] + ax[i] * by[i] - ay[i] * bx[i] + az[i] * bw[i];
+        ow[i] = aw[i] * bw[i] - ax[i] * bx[i] - ay[i] * by[i] - az[i] * bz[i];
+    }
+}
+
+}
+
+void normalize_quaternions(QuaternionColumns<float> q) {
+    // Lengths, square roots and scaling run as separate passes over a small
+    // buffer; a sqrt inside the scaling loop keeps it from vectorizing.
+    constexpr std::size_t run = 256;
+    float scale[run];
+    const std::size_t count = q.size();
+    for (std::size_t first = 0; first < count; first += run) {
+        const std::size_t n = std::min(run, count - first);
+        float* __restrict x = q.x.data() + first;
+        float* __restrict y = q.y.data() + first;
+        float* __restrict z = q.z.data() + first;
+        float* __restrict w = q.w.data() + first;
+        for (std::size_t i = 0; i < n; ++i) {
+            scale[i] = x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + w[i] * w[i];
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            scale[i] = std::sqrt(scale[i]);
+        }
+        // A zero quaternion becomes the identity: x, y and z stay 0 and w
+        // is replaced.
+        for (std::size_t i = 0; i < n; ++i) {
+            const float inverse = scale[i] > 0.0f ? 1.0f / scale[i] : 0.0f;
+            x[i] *= inverse;
+            y[i] *= inverse;
+            z[i] *= inverse;
+            w[i] = scale[i] > 0.0f ? w[i] * inverse : 1.0f;
+        }
+    }
+}
+
+void multiply_quaternions(QuaternionColumns<const float> a, QuaternionColumns<const float> b,
+                          QuaternionColumns<float> out) {
+    // Products go through a small local buffer so out may alias a or b.
+    constexpr std::size_t run = 256;
+    float buffer[4][run];
+    const std::size_t count = out.size();
+    for (std::size_t first = 0; first < count; first += run) {
+        const std::size_t n = std::min(run, count - first);
+        multiply(n, a.x.data() + first, a.y.data() + first, a.z.data() + first, a.w.data() + first,
+                 b.x.data() + first, b.y.data() + first, b.z.data() + first, b.w.data() + first,
+                 buffer[0], buffer[1], buffer[2], buffer[3]);
+        std::copy_n(buffer[0], n, out.x.data() + first);
+        std::copy_n(buffer[1], n, out.y.data() + first);
+        std::copy_n(buffer[2], n, out.z.data() + first);
+        std::copy_n(buffer[3], n, out.w.data() + first);
+    }
+}
+
+void quaternions_to_matrices(QuaternionColumns<const float> q, std::span<float> matrices) {
+    const std::size_t count = q.size();
+    float* m = matrices.data();
+    to_matrices(count, q.x.data(), q.y.data(), q.z.data(), q.w.data(), m, m + count, m + 2 * count,
+                m + 3 * count, m + 4 * count, m + 5 * count, m + 6 * count, m + 7 * count, m + 8 * count);
+}
+
 }
\ No newline at end of file
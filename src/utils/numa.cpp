@@ -0,0 +1,202 @@
+#include "buildify/utils/numa.hpp"
+#include "buildify/utils/logger.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace buildify::utils {
+
+namespace {
+
+// Parses a sysfs CPU list such as "0-3,8,10-11".
+std::vector<std::uint32_t> parse_cpu_list(const std::string& text) {
+    std::vector<std::uint32_t> cpus;
+    std::size_t position = 0;
+    while (position < text.size()) {
+        std::size_t end = text.find(',', position);
+        std::string range = text.substr(position, end == std::string::npos ? std::string::npos : end - position);
+        position = end == std::string::npos ? text.size() : end + 1;
+        std::size_t dash = range.find('-');
+        try {
+            std::uint32_t first = static_cast<std::uint32_t>(std::stoul(range.substr(0, dash)));
+            std::uint32_t last = dash == std::string::npos
+                ? first : static_cast<std::uint32_t>(std::stoul(range.substr(dash + 1)));
+            for (std::uint32_t cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            // Blank or malformed entries (a trailing newline) are skipped.
+        }
+    }
+    return cpus;
+}
+
+std::vector<std::uint32_t> allowed_cpus() {
+    std::vector<std::uint32_t> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(static_cast<std::uint32_t>(cpu));
+            }
+        }
+    }
+    return cpus;
+}
+
+long bind_pages(void* data, std::size_t bytes, int mode, const std::vector<unsigned long>& mask) {
+    // The kernel ignores the last bit of maxnode, hence the extra one.
+    const unsigned long max_node = mask.size() * sizeof(unsigned long) * 8 + 1;
+    return syscall(SYS_mbind, data, bytes, mode, mask.data(), max_node, MPOL_MF_MOVE);
+}
+
+std::vector<unsigned long> node_mask(std::span<const NumaNode> nodes) {
+    std::uint32_t highest = 0;
+    for (const auto& node : nodes) {
+        highest = std::max(highest, node.id);
+    }
+    constexpr std::size_t bits = sizeof(unsigned long) * 8;
+    return std::vector<unsigned long>(highest / bits + 1, 0);
+}
+
+}
+
+NumaTopology NumaTopology::from_sysfs(const std::string& root, std::span<const std::uint32_t> allowed) {
+    NumaTopology topology;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(root, error)) {
+        const std::string name = entry.path().filename().string();
+        if (!name.starts_with("node") || name.size() == 4 ||
+            !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string text;
+        std::getline(file, text);
+
+        NumaNode node;
+        node.id = static_cast<std::uint32_t>(std::stoul(name.substr(4)));
+        for (std::uint32_t cpu : parse_cpu_list(text)) {
+            if (allowed.empty() || std::find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        if (!node.cpus.empty()) {
+            topology.nodes_.push_back(std::move(node));
+        }
+    }
+    std::sort(topology.nodes_.begin(), topology.nodes_.end(),
+              [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+
+    if (topology.nodes_.empty()) {
+        NumaNode node;
+        node.cpus.assign(allowed.begin(), allowed.end());
+        if (node.cpus.empty()) {
+            node.cpus.push_back(0);
+        }
+        topology.nodes_.push_back(std::move(node));
+    }
+    return topology;
+}
+
+const NumaTopology& NumaTopology::system() {
+    static const NumaTopology topology = [] {
+        auto cpus = allowed_cpus();
+        auto result = from_sysfs("/sys/devices/system/node", cpus);
+        if (result.is_numa()) {
+            log_info("NUMA topology: {} nodes", result.node_count());
+        }
+        return result;
+    }();
+    return topology;
+}
+
+std::size_t NumaTopology::node_of_cpu(std::uint32_t cpu) const {
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        if (std::find(nodes_[i].cpus.begin(), nodes_[i].cpus.end(), cpu) != nodes_[i].cpus.end()) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+std::size_t current_numa_node() {
+    const auto& topology = NumaTopology::system();
+    if (!topology.is_numa()) {
+        return 0;
+    }
+    int cpu = sched_getcpu();
+    return cpu < 0 ? 0 : topology.node_of_cpu(static_cast<std::uint32_t>(cpu));
+}
+
+std::size_t partition_begin(std::size_t count, std::size_t part, std::span<const std::size_t> weights) {
+    const std::size_t total = std::accumulate(weights.begin(), weights.end(), std::size_t{0});
+    if (part == 0) {
+        return 0;
+    }
+    if (total == 0 || part >= weights.size()) {
+        return count;
+    }
+    const std::size_t before = std::accumulate(weights.begin(), weights.begin() + part, std::size_t{0});
+    // count * before / total without the product: count can be a byte
+    // count, and weights are small.
+    return (count / total) * before + (count % total) * before / total;
+}
+
+bool place_memory(void* data, std::size_t bytes, MemoryPlacement placement, std::span<const std::size_t> weights) {
+    const auto& topology = NumaTopology::system();
+    if (placement == MemoryPlacement::Default || !topology.is_numa() || data == nullptr) {
+        return true;
+    }
+
+    // mbind works on whole pages; the partial pages at either end keep
+    // their placement.
+    const auto page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto address = reinterpret_cast<std::uintptr_t>(data);
+    const std::uintptr_t first = (address + page - 1) / page * page;
+    const std::uintptr_t last = (address + bytes) / page * page;
+    if (last <= first) {
+        return true;
+    }
+    const std::size_t pages = (last - first) / page;
+
+    auto mask = node_mask(topology.nodes());
+    constexpr std::size_t bits = sizeof(unsigned long) * 8;
+    if (placement == MemoryPlacement::Interleave) {
+        for (const auto& node : topology.nodes()) {
+            mask[node.id / bits] |= 1ul << (node.id % bits);
+        }
+        return bind_pages(reinterpret_cast<void*>(first), last - first, MPOL_INTERLEAVE, mask) == 0;
+    }
+
+    std::vector<std::size_t> equal(topology.node_count(), 1);
+    if (weights.size() != topology.node_count()) {
+        weights = equal;
+    }
+    bool placed = true;
+    for (std::size_t part = 0; part < topology.node_count(); ++part) {
+        const std::size_t begin = partition_begin(pages, part, weights);
+        const std::size_t end = partition_begin(pages, part + 1, weights);
+        if (end <= begin) {
+            continue;
+        }
+        std::fill(mask.begin(), mask.end(), 0);
+        const std::uint32_t id = topology.nodes()[part].id;
+        mask[id / bits] |= 1ul << (id % bits);
+        // Preferred rather than bound, so a full node spills over instead
+        // of failing the allocation.
+        placed &= bind_pages(reinterpret_cast<void*>(first + begin * page), (end - begin) * page,
+                             MPOL_PREFERRED, mask) == 0;
+    }
+    return placed;
+}
+
+}
\ No newline at end of file
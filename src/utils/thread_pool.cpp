@@ -0,0 +1,234 @@
+#include "buildify/utils/thread_pool.hpp"
+#include "buildify/utils/numa.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace buildify::utils {
+
+namespace {
+
+struct ParallelForState {
+    struct Part {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        std::size_t chunk_count = 0;
+        std::atomic<std::size_t> next_chunk{0};
+    };
+
+    explicit ParallelForState(std::size_t part_count)
+        : parts(std::make_unique<Part[]>(part_count)), part_count(part_count) {}
+
+    std::unique_ptr<Part[]> parts;
+    std::size_t part_count;
+    std::size_t chunk_count = 0;
+    std::atomic<std::size_t> finished_chunks{0};
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+// Node index of a pool worker; unset on other threads.
+thread_local std::size_t worker_node = static_cast<std::size_t>(-1);
+
+}
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+    start(thread_count, false);
+}
+
+ThreadPool::~ThreadPool() {
+    stop();
+}
+
+bool ThreadPool::resize(std::size_t thread_count, bool pin) {
+    {
+        std::lock_guard lock(mutex_);
+        if (used_) {
+            return false;
+        }
+    }
+    stop();
+    start(thread_count, pin);
+    return true;
+}
+
+void ThreadPool::start(std::size_t thread_count, bool pin) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Thread slot s runs on slots[s]; slot 0 is the calling thread. Each
+    // node gets a share of the slots proportional to its CPU count, so a
+    // pinned pool covers every socket instead of filling the first one.
+    const auto& topology = NumaTopology::system();
+    const std::size_t node_count = pin ? topology.node_count() : 1;
+    std::vector<std::size_t> cpu_counts;
+    for (const auto& node : topology.nodes()) {
+        cpu_counts.push_back(node.cpus.size());
+    }
+    std::vector<std::uint32_t> slots;
+    std::vector<std::size_t> slot_nodes;
+    node_threads_.assign(node_count, 0);
+    for (std::size_t node = 0; node < node_count; ++node) {
+        const auto& cpus = topology.nodes()[node].cpus;
+        const std::size_t first = node_count == 1 ? 0 : partition_begin(thread_count, node, cpu_counts);
+        const std::size_t last = node_count == 1 ? thread_count : partition_begin(thread_count, node + 1, cpu_counts);
+        for (std::size_t i = 0; i < last - first; ++i) {
+            slots.push_back(cpus[i % cpus.size()]);
+            slot_nodes.push_back(node);
+        }
+        node_threads_[node] = last - first;
+    }
+
+    // The caller always participates in parallel_for, so one fewer worker
+    // keeps exactly thread_count threads busy.
+    stopping_ = false;
+    pinned_ = false;
+    workers_.reserve(thread_count - 1);
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        workers_.emplace_back([this, node = slot_nodes[i]]() { worker_loop(node); });
+    }
+
+    if (pin) {
+        pinned_ = true;
+        for (std::size_t i = 0; i < workers_.size() && pinned_; ++i) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(slots[i + 1], &set);
+            pinned_ = pthread_setaffinity_np(workers_[i].native_handle(), sizeof(set), &set) == 0;
+        }
+    }
+    if (!pinned_) {
+        // Unpinned threads migrate freely, so node ownership means nothing.
+        node_threads_.assign(1, thread_count);
+    }
+}
+
+void ThreadPool::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    if (workers_.empty()) {
+        task();
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        used_ = true;
+        tasks_.push_back(std::move(task));
+    }
+    condition_.notify_one();
+}
+
+void ThreadPool::worker_loop(std::size_t node) {
+    worker_node = node;
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex_);
+            condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (stopping_ && tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallel_for(std::size_t begin, std::size_t end,
+                              const std::function<void(std::size_t, std::size_t)>& body,
+                              std::size_t grain) {
+    const std::size_t single = 1;
+    run_parts(begin, end, body, grain, std::span(&single, 1));
+}
+
+void ThreadPool::parallel_for_partitioned(std::size_t begin, std::size_t end,
+                                          const std::function<void(std::size_t, std::size_t)>& body,
+                                          std::size_t grain) {
+    run_parts(begin, end, body, grain, node_threads_);
+}
+
+void ThreadPool::run_parts(std::size_t begin, std::size_t end,
+                           const std::function<void(std::size_t, std::size_t)>& body,
+                           std::size_t grain, std::span<const std::size_t> weights) {
+    if (end <= begin) {
+        return;
+    }
+
+    grain = std::max<std::size_t>(grain, 1);
+    auto state = std::make_shared<ParallelForState>(weights.size());
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        auto& part = state->parts[i];
+        part.begin = begin + partition_begin(end - begin, i, weights);
+        part.end = begin + partition_begin(end - begin, i + 1, weights);
+        part.chunk_count = (part.end - part.begin + grain - 1) / grain;
+        state->chunk_count += part.chunk_count;
+    }
+    const std::size_t chunk_count = state->chunk_count;
+
+    if (chunk_count == 1 || workers_.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    // Helpers that start after every chunk has been claimed return without
+    // touching `body`, which may no longer be alive at that point.
+    auto drain = [state, grain, chunk_count, &body]() {
+        std::size_t home = 0;
+        if (state->part_count > 1) {
+            home = worker_node != static_cast<std::size_t>(-1) ? worker_node : current_numa_node();
+            home %= state->part_count;
+        }
+        for (std::size_t offset = 0; offset < state->part_count; ++offset) {
+            auto& part = state->parts[(home + offset) % state->part_count];
+            for (;;) {
+                std::size_t chunk = part.next_chunk.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= part.chunk_count) {
+                    break;
+                }
+
+                std::size_t chunk_begin = part.begin + chunk * grain;
+                std::size_t chunk_end = std::min(part.end, chunk_begin + grain);
+                body(chunk_begin, chunk_end);
+
+                if (state->finished_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == chunk_count) {
+                    std::lock_guard lock(state->mutex);
+                    state->done.notify_all();
+                }
+            }
+        }
+    };
+
+    std::size_t helpers = std::min(workers_.size(), chunk_count - 1);
+    for (std::size_t i = 0; i < helpers; ++i) {
+        enqueue(drain);
+    }
+
+    drain();
+
+    std::unique_lock lock(state->mutex);
+    state->done.wait(lock, [&]() {
+        return state->finished_chunks.load(std::memory_order_acquire) == chunk_count;
+    });
+}
+
+}
\ No newline at end of file
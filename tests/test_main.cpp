@@ -1,5 +1,15 @@
 #include <gtest/gtest.h>
 #include <buildify/buildify.h>
+#include <buildify/buildify.hpp>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 // Test context initialization
 TEST(BuildifyTest, ContextInitialization) {
@@ -54,6 +64,1627 @@ TEST(BuildifyTest, MultipleGaussians) {
     ASSERT_EQ(scene->getGaussianCount(), 100);
 }
 
+namespace {
+
+std::shared_ptr<buildify::core::Camera> make_test_camera(buildify::core::Scene& scene) {
+    auto camera = scene.create_entity<buildify::core::Camera>("TestCamera");
+    camera->set_perspective(60.0f, 1.0f, 0.1f, 100.0f);
+    scene.set_active_camera(camera);
+    return camera;
+}
+
+}
+
+// Test tile renderer output for a single splat
+TEST(TileRendererTest, RendersSingleSplat) {
+    buildify::core::Scene scene("TileScene");
+    make_test_camera(scene);
+    scene.get_gaussians().add({0.0f, 0.0f, -5.0f}, {0.5f, 0.5f, 0.5f}, {}, 0.9f, {1.0f, 0.0f, 0.0f});
+
+    buildify::core::TileRenderer renderer;
+    ASSERT_TRUE(renderer.initialize({64, 64}));
+    renderer.clear({0.0f, 0.0f, 0.0f, 1.0f});
+    renderer.render_scene(scene);
+
+    auto color = renderer.get_color_buffer();
+    auto depth = renderer.get_depth_buffer();
+    std::size_t center = 32 * 64 + 32;
+    EXPECT_GT(color[center * 4 + 0], 0.5f);
+    EXPECT_LT(color[center * 4 + 1], 0.1f);
+    EXPECT_NEAR(depth[center], 5.0f, 0.1f);
+    EXPECT_FLOAT_EQ(color[0], 0.0f);
+    EXPECT_EQ(renderer.get_frame_stats().visible_splats, 1u);
+}
+
+// Test temporal cache reuse for a static camera
+TEST(TileRendererTest, TemporalCacheReusesStaticFrame) {
+    buildify::core::Scene scene("CacheScene");
+    make_test_camera(scene);
+    for (int i = 0; i < 50; ++i) {
+        scene.get_gaussians().add({i * 0.1f - 2.5f, (i % 7) * 0.2f - 0.6f, -6.0f - (i % 5)},
+                                  {0.2f, 0.3f, 0.2f}, {}, 0.8f, {0.2f, 0.5f, 0.9f});
+    }
+
+    buildify::core::TileRenderer renderer;
+    ASSERT_TRUE(renderer.initialize({96, 64}));
+    renderer.set_temporal_cache({.enabled = true});
+
+    renderer.render_scene(scene);
+    std::vector<float> first(renderer.get_color_buffer().begin(), renderer.get_color_buffer().end());
+    EXPECT_EQ(renderer.get_frame_stats().tiles_reused, 0u);
+
+    renderer.render_scene(scene);
+    const auto& stats = renderer.get_frame_stats();
+    EXPECT_EQ(stats.tiles_reused, stats.tile_count);
+
+    auto second = renderer.get_color_buffer();
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        ASSERT_FLOAT_EQ(first[i], second[i]);
+    }
+}
+
+// Test variable-rate shading keeps the fovea at full quality
+TEST(TileRendererTest, VariableRateShadesFewerSamples) {
+    buildify::core::Scene scene("RateScene");
+    make_test_camera(scene);
+    for (int i = 0; i < 200; ++i) {
+        scene.get_gaussians().add({(i % 20) * 0.3f - 3.0f, (i / 20) * 0.3f - 1.5f, -5.0f},
+                                  {0.15f, 0.15f, 0.15f}, {}, 0.9f, {0.8f, 0.4f, 0.1f});
+    }
+
+    buildify::core::TileRenderer full;
+    ASSERT_TRUE(full.initialize({128, 128}));
+    full.render_scene(scene);
+
+    buildify::core::RenderTarget target{128, 128};
+    target.variable_rate.enabled = true;
+    target.variable_rate.inner_radius = 0.1f;
+    target.variable_rate.outer_radius = 0.3f;
+    buildify::core::TileRenderer foveated;
+    ASSERT_TRUE(foveated.initialize(target));
+    foveated.render_scene(scene);
+
+    const auto& full_stats = full.get_frame_stats();
+    const auto& foveated_stats = foveated.get_frame_stats();
+    EXPECT_EQ(full_stats.pixels_shaded, 128u * 128u);
+    EXPECT_LT(foveated_stats.pixels_shaded, full_stats.pixels_shaded / 2);
+    EXPECT_GT(foveated_stats.tiles_reduced_rate, 0u);
+
+    std::size_t center = (64 * 128 + 64) * 4;
+    for (int c = 0; c < 4; ++c) {
+        EXPECT_FLOAT_EQ(full.get_color_buffer()[center + c], foveated.get_color_buffer()[center + c]);
+    }
+}
+
+// Test progressive refinement converges to the full-quality frame
+TEST(TileRendererTest, ProgressiveRefinementConverges) {
+    buildify::core::Scene scene("ProgressiveScene");
+    make_test_camera(scene);
+    for (int i = 0; i < 100; ++i) {
+        scene.get_gaussians().add({(i % 10) * 0.4f - 2.0f, (i / 10) * 0.4f - 2.0f, -6.0f},
+                                  {0.2f, 0.2f, 0.2f}, {}, 0.7f, {0.3f, 0.9f, 0.3f});
+    }
+
+    buildify::core::TileRenderer reference;
+    ASSERT_TRUE(reference.initialize({64, 64}));
+    reference.render_scene(scene);
+
+    buildify::core::TileRenderer progressive;
+    ASSERT_TRUE(progressive.initialize({64, 64}));
+    // A budget below one tile shades only the first few, at quarter rate.
+    EXPECT_FALSE(progressive.render_scene_progressive(scene, std::chrono::microseconds(1)));
+    const auto& first = progressive.get_frame_stats();
+    EXPECT_GE(first.tiles_rendered, 1u);
+    EXPECT_LT(first.tiles_rendered, first.tile_count);
+    EXPECT_EQ(first.pixels_shaded, first.tiles_rendered * 4u * 4u);
+
+    int frames = 1;
+    while (!progressive.render_scene_progressive(scene, std::chrono::microseconds(1))) {
+        ASSERT_LT(++frames, 100);
+    }
+
+    auto expected = reference.get_color_buffer();
+    auto actual = progressive.get_color_buffer();
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_FLOAT_EQ(expected[i], actual[i]);
+    }
+
+    // Clearing restarts refinement from the coarsest level.
+    progressive.clear({0.0f, 0.0f, 0.0f, 1.0f});
+    EXPECT_FALSE(progressive.render_scene_progressive(scene, std::chrono::microseconds(1)));
+    EXPECT_EQ(progressive.get_frame_stats().pixels_shaded, progressive.get_frame_stats().tiles_rendered * 4u * 4u);
+
+    // With room for it, one call covers the image coarsely and refines.
+    progressive.clear({0.0f, 0.0f, 0.0f, 1.0f});
+    EXPECT_TRUE(progressive.render_scene_progressive(scene, std::chrono::seconds(10)));
+    EXPECT_EQ(progressive.get_frame_stats().pixels_shaded, 16u * 16u + 64u * 64u);
+}
+
+// Test batched multi-view rendering against per-view renders
+TEST(TileRendererTest, BatchedViewsMatchSingleRenders) {
+    buildify::core::Scene scene("BatchScene");
+    auto camera = make_test_camera(scene);
+    for (int i = 0; i < 50; ++i) {
+        scene.get_gaussians().add({(i % 10) * 0.4f - 2.0f, (i / 10) * 0.4f - 1.0f, -6.0f},
+                                  {0.2f, 0.2f, 0.2f}, {}, 0.8f, {0.9f, 0.4f, 0.1f});
+    }
+
+    std::vector<buildify::core::Camera> cameras(2, *camera);
+    cameras[1].get_transform().position = {0.5f, 0.0f, 0.0f};
+
+    buildify::core::TileRenderer renderer;
+    ASSERT_TRUE(renderer.initialize({32, 32}));
+    const std::size_t pixels = 32 * 32;
+    std::vector<float> color(cameras.size() * pixels * 4);
+    std::vector<float> depth(cameras.size() * pixels);
+    renderer.render_views(scene, cameras, color, depth);
+    EXPECT_EQ(renderer.get_frame_stats().tile_count, 2u * 2u * 2u);
+
+    for (std::size_t v = 0; v < cameras.size(); ++v) {
+        *camera = cameras[v];
+        renderer.render_scene(scene);
+        auto expected_color = renderer.get_color_buffer();
+        auto expected_depth = renderer.get_depth_buffer();
+        for (std::size_t i = 0; i < pixels * 4; ++i) {
+            ASSERT_FLOAT_EQ(expected_color[i], color[v * pixels * 4 + i]);
+        }
+        for (std::size_t i = 0; i < pixels; ++i) {
+            ASSERT_FLOAT_EQ(expected_depth[i], depth[v * pixels + i]);
+        }
+    }
+}
+
+// Test auxiliary channels produced alongside color
+TEST(TileRendererTest, AuxChannelsMatchColorPass) {
+    buildify::core::Scene scene("AuxScene");
+    make_test_camera(scene);
+    scene.get_gaussians().add({0.0f, 0.0f, -5.0f}, {0.6f, 0.6f, 0.05f}, {}, 0.9f, {0.2f, 0.6f, 1.0f});
+
+    buildify::core::TileRenderer plain;
+    ASSERT_TRUE(plain.initialize({32, 32}));
+    plain.render_scene(scene);
+    EXPECT_TRUE(plain.get_alpha_buffer().empty());
+    EXPECT_TRUE(plain.get_normal_buffer().empty());
+
+    using buildify::core::AuxChannel;
+    buildify::core::TileRenderer renderer;
+    ASSERT_TRUE(renderer.initialize({32, 32}));
+    renderer.set_aux_channels(AuxChannel::Alpha | AuxChannel::MedianDepth | AuxChannel::Normal);
+    renderer.render_scene(scene);
+
+    auto expected = plain.get_color_buffer();
+    auto color = renderer.get_color_buffer();
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_FLOAT_EQ(expected[i], color[i]);
+    }
+
+    std::size_t center = 16 * 32 + 16;
+    auto alpha = renderer.get_alpha_buffer();
+    auto median = renderer.get_median_depth_buffer();
+    auto normal = renderer.get_normal_buffer();
+    ASSERT_EQ(normal.size(), 32u * 32u * 3u);
+    EXPECT_NEAR(alpha[center], 0.9f, 0.05f);
+    EXPECT_NEAR(median[center], 5.0f, 1e-3f);
+    EXPECT_NEAR(normal[center * 3 + 2], 1.0f, 1e-3f);
+    EXPECT_FLOAT_EQ(alpha[0], 0.0f);
+    EXPECT_FLOAT_EQ(median[0], 0.0f);
+}
+
+// Test Mip-Splatting 3D and 2D filters
+TEST(TileRendererTest, MipFiltersAttenuateSubpixelSplats) {
+    buildify::core::Scene scene("MipScene");
+    auto camera = make_test_camera(scene);
+    auto& cloud = scene.get_gaussians();
+    cloud.add({0.0f, 0.0f, -5.0f}, {0.05f, 0.05f, 0.05f}, {}, 0.9f, {1.0f, 1.0f, 1.0f});
+    EXPECT_FALSE(cloud.has_filter_3d());
+
+    std::vector<buildify::core::Camera> training(1, *camera);
+    cloud.compute_filter_3d(training, 32, 32);
+    ASSERT_TRUE(cloud.has_filter_3d());
+    float focal = 0.5f * 32.0f * camera->get_projection_matrix().m[0][0];
+    EXPECT_NEAR(cloud.filter_3d()[0], std::sqrt(0.2f) * 5.0f / focal, 1e-5f);
+
+    std::size_t center = 16 * 32 + 16;
+    buildify::core::TileRenderer renderer;
+    ASSERT_TRUE(renderer.initialize({32, 32}));
+    renderer.set_aux_channels(buildify::core::AuxChannel::Alpha);
+
+    renderer.set_anti_aliasing({false, false, 0.1f});
+    renderer.render_scene(scene);
+    float unfiltered = renderer.get_alpha_buffer()[center];
+
+    renderer.set_anti_aliasing({true, false, 0.1f});
+    renderer.render_scene(scene);
+    float filtered_3d = renderer.get_alpha_buffer()[center];
+
+    renderer.set_anti_aliasing({true, true, 0.1f});
+    renderer.render_scene(scene);
+    float filtered_both = renderer.get_alpha_buffer()[center];
+
+    EXPECT_GT(unfiltered, 0.4f);
+    EXPECT_LT(filtered_3d, 0.5f * unfiltered);
+    EXPECT_LT(filtered_both, filtered_3d);
+    EXPECT_GT(filtered_both, 0.0f);
+}
+
+// Test ray queries against the Gaussian BVH
+TEST(GaussianBVHTest, CastRaysReturnsNearestHitsInOrder) {
+    buildify::core::Scene scene("RayScene");
+    auto& cloud = scene.get_gaussians();
+    for (int i = 0; i < 5; ++i) {
+        cloud.add({0.0f, 0.0f, -2.0f - 2.0f * i}, {0.3f, 0.3f, 0.3f}, {}, 0.5f, {1.0f, 1.0f, 1.0f});
+    }
+    cloud.add({5.0f, 0.0f, -3.0f}, {0.3f, 0.3f, 0.3f}, {}, 0.9f, {1.0f, 1.0f, 1.0f});
+
+    const auto& bvh = scene.get_gaussian_bvh();
+    ASSERT_EQ(bvh.size(), 6u);
+
+    std::vector<buildify::core::Ray> rays(3);
+    rays[0].direction = {0.0f, 0.0f, -1.0f};
+    rays[1].origin = {5.0f, 0.0f, 0.0f};
+    rays[1].direction = {0.0f, 0.0f, -1.0f};
+    rays[2].direction = {0.0f, 1.0f, 0.0f};
+
+    auto result = bvh.cast_rays(rays, 3);
+    auto hits = result.hits_for(0);
+    ASSERT_EQ(hits.size(), 3u);
+    for (std::uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(hits[i].index, i);
+        EXPECT_NEAR(hits[i].t, 2.0f + 2.0f * i, 1e-4f);
+        EXPECT_NEAR(hits[i].alpha, 0.5f, 1e-4f);
+    }
+    EXPECT_NEAR(hits[1].transmittance, 0.5f, 1e-4f);
+    EXPECT_NEAR(result.transmittance[0], 0.125f, 1e-4f);
+
+    ASSERT_EQ(result.hits_for(1).size(), 1u);
+    EXPECT_EQ(result.hits_for(1)[0].index, 5u);
+    EXPECT_TRUE(result.hits_for(2).empty());
+
+    EXPECT_TRUE(bvh.occluded(rays[0], 0.1f));
+    EXPECT_FALSE(bvh.occluded(rays[0], 0.01f));
+    EXPECT_FALSE(bvh.occluded(rays[2]));
+
+    cloud.add({0.0f, 3.0f, 0.0f}, {0.3f, 0.3f, 0.3f}, {}, 0.9f, {1.0f, 1.0f, 1.0f});
+    EXPECT_TRUE(scene.get_gaussian_bvh().occluded(rays[2]));
+}
+
+// Test packet traversal against brute force on a random cloud
+TEST(GaussianBVHTest, MatchesBruteForce) {
+    buildify::core::GaussianCloud cloud;
+    std::uint32_t seed = 12345;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+    for (int i = 0; i < 2000; ++i) {
+        buildify::utils::Quaternionf rotation(next() - 0.5f, next() - 0.5f, next() - 0.5f, next() - 0.5f);
+        cloud.add({next() * 10.0f - 5.0f, next() * 10.0f - 5.0f, next() * 10.0f - 5.0f},
+                  {0.05f + 0.2f * next(), 0.05f + 0.2f * next(), 0.05f + 0.2f * next()},
+                  rotation, 0.1f + 0.8f * next(), {1.0f, 1.0f, 1.0f});
+    }
+
+    buildify::core::GaussianBVH bvh;
+    bvh.build(cloud);
+
+    std::vector<buildify::core::Ray> rays(37);
+    for (auto& ray : rays) {
+        ray.origin = {next() * 2.0f - 1.0f, next() * 2.0f - 1.0f, 8.0f};
+        ray.direction = buildify::utils::Vector3f(next() - 0.5f, next() - 0.5f, -1.0f).normalized();
+    }
+
+    const std::uint32_t max_hits = 4;
+    auto result = bvh.cast_rays(rays, max_hits);
+    auto all = bvh.cast_rays(rays, 2000);
+
+    for (std::size_t r = 0; r < rays.size(); ++r) {
+        auto everything = all.hits_for(r);
+        auto nearest = result.hits_for(r);
+        ASSERT_EQ(nearest.size(), std::min<std::size_t>(max_hits, everything.size()));
+        for (std::size_t i = 0; i < nearest.size(); ++i) {
+            EXPECT_EQ(nearest[i].index, everything[i].index);
+            EXPECT_FLOAT_EQ(nearest[i].transmittance, everything[i].transmittance);
+        }
+
+        // Brute-force count of splats whose 3-sigma ellipsoid the ray crosses.
+        std::size_t expected = 0;
+        for (std::size_t i = 0; i < cloud.size(); ++i) {
+            buildify::core::GaussianCloud single;
+            single.add(cloud.get_position(i),
+                       {cloud.column(buildify::core::GaussianAttribute::ScaleX)[i],
+                        cloud.column(buildify::core::GaussianAttribute::ScaleY)[i],
+                        cloud.column(buildify::core::GaussianAttribute::ScaleZ)[i]},
+                       {cloud.column(buildify::core::GaussianAttribute::RotationX)[i],
+                        cloud.column(buildify::core::GaussianAttribute::RotationY)[i],
+                        cloud.column(buildify::core::GaussianAttribute::RotationZ)[i],
+                        cloud.column(buildify::core::GaussianAttribute::RotationW)[i]},
+                       cloud.column(buildify::core::GaussianAttribute::Opacity)[i], {1.0f, 1.0f, 1.0f});
+            buildify::core::GaussianBVH one;
+            one.build(single);
+            expected += one.cast_rays(std::span(&rays[r], 1), 1).hit_counts[0];
+        }
+        EXPECT_EQ(everything.size(), expected);
+    }
+}
+
+// Test refitting after splats move
+TEST(GaussianBVHTest, RefitTracksMovedSplats) {
+    buildify::core::Scene scene("RefitScene");
+    auto& cloud = scene.get_gaussians();
+    for (int i = 0; i < 100; ++i) {
+        cloud.add({(i % 10) * 1.0f, (i / 10) * 1.0f, -5.0f}, {0.1f, 0.1f, 0.1f}, {}, 0.9f, {1.0f, 1.0f, 1.0f});
+    }
+    std::size_t nodes = scene.get_gaussian_bvh().node_count();
+
+    buildify::core::Ray ray;
+    ray.origin = {20.0f, 0.0f, 0.0f};
+    ray.direction = {0.0f, 0.0f, -1.0f};
+    EXPECT_FALSE(scene.get_gaussian_bvh().occluded(ray));
+
+    auto x = cloud.column(buildify::core::GaussianAttribute::PositionX);
+    x[37] = 20.0f;
+    cloud.column(buildify::core::GaussianAttribute::PositionY)[37] = 0.0f;
+
+    const auto& bvh = scene.refit_gaussian_bvh();
+    EXPECT_EQ(bvh.node_count(), nodes);
+    auto result = bvh.cast_rays(std::span(&ray, 1), 4);
+    ASSERT_EQ(result.hit_counts[0], 1u);
+    EXPECT_EQ(result.hits[0].index, 37u);
+    EXPECT_NEAR(result.hits[0].t, 5.0f, 1e-4f);
+}
+
+// Test playing back a streamed deformation
+TEST(GaussianAnimationTest, StreamedKeyframesInterpolate) {
+    using buildify::core::DeformationChannel;
+    using buildify::core::GaussianAttribute;
+    constexpr std::size_t splats = 37;
+    constexpr std::uint32_t frames = 20;
+    auto path = (std::filesystem::temp_directory_path() / "buildify_animation_test.b4dg").string();
+
+    {
+        buildify::core::DeformationStreamWriter writer;
+        ASSERT_TRUE(writer.open(path, splats, 10.0f,
+                                DeformationChannel::Position | DeformationChannel::Rotation | DeformationChannel::Scale, 4));
+        std::vector<float> dx(splats), zero(splats, 0.0f), one(splats, 1.0f), qz(splats), qw(splats), grow(splats);
+        for (std::uint32_t f = 0; f < frames; ++f) {
+            for (std::size_t i = 0; i < splats; ++i) {
+                dx[i] = 0.1f * f + 0.01f * i;
+                float angle = 0.05f * f;
+                qz[i] = std::sin(angle * 0.5f);
+                qw[i] = std::cos(angle * 0.5f);
+                grow[i] = 1.0f + 0.02f * f;
+            }
+            buildify::core::DeformationFrame frame{{dx, zero, zero}, {zero, zero, qz, qw}, {grow, one, one}};
+            ASSERT_TRUE(writer.append_frame(frame));
+        }
+        ASSERT_TRUE(writer.close());
+    }
+
+    buildify::core::Scene scene("AnimatedScene");
+    auto& cloud = scene.get_gaussians();
+    for (std::size_t i = 0; i < splats; ++i) {
+        cloud.add({static_cast<float>(i), 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}, {}, 1.0f, {1.0f, 1.0f, 1.0f});
+    }
+
+    auto animation = std::make_shared<buildify::core::GaussianAnimation>();
+    ASSERT_TRUE(animation->open(path));
+    EXPECT_EQ(animation->get_frame_count(), frames);
+    EXPECT_NEAR(animation->get_duration(), 1.9, 1e-6);
+    animation->set_max_resident_blocks(2);
+    animation->set_looping(false);
+    ASSERT_TRUE(scene.set_gaussian_animation(animation));
+
+    // 0.75 s is halfway between frames 7 and 8.
+    scene.update(0.75);
+    for (std::size_t i = 0; i < splats; ++i) {
+        EXPECT_NEAR(cloud.column(GaussianAttribute::PositionX)[i], i + 0.75f + 0.01f * i, 1e-4f);
+        EXPECT_NEAR(cloud.column(GaussianAttribute::ScaleX)[i], 0.5f * 1.15f, 1e-4f);
+        EXPECT_NEAR(cloud.column(GaussianAttribute::RotationZ)[i], std::sin(0.05f * 7.5f * 0.5f), 1e-3f);
+        EXPECT_NEAR(cloud.column(GaussianAttribute::RotationW)[i], std::cos(0.05f * 7.5f * 0.5f), 1e-3f);
+    }
+
+    // Play through to the end one frame at a time; playback clamps there.
+    for (int step = 0; step < 30; ++step) {
+        scene.update(0.1);
+    }
+    EXPECT_NEAR(animation->get_time(), 1.9, 1e-9);
+    EXPECT_NEAR(cloud.column(GaussianAttribute::PositionX)[0], 1.9f, 1e-4f);
+    auto stats = animation->get_stats();
+    EXPECT_GE(stats.blocks_loaded, 4u);
+    EXPECT_LE(stats.resident_bytes, 2 * 4 * (10 * 8 + 10 * 40 * 2));
+
+    // Hot reloading the scene file swaps the deformed splats for a new rest
+    // pose; the animation deforms that one from then on.
+    auto scene_path = (std::filesystem::temp_directory_path() / "buildify_animation_test.bgs").string();
+    buildify::core::GaussianCloud rest;
+    for (std::size_t i = 0; i < splats; ++i) {
+        rest.add({static_cast<float>(i), 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}, {}, 1.0f, {1.0f, 1.0f, 1.0f});
+    }
+    ASSERT_TRUE(buildify::core::save_gaussians(scene_path, rest));
+    ASSERT_TRUE(scene.load_from_file(scene_path));
+    for (std::size_t i = 0; i < splats; ++i) {
+        rest.column(GaussianAttribute::PositionY)[i] = 2.0f;
+    }
+    ASSERT_TRUE(buildify::core::save_gaussians(scene_path, rest));
+    buildify::core::GaussianReloadStats reload;
+    ASSERT_TRUE(scene.reload_from_file(reload));
+    EXPECT_TRUE(reload.positions_changed);
+    scene.update(0.0);
+    EXPECT_NEAR(cloud.column(GaussianAttribute::PositionX)[3], 3.0f + 1.9f + 0.03f, 1e-4f);
+    EXPECT_EQ(cloud.column(GaussianAttribute::PositionY)[3], 2.0f);
+
+    animation->close();
+    std::filesystem::remove(path);
+    std::filesystem::remove(scene_path);
+}
+
+// Test fusing a flat depth map and meshing it
+TEST(TsdfVolumeTest, FusesPlaneIntoOutwardFacingMesh) {
+    buildify::core::Scene scene("TsdfScene");
+    auto camera = make_test_camera(scene);
+    constexpr std::uint32_t size = 64;
+    std::vector<float> depth(size * size, 2.0f);
+    std::vector<float> color(size * size * 4);
+    for (std::size_t i = 0; i < depth.size(); ++i) {
+        color[i * 4 + 0] = 0.5f;
+        color[i * 4 + 1] = 0.25f;
+        color[i * 4 + 2] = 1.0f;
+        color[i * 4 + 3] = 1.0f;
+    }
+
+    buildify::core::TsdfSettings settings;
+    settings.voxel_size = 0.05f;
+    buildify::core::TsdfVolume volume(settings);
+    volume.integrate(*camera, size, size, depth, color);
+    EXPECT_GT(volume.block_count(), 0u);
+
+    auto mesh = volume.extract_mesh();
+    ASSERT_FALSE(mesh.empty());
+    ASSERT_EQ(mesh.normals.size(), mesh.vertices.size());
+    for (std::size_t i = 0; i < mesh.vertex_count(); ++i) {
+        EXPECT_NEAR(mesh.vertices[i].z, -2.0f, 0.5f * settings.voxel_size);
+        EXPECT_GT(mesh.normals[i].z, 0.9f);
+        EXPECT_NEAR(mesh.colors[i].y, 0.25f, 1e-4f);
+    }
+
+    auto path = (std::filesystem::temp_directory_path() / "buildify_tsdf_test.ply").string();
+    ASSERT_TRUE(mesh.save(path));
+    EXPECT_GT(std::filesystem::file_size(path), mesh.vertex_count() * 27);
+    std::filesystem::remove(path);
+}
+
+// Test meshing a rendered wall of splats
+TEST(TsdfVolumeTest, ExtractsGaussianSurface) {
+    buildify::core::Scene scene("GaussianMeshScene");
+    auto& cloud = scene.get_gaussians();
+    for (int y = -30; y <= 30; ++y) {
+        for (int x = -30; x <= 30; ++x) {
+            cloud.add({x * 0.05f, y * 0.05f, -3.0f}, {0.05f, 0.05f, 0.005f}, {}, 0.95f, {1.0f, 1.0f, 1.0f});
+        }
+    }
+    auto camera = make_test_camera(scene);
+    std::vector<buildify::core::Camera> cameras = {*camera, *camera};
+    cameras[1].get_transform().position = {0.3f, 0.0f, 0.0f};
+
+    buildify::core::TsdfSettings settings;
+    settings.voxel_size = 0.04f;
+    auto mesh = buildify::core::extract_gaussian_mesh(scene, cameras, 64, 64, settings);
+    ASSERT_FALSE(mesh.empty());
+    for (const auto& v : mesh.vertices) {
+        EXPECT_NEAR(v.z, -3.0f, settings.voxel_size);
+    }
+}
+
+// Test k-d tree queries against brute force
+TEST(KdTreeTest, MatchesBruteForce) {
+    std::vector<buildify::utils::Vector3f> points;
+    for (int i = 0; i < 2000; ++i) {
+        points.push_back({std::sin(i * 0.37f) * 2.0f, std::cos(i * 0.61f), std::sin(i * 1.13f + 0.5f) * 0.5f});
+    }
+    buildify::core::KdTree tree;
+    tree.build(points);
+    ASSERT_EQ(tree.size(), points.size());
+
+    for (int q = 0; q < 50; ++q) {
+        buildify::utils::Vector3f query(std::cos(q * 0.7f) * 2.0f, std::sin(q * 0.3f), std::cos(q * 1.9f) * 0.5f);
+        std::vector<float> expected;
+        for (const auto& p : points) {
+            auto d = p - query;
+            expected.push_back(d.dot(d));
+        }
+        std::sort(expected.begin(), expected.end());
+
+        std::uint32_t indices[8];
+        float distances2[8];
+        ASSERT_EQ(tree.knn(query, 8, indices, distances2), 8u);
+        for (int k = 0; k < 8; ++k) {
+            EXPECT_FLOAT_EQ(distances2[k], expected[k]);
+            auto d = points[indices[k]] - query;
+            EXPECT_FLOAT_EQ(d.dot(d), distances2[k]);
+        }
+    }
+
+    std::uint32_t index;
+    float distance2;
+    EXPECT_FALSE(tree.nearest({100.0f, 0.0f, 0.0f}, index, distance2, 1.0f));
+}
+
+// Test recovering a known rigid motion between two samplings of a surface
+TEST(RegistrationTest, PointToPlaneRecoversRigidMotion) {
+    auto surface = [](float u, float v) {
+        return buildify::utils::Vector3f(u, v, 0.15f * std::sin(3.0f * u) * std::cos(2.0f * v) + 0.05f * u * v);
+    };
+    std::vector<buildify::utils::Vector3f> target;
+    std::vector<buildify::utils::Vector3f> source;
+    for (int y = 0; y < 120; ++y) {
+        for (int x = 0; x < 120; ++x) {
+            target.push_back(surface(-1.0f + x / 60.0f, -1.0f + y / 60.0f));
+        }
+    }
+
+    // Source is an offset sampling of the same surface, moved by the inverse
+    // of the motion the alignment should find.
+    auto motion = buildify::utils::Matrix4f::translation({0.04f, -0.03f, 0.02f}) *
+                  buildify::utils::Matrix4f::rotation_z(0.08f) * buildify::utils::Matrix4f::rotation_x(0.05f);
+    for (int y = 0; y < 100; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            auto p = surface(-0.8f + x / 61.0f, -0.8f + y / 61.0f);
+            // Inverse of the rigid motion: R^T (p - t).
+            buildify::utils::Vector3f d(p.x - motion.m[0][3], p.y - motion.m[1][3], p.z - motion.m[2][3]);
+            source.push_back({motion.m[0][0] * d.x + motion.m[1][0] * d.y + motion.m[2][0] * d.z,
+                              motion.m[0][1] * d.x + motion.m[1][1] * d.y + motion.m[2][1] * d.z,
+                              motion.m[0][2] * d.x + motion.m[1][2] * d.y + motion.m[2][2] * d.z});
+        }
+    }
+
+    auto result = buildify::core::align_point_to_plane(source, target);
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            EXPECT_NEAR(result.transform.m[r][c], motion.m[r][c], 2e-3f);
+        }
+    }
+    EXPECT_GT(result.fitness, 0.95f);
+    EXPECT_LT(result.rmse, 2e-3f);
+}
+
+// Test voxel downsampling and outlier removal on seed points and splats
+TEST(PointFiltersTest, DownsamplesAndRemovesOutliers) {
+    std::vector<buildify::utils::Vector3f> points;
+    std::vector<buildify::utils::Vector3f> colors;
+    for (int z = 0; z < 20; ++z) {
+        for (int y = 0; y < 20; ++y) {
+            for (int x = 0; x < 20; ++x) {
+                // Four points per 0.1 voxel, centered on the voxel center.
+                for (int s = 0; s < 4; ++s) {
+                    float offset = (s < 2 ? -0.02f : 0.02f) * (s % 2 == 0 ? 1.0f : -1.0f);
+                    points.push_back({x * 0.1f + 0.05f + offset, y * 0.1f + 0.05f, z * 0.1f + 0.05f - offset});
+                    colors.push_back({s * 0.25f, 0.5f, 1.0f});
+                }
+            }
+        }
+    }
+
+    std::vector<buildify::utils::Vector3f> centers;
+    std::vector<buildify::utils::Vector3f> averaged;
+    buildify::core::voxel_downsample(points, colors, 0.1f, centers, averaged);
+    ASSERT_EQ(centers.size(), 8000u);
+    ASSERT_EQ(averaged.size(), centers.size());
+    for (std::size_t i = 0; i < centers.size(); ++i) {
+        float fx = centers[i].x / 0.1f - 0.5f;
+        float fz = centers[i].z / 0.1f - 0.5f;
+        EXPECT_NEAR(fx, std::round(fx), 1e-3f);
+        EXPECT_NEAR(fz, std::round(fz), 1e-3f);
+        EXPECT_NEAR(averaged[i].x, 0.375f, 1e-5f);
+    }
+
+    std::vector<buildify::utils::Vector3f> noisy(centers);
+    noisy.push_back({10.0f, 10.0f, 10.0f});
+    noisy.push_back({-5.0f, 1.0f, 1.0f});
+    auto mask = buildify::core::statistical_inlier_mask(noisy, 8, 2.0f);
+    ASSERT_EQ(mask.size(), noisy.size());
+    EXPECT_EQ(mask[noisy.size() - 1], 0);
+    EXPECT_EQ(mask[noisy.size() - 2], 0);
+    EXPECT_EQ(std::count(mask.begin(), mask.end(), 1), static_cast<std::ptrdiff_t>(centers.size()));
+
+    buildify::core::GaussianCloud cloud;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        cloud.add(points[i], {0.01f, 0.01f, 0.01f}, {}, 0.1f + 0.2f * (i % 4), colors[i]);
+    }
+    cloud.add({10.0f, 10.0f, 10.0f}, {0.01f, 0.01f, 0.01f}, {}, 0.5f, {1.0f, 0.0f, 0.0f});
+    EXPECT_EQ(buildify::core::voxel_downsample(cloud, 0.1f), points.size() - 8000);
+    ASSERT_EQ(cloud.size(), 8001u);
+    auto opacity = std::as_const(cloud).column(buildify::core::GaussianAttribute::Opacity);
+    for (std::size_t i = 0; i + 1 < cloud.size(); ++i) {
+        EXPECT_FLOAT_EQ(opacity[i], 0.7f);
+    }
+    EXPECT_EQ(buildify::core::remove_statistical_outliers(cloud, 8, 2.0f), 1u);
+    EXPECT_EQ(cloud.size(), 8000u);
+}
+
+// Test trajectory interpolation through keyframes and batched sampling
+TEST(CameraTrajectoryTest, InterpolatesKeyframesAndSamplesCameras) {
+    using buildify::core::TrajectoryInterpolation;
+    const buildify::utils::Vector3f up(0.0f, 1.0f, 0.0f);
+    for (auto interpolation : {TrajectoryInterpolation::Linear, TrajectoryInterpolation::CatmullRom,
+                               TrajectoryInterpolation::CubicSpline}) {
+        buildify::core::CameraTrajectory trajectory(interpolation);
+        // A quarter turn around y per second while moving along a circle.
+        for (int i = 0; i <= 4; ++i) {
+            float angle = i * 0.5f * std::numbers::pi_v<float>;
+            trajectory.add_keyframe(i, {std::sin(angle), 0.0f, std::cos(angle)},
+                                    buildify::utils::Quaternionf::from_axis_angle(up, angle));
+        }
+        ASSERT_EQ(trajectory.size(), 5u);
+        EXPECT_DOUBLE_EQ(trajectory.get_duration(), 4.0);
+
+        for (int i = 0; i <= 4; ++i) {
+            auto pose = trajectory.evaluate(i);
+            const auto& key = trajectory.get_keyframes()[i];
+            EXPECT_NEAR(pose.position.x, key.position.x, 1e-5f);
+            EXPECT_NEAR(pose.position.z, key.position.z, 1e-5f);
+            EXPECT_NEAR(std::abs(pose.rotation.y * key.rotation.y + pose.rotation.w * key.rotation.w), 1.0f, 1e-5f);
+        }
+
+        // Half way between keys the rotation is half way too: constant
+        // angular velocity about one axis survives every scheme.
+        auto half = trajectory.evaluate(1.5);
+        auto expected = buildify::utils::Quaternionf::from_axis_angle(up, 0.75f * std::numbers::pi_v<float>);
+        EXPECT_NEAR(std::abs(half.rotation.y * expected.y + half.rotation.w * expected.w), 1.0f, 1e-4f);
+        // Curves bow out towards the circle; the linear path cuts the chord.
+        if (interpolation != TrajectoryInterpolation::Linear) {
+            EXPECT_GT(half.position.length(), 0.85f);
+        } else {
+            EXPECT_NEAR(half.position.length(), std::sqrt(0.5f), 1e-5f);
+        }
+
+        std::vector<double> times;
+        for (int i = 0; i < 2000; ++i) {
+            times.push_back(-0.5 + i * 0.0025);
+        }
+        buildify::core::Camera prototype("Path");
+        prototype.set_perspective(60.0f, 1.0f, 0.1f, 100.0f);
+        auto cameras = trajectory.sample_cameras(prototype, times);
+        ASSERT_EQ(cameras.size(), times.size());
+        for (std::size_t i = 0; i < times.size(); i += 97) {
+            auto pose = trajectory.evaluate(times[i]);
+            EXPECT_EQ(cameras[i].get_name(), "Path");
+            EXPECT_FLOAT_EQ(cameras[i].get_transform().position.x, pose.position.x);
+            EXPECT_FLOAT_EQ(cameras[i].get_transform().rotation.w, pose.rotation.w);
+            EXPECT_FLOAT_EQ(cameras[i].get_view_matrix().m[0][3], cameras[i].get_params().view.m[0][3]);
+        }
+        EXPECT_FLOAT_EQ(cameras[0].get_transform().position.z, 1.0f);
+    }
+}
+
+TEST(MathTest, QuaternionAlgebraMatchesMatrices) {
+    using buildify::utils::Quaternionf;
+    using buildify::utils::Vector3f;
+    using buildify::utils::Vector4f;
+    Quaternionf a = Quaternionf::from_axis_angle(Vector3f(1.0f, 2.0f, -0.5f).normalized(), 0.8f);
+    Quaternionf b = Quaternionf::from_axis_angle(Vector3f(-0.3f, 0.4f, 1.0f).normalized(), 2.1f);
+
+    // The product composes rotations the way the matrices do.
+    auto product = (a * b).to_matrix();
+    auto expected = a.to_matrix() * b.to_matrix();
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            EXPECT_NEAR(product.m[r][c], expected.m[r][c], 1e-5f);
+        }
+    }
+    Vector3f v(0.2f, -1.0f, 3.0f);
+    Vector4f rotated = a.to_matrix() * Vector4f(v.x, v.y, v.z, 0.0f);
+    EXPECT_NEAR(a.rotate(v).x, rotated.x, 1e-5f);
+    EXPECT_NEAR(a.rotate(v).y, rotated.y, 1e-5f);
+    EXPECT_NEAR(a.rotate(v).z, rotated.z, 1e-5f);
+    EXPECT_NEAR((a * a.inverse()).w, 1.0f, 1e-6f);
+    EXPECT_NEAR(std::abs(Quaternionf::from_matrix(b.to_matrix()).dot(b)), 1.0f, 1e-6f);
+    EXPECT_NEAR(std::abs(a.log().exp().dot(a)), 1.0f, 1e-6f);
+
+    // Halfway along the shorter arc, even when b is given with the far sign.
+    Quaternionf far(-b.x, -b.y, -b.z, -b.w);
+    Quaternionf half = Quaternionf::slerp(a, far, 0.5f);
+    EXPECT_NEAR(std::abs(half.dot(a)), std::abs(half.dot(b)), 1e-5f);
+    EXPECT_NEAR(half.length(), 1.0f, 1e-6f);
+
+    // Batch kernels agree with the scalar methods, including the odd tail
+    // and zero quaternions.
+    const std::size_t count = 1000;
+    std::vector<float> ax(count), ay(count), az(count), aw(count), bx(count), by(count), bz(count), bw(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        float t = static_cast<float>(i);
+        ax[i] = std::sin(t); ay[i] = std::cos(1.3f * t); az[i] = std::sin(0.7f * t + 1.0f); aw[i] = 0.5f;
+        bx[i] = std::cos(t); by[i] = 0.3f; bz[i] = std::sin(2.1f * t); bw[i] = std::cos(0.4f * t);
+    }
+    ax[7] = ay[7] = az[7] = aw[7] = 0.0f;
+
+    std::vector<float> matrices(9 * count);
+    buildify::utils::quaternions_to_matrices({ax, ay, az, aw}, matrices);
+    std::vector<float> ox(count), oy(count), oz(count), ow(count);
+    buildify::utils::multiply_quaternions({ax, ay, az, aw}, {bx, by, bz, bw}, {ox, oy, oz, ow});
+    for (std::size_t i = 0; i < count; i += 37) {
+        Quaternionf qa(ax[i], ay[i], az[i], aw[i]);
+        Quaternionf qb(bx[i], by[i], bz[i], bw[i]);
+        auto m = qa.normalized().to_matrix();
+        for (int k = 0; k < 9; ++k) {
+            EXPECT_NEAR(matrices[k * count + i], i == 7 ? 0.0f : m.m[k / 3][k % 3], 1e-5f);
+        }
+        Quaternionf q = qa * qb;
+        EXPECT_NEAR(ox[i], q.x, 1e-5f);
+        EXPECT_NEAR(ow[i], q.w, 1e-5f);
+    }
+
+    buildify::utils::normalize_quaternions({ax, ay, az, aw});
+    EXPECT_FLOAT_EQ(aw[7], 1.0f);
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_NEAR(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i] + aw[i] * aw[i], 1.0f, 1e-5f);
+    }
+}
+
+TEST(CameraTest, LookAtFacesTarget) {
+    buildify::core::Camera camera("Viewer");
+    camera.get_transform().position = {1.0f, 2.0f, 3.0f};
+    const buildify::utils::Vector3f target(-2.0f, 0.5f, -1.0f);
+    camera.look_at(target);
+
+    // The target lands on the view axis, in front of the camera, and the
+    // camera stays upright.
+    auto view = camera.get_view_matrix();
+    buildify::utils::Vector4f eye = view * buildify::utils::Vector4f(target.x, target.y, target.z, 1.0f);
+    EXPECT_NEAR(eye.x, 0.0f, 1e-5f);
+    EXPECT_NEAR(eye.y, 0.0f, 1e-5f);
+    EXPECT_NEAR(eye.z, -(target - camera.get_transform().position).length(), 1e-4f);
+    EXPECT_GT(camera.get_transform().rotation.rotate({0.0f, 1.0f, 0.0f}).y, 0.0f);
+
+    // Looking straight down still yields a valid orientation.
+    camera.look_at({1.0f, -5.0f, 3.0f});
+    auto down = camera.get_transform().rotation.rotate({0.0f, 0.0f, -1.0f});
+    EXPECT_NEAR(down.y, -1.0f, 1e-5f);
+}
+
+TEST(CameraTest, CachedParamsTrackPoseAndProjection) {
+    buildify::core::Camera camera("Viewer");
+    camera.set_perspective(60.0f, 1.5f, 0.1f, 50.0f);
+    camera.look_at({0.0f, 0.0f, -1.0f});
+
+    auto params = camera.get_params();
+    auto expected = params.projection * params.view;
+    for (int r = 0; r < 4; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            EXPECT_FLOAT_EQ(params.view_projection.m[r][c], expected.m[r][c]);
+        }
+    }
+    EXPECT_TRUE(params.sphere_in_frustum({0.0f, 0.0f, -10.0f}, 0.1f));
+    EXPECT_FALSE(params.sphere_in_frustum({0.0f, 0.0f, 10.0f}, 1.0f));
+    EXPECT_FALSE(params.sphere_in_frustum({0.0f, 0.0f, -60.0f}, 1.0f));
+    EXPECT_FALSE(params.sphere_in_frustum({30.0f, 0.0f, -10.0f}, 1.0f));
+    EXPECT_TRUE(params.sphere_in_frustum({0.0f, 0.0f, -0.05f}, 0.1f));
+
+    // A pose edited in place is picked up before update() refreshes the
+    // cache, and both give the same snapshot.
+    camera.get_transform().position = {0.0f, 0.0f, 20.0f};
+    auto moved = camera.get_view_matrix();
+    EXPECT_FLOAT_EQ(moved.m[2][3], -20.0f);
+    EXPECT_TRUE(camera.get_params().sphere_in_frustum({0.0f, 0.0f, 10.0f}, 1.0f));
+    auto stale = camera.get_view_projection_matrix();
+    EXPECT_FLOAT_EQ(stale.m[3][3], camera.get_params().view_projection.m[3][3]);
+    EXPECT_FLOAT_EQ(stale.m[2][3], camera.get_params().view_projection.m[2][3]);
+    camera.update(0.0);
+    EXPECT_FLOAT_EQ(camera.get_view_matrix().m[2][3], moved.m[2][3]);
+
+    camera.set_orthographic(-2.0f, 2.0f, -1.0f, 1.0f, 0.5f, 30.0f);
+    params = camera.get_params();
+    EXPECT_TRUE(params.orthographic);
+    EXPECT_FLOAT_EQ(params.projection.m[3][3], 1.0f);
+    EXPECT_TRUE(params.sphere_in_frustum({1.5f, 0.0f, 0.0f}, 0.1f));
+    EXPECT_FALSE(params.sphere_in_frustum({3.0f, 0.0f, 0.0f}, 0.5f));
+}
+
+TEST(ConfigTest, ParsesOverridesAndDumpsSettings) {
+    buildify::utils::Config config;
+    ASSERT_TRUE(config.parse(R"({
+        "threads": {"count": 3, "pin": false},
+        "log": {"level": "warning"},
+        "render": {"sort_mode": "comparison", "temporal_cache": {"enabled": true, "max_pixel_motion": 2.5}},
+        "name": "line\nbreak é"
+    })"));
+    EXPECT_EQ(config.get_int("threads.count"), 3);
+    EXPECT_EQ(config.get_bool("render.temporal_cache.enabled"), true);
+    EXPECT_DOUBLE_EQ(config.get_double("render.temporal_cache.max_pixel_motion").value(), 2.5);
+    EXPECT_EQ(config.get_string("name"), "line\nbreak \xc3\xa9");
+    EXPECT_FALSE(config.get_int("log.level").has_value());
+    EXPECT_FALSE(config.parse(R"({"threads": {"count": [1, 2]}})"));
+    EXPECT_FALSE(config.parse(R"({"threads": )"));
+    EXPECT_EQ(config.get_int("threads.count"), 3);
+
+    // Environment variables win over the file; "__" separates levels.
+    setenv("BUILDIFY_RENDER__SORT_MODE", "radix", 1);
+    setenv("BUILDIFY_THREADS__COUNT", "2", 1);
+    EXPECT_GE(config.apply_environment(), 2u);
+    unsetenv("BUILDIFY_RENDER__SORT_MODE");
+    unsetenv("BUILDIFY_THREADS__COUNT");
+
+    auto settings = buildify::core::EngineConfig::from_config(config);
+    EXPECT_EQ(settings.worker_threads, 2u);
+    EXPECT_EQ(settings.sort_mode, buildify::core::TileSortMode::Radix);
+    EXPECT_EQ(settings.log_level, buildify::utils::LogLevel::Warning);
+    EXPECT_TRUE(settings.temporal_cache.enabled);
+    EXPECT_FLOAT_EQ(settings.temporal_cache.max_pixel_motion, 2.5f);
+    // Hot reload modifies scenes in place, so it is opt-in.
+    EXPECT_FALSE(settings.hot_reload_scenes);
+
+    // The dump reads back to the same values.
+    buildify::utils::Config round_trip;
+    ASSERT_TRUE(round_trip.parse(config.dump()));
+    EXPECT_EQ(round_trip.keys(), config.keys());
+    for (const auto& key : config.keys()) {
+        EXPECT_EQ(round_trip.get_string(key), config.get_string(key)) << key;
+    }
+    auto restored = buildify::core::EngineConfig::from_config(settings.to_config());
+    EXPECT_EQ(restored.worker_threads, settings.worker_threads);
+    EXPECT_EQ(restored.sort_mode, settings.sort_mode);
+    EXPECT_FLOAT_EQ(restored.temporal_cache.max_pixel_motion, settings.temporal_cache.max_pixel_motion);
+}
+
+TEST(TileRendererTest, SortModesRenderIdentically) {
+    buildify::core::Scene scene("Sort");
+    auto camera = scene.create_entity<buildify::core::Camera>("Camera");
+    camera->set_perspective(60.0f, 1.0f, 0.1f, 100.0f);
+    scene.set_active_camera(camera);
+    for (int i = 0; i < 2000; ++i) {
+        float t = static_cast<float>(i);
+        scene.get_gaussians().add({std::sin(t) * 0.5f, std::cos(1.7f * t) * 0.5f, -3.0f - 0.001f * (i % 7)},
+                                  {0.05f, 0.05f, 0.05f}, {}, 0.6f, {0.5f + 0.5f * std::sin(t), 0.3f, 0.7f});
+    }
+
+    std::vector<float> reference;
+    for (auto mode : {buildify::core::TileSortMode::Comparison, buildify::core::TileSortMode::Radix,
+                      buildify::core::TileSortMode::Auto}) {
+        buildify::core::TileRenderer renderer;
+        ASSERT_TRUE(renderer.initialize({64, 64}));
+        renderer.set_sort_mode(mode);
+        renderer.render_scene(scene);
+        auto color = renderer.get_color_buffer();
+        if (reference.empty()) {
+            reference.assign(color.begin(), color.end());
+        } else {
+            EXPECT_TRUE(std::equal(color.begin(), color.end(), reference.begin()));
+        }
+    }
+}
+
+TEST(EngineTest, RunLoopUsesFixedStepsAndPacesFrames) {
+    buildify::core::Engine engine;
+    buildify::core::RunSettings settings;
+    EXPECT_FALSE(engine.run(settings));
+    ASSERT_TRUE(engine.initialize());
+
+    std::vector<double> steps;
+    engine.add_update_callback([&steps](double dt) { steps.push_back(dt); });
+    settings.fixed_timestep = std::chrono::microseconds(2000);
+    settings.target_frame_rate = 200.0;
+    settings.max_frames = 20;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(engine.run(settings));
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto& stats = engine.get_timing_stats();
+    EXPECT_EQ(stats.frames, 20u);
+    EXPECT_EQ(stats.updates, steps.size());
+    for (double dt : steps) {
+        EXPECT_DOUBLE_EQ(dt, 0.002);
+    }
+    // Paced at 5 ms a frame, the 2 ms simulation keeps up with wall time.
+    EXPECT_GE(elapsed, 19 * 0.005 - 0.001);
+    EXPECT_NEAR(static_cast<double>(stats.updates + stats.dropped_updates) * 0.002, elapsed, 0.012);
+    EXPECT_GT(stats.average_frame_ms, 4.0);
+    EXPECT_GE(stats.p99_frame_ms, stats.average_frame_ms * 0.5);
+    EXPECT_GE(engine.get_interpolation_alpha(), 0.0);
+    EXPECT_LT(engine.get_interpolation_alpha(), 1.0);
+
+    // A stall longer than the catch-up budget drops steps instead of
+    // replaying them all, and stop() from a callback ends the loop.
+    // Window statistics are current while the loop is still running.
+    steps.clear();
+    double live_average_ms = 0.0;
+    engine.add_update_callback([&](double) {
+        if (steps.size() == 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        }
+        if (steps.size() >= 40) {
+            live_average_ms = engine.get_timing_stats().average_frame_ms;
+            engine.stop();
+        }
+    });
+    settings.max_frames = 0;
+    settings.target_frame_rate = 0.0;
+    settings.max_catch_up_steps = 3;
+    ASSERT_TRUE(engine.run(settings));
+    EXPECT_GT(engine.get_timing_stats().dropped_updates, 0u);
+    EXPECT_GT(live_average_ms, 0.0);
+    EXPECT_FALSE(engine.is_running());
+}
+
+TEST(NumaTest, ReadsTopologyAndPartitionsWork) {
+    namespace fs = std::filesystem;
+    auto root = fs::temp_directory_path() / "buildify_numa_test";
+    fs::remove_all(root);
+    for (auto [node, cpus] : {std::pair{"node0", "0-1,4\n"}, std::pair{"node1", "2-3\n"}, std::pair{"node2", "\n"}}) {
+        fs::create_directories(root / node);
+        std::ofstream(root / node / "cpulist") << cpus;
+    }
+    fs::create_directories(root / "power");
+
+    auto topology = buildify::utils::NumaTopology::from_sysfs(root.string());
+    ASSERT_EQ(topology.node_count(), 2u);
+    EXPECT_TRUE(topology.is_numa());
+    EXPECT_EQ(topology.nodes()[0].cpus, (std::vector<std::uint32_t>{0, 1, 4}));
+    EXPECT_EQ(topology.node_of_cpu(3), 1u);
+
+    // CPUs outside the affinity mask are dropped, and so are nodes left empty.
+    const std::uint32_t allowed[] = {2, 3};
+    auto restricted = buildify::utils::NumaTopology::from_sysfs(root.string(), allowed);
+    ASSERT_EQ(restricted.node_count(), 1u);
+    EXPECT_EQ(restricted.nodes()[0].id, 1u);
+    auto missing = buildify::utils::NumaTopology::from_sysfs((root / "absent").string(), allowed);
+    ASSERT_EQ(missing.node_count(), 1u);
+    EXPECT_EQ(missing.nodes()[0].cpus.size(), 2u);
+    fs::remove_all(root);
+
+    const std::size_t weights[] = {3, 1};
+    EXPECT_EQ(buildify::utils::partition_begin(100, 0, weights), 0u);
+    EXPECT_EQ(buildify::utils::partition_begin(100, 1, weights), 75u);
+    EXPECT_EQ(buildify::utils::partition_begin(100, 2, weights), 100u);
+
+    auto& pool = buildify::utils::ThreadPool::instance();
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallel_for_partitioned(0, visits.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            visits[i].fetch_add(1);
+        }
+    }, 7);
+    EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v) { return v == 1; }));
+
+    std::vector<float> buffer(1 << 20, 1.0f);
+    EXPECT_TRUE(buildify::utils::place_memory(buffer.data(), buffer.size() * sizeof(float),
+                                              buildify::utils::MemoryPlacement::Partitioned,
+                                              pool.node_weights()));
+    EXPECT_EQ(buffer.back(), 1.0f);
+
+    // Once work has been submitted the pool keeps its workers.
+    buildify::utils::ThreadPool local(2);
+    EXPECT_TRUE(local.resize(3));
+    EXPECT_EQ(local.size(), 2u);
+    local.submit([]() {}).wait();
+    EXPECT_FALSE(local.resize(4));
+    EXPECT_EQ(local.size(), 2u);
+}
+
+TEST(HugePageTest, LargeColumnsAreMappedAlignedAndFreed) {
+    using buildify::utils::HugePageMode;
+    const auto before = buildify::utils::get_huge_page_stats();
+
+    // Explicit pages usually are not reserved here; either way the
+    // allocation must succeed.
+    for (auto mode : {HugePageMode::Off, HugePageMode::Transparent, HugePageMode::Explicit}) {
+        buildify::utils::set_huge_page_mode(mode);
+        buildify::utils::HugePageVector<float> column(3 << 20, 2.0f);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(column.data()) % buildify::utils::huge_page_size, 0u);
+        EXPECT_GE(buildify::utils::get_huge_page_stats().mapped_bytes, before.mapped_bytes + (12u << 20));
+        EXPECT_EQ(column[(3 << 20) - 1], 2.0f);
+    }
+    buildify::utils::set_huge_page_mode(HugePageMode::Transparent);
+    EXPECT_EQ(buildify::utils::get_huge_page_stats().mapped_bytes, before.mapped_bytes);
+
+    buildify::utils::HugePageVector<float> small(16, 1.0f);
+    EXPECT_EQ(buildify::utils::get_huge_page_stats().mapped_bytes, before.mapped_bytes);
+
+    buildify::core::GaussianCloud cloud;
+    cloud.resize(1 << 20);
+    EXPECT_GE(buildify::utils::get_huge_page_stats().mapped_bytes,
+              before.mapped_bytes + buildify::core::GaussianCloud::attribute_count * (4u << 20));
+    EXPECT_EQ(cloud.column(buildify::core::GaussianAttribute::ScaleX)[12345], 1.0f);
+}
+
+TEST(SharedGaussiansTest, PublishesSnapshotsToReaders) {
+    const std::string name = "buildify_test_" + std::to_string(getpid());
+    buildify::core::SharedGaussianSegment writer;
+    ASSERT_TRUE(writer.create(name, 1000, 1));
+
+    buildify::core::GaussianCloud cloud(1);
+    for (int i = 0; i < 10; ++i) {
+        cloud.add({float(i), 0.0f, -5.0f}, {0.1f, 0.1f, 0.1f}, {}, 0.5f, {1.0f, 0.0f, 0.0f});
+    }
+    cloud.sh_rest()[9 * 5 + 2] = 0.25f;
+    ASSERT_TRUE(writer.publish(cloud));
+    EXPECT_EQ(writer.get_generation(), 2u);
+
+    // The name stays with its live writer.
+    buildify::core::SharedGaussianSegment thief;
+    EXPECT_FALSE(thief.create(name, 10, 1));
+    EXPECT_EQ(writer.header()->writer_pid, static_cast<std::uint32_t>(getpid()));
+
+    buildify::core::SharedGaussianSegment reader;
+    ASSERT_TRUE(reader.open(name));
+    EXPECT_FALSE(reader.is_writable());
+    EXPECT_EQ(reader.get_capacity(), 1000u);
+
+    // Zero-copy view of the published columns.
+    auto generation = reader.begin_read();
+    ASSERT_TRUE(generation);
+    ASSERT_EQ(reader.size(), 10u);
+    EXPECT_EQ(reader.column(buildify::core::GaussianAttribute::PositionX)[7], 7.0f);
+    EXPECT_TRUE(reader.filter_3d().empty());
+    EXPECT_TRUE(reader.end_read(*generation));
+
+    cloud.resize(20);
+    ASSERT_TRUE(writer.publish(cloud));
+    EXPECT_FALSE(reader.end_read(*generation));
+
+    buildify::core::GaussianCloud copy(1);
+    ASSERT_TRUE(reader.read(copy));
+    ASSERT_EQ(copy.size(), 20u);
+    EXPECT_EQ(copy.sh_rest()[9 * 5 + 2], 0.25f);
+    EXPECT_EQ(copy.get_position(3).x, 3.0f);
+
+    buildify::core::GaussianCloud wrong_degree(0);
+    EXPECT_FALSE(reader.read(wrong_degree));
+
+    // Reads racing publishes in the same process only ever see whole
+    // snapshots.
+    std::atomic<bool> publishing{true};
+    std::thread publisher([&]() {
+        buildify::core::GaussianCloud frame = cloud;
+        for (int round = 0; round < 200; ++round) {
+            std::fill_n(frame.column(buildify::core::GaussianAttribute::PositionY).data(), frame.size(), float(round));
+            writer.publish(frame);
+        }
+        publishing = false;
+    });
+    while (publishing) {
+        ASSERT_TRUE(reader.read(copy));
+        auto y = copy.column(buildify::core::GaussianAttribute::PositionY);
+        ASSERT_TRUE(std::all_of(y.begin(), y.end(), [&](float value) { return value == y[0]; }));
+    }
+    publisher.join();
+
+    // A writer that died mid-publish leaves the generation odd; readers
+    // time out instead of spinning.
+    auto& stuck = const_cast<buildify::core::SharedGaussianHeader*>(writer.header())->generation;
+    ++stuck;
+    EXPECT_FALSE(reader.begin_read(std::chrono::milliseconds(5)));
+    EXPECT_FALSE(reader.read(copy, std::chrono::milliseconds(5)));
+    ++stuck;
+    cloud.resize(1001);
+    EXPECT_FALSE(writer.publish(cloud));
+    EXPECT_FALSE(reader.open(name + "_missing"));
+
+    writer.close();
+    buildify::core::SharedGaussianSegment late;
+    EXPECT_FALSE(late.open(name));
+}
+
+TEST(RenderServerTest, BatchesConcurrentClientsAndReturnsFrames) {
+    auto scene = std::make_shared<buildify::core::Scene>("served");
+    auto& cloud = scene->get_gaussians();
+    for (int i = 0; i < 200; ++i) {
+        cloud.add({(i % 20) * 0.1f - 1.0f, (i / 20) * 0.1f - 0.5f, -4.0f}, {0.05f, 0.05f, 0.05f}, {}, 0.8f,
+                  {0.2f, 0.6f, 0.9f});
+    }
+
+    buildify::core::RenderServer server;
+    server.add_scene("served", scene);
+    buildify::core::RenderServerSettings settings;
+    settings.socket_path = (std::filesystem::temp_directory_path() /
+                            ("buildify_render_" + std::to_string(getpid()) + ".sock")).string();
+    settings.batch_window = std::chrono::milliseconds(200);
+    settings.max_batch_views = 3;
+    ASSERT_TRUE(server.start(settings));
+
+    buildify::core::Camera camera;
+    camera.set_perspective(60.0f, 64.0f / 48.0f, 0.1f, 100.0f);
+
+    // A single in-process render is the reference image.
+    buildify::core::TileRenderer reference;
+    buildify::core::RenderTarget target{};
+    target.width = 64;
+    target.height = 48;
+    reference.initialize(target);
+    std::vector<float> expected(64 * 48 * 4);
+    reference.render_views(*scene, std::span(&camera, 1), expected);
+
+    constexpr int clients = 3;
+    std::vector<std::vector<float>> frames(clients);
+    std::vector<std::uint32_t> batch_sizes(clients);
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c]() {
+            buildify::core::RenderClient client;
+            ASSERT_TRUE(client.connect(settings.socket_path, 64, 48));
+            auto frame = client.render("served", camera, 64, 48);
+            frames[c].assign(frame.begin(), frame.end());
+            batch_sizes[c] = client.get_last_batch_size();
+            EXPECT_TRUE(client.render("missing", camera, 64, 48).empty());
+            EXPECT_TRUE(client.render("served", camera, 128, 128).empty());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int c = 0; c < clients; ++c) {
+        ASSERT_EQ(frames[c].size(), expected.size());
+        EXPECT_EQ(frames[c], expected);
+        EXPECT_EQ(batch_sizes[c], 3u);
+    }
+    auto stats = server.get_stats();
+    EXPECT_EQ(stats.connections, 3u);
+    EXPECT_EQ(stats.requests, 3u);
+    EXPECT_EQ(stats.largest_batch, 3u);
+    EXPECT_EQ(stats.rejected, 6u);
+
+    // A client pipelining past its slots is refused instead of queueing
+    // without bound, and every request still gets exactly one reply.
+    namespace protocol = buildify::core::render_protocol;
+    int raw = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, settings.socket_path.c_str(), settings.socket_path.size());
+    ASSERT_EQ(::connect(raw, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    auto append = [](std::string& out, protocol::MessageType type, std::uint32_t id, const void* data,
+                     std::size_t bytes) {
+        protocol::MessageHeader header{protocol::request_magic, protocol::version,
+                                       static_cast<std::uint16_t>(type), id, static_cast<std::uint32_t>(bytes)};
+        out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.append(static_cast<const char*>(data), bytes);
+    };
+    std::string pipelined;
+    protocol::HelloRequest hello{64, 48, 2};
+    append(pipelined, protocol::MessageType::Hello, 0, &hello, sizeof(hello));
+    constexpr int burst = 6;
+    for (int i = 1; i <= burst; ++i) {
+        protocol::RenderRequest request{64, 48, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, 60.0f, 0.1f, 100.0f, 6};
+        std::string message(reinterpret_cast<const char*>(&request), sizeof(request));
+        message += "served";
+        append(pipelined, protocol::MessageType::Render, static_cast<std::uint32_t>(i), message.data(),
+               message.size());
+    }
+    ASSERT_EQ(::send(raw, pipelined.data(), pipelined.size(), 0), static_cast<ssize_t>(pipelined.size()));
+    int ok = 0;
+    int busy = 0;
+    for (int i = 0; i <= burst; ++i) {
+        protocol::MessageHeader reply{};
+        ASSERT_EQ(::recv(raw, &reply, sizeof(reply), MSG_WAITALL), static_cast<ssize_t>(sizeof(reply)));
+        std::string payload(reply.payload_bytes, '\0');
+        if (!payload.empty()) {
+            ASSERT_EQ(::recv(raw, payload.data(), payload.size(), MSG_WAITALL), static_cast<ssize_t>(payload.size()));
+        }
+        if (reply.request_id != 0) {
+            ok += reply.code == static_cast<std::uint16_t>(protocol::Status::Ok);
+            busy += reply.code == static_cast<std::uint16_t>(protocol::Status::Busy);
+        }
+    }
+    EXPECT_EQ(ok + busy, burst);
+    EXPECT_GE(busy, 1);
+    ::close(raw);
+
+    // Only the most recently used frame sizes keep a renderer.
+    {
+        buildify::core::RenderClient client;
+        ASSERT_TRUE(client.connect(settings.socket_path, 64, 48));
+        for (std::uint32_t size : {16u, 24u, 32u, 16u}) {
+            EXPECT_EQ(client.render("served", camera, size, size).size(), std::size_t{size} * size * 4);
+        }
+    }
+    EXPECT_EQ(server.get_stats().cached_renderers, settings.max_cached_renderers);
+    server.stop();
+    EXPECT_FALSE(std::filesystem::exists(settings.socket_path));
+}
+
+TEST(SceneResidencyTest, EvictsLeastRecentlyUsedAndReloadsTransparently) {
+    const auto spill = std::filesystem::temp_directory_path() / ("buildify_spill_test_" + std::to_string(getpid()));
+    buildify::core::SceneResidency residency;
+    std::size_t scene_bytes = 0;
+    for (int s = 0; s < 3; ++s) {
+        auto scene = std::make_shared<buildify::core::Scene>("scene" + std::to_string(s));
+        auto& cloud = scene->get_gaussians();
+        cloud = buildify::core::GaussianCloud(1);
+        for (int i = 0; i < 100; ++i) {
+            cloud.add({float(i), float(s), -5.0f}, {0.1f, 0.1f, 0.1f}, {}, 0.5f, {1.0f, 0.0f, 0.0f});
+        }
+        cloud.sh_rest()[17] = 0.5f + s;
+        scene_bytes = cloud.memory_footprint();
+        residency.add(scene->get_name(), scene);
+    }
+    EXPECT_EQ(residency.get_stats().resident_scenes, 3u);
+
+    // Room for two: scene0 is the least recently used.
+    residency.set_settings({scene_bytes * 2 + scene_bytes / 2, spill.string()});
+    auto stats = residency.get_stats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.resident_scenes, 2u);
+    EXPECT_LE(stats.resident_bytes, scene_bytes * 2 + scene_bytes / 2);
+
+    // Taking a scene back before its write finishes skips the disk; wait
+    // so the reload path is exercised.
+    auto wait_evicted = [&](const std::string& name) {
+        while (residency.get_state(name) == buildify::core::SceneResidencyState::Evicting) {
+            std::this_thread::yield();
+        }
+        EXPECT_EQ(residency.get_state(name), buildify::core::SceneResidencyState::Evicted);
+    };
+    wait_evicted("scene0");
+    auto scene0 = residency.acquire("scene0");
+    ASSERT_NE(scene0, nullptr);
+    const auto& cloud0 = scene0->get_gaussians();
+    ASSERT_EQ(cloud0.size(), 100u);
+    EXPECT_EQ(cloud0.get_position(42).x, 42.0f);
+    EXPECT_EQ(cloud0.sh_rest()[17], 0.5f);
+    EXPECT_EQ(residency.get_state("scene0"), buildify::core::SceneResidencyState::Resident);
+
+    // Bringing scene0 back pushed out scene1, now the oldest.
+    stats = residency.get_stats();
+    EXPECT_EQ(stats.evictions, 2u);
+    EXPECT_EQ(stats.reloads, 1u);
+    EXPECT_EQ(stats.resident_scenes, 2u);
+    EXPECT_EQ(residency.get_state("scene2"), buildify::core::SceneResidencyState::Resident);
+    wait_evicted("scene1");
+
+    // touch() works on the scene object, as the engine's render loop uses it.
+    for (const auto& scene : residency.get_scenes()) {
+        if (scene->get_name() == "scene1") {
+            residency.touch(*scene);
+            EXPECT_EQ(scene->get_gaussians().size(), 100u);
+            EXPECT_EQ(scene->get_gaussians().get_position(1).y, 1.0f);
+        }
+    }
+    EXPECT_EQ(residency.get_state("scene1"), buildify::core::SceneResidencyState::Resident);
+    EXPECT_EQ(residency.get_stats().reloads, 2u);
+    EXPECT_EQ(residency.acquire("missing"), nullptr);
+
+    // scene2 was pushed out by scene1; removing it must not strand the
+    // holder with an empty cloud.
+    wait_evicted("scene2");
+    std::shared_ptr<buildify::core::Scene> scene2;
+    for (const auto& scene : residency.get_scenes()) {
+        if (scene->get_name() == "scene2") {
+            scene2 = scene;
+        }
+    }
+    ASSERT_NE(scene2, nullptr);
+    EXPECT_EQ(scene2->get_gaussians().size(), 0u);
+    residency.remove("scene2");
+    ASSERT_EQ(scene2->get_gaussians().size(), 100u);
+    EXPECT_EQ(scene2->get_gaussians().sh_rest()[17], 2.5f);
+
+    residency.clear();
+    EXPECT_FALSE(std::filesystem::exists(spill));
+}
+
+TEST(GaussianInstanceTest, InstancesRenderLikeBakedCopiesAndCullOffscreen) {
+    struct Splat {
+        buildify::utils::Vector3f position;
+        buildify::utils::Vector3f scale;
+        buildify::utils::Quaternionf rotation;
+        buildify::utils::Vector3f color;
+    };
+    std::vector<Splat> splats;
+    for (int i = 0; i < 200; ++i) {
+        float t = i * 0.37f;
+        splats.push_back({{0.4f * std::sin(t), 0.4f * std::cos(1.3f * t), 0.3f * std::sin(0.7f * t)},
+                          {0.05f + 0.02f * (i % 3), 0.04f, 0.06f},
+                          buildify::utils::Quaternionf::from_axis_angle({0.0f, 0.0f, 1.0f}, t),
+                          {0.1f * (i % 10), 0.5f, 1.0f - 0.1f * (i % 10)}});
+    }
+    buildify::core::GaussianCloud source;
+    for (const auto& splat : splats) {
+        source.add(splat.position, splat.scale, splat.rotation, 0.8f, splat.color);
+    }
+    auto asset = std::make_shared<const buildify::core::GaussianAsset>(std::move(source), 16);
+    EXPECT_EQ(asset->get_clusters().size(), 13u);
+    EXPECT_EQ(asset->get_gaussians().size(), 200u);
+
+    buildify::utils::Transform placements[3];
+    placements[0].position = {-1.0f, 0.0f, -6.0f};
+    placements[0].rotation = buildify::utils::Quaternionf::from_axis_angle({0.0f, 1.0f, 0.0f}, 0.7f);
+    placements[0].scale = {1.5f, 1.5f, 1.5f};
+    placements[1].position = {1.2f, 0.3f, -5.0f};
+    // Behind the camera.
+    placements[2].position = {0.0f, 0.0f, 10.0f};
+
+    buildify::core::Scene instanced("Instanced");
+    make_test_camera(instanced);
+    buildify::core::Scene baked("Baked");
+    make_test_camera(baked);
+    for (const auto& transform : placements) {
+        auto instance = instanced.create_entity<buildify::core::GaussianInstance>("Chair", asset);
+        instance->set_transform(transform);
+
+        const auto model = transform.to_matrix();
+        for (const auto& splat : splats) {
+            const auto& p = splat.position;
+            buildify::utils::Vector3f position = {
+                model.m[0][0] * p.x + model.m[0][1] * p.y + model.m[0][2] * p.z + model.m[0][3],
+                model.m[1][0] * p.x + model.m[1][1] * p.y + model.m[1][2] * p.z + model.m[1][3],
+                model.m[2][0] * p.x + model.m[2][1] * p.y + model.m[2][2] * p.z + model.m[2][3]};
+            baked.get_gaussians().add(position, splat.scale * transform.scale.x, transform.rotation * splat.rotation,
+                                      0.8f, splat.color);
+        }
+    }
+    EXPECT_EQ(asset.use_count(), 4);
+
+    buildify::core::TileRenderer renderer;
+    ASSERT_TRUE(renderer.initialize({96, 64}));
+    renderer.render_scene(baked);
+    std::vector<float> expected(renderer.get_color_buffer().begin(), renderer.get_color_buffer().end());
+    renderer.render_scene(instanced);
+    auto color = renderer.get_color_buffer();
+    float max_difference = 0.0f;
+    float coverage = 0.0f;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        max_difference = std::max(max_difference, std::abs(color[i] - expected[i]));
+        coverage += color[i];
+    }
+    EXPECT_LT(max_difference, 1e-3f);
+    EXPECT_GT(coverage, 1.0f);
+
+    const auto& stats = renderer.get_frame_stats();
+    EXPECT_EQ(stats.instances_visible, 2u);
+    EXPECT_EQ(stats.instances_culled, 1u);
+    EXPECT_EQ(stats.visible_splats, 400u);
+
+    // Moving an instance invalidates the temporal cache.
+    renderer.set_temporal_cache({.enabled = true});
+    renderer.render_scene(instanced);
+    renderer.render_scene(instanced);
+    EXPECT_EQ(renderer.get_frame_stats().tiles_reused, renderer.get_frame_stats().tile_count);
+    instanced.find_entity("Chair")->get_transform().position.x += 0.5f;
+    renderer.render_scene(instanced);
+    EXPECT_EQ(renderer.get_frame_stats().tiles_reused, 0u);
+}
+
+TEST(GaussianInstanceTest, TemporalCacheFollowsSplatsAcrossClusterCulling) {
+    buildify::core::GaussianCloud source;
+    for (int i = 0; i < 256; ++i) {
+        float t = i * 0.61f;
+        source.add({0.5f * std::sin(t), 0.5f * std::cos(1.7f * t), 0.3f * std::sin(0.9f * t)},
+                   {0.06f, 0.05f, 0.06f}, {}, 0.8f, {0.1f * (i % 10), 0.4f, 1.0f - 0.1f * (i % 10)});
+    }
+    auto asset = std::make_shared<const buildify::core::GaussianAsset>(std::move(source), 16);
+
+    buildify::core::Scene scene("Row");
+    auto camera = make_test_camera(scene);
+    for (int i = 0; i < 6; ++i) {
+        auto instance = scene.create_entity<buildify::core::GaussianInstance>("Asset" + std::to_string(i), asset);
+        instance->get_transform().position = {-4.0f + 1.6f * i, 0.2f * (i % 2), -6.0f};
+    }
+
+    buildify::core::TileRenderer cached;
+    buildify::core::TileRenderer reference;
+    ASSERT_TRUE(cached.initialize({96, 64}));
+    ASSERT_TRUE(reference.initialize({96, 64}));
+    cached.set_temporal_cache({.enabled = true, .max_pixel_motion = 0.75f, .max_splat_change = 0.0f});
+
+    // Pan sideways so instances at the frame edges lose and regain clusters,
+    // shifting where every later splat lands in the projection. Tiles must
+    // keep exactly the same splats to be reused.
+    std::size_t culled_changes = 0;
+    std::size_t reused_on_change = 0;
+    std::size_t last_visible = 0;
+    double total_difference = 0.0;
+    std::size_t samples = 0;
+    for (int step = 0; step < 40; ++step) {
+        auto transform = camera->get_transform();
+        transform.position.x = 0.01f * step;
+        camera->set_transform(transform);
+
+        cached.render_scene(scene);
+        reference.render_scene(scene);
+        const auto& stats = cached.get_frame_stats();
+        if (step > 0) {
+            if (stats.visible_splats != last_visible) {
+                ++culled_changes;
+                reused_on_change += stats.tiles_reused;
+            }
+        }
+        last_visible = stats.visible_splats;
+
+        auto color = cached.get_color_buffer();
+        auto expected = reference.get_color_buffer();
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            total_difference += std::abs(color[i] - expected[i]);
+        }
+        samples += expected.size();
+    }
+    EXPECT_GT(culled_changes, 10u);
+    EXPECT_GT(reused_on_change, 0u);
+    // Reused tiles are reprojected, so edges may be off by a fraction of a
+    // pixel; stale splat sets would show up as whole wrong tiles.
+    EXPECT_LT(total_difference / samples, 0.01);
+}
+
+TEST(AsyncIoTest, LoadsConcurrentlyWithProgressAndCancellation) {
+    const auto directory = std::filesystem::temp_directory_path() / ("buildify_async_" + std::to_string(getpid()));
+    std::filesystem::create_directories(directory);
+    const std::string first_path = (directory / "first.bgs").string();
+    const std::string second_path = (directory / "second.bgs").string();
+
+    auto scene = std::make_shared<buildify::core::Scene>("Saved");
+    auto& cloud = scene->get_gaussians();
+    cloud = buildify::core::GaussianCloud(1);
+    for (int i = 0; i < 5000; ++i) {
+        cloud.add({float(i % 50), float(i / 50), -5.0f}, {0.1f, 0.1f, 0.1f}, {}, 0.5f, {1.0f, 0.0f, 0.0f});
+    }
+    cloud.sh_rest()[123] = 0.75f;
+    ASSERT_TRUE(buildify::utils::sync_wait(buildify::core::save_scene_async(first_path, scene)));
+    ASSERT_TRUE(scene->save_to_file(second_path));
+
+    std::vector<float> reported;
+    std::mutex reported_mutex;
+    auto progress = [&](float done) {
+        std::lock_guard lock(reported_mutex);
+        reported.push_back(done);
+    };
+    std::vector<buildify::utils::Task<std::shared_ptr<buildify::core::Scene>>> loads;
+    loads.push_back(buildify::core::load_scene_async("First", first_path, {}, progress));
+    loads.push_back(buildify::core::load_scene_async("Second", second_path));
+    auto scenes = buildify::utils::sync_wait(buildify::utils::when_all(std::move(loads)));
+    ASSERT_EQ(scenes.size(), 2u);
+    for (const auto& loaded : scenes) {
+        ASSERT_NE(loaded, nullptr);
+        ASSERT_EQ(loaded->get_gaussians().size(), 5000u);
+        EXPECT_EQ(loaded->get_gaussians().get_position(1234).y, 24.0f);
+        EXPECT_EQ(loaded->get_gaussians().sh_rest()[123], 0.75f);
+    }
+    EXPECT_EQ(scenes[0]->get_name(), "First");
+    ASSERT_FALSE(reported.empty());
+    EXPECT_TRUE(std::is_sorted(reported.begin(), reported.end()));
+    EXPECT_EQ(reported.back(), 1.0f);
+
+    // Cancelled from its own progress callback after the first chunk.
+    buildify::utils::CancellationSource cancel;
+    auto cancelled = buildify::utils::sync_wait(buildify::core::load_gaussians_async(
+        first_path, cancel.token(), [&](float) { cancel.cancel(); }));
+    EXPECT_EQ(cancelled, nullptr);
+
+    // A cancelled save leaves no partial file behind.
+    const std::string third_path = (directory / "third.bgs").string();
+    EXPECT_FALSE(buildify::utils::sync_wait(buildify::core::save_gaussians_async(
+        third_path, std::make_shared<buildify::core::GaussianCloud>(cloud), cancel.token())));
+    EXPECT_FALSE(std::filesystem::exists(third_path));
+    EXPECT_EQ(buildify::utils::sync_wait(buildify::core::load_scene_async("Missing", third_path)), nullptr);
+
+    std::filesystem::remove_all(directory);
+}
+
+namespace {
+
+buildify::utils::Task<int> value_on_io_thread(int value) {
+    co_await buildify::utils::schedule_on(buildify::utils::ThreadPool::io_instance());
+    if (value < 0) {
+        throw std::runtime_error("negative");
+    }
+    co_return value;
+}
+
+buildify::utils::Task<void> fail_on_io_thread() {
+    co_await value_on_io_thread(-1);
+}
+
+}
+
+TEST(TaskTest, ExceptionsReachTheWaiter) {
+    EXPECT_EQ(buildify::utils::sync_wait(value_on_io_thread(3)), 3);
+    EXPECT_THROW(buildify::utils::sync_wait(value_on_io_thread(-1)), std::runtime_error);
+    EXPECT_THROW(buildify::utils::sync_wait(fail_on_io_thread()), std::runtime_error);
+
+    // when_all lets the other tasks finish before rethrowing.
+    std::vector<buildify::utils::Task<int>> tasks;
+    for (int value : {1, -1, 2, -2}) {
+        tasks.push_back(value_on_io_thread(value));
+    }
+    EXPECT_THROW(buildify::utils::sync_wait(buildify::utils::when_all(std::move(tasks))), std::runtime_error);
+
+    tasks.clear();
+    tasks.push_back(value_on_io_thread(4));
+    tasks.push_back(value_on_io_thread(5));
+    EXPECT_EQ(buildify::utils::sync_wait(buildify::utils::when_all(std::move(tasks))), (std::vector<int>{4, 5}));
+}
+
+TEST(HotReloadTest, AppliesChangedChunksAndPicksUpRewrites) {
+    namespace core = buildify::core;
+    const auto directory = std::filesystem::temp_directory_path() / ("buildify_reload_" + std::to_string(getpid()));
+    std::filesystem::create_directories(directory);
+    const std::string path = (directory / "scene.bgs").string();
+
+    core::GaussianCloud source(1);
+    for (int i = 0; i < 40000; ++i) {
+        source.add({float(i % 200), float(i / 200), -5.0f}, {0.1f, 0.1f, 0.1f}, {}, 0.5f, {1.0f, 0.0f, 0.0f});
+    }
+    ASSERT_TRUE(core::save_gaussians(path, source));
+
+    buildify::utils::FileWatcher watcher;
+    ASSERT_TRUE(watcher.watch(path));
+    EXPECT_TRUE(watcher.poll().empty());
+
+    core::Scene scene("Reloaded");
+    EXPECT_FALSE(scene.load_from_file((directory / "missing.bgs").string()));
+    EXPECT_TRUE(scene.get_source_path().empty());
+    ASSERT_TRUE(scene.load_from_file(path));
+    EXPECT_EQ(scene.get_source_path(), path);
+    const core::Scene& resident = scene;
+    const auto& cloud = resident.get_gaussians();
+    ASSERT_EQ(cloud.size(), source.size());
+    scene.get_gaussian_bvh();
+
+    // An unchanged file writes nothing, so caches stay valid.
+    core::GaussianReloadStats stats;
+    auto version = cloud.get_version();
+    ASSERT_TRUE(scene.reload_from_file(stats));
+    EXPECT_GT(stats.chunks, 10u);
+    EXPECT_EQ(stats.changed_chunks, 0u);
+    EXPECT_EQ(cloud.get_version(), version);
+
+    // A color edit saved through a rename, like most exporters do: one
+    // chunk changes and the BVH is kept.
+    source.column(core::GaussianAttribute::ColorG)[123] = 0.5f;
+    const std::string temporary = path + ".tmp";
+    ASSERT_TRUE(core::save_gaussians(temporary, source));
+    std::filesystem::rename(temporary, path);
+    const auto changed = watcher.poll();
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], buildify::utils::FileWatcher::normalize(path));
+    EXPECT_TRUE(watcher.poll().empty());
+
+    ASSERT_TRUE(scene.reload_from_file(stats));
+    EXPECT_EQ(stats.changed_chunks, 1u);
+    EXPECT_TRUE(stats.appearance_changed);
+    EXPECT_FALSE(stats.positions_changed || stats.shapes_changed || stats.full_load);
+    EXPECT_EQ(cloud.column(core::GaussianAttribute::ColorG)[123], 0.5f);
+    EXPECT_NE(cloud.get_version(), version);
+    EXPECT_EQ(resident.get_gaussian_bvh().get_source_version(), cloud.get_version());
+
+    // Moved splats refit the BVH instead of rebuilding it.
+    source.column(core::GaussianAttribute::PositionX)[39999] = 500.0f;
+    ASSERT_TRUE(core::save_gaussians(path, source));
+    ASSERT_EQ(watcher.poll().size(), 1u);
+    ASSERT_TRUE(scene.reload_from_file(stats));
+    EXPECT_TRUE(stats.positions_changed);
+    EXPECT_FALSE(stats.shapes_changed);
+    EXPECT_EQ(resident.get_gaussian_bvh().get_source_version(), cloud.get_version());
+    EXPECT_EQ(cloud.get_position(39999).x, 500.0f);
+
+    // A different splat count is loaded in full.
+    source.add({0.0f, 0.0f, -5.0f}, {0.1f, 0.1f, 0.1f}, {}, 0.5f, {0.0f, 1.0f, 0.0f});
+    ASSERT_TRUE(core::save_gaussians(path, source));
+    ASSERT_TRUE(scene.reload_from_file(stats));
+    EXPECT_TRUE(stats.full_load);
+    EXPECT_EQ(cloud.size(), source.size());
+
+    // An evicted scene is not read back to be diffed: its spill file is
+    // dropped and the next acquire loads the rewritten file.
+    core::SceneResidency residency;
+    auto evicted = std::make_shared<core::Scene>("Evicted");
+    ASSERT_TRUE(evicted->load_from_file(path));
+    residency.add("Evicted", evicted);
+    residency.add("Other", std::make_shared<core::Scene>("Other"));
+    EXPECT_FALSE(residency.refresh_evicted("Evicted", path));
+    residency.set_settings({source.memory_footprint() / 2, (directory / "spill").string()});
+    residency.acquire("Other");
+    while (residency.get_state("Evicted") == core::SceneResidencyState::Evicting) {
+        std::this_thread::yield();
+    }
+    ASSERT_EQ(residency.get_state("Evicted"), core::SceneResidencyState::Evicted);
+    source.column(core::GaussianAttribute::PositionY)[7] = -3.0f;
+    ASSERT_TRUE(core::save_gaussians(path, source));
+    EXPECT_TRUE(residency.refresh_evicted("Evicted", path));
+    EXPECT_TRUE(std::filesystem::is_empty(directory / "spill"));
+    ASSERT_EQ(residency.acquire("Evicted"), evicted);
+    ASSERT_EQ(evicted->get_gaussians().size(), source.size());
+    EXPECT_EQ(evicted->get_gaussians().get_position(7).y, -3.0f);
+    residency.clear();
+
+    std::filesystem::remove_all(directory);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();